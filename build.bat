@@ -9,12 +9,18 @@ IF NOT EXIST %HENG_OUT% (MKDIR %HENG_OUT%)
 CALL build_hcore.bat
 IF ERRORLEVEL 1 GOTO fail
 
+CALL build_hpack.bat
+IF ERRORLEVEL 1 GOTO fail
+
 CALL build_heng.bat
 IF ERRORLEVEL 1 GOTO fail
 
 CALL build_hgame.bat
 IF ERRORLEVEL 1 GOTO fail
 
+CALL build_hengbench.bat
+IF ERRORLEVEL 1 GOTO fail
+
 ECHO.
 ECHO ----------------------
 ECHO copying dependencies
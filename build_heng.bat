@@ -10,6 +10,7 @@ ECHO.
 
 %HENG_DOTNET%\csc.exe -nologo ^
 	-debug -d:DEBUG ^
+	-unsafe ^
 	-platform:%CPU% -t:library ^
 	-out:"%HENG_OUT%\heng.dll" ^
 	-recurse:"src\heng\*.cs"
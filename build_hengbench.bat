@@ -0,0 +1,27 @@
+@ECHO off
+
+IF NOT DEFINED CPU (GOTO envmissing)
+
+ECHO.
+ECHO ----------------------
+ECHO building heng_bench
+ECHO ----------------------
+ECHO.
+
+%HENG_DOTNET%\csc.exe -nologo ^
+	-debug -d:DEBUG ^
+	-platform:%CPU% -t:exe ^
+	-r:%HENG_OUT%\heng.dll ^
+	-out:"%HENG_OUT%\heng_bench.exe" ^
+	-recurse:"src\hengbench\*.cs"
+
+IF ERRORLEVEL 1 GOTO :EOF
+
+ECHO done
+GOTO :EOF
+
+:envmissing
+ECHO.
+ECHO build environment isn't set up - did you forget to call setup.bat?
+
+EXIT /b 1
\ No newline at end of file
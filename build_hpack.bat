@@ -0,0 +1,48 @@
+@ECHO off
+
+IF NOT DEFINED CPU (GOTO envmissing)
+
+ECHO.
+ECHO ----------------------
+ECHO building heng-pack
+ECHO ----------------------
+ECHO.
+
+REM - the pack tool converts assets with the same code hcore loads them with
+REM - hcore's time.h would shadow the system's as a regular include path, so it's only searched for quoted includes
+clang ^
+	-target %ARCH%-windows-unknown ^
+	-g -gcodeview ^
+	-O2 ^
+	-std=c11 ^
+	-Wall -Wno-deprecated-declarations -Wno-missing-prototype-for-cc ^
+	-iquote src\hcore ^
+	-I%HENG_SDL2_INC% -L%HENG_SDL2_LIB% -lSDL2.lib ^
+	-I%HENG_OGG_INC% -L%HENG_OGG_LIB% -logg.lib ^
+	-I%HENG_VORBIS_INC% -L%HENG_VORBIS_LIB% -lvorbis.lib -lvorbisfile.lib ^
+	-lMSVCRTD.lib ^
+	-Xlinker /NODEFAULTLIB:libcmt.lib ^
+	-Xlinker /NODEFAULTLIB:msvcrt.lib ^
+	-o"%HENG_OUT%/heng-pack.exe" ^
+	"src\hpack\*.c" ^
+	"src\hcore\audio_resampler.c" ^
+	"src\hcore\audio_sounds.c" ^
+	"src\hcore\audio_sounds_adpcm.c" ^
+	"src\hcore\audio_sounds_ogg.c" ^
+	"src\hcore\audio_sounds_wav.c" ^
+	"src\hcore\memory.c" ^
+	"src\hcore\pack.c" ^
+	"src\hcore\resource_loader.c" ^
+	"src\hcore\resource_map.c" ^
+	"src\hcore\time_profiler.c"
+
+IF ERRORLEVEL 1 GOTO :EOF
+
+ECHO done
+GOTO :EOF
+
+:envmissing
+ECHO.
+ECHO build environment isn't set up - did you forget to call setup.bat?
+
+EXIT /b 1
\ No newline at end of file
@@ -0,0 +1,1060 @@
+// hcore-bench: times hcore's hot paths headlessly, and writes the results as json
+// video draws offscreen with the software backend and audio runs on SDL's dummy driver, so it works without a display or sound card;
+// the log, the event log and a generated test sound are written to the working directory
+
+#define SDL_MAIN_HANDLED
+
+#include "core.h"
+#include "resource_map.h"
+#include "vector_batch.h"
+
+extern void Core_Events_Log_LogEvent(SDL_Event *ev);
+extern bool Audio_Sounds_Init(struct audio_sounds_config config);
+extern void Audio_Sounds_Quit();
+
+#define BENCH_RESULTS_VERSION 3
+#define BENCH_SAMPLES_DEFAULT 15
+#define BENCH_SAMPLES_MAX 1000
+
+typedef struct
+{
+	char *name;
+	int iterations;		// operations per sample; results are per operation
+
+	bool (*setup)();	// optional
+	void (*run)(int iterations);
+	void (*teardown)();	// optional
+
+	uint64 (*getPeakBytes)();	// optional; read after the samples, for benchmarks that compare memory too
+} benchmark;
+
+// deterministic, so every run draws and looks up the same things
+intern uint32 randState;
+
+intern uint32 Random()
+{
+	randState = randState * 1664525u + 1013904223u;
+	return randState >> 8;
+}
+
+// - - - - - -
+// mixer
+// - - - - - -
+
+#define BENCH_SOUND_PATH "hbench_tone.wav"
+#define BENCH_SOUND_RATE 44100
+#define BENCH_SOUND_SECONDS 2
+#define BENCH_MAX_SOUNDS 16
+#define BENCH_MIXER_CHANNELS 128
+#define BENCH_MIXER_REAL_VOICES 32
+
+intern int benchSoundID = -1;
+intern int mixerChannels[BENCH_MIXER_CHANNELS];
+intern SDL_AudioDeviceID mixerDevice;
+
+intern void WriteLE(FILE *file, uint32 value, int bytes)
+{
+	for(int i = 0; i < bytes; i++)
+	{ fputc((value >> (i * 8)) & 0xFF, file); }
+}
+
+// an s16 tone, a fifth higher in each channel than the one before it
+intern bool WriteTone(char *path, int rate, int channelCt, uint32 frames)
+{
+	FILE *file = fopen(path, "wb");
+	if(!file)
+	{
+		LogError("couldn't write test sound '%s'", path);
+		return false;
+	}
+
+	uint32 frameSize = channelCt * sizeof(int16);
+	uint32 dataLen = frames * frameSize;
+
+	fwrite("RIFF", 1, 4, file);
+	WriteLE(file, 36 + dataLen, 4);
+	fwrite("WAVEfmt ", 1, 8, file);
+	WriteLE(file, 16, 4);
+	WriteLE(file, 1, 2);	// pcm
+	WriteLE(file, channelCt, 2);
+	WriteLE(file, rate, 4);
+	WriteLE(file, rate * frameSize, 4);
+	WriteLE(file, frameSize, 2);
+	WriteLE(file, 16, 2);
+	fwrite("data", 1, 4, file);
+	WriteLE(file, dataLen, 4);
+
+	for(uint32 i = 0; i < frames; i++)
+	{
+		double freq = 440;
+		for(int c = 0; c < channelCt; c++, freq *= 1.5)
+		{ WriteLE(file, (uint16)((int16)(sin(i * 2 * M_PI * freq / rate) * 8000)), 2); }
+	}
+
+	fclose(file);
+	return true;
+}
+
+// in the same format the device is opened with, so it's copied straight through as it plays
+intern bool WriteTestSound(char *path)
+{
+	return WriteTone(path, BENCH_SOUND_RATE, 2, BENCH_SOUND_RATE * BENCH_SOUND_SECONDS);
+}
+
+intern bool SetupMixer()
+{
+	if(benchSoundID < 0)
+	{
+		if(!WriteTestSound(BENCH_SOUND_PATH))
+		{ return false; }
+
+		benchSoundID = Audio_Sounds_LoadSound(BENCH_SOUND_PATH);
+		if(benchSoundID < 0)
+		{ return false; }
+
+		// half the channels play at the sound's own rate, and half are resampled
+		for(int i = 0; i < BENCH_MIXER_CHANNELS; i++)
+		{
+			int ch = Audio_Mixer_Channels_GetNextFreeChannel();
+			if(ch < 0 || Audio_Mixer_Channels_SetSound(ch, benchSoundID) < 0)
+			{ return false; }
+
+			Audio_Mixer_Channels_SetVolume(ch, (uint8)(64 + (i % 128)));
+			Audio_Mixer_Channels_SetPanning(ch, (mixer_channel_panning) { (uint8)(255 - i), (uint8)(i * 2) });
+			Audio_Mixer_Channels_SetBus(ch, (uint8)(i % MIXER_BUS_MASTER));
+
+			if(i % 2)
+			{ Audio_Mixer_Channels_SetRate(ch, 0.75f + (i % 8) * 0.1f); }
+
+			mixerChannels[i] = ch;
+		}
+
+		// the dummy device plays in real time; paused, every push mixes a whole buffer
+		mixerDevice = Audio_GetSnapshotView(1 << AUDIO_SNAPSHOT_DEVICE)->device.deviceID;
+		SDL_PauseAudioDevice(mixerDevice, 1);
+	}
+
+	return true;
+}
+
+intern void RunMixer(int channelCount, int iterations)
+{
+	for(int i = 0; i < iterations; i++)
+	{
+		Audio_Mixer_Channels_AdvanceBatch(mixerChannels, channelCount, true);
+		Audio_PushSound();
+		SDL_ClearQueuedAudio(mixerDevice);
+	}
+}
+
+intern void RunMixerReal(int iterations)
+{
+	RunMixer(BENCH_MIXER_REAL_VOICES, iterations);
+}
+
+intern void RunMixerVirtual(int iterations)
+{
+	RunMixer(BENCH_MIXER_CHANNELS, iterations);
+}
+
+// - - - - - -
+// sound loading
+// - - - - - -
+
+#define BENCH_LOAD_SOUNDS 100
+#define BENCH_LOAD_PATH_MAX 32
+
+intern char loadPaths[BENCH_LOAD_SOUNDS][BENCH_LOAD_PATH_MAX];
+intern int loadIDs[BENCH_LOAD_SOUNDS];
+intern bool loadSetWritten;
+
+// a game's worth of short effects, at the rates and channel counts they tend to come in, and mostly not the device's
+intern bool WriteLoadSet()
+{
+	int rates[] = { 22050, 32000, BENCH_SOUND_RATE, 48000 };
+
+	for(int i = 0; i < BENCH_LOAD_SOUNDS; i++)
+	{
+		int rate = rates[i % 4];
+		uint32 frames = (uint32)(rate) * (250 + ((i * 37) % 500)) / 1000;
+
+		snprintf(loadPaths[i], BENCH_LOAD_PATH_MAX, "hbench_load_%03i.wav", i);
+		if(!WriteTone(loadPaths[i], rate, 1 + ((i / 4) % 2), frames))
+		{ return false; }
+	}
+
+	return true;
+}
+
+// the sounds are started again with the conversion being measured, so the mixer's channels have to let go of theirs
+intern bool SetupSoundLoad(bool convertOnLoad)
+{
+	if(!loadSetWritten)
+	{
+		if(!WriteLoadSet())
+		{ return false; }
+
+		loadSetWritten = true;
+	}
+
+	if(benchSoundID > -1)
+	{
+		for(int i = 0; i < BENCH_MIXER_CHANNELS; i++)
+		{ Audio_Mixer_Channels_SetSound(mixerChannels[i], -1); }
+
+		benchSoundID = -1;
+	}
+
+	Audio_Sounds_Quit();
+	if(!Audio_Sounds_Init((struct audio_sounds_config) { .maxSounds = BENCH_LOAD_SOUNDS, .convertOnLoad = convertOnLoad }))
+	{ return false; }
+
+	Memory_ResetPeaks();
+	return true;
+}
+
+intern bool SetupSoundLoadNative()
+{
+	return SetupSoundLoad(false);
+}
+
+intern bool SetupSoundLoadConverted()
+{
+	return SetupSoundLoad(true);
+}
+
+intern void TeardownSoundLoad()
+{
+	Audio_Sounds_Quit();
+	Audio_Sounds_Init((struct audio_sounds_config) { .maxSounds = BENCH_MAX_SOUNDS });
+}
+
+// loads the whole set, then lets it all go
+intern void RunSoundLoad(int iterations)
+{
+	for(int i = 0; i < iterations; i++)
+	{
+		for(int s = 0; s < BENCH_LOAD_SOUNDS; s++)
+		{ loadIDs[s] = Audio_Sounds_LoadSound(loadPaths[s]); }
+
+		for(int s = 0; s < BENCH_LOAD_SOUNDS; s++)
+		{
+			if(loadIDs[s] > -1)
+			{ Audio_Sounds_FreeSound(loadIDs[s]); }
+		}
+	}
+}
+
+// only the samples hcore keeps; SDL's own copy of each file is freed as soon as it's loaded, either way
+intern uint64 GetSoundsPeakBytes()
+{
+	memory_state state;
+	Core_GetMemorySnapshot(&state);
+
+	return state.tags[MEMORY_TAG_SOUNDS].peakBytes;
+}
+
+// - - - - - -
+// resource map
+// - - - - - -
+
+#define BENCH_MAP_SIZE 4096
+#define BENCH_MAP_RESIDENT 2048
+#define BENCH_MAP_PATH_MAX 64
+
+intern resource_map *benchMap;
+intern char benchPaths[BENCH_MAP_SIZE][BENCH_MAP_PATH_MAX];
+intern int benchIndices[BENCH_MAP_SIZE];
+intern int benchDummy;
+
+intern void *AllocDummy(char *filePath)
+{
+	return &benchDummy;
+}
+
+intern void FreeDummy(void *data)
+{
+	noop;
+}
+
+intern uint64 SizeDummy(void *data)
+{
+	return 1;
+}
+
+intern bool SetupResourceMap()
+{
+	benchMap = ResourceMap_Create(BENCH_MAP_SIZE, &AllocDummy, &FreeDummy, &SizeDummy);
+	if(!benchMap)
+	{ return false; }
+
+	// paths like a game's, so they hash like a game's
+	for(int i = 0; i < BENCH_MAP_SIZE; i++)
+	{ snprintf(benchPaths[i], BENCH_MAP_PATH_MAX, "data/region_%02i/sprites/sprite_%04i.bmp", i % 17, i); }
+
+	for(int i = 0; i < BENCH_MAP_RESIDENT; i++)
+	{
+		benchIndices[i] = ResourceMap_AllocResource(benchMap, benchPaths[i]);
+		if(benchIndices[i] < 0)
+		{ return false; }
+	}
+
+	randState = 1;
+	return true;
+}
+
+intern void TeardownResourceMap()
+{
+	ResourceMap_Free(benchMap);
+	benchMap = NULL;
+}
+
+// finds an already-resident path, then lets go of the extra reference
+intern void RunResourceMapHit(int iterations)
+{
+	for(int i = 0; i < iterations; i++)
+	{
+		int index = ResourceMap_AllocResource(benchMap, benchPaths[Random() % BENCH_MAP_RESIDENT]);
+		ResourceMap_FreeResource(benchMap, index);
+	}
+}
+
+// loads and releases paths that aren't resident, probing past the values freed before them
+intern void RunResourceMapChurn(int iterations)
+{
+	for(int i = 0; i < iterations; i++)
+	{
+		int index = ResourceMap_AllocResource(benchMap, benchPaths[BENCH_MAP_RESIDENT + (Random() % (BENCH_MAP_SIZE - BENCH_MAP_RESIDENT))]);
+		ResourceMap_FreeResource(benchMap, index);
+	}
+}
+
+// - - - - - -
+// video queue
+// - - - - - -
+
+#define BENCH_WINDOW 0
+#define BENCH_WINDOW_W 1280
+#define BENCH_WINDOW_H 720
+#define BENCH_FRAME_COMMANDS 4096
+#define BENCH_CLOUD_POINTS 65536
+#define BENCH_FRAME_PATH "frame.bmp"
+
+intern screen_point cloud[BENCH_CLOUD_POINTS];
+intern bool windowOpen;
+
+intern screen_point RandomPoint()
+{
+	return (screen_point) { Random() % BENCH_WINDOW_W, Random() % BENCH_WINDOW_H };
+}
+
+intern color RandomColor()
+{
+	uint32 c = Random();
+	return (color) { c & 0xFF, (c >> 8) & 0xFF, (c >> 16) & 0xFF, 0xFF };
+}
+
+intern bool SetupVideo()
+{
+	if(!windowOpen)
+	{
+		Video_Windows_OpenWindow(BENCH_WINDOW, "hcore_bench", (screen_rect) { 0, 0, BENCH_WINDOW_W, BENCH_WINDOW_H },
+			SDL_WINDOW_HIDDEN, SDL_RENDERER_SOFTWARE);
+
+		windowOpen = Video_Windows_CheckWindow(BENCH_WINDOW);
+		if(!windowOpen)
+		{ return false; }
+	}
+
+	randState = 1;
+	for(int i = 0; i < BENCH_CLOUD_POINTS; i++)
+	{ cloud[i] = RandomPoint(); }
+
+	return true;
+}
+
+// an even mix of the primitive commands, as a debug overlay would queue them
+intern void QueueFrame()
+{
+	randState = 1;
+	Video_Queue_ClearWindow(BENCH_WINDOW, COLOR_BLACK);
+
+	for(int i = 0; i < BENCH_FRAME_COMMANDS; i += 4)
+	{
+		screen_point p = RandomPoint();
+
+		Video_Queue_DrawPoint(BENCH_WINDOW, RandomColor(), p);
+		Video_Queue_DrawLine(BENCH_WINDOW, RandomColor(), (screen_line) { p, RandomPoint() });
+		Video_Queue_DrawRect(BENCH_WINDOW, RandomColor(), (screen_rect) { p.x, p.y, 16, 16 }, i % 8 == 0);
+
+		screen_point polygon[8];
+		for(int v = 0; v < 8; v++)
+		{
+			float a = (float)(v) * (float)(M_PI) / 4;
+			polygon[v] = (screen_point) { p.x + (int)(cosf(a) * 12), p.y + (int)(sinf(a) * 12) };
+		}
+
+		if(i % 8 == 0)
+		{ Video_Queue_FillPolygon(BENCH_WINDOW, RandomColor(), polygon, 8); }
+		else
+		{ Video_Queue_DrawPolygon(BENCH_WINDOW, RandomColor(), polygon, 8); }
+	}
+}
+
+intern void RunVideoEnqueue(int iterations)
+{
+	for(int i = 0; i < iterations; i++)
+	{
+		QueueFrame();
+		Video_Queue_ClearQueue(BENCH_WINDOW);
+	}
+}
+
+intern void RunVideoPump(int iterations)
+{
+	for(int i = 0; i < iterations; i++)
+	{
+		QueueFrame();
+		Video_Queue_Pump(BENCH_WINDOW);
+	}
+}
+
+intern void RunVideoPointCloud(int iterations)
+{
+	for(int i = 0; i < iterations; i++)
+	{
+		Video_Queue_ClearWindow(BENCH_WINDOW, COLOR_BLACK);
+		Video_Queue_DrawPoints(BENCH_WINDOW, COLOR_WHITE, cloud, BENCH_CLOUD_POINTS);
+		Video_Queue_Pump(BENCH_WINDOW);
+	}
+}
+
+// the frame pump_4096 draws, for comparing against a golden image; it's the same every run
+intern bool SaveFrame(char *filePath)
+{
+	if(!SetupVideo())
+	{ return false; }
+
+	QueueFrame();
+	Video_Queue_Pump(BENCH_WINDOW);
+
+	return Video_Windows_SaveImage(BENCH_WINDOW, filePath);
+}
+
+// pixel for pixel; both are converted to one format first, since the golden may have been resaved by another tool
+intern bool CompareFrame(char *framePath, char *goldenPath)
+{
+	SDL_Surface *frame = SDL_LoadBMP(framePath);
+	SDL_Surface *golden = SDL_LoadBMP(goldenPath);
+	SDL_Surface *a = frame ? SDL_ConvertSurfaceFormat(frame, SDL_PIXELFORMAT_ARGB8888, 0) : NULL;
+	SDL_Surface *b = golden ? SDL_ConvertSurfaceFormat(golden, SDL_PIXELFORMAT_ARGB8888, 0) : NULL;
+
+	bool match = false;
+	if(!a || !b)
+	{ fprintf(stderr, "couldn't load '%s' and '%s' for comparing\n\tSDL error: %s\n", framePath, goldenPath, SDL_GetError()); }
+	else if(a->w != b->w || a->h != b->h)
+	{ fprintf(stderr, "frame is %ix%i, but golden image '%s' is %ix%i\n", a->w, a->h, goldenPath, b->w, b->h); }
+	else
+	{
+		int differing = 0;
+		for(int y = 0; y < a->h; y++)
+		{
+			uint32 *rowA = (uint32*)((uint8*)(a->pixels) + y * a->pitch);
+			uint32 *rowB = (uint32*)((uint8*)(b->pixels) + y * b->pitch);
+
+			for(int x = 0; x < a->w; x++)
+			{ differing += (rowA[x] != rowB[x]); }
+		}
+
+		match = (differing == 0);
+		if(!match)
+		{ fprintf(stderr, "frame differs from golden image '%s' in %i pixels\n", goldenPath, differing); }
+	}
+
+	SDL_FreeSurface(a);
+	SDL_FreeSurface(b);
+	SDL_FreeSurface(frame);
+	SDL_FreeSurface(golden);
+
+	return match;
+}
+
+// - - - - - -
+// vector batches
+// - - - - - -
+
+// not a multiple of 4, so the batches' scalar tails are checked and timed too
+#define BENCH_VECTORS 4099
+#define BENCH_VECTOR_DEGREES 33.0f
+
+intern vector2 vectors[BENCH_VECTORS];
+intern vector2 vectorsOut[BENCH_VECTORS];
+intern vector2 vectorsExpected[BENCH_VECTORS];
+intern float vectorsSoAX[BENCH_VECTORS], vectorsSoAY[BENCH_VECTORS];
+intern float vectorsOutX[BENCH_VECTORS], vectorsOutY[BENCH_VECTORS];
+intern float dots[BENCH_VECTORS], dotsExpected[BENCH_VECTORS];
+intern bool vectorsChecked;
+intern bool vectorsEquivalent;
+
+intern const vector2 benchScale = { 1.5f, 0.75f };
+intern const vector2 benchTranslation = { 100.25f, -3.5f };
+
+intern float RandomCoordinate()
+{
+	return (Random() / (float)(1 << 24)) * 128 - 64;
+}
+
+// the reference every batch has to match; it's what callers did before batches existed
+intern vector2 TransformReference(vector2 v)
+{
+	vector2 scaled = { v.x * benchScale.x, v.y * benchScale.y };
+	return VectorAdd(VectorRotate(scaled, BENCH_VECTOR_DEGREES), benchTranslation);
+}
+
+// the batches promise the same results as vector.h, not just close ones, so they're compared exactly
+intern bool CheckVectors(char *op, vector2 *actual)
+{
+	for(int i = 0; i < BENCH_VECTORS; i++)
+	{
+		if(actual[i].x != vectorsExpected[i].x || actual[i].y != vectorsExpected[i].y)
+		{
+			fprintf(stderr, "%s differs from vector.h at %i: (%g, %g), expected (%g, %g)\n", op, i,
+				actual[i].x, actual[i].y, vectorsExpected[i].x, vectorsExpected[i].y);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+intern bool CheckVectorsSoA(char *op)
+{
+	for(int i = 0; i < BENCH_VECTORS; i++)
+	{ vectorsOut[i] = (vector2) { vectorsOutX[i], vectorsOutY[i] }; }
+
+	return CheckVectors(op, vectorsOut);
+}
+
+intern bool CheckFloats(char *op, float *actual, float *expected, int count)
+{
+	for(int i = 0; i < count; i++)
+	{
+		if(actual[i] != expected[i])
+		{
+			fprintf(stderr, "%s differs from vector.h at %i: %g, expected %g\n", op, i, actual[i], expected[i]);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+// every operation, in both layouts, against the scalar functions they batch
+intern bool CheckVectorBatch()
+{
+	vector2_soa in = { vectorsSoAX, vectorsSoAY };
+	vector2_soa out = { vectorsOutX, vectorsOutY };
+	bool equivalent = true;
+
+	Vector_Batch_ToSoA(in, vectors, BENCH_VECTORS);
+	Vector_Batch_ToAoS(vectorsOut, in, BENCH_VECTORS);
+	memcpy(vectorsExpected, vectors, sizeof(vectors));
+	equivalent = CheckVectors("ToSoA/ToAoS", vectorsOut) && equivalent;
+
+	for(int i = 0; i < BENCH_VECTORS; i++)
+	{ vectorsExpected[i] = VectorAdd(vectors[i], vectors[BENCH_VECTORS - 1 - i]); }
+
+	// the second operand is the output too, since outputs may alias inputs
+	for(int i = 0; i < BENCH_VECTORS; i++)
+	{
+		vectorsOutX[i] = vectors[BENCH_VECTORS - 1 - i].x;
+		vectorsOutY[i] = vectors[BENCH_VECTORS - 1 - i].y;
+		vectorsOut[i] = vectors[BENCH_VECTORS - 1 - i];
+	}
+
+	Vector_Batch_Add(vectorsOut, vectors, vectorsOut, BENCH_VECTORS);
+	equivalent = CheckVectors("Add", vectorsOut) && equivalent;
+	Vector_Batch_AddSoA(out, in, out, BENCH_VECTORS);
+	equivalent = CheckVectorsSoA("AddSoA") && equivalent;
+
+	for(int i = 0; i < BENCH_VECTORS; i++)
+	{ vectorsExpected[i] = VectorScale(vectors[i], benchScale.x); }
+
+	Vector_Batch_Scale(vectorsOut, vectors, benchScale.x, BENCH_VECTORS);
+	equivalent = CheckVectors("Scale", vectorsOut) && equivalent;
+	Vector_Batch_ScaleSoA(out, in, benchScale.x, BENCH_VECTORS);
+	equivalent = CheckVectorsSoA("ScaleSoA") && equivalent;
+
+	for(int i = 0; i < BENCH_VECTORS; i++)
+	{ vectorsExpected[i] = VectorNormalize(vectors[i]); }
+
+	Vector_Batch_Normalize(vectorsOut, vectors, BENCH_VECTORS);
+	equivalent = CheckVectors("Normalize", vectorsOut) && equivalent;
+	Vector_Batch_NormalizeSoA(out, in, BENCH_VECTORS);
+	equivalent = CheckVectorsSoA("NormalizeSoA") && equivalent;
+
+	for(int i = 0; i < BENCH_VECTORS; i++)
+	{ vectorsExpected[i] = VectorRotate(vectors[i], BENCH_VECTOR_DEGREES); }
+
+	Vector_Batch_Rotate(vectorsOut, vectors, BENCH_VECTOR_DEGREES, BENCH_VECTORS);
+	equivalent = CheckVectors("Rotate", vectorsOut) && equivalent;
+	Vector_Batch_RotateSoA(out, in, BENCH_VECTOR_DEGREES, BENCH_VECTORS);
+	equivalent = CheckVectorsSoA("RotateSoA") && equivalent;
+
+	for(int i = 0; i < BENCH_VECTORS; i++)
+	{ vectorsExpected[i] = TransformReference(vectors[i]); }
+
+	Vector_Batch_Transform(vectorsOut, vectors, benchScale, BENCH_VECTOR_DEGREES, benchTranslation, BENCH_VECTORS);
+	equivalent = CheckVectors("Transform", vectorsOut) && equivalent;
+	Vector_Batch_TransformSoA(out, in, benchScale, BENCH_VECTOR_DEGREES, benchTranslation, BENCH_VECTORS);
+	equivalent = CheckVectorsSoA("TransformSoA") && equivalent;
+
+	for(int i = 0; i < BENCH_VECTORS; i++)
+	{ dotsExpected[i] = VectorDot(vectors[i], benchTranslation); }
+
+	for(int i = 0; i < BENCH_VECTORS; i++)
+	{
+		vectorsOut[i] = benchTranslation;
+		vectorsOutX[i] = benchTranslation.x;
+		vectorsOutY[i] = benchTranslation.y;
+	}
+
+	Vector_Batch_Dot(dots, vectors, vectorsOut, BENCH_VECTORS);
+	equivalent = CheckFloats("Dot", dots, dotsExpected, BENCH_VECTORS) && equivalent;
+	Vector_Batch_DotSoA(dots, in, out, BENCH_VECTORS);
+	equivalent = CheckFloats("DotSoA", dots, dotsExpected, BENCH_VECTORS) && equivalent;
+
+	// every count up to a few batches wide, so each split between the wide loop and the tail is covered
+	for(int count = 1; count <= 13; count++)
+	{
+		float expected[2] = { FLT_MAX, -FLT_MAX };
+		for(int i = 0; i < count; i++)
+		{
+			float dot = VectorDot(VectorAdd(vectors[i], benchTranslation), benchScale);
+			expected[0] = min(expected[0], dot);
+			expected[1] = max(expected[1], dot);
+		}
+
+		float actual[2], actualSoA[2];
+		Vector_Batch_ProjectMinMax(vectors, count, benchTranslation, benchScale, &actual[0], &actual[1]);
+		Vector_Batch_ProjectMinMaxSoA(in, count, benchTranslation, benchScale, &actualSoA[0], &actualSoA[1]);
+
+		equivalent = CheckFloats("ProjectMinMax", actual, expected, 2) && equivalent;
+		equivalent = CheckFloats("ProjectMinMaxSoA", actualSoA, expected, 2) && equivalent;
+	}
+
+	return equivalent;
+}
+
+// a few zero vectors are mixed in, since normalizing leaves them alone
+intern bool SetupVectorBatch()
+{
+	if(!vectorsChecked)
+	{
+		randState = 1;
+		for(int i = 0; i < BENCH_VECTORS; i++)
+		{ vectors[i] = (i % 37 == 0) ? VECTOR2_ZERO : (vector2) { RandomCoordinate(), RandomCoordinate() }; }
+
+		vectorsEquivalent = CheckVectorBatch();
+		vectorsChecked = true;
+	}
+
+	// the soa runs read the same vectors as the aos ones
+	Vector_Batch_ToSoA((vector2_soa) { vectorsSoAX, vectorsSoAY }, vectors, BENCH_VECTORS);
+	return vectorsEquivalent;
+}
+
+intern void RunTransformScalar(int iterations)
+{
+	for(int i = 0; i < iterations; i++)
+	{
+		for(int v = 0; v < BENCH_VECTORS; v++)
+		{ vectorsOut[v] = TransformReference(vectors[v]); }
+	}
+}
+
+intern void RunTransformBatch(int iterations)
+{
+	for(int i = 0; i < iterations; i++)
+	{ Vector_Batch_Transform(vectorsOut, vectors, benchScale, BENCH_VECTOR_DEGREES, benchTranslation, BENCH_VECTORS); }
+}
+
+intern void RunTransformBatchSoA(int iterations)
+{
+	for(int i = 0; i < iterations; i++)
+	{
+		Vector_Batch_TransformSoA((vector2_soa) { vectorsOutX, vectorsOutY }, (vector2_soa) { vectorsSoAX, vectorsSoAY },
+			benchScale, BENCH_VECTOR_DEGREES, benchTranslation, BENCH_VECTORS);
+	}
+}
+
+intern void RunNormalizeScalar(int iterations)
+{
+	for(int i = 0; i < iterations; i++)
+	{
+		for(int v = 0; v < BENCH_VECTORS; v++)
+		{ vectorsOut[v] = VectorNormalize(vectors[v]); }
+	}
+}
+
+intern void RunNormalizeBatch(int iterations)
+{
+	for(int i = 0; i < iterations; i++)
+	{ Vector_Batch_Normalize(vectorsOut, vectors, BENCH_VECTORS); }
+}
+
+// - - - - - -
+// snapshots
+// - - - - - -
+
+// what the engine pays per frame to read every section; interop only hands back a pointer, so this is all of it
+intern void RunSnapshotIdle(int iterations)
+{
+	for(int i = 0; i < iterations; i++)
+	{
+		Video_GetSnapshotView(UINT32_MAX);
+		Audio_GetSnapshotView(UINT32_MAX);
+	}
+}
+
+// a frame's worth of changes to one source per section, so each is gathered and compared again
+intern void RunSnapshotChanged(int iterations)
+{
+	for(int i = 0; i < iterations; i++)
+	{
+		Video_Queue_DrawPoint(BENCH_WINDOW, COLOR_WHITE, (screen_point) { i % BENCH_WINDOW_W, 0 });
+		Video_Queue_ClearQueue(BENCH_WINDOW);
+		Audio_Mixer_Channels_SetVolume(mixerChannels[0], (uint8)(i));
+		Audio_Mixer_Buses_SetGain(MIXER_BUS_SFX, 1);
+
+		Video_GetSnapshotView(UINT32_MAX);
+		Audio_GetSnapshotView(UINT32_MAX);
+	}
+}
+
+intern bool SetupSnapshot()
+{
+	return SetupVideo() && SetupMixer();
+}
+
+// - - - - - -
+// event log
+// - - - - - -
+
+intern void RunEventLog(int iterations)
+{
+	SDL_Event ev = { 0 };
+
+	for(int i = 0; i < iterations; i++)
+	{
+		ev.type = (i % 2) ? SDL_KEYUP : SDL_KEYDOWN;
+		ev.key.timestamp = (uint32)(i);
+		ev.key.keysym.scancode = (SDL_Scancode)(SDL_SCANCODE_A + (i % 26));
+
+		Core_Events_Log_LogEvent(&ev);
+	}
+}
+
+// - - - - - -
+// logging
+// - - - - - -
+
+// everything's formatted, even when no output wants it
+intern void RunLogFiltered(int iterations)
+{
+	for(int i = 0; i < iterations; i++)
+	{ LogDebug("bench message %i: %s (%f)", i, "filtered", i * 0.5); }
+}
+
+intern bool SetupLogFile()
+{
+	Log_File_SetMinLevel(LOG_DEBUG);
+	return true;
+}
+
+intern void TeardownLogFile()
+{
+	Log_File_SetMinLevel(LOG_WARNING);
+}
+
+intern void RunLogFile(int iterations)
+{
+	for(int i = 0; i < iterations; i++)
+	{ LogDebug("bench message %i: %s (%f)", i, "to file", i * 0.5); }
+}
+
+// - - - - - -
+// runner
+// - - - - - -
+
+intern benchmark benchmarks[] =
+{
+	{ "mixer/push_32_real", 200, &SetupMixer, &RunMixerReal, NULL },
+	{ "mixer/push_128_channels_32_real", 200, &SetupMixer, &RunMixerVirtual, NULL },
+	{ "sounds/load_100_native", 1, &SetupSoundLoadNative, &RunSoundLoad, &TeardownSoundLoad, &GetSoundsPeakBytes },
+	{ "sounds/load_100_converted", 1, &SetupSoundLoadConverted, &RunSoundLoad, &TeardownSoundLoad, &GetSoundsPeakBytes },
+	{ "resource_map/alloc_resident", 100000, &SetupResourceMap, &RunResourceMapHit, &TeardownResourceMap },
+	{ "resource_map/alloc_free_churn", 100000, &SetupResourceMap, &RunResourceMapChurn, &TeardownResourceMap },
+	{ "video_queue/enqueue_4096", 50, &SetupVideo, &RunVideoEnqueue, NULL },
+	{ "video_queue/pump_4096", 10, &SetupVideo, &RunVideoPump, NULL },
+	{ "video_queue/pump_points_65536", 10, &SetupVideo, &RunVideoPointCloud, NULL },
+	{ "vector_batch/transform_4099_scalar", 1000, &SetupVectorBatch, &RunTransformScalar, NULL },
+	{ "vector_batch/transform_4099_aos", 1000, &SetupVectorBatch, &RunTransformBatch, NULL },
+	{ "vector_batch/transform_4099_soa", 1000, &SetupVectorBatch, &RunTransformBatchSoA, NULL },
+	{ "vector_batch/normalize_4099_scalar", 1000, &SetupVectorBatch, &RunNormalizeScalar, NULL },
+	{ "vector_batch/normalize_4099_aos", 1000, &SetupVectorBatch, &RunNormalizeBatch, NULL },
+	{ "snapshot/view_unchanged", 100000, &SetupSnapshot, &RunSnapshotIdle, NULL },
+	{ "snapshot/view_changed", 10000, &SetupSnapshot, &RunSnapshotChanged, NULL },
+	{ "event_log/log_input", 100000, NULL, &RunEventLog, NULL },
+	{ "log/filtered", 100000, NULL, &RunLogFiltered, NULL },
+	{ "log/file", 20000, &SetupLogFile, &RunLogFile, &TeardownLogFile }
+};
+
+#define BENCH_COUNT ((int)(sizeof(benchmarks) / sizeof(benchmark)))
+
+intern int CompareDoubles(const void *a, const void *b)
+{
+	double da = *(double*)(a);
+	double db = *(double*)(b);
+
+	return (da > db) - (da < db);
+}
+
+// only what json needs escaped is left out; nothing we write needs more
+intern void WriteString(FILE *out, char *str)
+{
+	fputc('"', out);
+
+	for(; *str; str++)
+	{
+		if(*str != '"' && *str != '\\' && (unsigned char)(*str) >= 0x20)
+		{ fputc(*str, out); }
+	}
+
+	fputc('"', out);
+}
+
+intern double TimeSample(benchmark *b)
+{
+	uint64 start = SDL_GetPerformanceCounter();
+	b->run(b->iterations);
+	uint64 end = SDL_GetPerformanceCounter();
+
+	double seconds = (double)(end - start) / (double)(SDL_GetPerformanceFrequency());
+	return seconds * 1e9 / b->iterations;
+}
+
+// one warm-up sample is thrown away, then the rest are summarized
+intern bool RunBenchmark(benchmark *b, int sampleCount, FILE *out, bool first)
+{
+	fprintf(out, "%s\n\t\t{ \"name\": ", first ? "" : ",");
+	WriteString(out, b->name);
+
+	if(b->setup && !b->setup())
+	{
+		LogError("couldn't set up benchmark '%s'", b->name);
+		fprintf(out, ", \"error\": \"setup failed\" }");
+		return false;
+	}
+
+	double samples[BENCH_SAMPLES_MAX];
+
+	TimeSample(b);
+	for(int i = 0; i < sampleCount; i++)
+	{ samples[i] = TimeSample(b); }
+
+	uint64 peakBytes = b->getPeakBytes ? b->getPeakBytes() : 0;
+
+	if(b->teardown)
+	{ b->teardown(); }
+
+	qsort(samples, sampleCount, sizeof(double), &CompareDoubles);
+
+	double mean = 0;
+	for(int i = 0; i < sampleCount; i++)
+	{ mean += samples[i] / sampleCount; }
+
+	fprintf(out, ", \"iterations\": %i, \"min_ns\": %.1f, \"median_ns\": %.1f, \"mean_ns\": %.1f, \"max_ns\": %.1f",
+		b->iterations, samples[0], samples[sampleCount / 2], mean, samples[sampleCount - 1]);
+
+	if(b->getPeakBytes)
+	{ fprintf(out, ", \"peak_bytes\": %llu", (unsigned long long)(peakBytes)); }
+
+	fprintf(out, " }");
+
+	return true;
+}
+
+intern void PrintUsage()
+{
+	fprintf(stderr,
+		"usage: hcore_bench [options]\n"
+		"\tresults are written as json, one entry per benchmark; times are per operation\n"
+		"options:\n"
+		"\t--samples <count>\ttimed samples per benchmark (default: %i)\n"
+		"\t--filter <text>\tonly run benchmarks whose names contain the text\n"
+		"\t--commit <id>\trecorded in the results, to track them per commit\n"
+		"\t--out <path>\twrite results to a file, instead of stdout\n"
+		"\t--video <backend>\twindowed, software or null (default: software)\n"
+		"\t--image <path>\tsave the video_queue/pump_4096 frame as a bmp, after benchmarking\n"
+		"\t--golden <path>\tfail unless that frame matches the bmp; it's saved to frame.bmp without --image\n"
+		"\t--list\tprint benchmark names and exit\n",
+		BENCH_SAMPLES_DEFAULT);
+}
+
+int main(int argc, char **argv)
+{
+	int sampleCount = BENCH_SAMPLES_DEFAULT;
+	char *filter = NULL;
+	char *commit = "unknown";
+	char *outPath = NULL;
+	char *imagePath = NULL;
+	char *goldenPath = NULL;
+	video_backend backend = VIDEO_BACKEND_SOFTWARE;
+
+	for(int i = 1; i < argc; i++)
+	{
+		char *arg = argv[i];
+
+		if(strcmp(arg, "--samples") == 0 && i + 1 < argc)
+		{
+			sampleCount = atoi(argv[++i]);
+			if(sampleCount < 1 || sampleCount > BENCH_SAMPLES_MAX)
+			{
+				fprintf(stderr, "sample count must be between 1 and %i\n", BENCH_SAMPLES_MAX);
+				return 1;
+			}
+		}
+		else if(strcmp(arg, "--filter") == 0 && i + 1 < argc)
+		{ filter = argv[++i]; }
+		else if(strcmp(arg, "--commit") == 0 && i + 1 < argc)
+		{ commit = argv[++i]; }
+		else if(strcmp(arg, "--out") == 0 && i + 1 < argc)
+		{ outPath = argv[++i]; }
+		else if(strcmp(arg, "--image") == 0 && i + 1 < argc)
+		{ imagePath = argv[++i]; }
+		else if(strcmp(arg, "--golden") == 0 && i + 1 < argc)
+		{ goldenPath = argv[++i]; }
+		else if(strcmp(arg, "--video") == 0 && i + 1 < argc)
+		{
+			char *name = argv[++i];
+			if(strcmp(name, "windowed") == 0)
+			{ backend = VIDEO_BACKEND_WINDOWED; }
+			else if(strcmp(name, "software") == 0)
+			{ backend = VIDEO_BACKEND_SOFTWARE; }
+			else if(strcmp(name, "null") == 0)
+			{ backend = VIDEO_BACKEND_NULL; }
+			else
+			{
+				fprintf(stderr, "unknown video backend '%s'\n", name);
+				return 1;
+			}
+		}
+		else if(strcmp(arg, "--help") == 0)
+		{
+			PrintUsage();
+			return 0;
+		}
+		else if(strcmp(arg, "--list") == 0)
+		{
+			for(int b = 0; b < BENCH_COUNT; b++)
+			{ printf("%s\n", benchmarks[b].name); }
+
+			return 0;
+		}
+		else
+		{
+			PrintUsage();
+			return 1;
+		}
+	}
+
+	// headless unless told otherwise; only the windowed backend uses a video driver at all
+	SDL_setenv("SDL_VIDEODRIVER", "dummy", 0);
+	SDL_setenv("SDL_AUDIODRIVER", "dummy", 0);
+
+	// stdout is kept for the results
+	core_config config =
+	{
+		.log = { .minLevelConsole = LOG_FAILURE, .minLevelFile = LOG_WARNING },
+		.events = { .evLogMode = EVLOG_LOG_INPUT },
+		.audio =
+		{
+			.format = AUDIO_FORMAT_S16,
+			.sampleRate = BENCH_SOUND_RATE,
+			.channels = 2,
+			.sounds = { .maxSounds = BENCH_MAX_SOUNDS },
+			.mixer =
+			{
+				.channelCount = BENCH_MIXER_CHANNELS,
+				.attenuationThreshold = 32,
+				.stereoFalloffExponent = 0.15f,
+				.realVoiceCount = BENCH_MIXER_REAL_VOICES
+			}
+		},
+		.video = { .backend = backend }
+	};
+
+	if(!Core_Init(config))
+	{
+		fprintf(stderr, "couldn't initialize hcore; see log.txt\n");
+		Core_Quit();
+		return 1;
+	}
+
+	FILE *out = outPath ? fopen(outPath, "w") : stdout;
+	if(!out)
+	{
+		fprintf(stderr, "couldn't open '%s' for writing\n", outPath);
+		Core_Quit();
+		return 1;
+	}
+
+	SDL_version sdl;
+	SDL_GetVersion(&sdl);
+
+	fprintf(out, "{\n\t\"version\": %i,\n\t\"commit\": ", BENCH_RESULTS_VERSION);
+	WriteString(out, commit);
+	char *backendNames[] = { "windowed", "software", "null" };
+
+	fprintf(out, ",\n\t\"sdl\": \"%i.%i.%i\",\n\t\"video\": \"%s\",\n\t\"samples\": %i,\n\t\"benchmarks\": [",
+		sdl.major, sdl.minor, sdl.patch, backendNames[backend], sampleCount);
+
+	bool success = true;
+	bool first = true;
+	for(int i = 0; i < BENCH_COUNT; i++)
+	{
+		if(filter && !strstr(benchmarks[i].name, filter))
+		{ continue; }
+
+		success = RunBenchmark(&benchmarks[i], sampleCount, out, first) && success;
+		first = false;
+	}
+
+	fprintf(out, "\n\t]\n}\n");
+
+	if(outPath)
+	{ fclose(out); }
+
+	if(goldenPath && !imagePath)
+	{ imagePath = BENCH_FRAME_PATH; }
+
+	if(imagePath && !SaveFrame(imagePath))
+	{
+		fprintf(stderr, "couldn't save frame to '%s'; see log.txt\n", imagePath);
+		success = false;
+	}
+	else if(goldenPath && !CompareFrame(imagePath, goldenPath))
+	{ success = false; }
+
+	Core_Quit();
+	remove(BENCH_SOUND_PATH);
+
+	if(loadSetWritten)
+	{
+		for(int i = 0; i < BENCH_LOAD_SOUNDS; i++)
+		{ remove(loadPaths[i]); }
+	}
+
+	return success ? 0 : 1;
+}
\ No newline at end of file
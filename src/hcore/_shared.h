@@ -39,8 +39,10 @@ typedef uint64_t uint64;
 // compiler specifics
 #ifdef _MSC_VER
 #define HINLINE intern __inline
+#define HTHREADLOCAL __declspec(thread)	// msvc's c compiler doesn't know _Thread_local
 #elif __GNUC__
 #define HINLINE intern inline
+#define HTHREADLOCAL _Thread_local
 #endif
 
 // platform specifics
@@ -65,7 +67,46 @@ typedef uint64_t uint64;
 #define FlagClear(mask, flag) ((mask) &= ~(flag))
 #define FlagTest(mask, flag) (((mask) & (flag)) == (flag))
 
+// snapshot helpers
+// snapshots are read in place by the engine: a header, then sections that each start with a
+// generation, which only changes when the section's contents do
+#define SNAPSHOT_SECTIONS_MAX 8
+
+typedef struct
+{
+	uint32 version;
+	uint32 size;
+	uint32 sectionCount;
+	uint32 sectionOffsets[SNAPSHOT_SECTIONS_MAX];	// from the start of the header
+} snapshot_header;
+
+// a section's source counts its changes, bumping the count in every mutator, so a section is only
+// gathered again once the count has moved past the one it was last gathered at
+HINLINE bool Snapshot_CheckSection(uint64 changes, uint64 *gatheredAt)
+{
+	if(changes == *gatheredAt)
+	{ return false; }
+
+	*gatheredAt = changes;
+	return true;
+}
+
+// fresh must be zeroed before it's filled in, so padding compares equal
+HINLINE bool Snapshot_UpdateSection(void *section, void *fresh, size_t size)
+{
+	uint64 *generation = (uint64*)(section);
+	*(uint64*)(fresh) = *generation;
+
+	if(memcmp(section, fresh, size) == 0)
+	{ return false; }
+
+	memcpy(section, fresh, size);
+	(*generation)++;
+	return true;
+}
+
 // shared hcore includes
 #include "hassert.h"
+#include "hmemory.h"
 #include "log.h"
 #include "vector.h"
\ No newline at end of file
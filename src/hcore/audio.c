@@ -1,17 +1,26 @@
 #include "audio.h"
+#include "time.h"
 
 extern bool Audio_Sounds_Init(struct audio_sounds_config config);
 extern void Audio_Sounds_Quit();
-extern struct audio_sounds_state Audio_Sounds_GetSnapshot();
+extern uint64 Audio_Sounds_GetChanges();
+extern void Audio_Sounds_GetSnapshot(struct audio_sounds_state *state);
 
 extern bool Audio_Mixer_Init(struct audio_mixer_config config);
 extern void Audio_Mixer_Quit();
 extern void Audio_Mixer_Mix_GetMixedSamples(void *data, uint32 dataLen);
-extern struct audio_mixer_state Audio_Mixer_GetSnapshot();
+extern void Audio_Mixer_UpdateSnapshot(struct audio_mixer_state *state, uint32 sectionMask, uint64 *gatheredAt);
 
 intern SDL_AudioDeviceID device;
 intern SDL_AudioSpec deviceSpec;
 
+// scratch for a single push: each channel's samples, then the final mix; reset once the mix is queued
+intern memory_arena frameArena;
+
+intern audio_state snapshot;
+intern uint64 gatheredAt[AUDIO_SNAPSHOT_COUNT];	// each section's source's change count, as of its last gather
+intern uint64 deviceChanges;
+
 intern SDL_AudioFormat GetSDLFormat(audio_format format)
 {
 	switch(format)
@@ -78,6 +87,9 @@ intern uint32 GetSampleSize(SDL_AudioFormat format)
 
 bool Audio_Init(audio_config config)
 {
+	// no change count gets this high, so every section is gathered on its first request
+	memset(gatheredAt, 0xFF, sizeof(gatheredAt));
+	
 	if(SDL_InitSubSystem(SDL_INIT_AUDIO) >= 0)
 	{
 		LogNote("SDL audio successfully initialized");
@@ -94,8 +106,10 @@ bool Audio_Init(audio_config config)
 		if(device > 0)
 		{
 			LogNote("audio device %i successfully opened", device);
+			deviceChanges++;
 			
-			if(Audio_Sounds_Init(config.sounds) && Audio_Mixer_Init(config.mixer))
+			// room for one channel's samples and the mix, plus alignment
+			if(Memory_Arena_Init(&frameArena, MEMORY_TAG_AUDIO, (size_t)(deviceSpec.size) * 2 + 64) && Audio_Sounds_Init(config.sounds) && Audio_Mixer_Init(config.mixer))
 			{
 				LogNote("audio successfully initialized");
 				
@@ -116,9 +130,11 @@ void Audio_Quit()
 {
 	Audio_Mixer_Quit();
 	Audio_Sounds_Quit();
+	Memory_Arena_Release(&frameArena);
 	
 	SDL_PauseAudioDevice(device, 1);
 	SDL_CloseAudioDevice(device);
+	deviceChanges++;
 	SDL_QuitSubSystem(SDL_INIT_AUDIO);
 }
 
@@ -132,6 +148,11 @@ uint32 Audio_GetSampleSize()
 	return GetSampleSize(deviceSpec.format);
 }
 
+memory_arena *Audio_GetFrameArena()
+{
+	return &frameArena;
+}
+
 uint32 Audio_GetBytesNeeded()
 {
 	uint32 queuedBytes = SDL_GetQueuedAudioSize(device);
@@ -140,28 +161,69 @@ uint32 Audio_GetBytesNeeded()
 
 HEXPORT(void) Audio_PushSound()
 {
+	ProfileBegin("Audio_PushSound");
+	uint64 statStart = SDL_GetPerformanceCounter();
+	
 	uint32 bytesNeeded = Audio_GetBytesNeeded();
 	
-	uint8 *data = calloc(bytesNeeded, sizeof(uint8));
+	uint8 *data = Memory_Arena_Push(&frameArena, bytesNeeded);
+	if(data)
+	{
+		memset(data, 0, bytesNeeded);
 
-	Audio_Mixer_Mix_GetMixedSamples(data, bytesNeeded);
-	SDL_QueueAudio(device, data, bytesNeeded);
+		Audio_Mixer_Mix_GetMixedSamples(data, bytesNeeded);
+		SDL_QueueAudio(device, data, bytesNeeded);
+	}
 
-	free(data);
+	Memory_Arena_Reset(&frameArena);
+	
+	Time_AddFrameTime(FRAME_STAT_AUDIO, statStart);
+	ProfileEnd();
 }
 
 HEXPORT(void) Audio_GetSnapshot(audio_state *state)
 {
-	*state = (audio_state)
+	AssertPtr(state);
+	*state = *Audio_GetSnapshotView(UINT32_MAX);
+}
+
+HEXPORT(audio_state*) Audio_GetSnapshotView(uint32 sectionMask)
+{
+	snapshot.header.version = AUDIO_SNAPSHOT_VERSION;
+	snapshot.header.size = sizeof(audio_state);
+	snapshot.header.sectionCount = AUDIO_SNAPSHOT_COUNT;
+	snapshot.header.sectionOffsets[AUDIO_SNAPSHOT_DEVICE] = offsetof(audio_state, device);
+	snapshot.header.sectionOffsets[AUDIO_SNAPSHOT_SOUNDS] = offsetof(audio_state, sounds);
+	snapshot.header.sectionOffsets[AUDIO_SNAPSHOT_CHANNELS] = offsetof(audio_state, mixer.channels);
+	snapshot.header.sectionOffsets[AUDIO_SNAPSHOT_MIX] = offsetof(audio_state, mixer.mix);
+	snapshot.header.sectionOffsets[AUDIO_SNAPSHOT_BUSES] = offsetof(audio_state, mixer.buses);
+	
+	// sections are only gathered once their source has changed, and only copied over (with a new generation)
+	// if what was gathered differs; a frame that didn't touch a source skips its section entirely
+	if(FlagTest(sectionMask, 1 << AUDIO_SNAPSHOT_DEVICE) && Snapshot_CheckSection(deviceChanges, &gatheredAt[AUDIO_SNAPSHOT_DEVICE]))
 	{
-		.deviceID = (int)(device),
+		struct audio_device_state fresh;
+		memset(&fresh, 0, sizeof(fresh));
 		
-		.format = GetHFormat(deviceSpec.format),
-		.channels = deviceSpec.channels,
-		.sampleRate = deviceSpec.freq,
-		.sampleSize = Audio_GetSampleSize(),
+		fresh.deviceID = (int)(device);
+		fresh.format = GetHFormat(deviceSpec.format);
+		fresh.channels = deviceSpec.channels;
+		fresh.sampleRate = deviceSpec.freq;
+		fresh.sampleSize = Audio_GetSampleSize();
 		
-		.sounds = Audio_Sounds_GetSnapshot(),
-		.mixer = Audio_Mixer_GetSnapshot()
-	};
+		Snapshot_UpdateSection(&snapshot.device, &fresh, sizeof(fresh));
+	}
+	
+	if(FlagTest(sectionMask, 1 << AUDIO_SNAPSHOT_SOUNDS) &&
+		Snapshot_CheckSection(Audio_Sounds_GetChanges(), &gatheredAt[AUDIO_SNAPSHOT_SOUNDS]))
+	{
+		struct audio_sounds_state fresh;
+		memset(&fresh, 0, sizeof(fresh));
+		Audio_Sounds_GetSnapshot(&fresh);
+		Snapshot_UpdateSection(&snapshot.sounds, &fresh, sizeof(fresh));
+	}
+	
+	Audio_Mixer_UpdateSnapshot(&snapshot.mixer, sectionMask, gatheredAt);
+	
+	return &snapshot;
 }
\ No newline at end of file
@@ -26,6 +26,8 @@ typedef struct
 	struct audio_sounds_config
 	{
 		int maxSounds;
+		bool compressSounds;	// keep sounds resident as IMA-ADPCM (S16 devices only)
+		bool convertOnLoad;		// convert sounds to the device's format as they load, rather than as they play
 	} sounds;
 	
 	struct audio_mixer_config
@@ -33,6 +35,7 @@ typedef struct
 		int channelCount;
 		float attenuationThreshold;
 		float stereoFalloffExponent;
+		int realVoiceCount;	// channels actually mixed each push; the rest are virtualized (0 mixes every channel)
 	} mixer;
 } audio_config;
 
@@ -45,17 +48,37 @@ HEXPORT(void) Audio_PushSound();
 // sounds
 // - - - - - -
 
+typedef enum
+{
+	SOUND_ENCODING_PCM,		// samples in the device's format
+	SOUND_ENCODING_ADPCM	// 4-bit IMA-ADPCM blocks, decoded by the mixer as it reads them
+} sound_encoding;
+
 typedef struct
 {
 	void *data;
-	uint32 dataLen;
+	uint32 dataLen;		// length of the samples once decoded, in their own format
+	SDL_AudioSpec spec;	// the samples' own format; the mixer converts them as they play when it isn't the device's
+	
+	sound_encoding encoding;
+	uint32 encodedLen;	// length of data as it's stored
+	
+	int packID;			// the pack data is mapped from, or -1 if it's owned by the sound
 } sound;
 
+// each ADPCM block holds this many frames; per channel, a 4-byte header (predictor and step index)
+// is followed by the 4-bit samples, so a block of 16-bit samples is just over a quarter of their size
+#define AUDIO_SOUNDS_ADPCM_BLOCK_FRAMES 256
+#define AUDIO_SOUNDS_ADPCM_BLOCK_SIZE(channels) ((channels) * (4 + (AUDIO_SOUNDS_ADPCM_BLOCK_FRAMES / 2)))
+
 #define AssertSound(id) Assert(Audio_Sounds_CheckSound(id), "sound with ID %i is invalid", id)
 
 HEXPORT(int) Audio_Sounds_LoadSound(char *filePath);
+HEXPORT(int) Audio_Sounds_RequestSound(char *filePath);	// loads in the background; the sound stays silent until it's ready
 HEXPORT(void) Audio_Sounds_FreeSound(int soundID);
 HEXPORT(bool) Audio_Sounds_CheckSound(int soundID);
+HEXPORT(uint64) Audio_Sounds_GetSoundSize(int soundID);
+HEXPORT(void) Audio_Sounds_SetBudget(uint64 bytes);		// only reported; streaming code enforces it
 
 // - - - - - -
 // mixer
@@ -68,67 +91,196 @@ typedef struct
 	// more go here when 5/7.1 is a thing
 } mixer_channel_panning;
 
-#define AUDIO_MIXER_CHANNELS_MAX 64
+#define AUDIO_MIXER_CHANNELS_MAX 256
+#define AUDIO_MIXER_CHANNELS_PRIORITY_DEFAULT 128
+#define AUDIO_MIXER_CHANNELS_RATE_MAX 8.0f
+#define AUDIO_MIXER_CHANNELS_FRAC_BITS 16	// fixed-point precision of a channel's position between frames
 typedef struct mixer_channel
 {
 	int soundID;
 	uint32 dataPos;
+	uint32 dataFrac;
 	
 	uint8 volume;
 	mixer_channel_panning panning;
+	uint8 priority;
+	uint8 bus;
+	float rate;
+	
+	// virtual channels keep advancing through their sound, but aren't mixed
+	bool isVirtual;
+	bool isFresh;	// given a sound since the last advance, so it isn't stolen before it's been heard
+
+	uint32 voice;	// bumped whenever the channel's given a sound, so whoever played the last one can tell it was stolen
 } mixer_channel;
 
+// when every channel is busy, the least important one is stolen: virtual channels first, then by priority and volume
 HEXPORT(int) Audio_Mixer_Channels_GetNextFreeChannel();
 HEXPORT(int) Audio_Mixer_Channels_SetSound(int channel, int soundID);
+HEXPORT(uint32) Audio_Mixer_Channels_GetVoice(int channel);
 HEXPORT(void) Audio_Mixer_Channels_SetVolume(int channel, uint8 volume);
 HEXPORT(void) Audio_Mixer_Channels_SetPanning(int channel, mixer_channel_panning panning);
+HEXPORT(void) Audio_Mixer_Channels_SetRate(int channel, float rate);
+HEXPORT(void) Audio_Mixer_Channels_SetPriority(int channel, uint8 priority);
+HEXPORT(void) Audio_Mixer_Channels_SetBus(int channel, uint8 bus);
 HEXPORT(void) Audio_Mixer_Channels_CalcAttenuation(int channel, vector2 offsetFromListener, float maxDist);
+HEXPORT(void) Audio_Mixer_Channels_CalcAttenuationBatch(int *channelIDs, vector2 *offsetsFromListener, int count, float maxDist);
+
+#define AUDIO_MIXER_ATTENUATION_CURVE_MAX 64
+HEXPORT(void) Audio_Mixer_Channels_SetAttenuationCurve(float *gains, int count);
 
 HEXPORT(void) Audio_Mixer_Channels_Advance(int channel, bool loop);
+HEXPORT(void) Audio_Mixer_Channels_AdvanceBatch(int *channelIDs, int count, bool loop);
+
+// - - - - - -
+// mixer buses
+// - - - - - -
+
+// channels are mixed into one of the source buses, each of which is processed once per block and summed
+// into the master bus, along with the shared reverb's return. the master bus then goes through a look-ahead limiter.
+typedef enum
+{
+	MIXER_BUS_MUSIC,
+	MIXER_BUS_SFX,
+	MIXER_BUS_UI,
+	MIXER_BUS_MASTER,
+	MIXER_BUS_COUNT
+} mixer_bus;
+
+HEXPORT(void) Audio_Mixer_Buses_SetGain(int bus, float gain);
+HEXPORT(void) Audio_Mixer_Buses_SetLowPass(int bus, float cutoffHz);	// 0 disables
+HEXPORT(void) Audio_Mixer_Buses_SetReverbSend(int bus, float send);
+HEXPORT(void) Audio_Mixer_Buses_SetCompressor(int bus, float thresholdDB, float ratio);	// ratio <= 1 disables
+HEXPORT(void) Audio_Mixer_Buses_SetReverb(float feedback, float damping);
+
+// - - - - - -
+// resampler
+// - - - - - -
+
+typedef enum
+{
+	RESAMPLER_QUALITY_LINEAR,	// fast 2-tap linear interpolation
+	RESAMPLER_QUALITY_SINC		// polyphase windowed-sinc
+} resampler_quality;
+
+// converts between sample formats, channel counts and sample rates incrementally, in fixed-size blocks
+typedef struct audio_resampler audio_resampler;
+
+audio_resampler *Audio_Resampler_Create(SDL_AudioSpec srcSpec, SDL_AudioSpec dstSpec, resampler_quality quality);
+void Audio_Resampler_Free(audio_resampler *r);
+void Audio_Resampler_Reset(audio_resampler *r);	// starts a new stream, at the same rate
+void Audio_Resampler_SetRate(audio_resampler *r, float rate);	// playback rate, on top of the conversion; a sinc filter keeps its cutoff
+uint64 Audio_Resampler_GetPosition(audio_resampler *r);	// input frames played so far; it buffers ahead of this
+uint32 Audio_Resampler_GetFrameSize(SDL_AudioSpec spec);	// 0 if the sample format isn't supported
+uint32 Audio_Resampler_GetMaxOutputLength(audio_resampler *r, uint32 inputLen);
+uint32 Audio_Resampler_Process(audio_resampler *r, void *input, uint32 inputLen, uint32 *inputUsed, void *output, uint32 outputLen);
+uint32 Audio_Resampler_Flush(audio_resampler *r, void *output, uint32 outputLen);
 
 // - - - - - -
 // state snapshot
 // - - - - - -
 
+#define AUDIO_SNAPSHOT_VERSION 3
+
+typedef enum
+{
+	AUDIO_SNAPSHOT_DEVICE,
+	AUDIO_SNAPSHOT_SOUNDS,
+	AUDIO_SNAPSHOT_CHANNELS,
+	AUDIO_SNAPSHOT_MIX,
+	AUDIO_SNAPSHOT_BUSES,
+	AUDIO_SNAPSHOT_COUNT
+} audio_snapshot_section;
+
 typedef struct
 {
-	int deviceID;
-	
-	audio_format format;
-	int channels;
-	int sampleRate;
-	int sampleSize;
+	snapshot_header header;
 	
-	int samplesNeeded;
+	struct audio_device_state
+	{
+		uint64 generation;
+		
+		int deviceID;
+		
+		audio_format format;
+		int channels;
+		int sampleRate;
+		int sampleSize;
+		
+		int samplesNeeded;
+	} device;
 	
 	struct audio_sounds_state
 	{
+		uint64 generation;
+		
 		int maxSounds;
 		int soundCount;
+		int pendingCount;		// requested, but not loaded yet
+		
+		uint64 residentBytes;	// as stored
+		uint64 decodedBytes;	// as they'd be stored fully decoded
+		uint64 budgetBytes;		// 0 if there's no budget
 	} sounds;
 	
 	struct audio_mixer_state
 	{
 		struct audio_mixer_channels_state
 		{
+			uint64 generation;
+			
 			int channelCount;
+			int realVoiceCount;
 			struct audio_mixer_channels_channel
 			{
 				int soundID;
+				uint32 voice;
 				uint32 dataPos;
 				uint32 dataLen;
 				
 				uint8 volume;
 				mixer_channel_panning panning;
+				uint8 priority;
+				uint8 bus;
+				float rate;
+				uint8 isVirtual;
+				uint8 isLoading;	// its sound was requested, and is still loading
 			} channels[AUDIO_MIXER_CHANNELS_MAX];
 		} channels;
 		
 		struct audio_mixer_mix_state
 		{
+			uint64 generation;
+			
 			int accumulatorSize;
 			float stereoFalloffExp;
 		} mix;
+		
+		struct audio_mixer_buses_state
+		{
+			uint64 generation;
+			
+			int busCount;
+			float reverbFeedback;
+			float reverbDamping;
+			float limiterGain;
+			
+			struct audio_mixer_buses_bus
+			{
+				float gain;
+				float lowPassCutoff;
+				float reverbSend;
+				float compressorThreshold;
+				float compressorRatio;
+				float peak;	// of the last processed block, after gain
+			} buses[MIXER_BUS_COUNT];
+		} buses;
 	} mixer;
 } audio_state;
 
-HEXPORT(void) Audio_GetSnapshot(audio_state *state);
\ No newline at end of file
+HEXPORT(void) Audio_GetSnapshot(audio_state *state);
+
+// refreshes the sections in sectionMask (bits of audio_snapshot_section) and returns the
+// persistent snapshot; it stays valid until audio quits, and the other sections are left as
+// they were last refreshed
+HEXPORT(audio_state*) Audio_GetSnapshotView(uint32 sectionMask);
\ No newline at end of file
@@ -1,16 +1,23 @@
 #include "audio.h"
 
-extern bool Audio_Mixer_Channels_Init(int channelCt, float threshold);
+extern bool Audio_Mixer_Channels_Init(int channelCt, float threshold, int realVoiceCt);
 extern void Audio_Mixer_Channels_Quit();
 extern bool Audio_Mixer_Mix_Init(float stereoFalloff);
 extern void Audio_Mixer_Mix_Quit();
-extern struct audio_mixer_channels_state Audio_Mixer_Channels_GetSnapshot();
-extern struct audio_mixer_mix_state Audio_Mixer_Mix_GetSnapshot();
+extern bool Audio_Mixer_Buses_Init();
+extern void Audio_Mixer_Buses_Quit();
+extern uint64 Audio_Mixer_Channels_GetChanges();
+extern void Audio_Mixer_Channels_GetSnapshot(struct audio_mixer_channels_state *state);
+extern uint64 Audio_Mixer_Mix_GetChanges();
+extern void Audio_Mixer_Mix_GetSnapshot(struct audio_mixer_mix_state *state);
+extern uint64 Audio_Mixer_Buses_GetChanges();
+extern void Audio_Mixer_Buses_GetSnapshot(struct audio_mixer_buses_state *state);
 
 bool Audio_Mixer_Init(struct audio_mixer_config config)
 {
-	if(Audio_Mixer_Channels_Init(config.channelCount, config.attenuationThreshold) &&
-		Audio_Mixer_Mix_Init(config.stereoFalloffExponent))
+	if(Audio_Mixer_Channels_Init(config.channelCount, config.attenuationThreshold, config.realVoiceCount) &&
+		Audio_Mixer_Mix_Init(config.stereoFalloffExponent) &&
+		Audio_Mixer_Buses_Init())
 	{
 		LogNote("audio mixer successfully initialized");
 		return true;
@@ -22,17 +29,38 @@ bool Audio_Mixer_Init(struct audio_mixer_config config)
 
 void Audio_Mixer_Quit()
 {
+	Audio_Mixer_Buses_Quit();
 	Audio_Mixer_Mix_Quit();
 	Audio_Mixer_Channels_Quit();
 }
 
-struct audio_mixer_state Audio_Mixer_GetSnapshot()
+// gatheredAt is indexed by audio_snapshot_section, like the rest of the snapshot's bookkeeping
+void Audio_Mixer_UpdateSnapshot(struct audio_mixer_state *state, uint32 sectionMask, uint64 *gatheredAt)
 {
-	struct audio_mixer_state state = 
+	if(FlagTest(sectionMask, 1 << AUDIO_SNAPSHOT_CHANNELS) &&
+		Snapshot_CheckSection(Audio_Mixer_Channels_GetChanges(), &gatheredAt[AUDIO_SNAPSHOT_CHANNELS]))
 	{
-		.channels = Audio_Mixer_Channels_GetSnapshot(),
-		.mix = Audio_Mixer_Mix_GetSnapshot()
-	};
+		struct audio_mixer_channels_state fresh;
+		memset(&fresh, 0, sizeof(fresh));
+		Audio_Mixer_Channels_GetSnapshot(&fresh);
+		Snapshot_UpdateSection(&state->channels, &fresh, sizeof(fresh));
+	}
+	
+	if(FlagTest(sectionMask, 1 << AUDIO_SNAPSHOT_MIX) &&
+		Snapshot_CheckSection(Audio_Mixer_Mix_GetChanges(), &gatheredAt[AUDIO_SNAPSHOT_MIX]))
+	{
+		struct audio_mixer_mix_state fresh;
+		memset(&fresh, 0, sizeof(fresh));
+		Audio_Mixer_Mix_GetSnapshot(&fresh);
+		Snapshot_UpdateSection(&state->mix, &fresh, sizeof(fresh));
+	}
 	
-	return state;
+	if(FlagTest(sectionMask, 1 << AUDIO_SNAPSHOT_BUSES) &&
+		Snapshot_CheckSection(Audio_Mixer_Buses_GetChanges(), &gatheredAt[AUDIO_SNAPSHOT_BUSES]))
+	{
+		struct audio_mixer_buses_state fresh;
+		memset(&fresh, 0, sizeof(fresh));
+		Audio_Mixer_Buses_GetSnapshot(&fresh);
+		Snapshot_UpdateSection(&state->buses, &fresh, sizeof(fresh));
+	}
 }
\ No newline at end of file
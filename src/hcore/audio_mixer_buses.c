@@ -0,0 +1,501 @@
+#include "audio.h"
+
+extern SDL_AudioSpec Audio_GetSpec();
+
+#define BUS_CHANNELS_MAX 8
+
+#define COMPRESSOR_ATTACK_SECONDS 0.005f
+#define COMPRESSOR_RELEASE_SECONDS 0.1f
+
+#define LIMITER_LOOKAHEAD_SECONDS 0.005f
+#define LIMITER_RELEASE_SECONDS 0.05f
+#define LIMITER_CEILING 0.98f
+
+#define REVERB_COMBS 4
+#define REVERB_ALLPASSES 2
+#define REVERB_INPUT_GAIN 0.03f
+
+typedef struct
+{
+	float *samples;
+	bool active;	// whether anything was mixed in this block
+
+	float gain;
+	float reverbSend;
+
+	float lowPassCutoff;
+	float lowPassCoef;
+	float lowPassState[BUS_CHANNELS_MAX];
+
+	float compThreshold;	// dB
+	float compRatio;
+	float compEnvelope;
+
+	float peak;
+} bus_state;
+
+typedef struct
+{
+	float *buffer;
+	int length;
+	int pos;
+	float filterStore;
+} reverb_line;
+
+intern int channels;
+intern int sampleRate;
+intern uint32 maxFrames;
+
+intern bus_state buses[MIXER_BUS_COUNT];
+intern uint64 snapshotChanges;	// bumped by every setter, and every render, since peaks and the limiter move with each block
+
+intern float *reverbInput;
+intern reverb_line combs[REVERB_COMBS];
+intern reverb_line allpasses[REVERB_ALLPASSES];
+intern float reverbFeedback;
+intern float reverbDamping;
+
+// the master output is delayed by the look-ahead, so gain reduction can reach its target before a peak arrives.
+// the gain each frame needs is min-filtered over the look-ahead window, then box-filtered over the same length,
+// which guarantees the peak is never exceeded while keeping the gain changes smooth
+intern uint32 lookahead;
+intern uint64 limiterFrame;
+intern float *limiterDelay;
+intern float *minValues;
+intern uint64 *minFrames;
+intern uint32 minHead;
+intern uint32 minCount;
+intern float *boxValues;
+intern double boxSum;
+intern float limiterGain;
+intern float limiterRelease;
+
+// Freeverb's tunings at 44.1kHz
+intern const int combLengths[REVERB_COMBS] = { 1116, 1188, 1277, 1356 };
+intern const int allpassLengths[REVERB_ALLPASSES] = { 556, 441 };
+
+intern bool CheckBus(int bus, char *action)
+{
+	if(bus > -1 && bus < MIXER_BUS_COUNT)
+	{ return true; }
+
+	LogError("can't %s: bus index %i is invalid (max: %i)", action, bus, MIXER_BUS_COUNT);
+	return false;
+}
+
+intern bool InitReverbLine(reverb_line *line, int length44k)
+{
+	line->length = max(1, (int)(((int64)(length44k) * sampleRate) / 44100));
+	line->pos = 0;
+	line->filterStore = 0;
+	line->buffer = Memory_Calloc(MEMORY_TAG_AUDIO, line->length, sizeof(float));
+
+	return (line->buffer != NULL);
+}
+
+intern void ProcessBus(bus_state *b, uint32 frameCount)
+{
+	float *s = b->samples;
+	float peak = 0;
+
+	float attack = expf(-1.0f / (COMPRESSOR_ATTACK_SECONDS * sampleRate));
+	float release = expf(-1.0f / (COMPRESSOR_RELEASE_SECONDS * sampleRate));
+	bool lowPass = (b->lowPassCoef > 0);
+	bool compress = (b->compRatio > 1);
+
+	for(uint32 f = 0; f < frameCount; f++)
+	{
+		float *frame = &s[f * channels];
+		float framePeak = 0;
+
+		for(int c = 0; c < channels; c++)
+		{
+			float x = frame[c] * b->gain;
+
+			if(lowPass)
+			{
+				b->lowPassState[c] += (x - b->lowPassState[c]) * b->lowPassCoef;
+				x = b->lowPassState[c];
+			}
+
+			frame[c] = x;
+			framePeak = max(framePeak, fabsf(x));
+		}
+
+		if(compress)
+		{
+			// the envelope is linked across channels, so the stereo image doesn't shift
+			float coef = (framePeak > b->compEnvelope) ? attack : release;
+			b->compEnvelope = (coef * b->compEnvelope) + ((1 - coef) * framePeak);
+
+			if(b->compEnvelope > 0)
+			{
+				float envDB = 20 * log10f(b->compEnvelope);
+				if(envDB > b->compThreshold)
+				{
+					float gainDB = (b->compThreshold - envDB) * (1 - (1 / b->compRatio));
+					float gain = powf(10, gainDB / 20);
+
+					for(int c = 0; c < channels; c++)
+					{ frame[c] *= gain; }
+
+					framePeak *= gain;
+				}
+			}
+		}
+
+		peak = max(peak, framePeak);
+	}
+
+	b->peak = peak;
+}
+
+intern void ProcessReverb(float *input, float *output, uint32 frameCount)
+{
+	for(uint32 f = 0; f < frameCount; f++)
+	{
+		float in = input[f] * REVERB_INPUT_GAIN;
+		float out = 0;
+
+		// parallel damped feedback combs...
+		for(int i = 0; i < REVERB_COMBS; i++)
+		{
+			reverb_line *comb = &combs[i];
+			float delayed = comb->buffer[comb->pos];
+
+			comb->filterStore = (delayed * (1 - reverbDamping)) + (comb->filterStore * reverbDamping);
+			comb->buffer[comb->pos] = in + (comb->filterStore * reverbFeedback);
+			comb->pos = (comb->pos + 1) % comb->length;
+
+			out += delayed;
+		}
+
+		// ...then series allpasses to diffuse them
+		for(int i = 0; i < REVERB_ALLPASSES; i++)
+		{
+			reverb_line *ap = &allpasses[i];
+			float delayed = ap->buffer[ap->pos];
+
+			ap->buffer[ap->pos] = out + (delayed * 0.5f);
+			ap->pos = (ap->pos + 1) % ap->length;
+
+			out = delayed - out;
+		}
+
+		float *frame = &output[f * channels];
+		for(int c = 0; c < channels; c++)
+		{ frame[c] += out; }
+	}
+}
+
+intern void ProcessLimiter(float *input, float *output, uint32 frameCount)
+{
+	for(uint32 f = 0; f < frameCount; f++, limiterFrame++)
+	{
+		float *in = &input[f * channels];
+		float *out = &output[f * channels];
+		uint32 slot = (uint32)(limiterFrame % lookahead);
+
+		// gain needed to bring this frame under the ceiling
+		float framePeak = 0;
+		for(int c = 0; c < channels; c++)
+		{ framePeak = max(framePeak, fabsf(in[c])); }
+
+		float needed = (framePeak > LIMITER_CEILING) ? (LIMITER_CEILING / framePeak) : 1;
+
+		// sliding minimum over the last (lookahead + 1) frames, as a monotonic queue
+		uint32 capacity = lookahead + 1;
+		while(minCount > 0 && minValues[(minHead + minCount - 1) % capacity] >= needed)
+		{ minCount--; }
+
+		uint32 back = (minHead + minCount) % capacity;
+		minValues[back] = needed;
+		minFrames[back] = limiterFrame;
+		minCount++;
+
+		while(minFrames[minHead] + lookahead < limiterFrame)
+		{
+			minHead = (minHead + 1) % capacity;
+			minCount--;
+		}
+
+		// box filter over the last (lookahead) minimums
+		float windowMin = minValues[minHead];
+		boxSum += windowMin - boxValues[slot];
+		boxValues[slot] = windowMin;
+
+		float target = (float)(boxSum / lookahead);
+
+		// drop straight to the target, but recover slowly
+		if(target < limiterGain)
+		{ limiterGain = target; }
+		else
+		{ limiterGain += (target - limiterGain) * limiterRelease; }
+
+		// swap this frame into the delay line, and output the one from (lookahead) frames ago
+		float *delayed = &limiterDelay[slot * channels];
+		for(int c = 0; c < channels; c++)
+		{
+			float x = delayed[c];
+			delayed[c] = in[c];
+			out[c] = x * limiterGain;
+		}
+	}
+}
+
+bool Audio_Mixer_Buses_Init()
+{
+	SDL_AudioSpec spec = Audio_GetSpec();
+
+	if(spec.channels > BUS_CHANNELS_MAX)
+	{
+		LogFailure("audio mixer buses failed to initialize: %i channels exceeds the maximum (%i)", spec.channels, BUS_CHANNELS_MAX);
+		return false;
+	}
+
+	channels = spec.channels;
+	sampleRate = spec.freq;
+	maxFrames = spec.samples;
+
+	bool allocated = true;
+	for(int i = 0; i < MIXER_BUS_COUNT; i++)
+	{
+		buses[i] = (bus_state){ .gain = 1 };
+		buses[i].samples = Memory_Calloc(MEMORY_TAG_AUDIO, maxFrames * channels, sizeof(float));
+
+		allocated &= (buses[i].samples != NULL);
+	}
+
+	reverbFeedback = 0.84f;
+	reverbDamping = 0.2f;
+	reverbInput = Memory_Calloc(MEMORY_TAG_AUDIO, maxFrames, sizeof(float));
+	allocated &= (reverbInput != NULL);
+
+	for(int i = 0; i < REVERB_COMBS; i++)
+	{ allocated &= InitReverbLine(&combs[i], combLengths[i]); }
+
+	for(int i = 0; i < REVERB_ALLPASSES; i++)
+	{ allocated &= InitReverbLine(&allpasses[i], allpassLengths[i]); }
+
+	lookahead = max(1, (uint32)(LIMITER_LOOKAHEAD_SECONDS * sampleRate));
+	limiterFrame = 0;
+	limiterGain = 1;
+	snapshotChanges++;
+	limiterRelease = 1 - expf(-1.0f / (LIMITER_RELEASE_SECONDS * sampleRate));
+	minHead = 0;
+	minCount = 0;
+	boxSum = lookahead;
+
+	limiterDelay = Memory_Calloc(MEMORY_TAG_AUDIO, lookahead * channels, sizeof(float));
+	minValues = Memory_Calloc(MEMORY_TAG_AUDIO, lookahead + 1, sizeof(float));
+	minFrames = Memory_Calloc(MEMORY_TAG_AUDIO, lookahead + 1, sizeof(uint64));
+	boxValues = Memory_Alloc(MEMORY_TAG_AUDIO, lookahead * sizeof(float));
+	allocated &= (limiterDelay && minValues && minFrames && boxValues);
+
+	if(allocated)
+	{
+		for(uint32 i = 0; i < lookahead; i++)
+		{ boxValues[i] = 1; }
+
+		LogNote("audio mixer buses successfully initialized");
+		return true;
+	}
+
+	LogFailure("audio mixer buses failed to initialize: couldn't allocate buffers");
+	return false;
+}
+
+void Audio_Mixer_Buses_Quit()
+{
+	for(int i = 0; i < MIXER_BUS_COUNT; i++)
+	{
+		Memory_Free(buses[i].samples);
+		buses[i].samples = NULL;
+	}
+
+	for(int i = 0; i < REVERB_COMBS; i++)
+	{
+		Memory_Free(combs[i].buffer);
+		combs[i].buffer = NULL;
+	}
+
+	for(int i = 0; i < REVERB_ALLPASSES; i++)
+	{
+		Memory_Free(allpasses[i].buffer);
+		allpasses[i].buffer = NULL;
+	}
+
+	Memory_Free(reverbInput);
+	Memory_Free(limiterDelay);
+	Memory_Free(minValues);
+	Memory_Free(minFrames);
+	Memory_Free(boxValues);
+
+	reverbInput = NULL;
+	limiterDelay = NULL;
+	minValues = NULL;
+	minFrames = NULL;
+	boxValues = NULL;
+
+	channels = 0;
+	maxFrames = 0;
+}
+
+void Audio_Mixer_Buses_Accumulate(int bus, float *samples, uint32 sampleCount)
+{
+	AssertPtr(samples);
+
+	if(CheckBus(bus, "accumulate samples"))
+	{
+		bus_state *b = &buses[bus];
+		AssertPtr(b->samples);
+
+		sampleCount = min(sampleCount, maxFrames * channels);
+		for(uint32 i = 0; i < sampleCount; i++)
+		{ b->samples[i] += samples[i]; }
+
+		b->active = true;
+	}
+}
+
+void Audio_Mixer_Buses_Render(float *output, uint32 sampleCount)
+{
+	AssertPtr(output);
+
+	bus_state *master = &buses[MIXER_BUS_MASTER];
+	AssertPtr(master->samples);
+
+	uint32 frameCount = min(sampleCount / channels, maxFrames);
+	uint32 blockSamples = frameCount * channels;
+
+	memset(reverbInput, 0, frameCount * sizeof(float));
+
+	for(int i = 0; i < MIXER_BUS_MASTER; i++)
+	{
+		bus_state *b = &buses[i];
+		if(!b->active)
+		{
+			b->peak = 0;
+			memset(b->lowPassState, 0, sizeof(b->lowPassState));
+			continue;
+		}
+
+		ProcessBus(b, frameCount);
+
+		for(uint32 s = 0; s < blockSamples; s++)
+		{ master->samples[s] += b->samples[s]; }
+
+		if(b->reverbSend > 0)
+		{
+			for(uint32 f = 0; f < frameCount; f++)
+			{
+				float mono = 0;
+				for(int c = 0; c < channels; c++)
+				{ mono += b->samples[(f * channels) + c]; }
+
+				reverbInput[f] += (mono / channels) * b->reverbSend;
+			}
+		}
+
+		memset(b->samples, 0, blockSamples * sizeof(float));
+		b->active = false;
+	}
+
+	// the reverb keeps running while silent, so its tail rings out
+	ProcessReverb(reverbInput, master->samples, frameCount);
+	ProcessBus(master, frameCount);
+	ProcessLimiter(master->samples, output, frameCount);
+
+	memset(master->samples, 0, blockSamples * sizeof(float));
+	snapshotChanges++;
+}
+
+HEXPORT(void) Audio_Mixer_Buses_SetGain(int bus, float gain)
+{
+	if(CheckBus(bus, "set bus gain"))
+	{
+		buses[bus].gain = max(gain, 0);
+		snapshotChanges++;
+	}
+}
+
+HEXPORT(void) Audio_Mixer_Buses_SetLowPass(int bus, float cutoffHz)
+{
+	if(CheckBus(bus, "set bus low-pass"))
+	{
+		bus_state *b = &buses[bus];
+
+		// a one-pole filter; at or above nyquist, it would do nothing anyway
+		if(cutoffHz > 0 && cutoffHz < (sampleRate / 2))
+		{
+			b->lowPassCutoff = cutoffHz;
+			b->lowPassCoef = 1 - expf((float)(-2 * M_PI) * cutoffHz / sampleRate);
+		}
+		else
+		{
+			b->lowPassCutoff = 0;
+			b->lowPassCoef = 0;
+		}
+
+		snapshotChanges++;
+	}
+}
+
+HEXPORT(void) Audio_Mixer_Buses_SetReverbSend(int bus, float send)
+{
+	if(CheckBus(bus, "set bus reverb send"))
+	{
+		if(bus == MIXER_BUS_MASTER)
+		{ LogWarning("the master bus can't send to the reverb; ignoring"); }
+		else
+		{
+			buses[bus].reverbSend = Clamp(send, 0, 1);
+			snapshotChanges++;
+		}
+	}
+}
+
+HEXPORT(void) Audio_Mixer_Buses_SetCompressor(int bus, float thresholdDB, float ratio)
+{
+	if(CheckBus(bus, "set bus compressor"))
+	{
+		buses[bus].compThreshold = min(thresholdDB, 0);
+		buses[bus].compRatio = max(ratio, 1);
+		snapshotChanges++;
+	}
+}
+
+HEXPORT(void) Audio_Mixer_Buses_SetReverb(float feedback, float damping)
+{
+	// feedback at or above 1 would never decay
+	reverbFeedback = Clamp(feedback, 0, 0.98f);
+	reverbDamping = Clamp(damping, 0, 1);
+	snapshotChanges++;
+}
+
+uint64 Audio_Mixer_Buses_GetChanges()
+{
+	return snapshotChanges;
+}
+
+void Audio_Mixer_Buses_GetSnapshot(struct audio_mixer_buses_state *state)
+{
+	state->busCount = MIXER_BUS_COUNT;
+	state->reverbFeedback = reverbFeedback;
+	state->reverbDamping = reverbDamping;
+	state->limiterGain = limiterGain;
+
+	for(int i = 0; i < MIXER_BUS_COUNT; i++)
+	{
+		bus_state *b = &buses[i];
+		state->buses[i] = (struct audio_mixer_buses_bus)
+		{
+			.gain = b->gain,
+			.lowPassCutoff = b->lowPassCutoff,
+			.reverbSend = b->reverbSend,
+			.compressorThreshold = b->compThreshold,
+			.compressorRatio = b->compRatio,
+			.peak = b->peak
+		};
+	}
+}
\ No newline at end of file
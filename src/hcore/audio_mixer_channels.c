@@ -1,23 +1,141 @@
 #include "audio.h"
+#include "vector_batch.h"
 
+extern SDL_AudioSpec Audio_GetSpec();
+extern uint32 Audio_GetSampleSize();
 extern uint32 Audio_GetBytesNeeded();
+extern memory_arena *Audio_GetFrameArena();
 extern sound *Audio_Sounds_GetSound(int soundID);
-extern void Audio_Mixer_Mix_AddSamples(void *data, uint32 dataLen, uint8 volume, mixer_channel_panning panning);
+extern bool Audio_Sounds_IsLoading(int soundID);
+extern uint64 Audio_Sounds_GetChanges();
+extern bool Audio_Sounds_SpecsMatch(SDL_AudioSpec a, SDL_AudioSpec b);
+extern void Audio_Mixer_Mix_AddSamples(void *data, uint32 dataLen, uint8 volume, mixer_channel_panning panning, int bus);
+extern void Audio_Sounds_ADPCM_DecodeBlock(uint8 *data, uint32 blockIndex, uint32 frameCount, int channels, int16 *dest);
+
+// compressed sounds are decoded a block at a time as they're read. each channel keeps its two most recent
+// blocks, so reading across a block boundary (or a block only partly taken by a resampler) doesn't decode either twice
+typedef struct
+{
+	sound *s;
+	uint32 blocks[2];
+	int16 *frames[2];
+	int next;
+} decode_cache;
+
+// sounds that aren't in the device's format, or that play at another rate, are streamed through a resampler.
+// it reads ahead of what's been heard, so while it's in use the channel's position comes from how far it's played
+typedef struct
+{
+	audio_resampler *r;
+	SDL_AudioSpec spec;	// what the resampler converts from
+	
+	bool isActive;
+	bool isDraining;	// the sound's run out, and only what's buffered is left
+	uint32 startFrame;
+	uint32 feedFrame;	// the next frame the resampler's given
+} channel_stream;
 
 intern int channelCount;
 intern mixer_channel channels[AUDIO_MIXER_CHANNELS_MAX];
 
+intern int realVoiceCount;
+
+// bumped by anything that changes what a channel's snapshot shows; its sound's loading is counted by the sounds
+intern uint64 snapshotChanges;
+
+// free channels are kept on a stack; each channel knows its slot in it (or -1 while in use), so it can be
+// claimed or released in constant time
+intern int freeChannels[AUDIO_MIXER_CHANNELS_MAX];
+intern int freeChannelCount;
+intern int freeSlots[AUDIO_MIXER_CHANNELS_MAX];
+
+intern decode_cache decodeCaches[AUDIO_MIXER_CHANNELS_MAX];
+intern int16 *decodeBuffer;
+
+intern channel_stream streams[AUDIO_MIXER_CHANNELS_MAX];
+
 intern int attenuationThreshold;
 
-bool Audio_Mixer_Channels_Init(int channelCt, int threshold)
+intern float attenuationCurve[AUDIO_MIXER_ATTENUATION_CURVE_MAX];
+intern int attenuationCurveLength;
+
+intern void MarkFree(int channel)
+{
+	if(freeSlots[channel] < 0)
+	{
+		freeSlots[channel] = freeChannelCount;
+		freeChannels[freeChannelCount++] = channel;
+	}
+}
+
+intern void MarkBusy(int channel)
+{
+	int slot = freeSlots[channel];
+	if(slot > -1)
+	{
+		// fill the gap with the top of the stack
+		int last = freeChannels[--freeChannelCount];
+		freeChannels[slot] = last;
+		freeSlots[last] = slot;
+		freeSlots[channel] = -1;
+	}
+}
+
+intern void ResetDecodeCache(decode_cache *cache, sound *s)
+{
+	cache->s = s;
+	cache->blocks[0] = UINT32_MAX;
+	cache->blocks[1] = UINT32_MAX;
+	cache->next = 0;
+}
+
+bool Audio_Mixer_Channels_Init(int channelCt, float threshold, int realVoiceCt)
 {
 	AssertCount(channelCt, AUDIO_MIXER_CHANNELS_MAX);
 	
 	channelCount = channelCt;
-	attenuationThreshold = threshold;
+	attenuationThreshold = (int)(threshold);
+	attenuationCurveLength = 0;
 	
-	for(int i = 0; i < channelCount; i++)
-	{ channels[i].soundID = -1; }
+	realVoiceCount = (realVoiceCt > 0) ? min(realVoiceCt, channelCount) : channelCount;
+	
+	// pushed in reverse, so the lowest channels are handed out first
+	freeChannelCount = 0;
+	for(int i = channelCount - 1; i >= 0; i--)
+	{
+		channels[i].soundID = -1;
+		channels[i].priority = AUDIO_MIXER_CHANNELS_PRIORITY_DEFAULT;
+		channels[i].bus = MIXER_BUS_SFX;
+		channels[i].rate = 1;
+		channels[i].isVirtual = false;
+		channels[i].isFresh = false;
+		
+		freeSlots[i] = -1;
+		MarkFree(i);
+	}
+	
+	snapshotChanges++;
+	
+	// only 16-bit devices can have compressed sounds
+	SDL_AudioSpec spec = Audio_GetSpec();
+	if(spec.format == AUDIO_S16)
+	{
+		uint32 blockSamples = AUDIO_SOUNDS_ADPCM_BLOCK_FRAMES * spec.channels;
+		
+		decodeBuffer = Memory_Alloc(MEMORY_TAG_AUDIO, channelCount * 2 * blockSamples * sizeof(int16));
+		if(!decodeBuffer)
+		{
+			LogFailure("audio mixer channels failed to initialize: couldn't allocate decode caches");
+			return false;
+		}
+		
+		for(int i = 0; i < channelCount; i++)
+		{
+			decodeCaches[i].frames[0] = decodeBuffer + (((i * 2) + 0) * blockSamples);
+			decodeCaches[i].frames[1] = decodeBuffer + (((i * 2) + 1) * blockSamples);
+			ResetDecodeCache(&decodeCaches[i], NULL);
+		}
+	}
 	
 	LogNote("audio mixer channels successfully initialized");
 	return true;
@@ -25,18 +143,62 @@ bool Audio_Mixer_Channels_Init(int channelCt, int threshold)
 
 void Audio_Mixer_Channels_Quit()
 {
+	Memory_Free(decodeBuffer);
+	decodeBuffer = NULL;
+	
+	for(int i = 0; i < AUDIO_MIXER_CHANNELS_MAX; i++)
+	{
+		Audio_Resampler_Free(streams[i].r);
+		streams[i].r = NULL;
+		streams[i].isActive = false;
+	}
+	
 	channelCount = 0;
+	realVoiceCount = 0;
+	freeChannelCount = 0;
+	snapshotChanges++;
+}
+
+intern uint32 GetVoiceScore(int channel)
+{
+	if(channel > -1 && channel < channelCount)
+	{
+		// silent channels can't be heard at all; otherwise priority comes first, then loudness
+		mixer_channel *ch = &channels[channel];
+		if(ch->volume > 0)
+		{ return ((uint32)(ch->priority) << 8) | ch->volume; }
+	}
+	
+	return 0;
 }
 
 HEXPORT(int) Audio_Mixer_Channels_GetNextFreeChannel()
 {
+	if(freeChannelCount > 0)
+	{ return freeChannels[freeChannelCount - 1]; }
+
+	// every channel's busy, so steal the one that'd be missed least; ties go to the lowest channel
+	int stolen = -1;
+	uint32 stolenScore = UINT32_MAX;
 	for(int i = 0; i < channelCount; i++)
 	{
-		if(channels[i].soundID < 0)
-		{ return i; }
+		if(channels[i].isFresh)
+		{ continue; }
+
+		uint32 score = (channels[i].isVirtual ? 0 : (1u << 16)) | GetVoiceScore(i);
+		if(score < stolenScore)
+		{
+			stolen = i;
+			stolenScore = score;
+		}
 	}
 
-	return -1;
+	if(stolen > -1)
+	{ LogDebug("no free mixer channels; stealing channel %i (sound ID %i)", stolen, channels[stolen].soundID); }
+	else
+	{ LogWarning("no free mixer channels, and every one was given its sound since the last advance"); }
+
+	return stolen;
 }
 
 HEXPORT(int) Audio_Mixer_Channels_SetSound(int channel, int soundID)
@@ -49,6 +211,22 @@ HEXPORT(int) Audio_Mixer_Channels_SetSound(int channel, int soundID)
 		{
 			channels[channel].soundID = soundID;
 			channels[channel].dataPos = 0;
+			channels[channel].dataFrac = 0;
+			channels[channel].rate = 1;
+			channels[channel].isVirtual = false;
+			channels[channel].isFresh = (soundID > -1);
+			
+			ResetDecodeCache(&decodeCaches[channel], NULL);
+			streams[channel].isActive = false;
+			snapshotChanges++;
+			
+			if(soundID < 0)
+			{ MarkFree(channel); }
+			else
+			{
+				channels[channel].voice++;
+				MarkBusy(channel);
+			}
 				
 			return channel;
 		}
@@ -61,10 +239,22 @@ HEXPORT(int) Audio_Mixer_Channels_SetSound(int channel, int soundID)
 	return -1;
 }
 
+HEXPORT(uint32) Audio_Mixer_Channels_GetVoice(int channel)
+{
+	if(channel > -1 && channel < channelCount)
+	{ return channels[channel].voice; }
+
+	LogError("can't get voice for channel %i: channel index is invalid (max: %i)", channel, channelCount);
+	return 0;
+}
+
 HEXPORT(void) Audio_Mixer_Channels_SetVolume(int channel, uint8 volume)
 {
 	if(channel > -1 && channel < channelCount)
-	{ channels[channel].volume = volume; }
+	{
+		channels[channel].volume = volume;
+		snapshotChanges++;
+	}
 	else
 	{ LogError("can't set volume for channel %i: channel index is invalid (max: %i)", channel, channelCount); }
 }
@@ -72,70 +262,379 @@ HEXPORT(void) Audio_Mixer_Channels_SetVolume(int channel, uint8 volume)
 HEXPORT(void) Audio_Mixer_Channels_SetPanning(int channel, mixer_channel_panning panning)
 {
 	if(channel > -1 && channel < channelCount)
-	{ channels[channel].panning = panning; }
+	{
+		channels[channel].panning = panning;
+		snapshotChanges++;
+	}
 	else
 	{ LogError("can't set panning for channel %i: channel index is invalid (max: %i)", channel, channelCount); }
 }
 
+HEXPORT(void) Audio_Mixer_Channels_SetRate(int channel, float rate)
+{
+	if(channel > -1 && channel < channelCount)
+	{
+		if(rate < 0 || rate > AUDIO_MIXER_CHANNELS_RATE_MAX)
+		{
+			LogWarning("channel %i's rate (%f) is out of range; clamping to 0-%f", channel, rate, AUDIO_MIXER_CHANNELS_RATE_MAX);
+			rate = Clamp(rate, 0, AUDIO_MIXER_CHANNELS_RATE_MAX);
+		}
+
+		channels[channel].rate = rate;
+		snapshotChanges++;
+	}
+	else
+	{ LogError("can't set rate for channel %i: channel index is invalid (max: %i)", channel, channelCount); }
+}
+
+HEXPORT(void) Audio_Mixer_Channels_SetPriority(int channel, uint8 priority)
+{
+	if(channel > -1 && channel < channelCount)
+	{
+		channels[channel].priority = priority;
+		snapshotChanges++;
+	}
+	else
+	{ LogError("can't set priority for channel %i: channel index is invalid (max: %i)", channel, channelCount); }
+}
+
+HEXPORT(void) Audio_Mixer_Channels_SetBus(int channel, uint8 bus)
+{
+	if(channel > -1 && channel < channelCount)
+	{
+		// channels can only feed source buses; the master bus is fed by those
+		if(bus < MIXER_BUS_MASTER)
+		{
+			channels[channel].bus = bus;
+			snapshotChanges++;
+		}
+		else
+		{ LogError("can't set bus for channel %i: bus index %i isn't a source bus", channel, bus); }
+	}
+	else
+	{ LogError("can't set bus for channel %i: channel index is invalid (max: %i)", channel, channelCount); }
+}
+
+intern uint8 GetAttenuatedVolume(float sqrMag, float maxDist)
+{
+	if(attenuationCurveLength > 1)
+	{
+		// sample the curve at the linear distance, interpolating between its points
+		float t = min(sqrtf(sqrMag) / maxDist, 1);
+		float pos = t * (attenuationCurveLength - 1);
+
+		int i = min((int)(pos), attenuationCurveLength - 2);
+		float frac = pos - i;
+		float gain = attenuationCurve[i] + ((attenuationCurve[i + 1] - attenuationCurve[i]) * frac);
+
+		return (uint8)(255 * Clamp(gain, 0, 1));
+	}
+
+	float dist = min(sqrMag / (maxDist * maxDist), 1);
+	return 255 - (uint8)(255 * dist);
+}
+
+intern void ApplyAttenuation(mixer_channel *ch, float sqrMag, float dot, float maxDist)
+{
+	float lScale = (float)(fabs(max(dot - 1, -1)));
+	float rScale = min(dot + 1, 1);
+
+	ch->volume = GetAttenuatedVolume(sqrMag, maxDist);
+	ch->panning.left = (uint8)(255 * lScale);
+	ch->panning.right = (uint8)(255 * rScale);
+	snapshotChanges++;
+}
+
 HEXPORT(void) Audio_Mixer_Channels_CalcAttenuation(int channel, vector2 offsetFromListener, float maxDist)
 {
 	if(channel > -1 && channel < channelCount)
 	{
 		float sqrMag = VectorSqrMagnitude(offsetFromListener);
-		float dist = min(sqrMag / (maxDist * maxDist), 1);
-		
 		float dot = VectorDot(VectorNormalize(offsetFromListener), VECTOR2_RIGHT);
-		float lScale = (float)(fabs(max(dot - 1, -1)));
-		float rScale = min(dot + 1, 1);
 		
-		uint8 volume = 255 - (uint8)(255 * dist);
-		uint8 left = (uint8)(255 * lScale);
-		uint8 right = (uint8)(255 * rScale);
-		
-		Audio_Mixer_Channels_SetVolume(channel, volume);
-		Audio_Mixer_Channels_SetPanning(channel, (mixer_channel_panning) { .left = left, .right = right });
+		ApplyAttenuation(&channels[channel], sqrMag, dot, maxDist);
 	}
 	else
 	{ LogError("can't calculate attenuation for channel %i: channel index is invalid (max: %i)", channel, channelCount); }
 }
 
-HEXPORT(void) Audio_Mixer_Channels_Advance(int channel, bool loop)
+HEXPORT(void) Audio_Mixer_Channels_CalcAttenuationBatch(int *channelIDs, vector2 *offsetsFromListener, int count, float maxDist)
+{
+	AssertPtr(channelIDs);
+	AssertPtr(offsetsFromListener);
+
+	float sqrMags[AUDIO_MIXER_CHANNELS_MAX];
+	vector2 normals[AUDIO_MIXER_CHANNELS_MAX];
+
+	for(int start = 0; start < count; start += AUDIO_MIXER_CHANNELS_MAX)
+	{
+		int n = min(count - start, AUDIO_MIXER_CHANNELS_MAX);
+		vector2 *offsets = offsetsFromListener + start;
+
+		Vector_Batch_Dot(sqrMags, offsets, offsets, n);
+		Vector_Batch_Normalize(normals, offsets, n);
+
+		for(int i = 0; i < n; i++)
+		{
+			int channel = channelIDs[start + i];
+			if(channel > -1 && channel < channelCount)
+			{
+				// the dot product of a normal with VECTOR2_RIGHT is just its x component
+				ApplyAttenuation(&channels[channel], sqrMags[i], normals[i].x, maxDist);
+			}
+			else
+			{ LogError("can't calculate attenuation for channel %i: channel index is invalid (max: %i)", channel, channelCount); }
+		}
+	}
+}
+
+HEXPORT(void) Audio_Mixer_Channels_SetAttenuationCurve(float *gains, int count)
+{
+	if(count > 1 && gains)
+	{
+		if(count > AUDIO_MIXER_ATTENUATION_CURVE_MAX)
+		{
+			LogWarning("attenuation curve has %i points; only the first %i will be used", count, AUDIO_MIXER_ATTENUATION_CURVE_MAX);
+			count = AUDIO_MIXER_ATTENUATION_CURVE_MAX;
+		}
+
+		memcpy(attenuationCurve, gains, count * sizeof(float));
+		attenuationCurveLength = count;
+	}
+	else
+	{ attenuationCurveLength = 0; }	// fewer than 2 points - fall back to the squared distance ratio
+}
+
+#define FRAC_ONE (1u << AUDIO_MIXER_CHANNELS_FRAC_BITS)
+#define FRAC_MASK (FRAC_ONE - 1)
+
+intern uint8 *GetFrames(decode_cache *cache, sound *s, uint32 frame, uint32 frameSize, uint32 *framesAvailable)
+{
+	uint32 frameCount = s->dataLen / frameSize;
+	
+	if(s->encoding == SOUND_ENCODING_PCM)
+	{
+		*framesAvailable = frameCount - frame;
+		return (uint8*)(s->data) + (frame * frameSize);
+	}
+	
+	AssertPtr(decodeBuffer);
+	
+	uint32 block = frame / AUDIO_SOUNDS_ADPCM_BLOCK_FRAMES;
+	uint32 offset = frame % AUDIO_SOUNDS_ADPCM_BLOCK_FRAMES;
+	int sampleChannels = frameSize / sizeof(int16);
+	
+	*framesAvailable = min(AUDIO_SOUNDS_ADPCM_BLOCK_FRAMES - offset, frameCount - frame);
+	
+	if(cache->s != s)
+	{ ResetDecodeCache(cache, s); }
+	
+	int slot = (cache->blocks[0] == block) ? 0 : ((cache->blocks[1] == block) ? 1 : -1);
+	if(slot < 0)
+	{
+		// replace the older of the two blocks
+		slot = cache->next;
+		cache->next ^= 1;
+		cache->blocks[slot] = block;
+		
+		Audio_Sounds_ADPCM_DecodeBlock(s->data, block, frameCount, sampleChannels, cache->frames[slot]);
+	}
+	
+	return (uint8*)(cache->frames[slot] + (offset * sampleChannels));
+}
+
+intern uint32 CopyFrames(mixer_channel *ch, decode_cache *cache, sound *s, uint8 *chBuffer, uint32 bytesNeeded, bool loop)
+{
+	SDL_AudioSpec spec = Audio_GetSpec();
+	uint32 frameSize = Audio_GetSampleSize() * spec.channels;
+	uint32 frameCount = s->dataLen / frameSize;
+	uint32 framesNeeded = bytesNeeded / frameSize;
+	
+	uint32 frame = ch->dataPos / frameSize;
+	uint32 written = 0;
+	
+	// copy whole runs at a time: up to the end of the sound, or of a compressed block
+	while(written < framesNeeded && frame < frameCount)
+	{
+		uint32 available;
+		uint8 *src = GetFrames(cache, s, frame, frameSize, &available);
+		uint32 n = min(available, framesNeeded - written);
+		
+		memcpy(chBuffer + (written * frameSize), src, n * frameSize);
+		written += n;
+		frame += n;
+		
+		if(loop && frame >= frameCount)
+		{ frame = 0; }
+	}
+	
+	uint32 bytesWritten = written * frameSize;
+	memset(chBuffer + bytesWritten, 0, bytesNeeded - bytesWritten);
+	
+	ch->dataPos = (frame < frameCount) ? (frame * frameSize) : s->dataLen;
+	
+	return bytesWritten;
+}
+
+intern bool StartStream(channel_stream *stream, mixer_channel *ch, sound *s)
+{
+	if(!stream->r || !Audio_Sounds_SpecsMatch(stream->spec, s->spec))
+	{
+		// kept for the channel's next sound, unless that's in another format
+		Audio_Resampler_Free(stream->r);
+		
+		stream->r = Audio_Resampler_Create(s->spec, Audio_GetSpec(), RESAMPLER_QUALITY_LINEAR);
+		stream->spec = s->spec;
+		
+		if(!stream->r)
+		{ return false; }
+	}
+	else
+	{ Audio_Resampler_Reset(stream->r); }
+	
+	stream->isActive = true;
+	stream->isDraining = false;
+	stream->startFrame = ch->dataPos / Audio_Resampler_GetFrameSize(s->spec);
+	stream->feedFrame = stream->startFrame;
+	
+	return true;
+}
+
+intern uint32 StreamFrames(mixer_channel *ch, channel_stream *stream, decode_cache *cache, sound *s, uint8 *chBuffer, uint32 bytesNeeded, bool loop)
+{
+	SDL_AudioSpec spec = Audio_GetSpec();
+	uint32 dstFrameSize = Audio_GetSampleSize() * spec.channels;
+	uint32 srcFrameSize = Audio_Resampler_GetFrameSize(s->spec);
+	uint32 frameCount = s->dataLen / srcFrameSize;
+	uint32 outputLen = (bytesNeeded / dstFrameSize) * dstFrameSize;
+	uint32 written = 0;
+	
+	Audio_Resampler_SetRate(stream->r, ch->rate);
+	
+	while(written < outputLen)
+	{
+		if(stream->feedFrame >= frameCount)
+		{
+			if(loop && !stream->isDraining && frameCount > 0)
+			{ stream->feedFrame = 0; }
+			else
+			{ stream->isDraining = true; }
+		}
+		
+		if(stream->isDraining)
+		{
+			written += Audio_Resampler_Flush(stream->r, chBuffer + written, outputLen - written);
+			break;
+		}
+		
+		// feed whole runs at a time: up to the end of the sound, or of a compressed block
+		uint32 available;
+		uint8 *src = GetFrames(cache, s, stream->feedFrame, srcFrameSize, &available);
+		
+		uint32 used;
+		uint32 produced = Audio_Resampler_Process(stream->r, src, available * srcFrameSize, &used, chBuffer + written, outputLen - written);
+		
+		written += produced;
+		stream->feedFrame += used / srcFrameSize;
+		
+		if(produced == 0 && used == 0)
+		{ break; }
+	}
+	
+	memset(chBuffer + written, 0, bytesNeeded - written);
+	
+	// looping streams are fed from the start again as they reach the end, so what's played wraps the same way
+	uint64 played = stream->startFrame + Audio_Resampler_GetPosition(stream->r);
+	if(stream->isDraining && written < outputLen)
+	{
+		ch->dataPos = s->dataLen;
+		stream->isActive = false;
+	}
+	else if(frameCount > 0)
+	{ ch->dataPos = (uint32)(loop ? (played % frameCount) : min(played, frameCount - 1)) * srcFrameSize; }
+	
+	ch->dataFrac = 0;
+	return written;
+}
+
+intern void SkipFrames(mixer_channel *ch, sound *s, uint32 bytesNeeded, bool loop)
+{
+	SDL_AudioSpec spec = Audio_GetSpec();
+	uint32 frameSize = Audio_Resampler_GetFrameSize(s->spec);
+	uint32 frameCount = s->dataLen / frameSize;
+	uint32 framesNeeded = bytesNeeded / (Audio_GetSampleSize() * spec.channels);
+	
+	// move the position as far as mixing would have, in the sound's own frames, without touching any samples
+	uint64 step = (uint64)((double)(ch->rate) * s->spec.freq / spec.freq * FRAC_ONE);
+	uint64 advance = (framesNeeded * step) + ch->dataFrac;
+	uint64 frame = (ch->dataPos / frameSize) + (advance >> AUDIO_MIXER_CHANNELS_FRAC_BITS);
+	
+	if(frame < frameCount || (loop && frameCount > 0))
+	{
+		ch->dataPos = (uint32)(frame % frameCount) * frameSize;
+		ch->dataFrac = (uint32)(advance & FRAC_MASK);
+	}
+	else
+	{
+		ch->dataPos = s->dataLen;
+		ch->dataFrac = 0;
+	}
+}
+
+intern void AdvanceChannel(int channel, bool loop, bool mix)
 {
 	if(channel > -1 && channel < channelCount)
 	{
 		mixer_channel *ch = &channels[channel];
 		if(ch->soundID > -1)
 		{
+			ch->isFresh = false;
+			snapshotChanges++;
+
 			if(Audio_Sounds_CheckSound(ch->soundID))
 			{
+				// sounds still loading in the background hold their channel, silently
 				sound *s = Audio_Sounds_GetSound(ch->soundID);
+				if(!s)
+				{ return; }
+				
 				if(loop || ch->dataPos < s->dataLen)
 				{	
-					uint32 bytesUsed;
 					uint32 bytesNeeded = Audio_GetBytesNeeded();
-					uint32 bytesAvailable = min(s->dataLen - ch->dataPos, bytesNeeded);
-					
-					uint8 *chBuffer = malloc(bytesNeeded * sizeof(uint8));
-					memcpy(chBuffer, (uint8 *)(s->data) + ch->dataPos, bytesAvailable);
 					
-					if(loop && bytesAvailable < bytesNeeded)
+					ch->isVirtual = !mix;
+					if(ch->isVirtual)
 					{
-						int loopBytes = bytesNeeded - bytesAvailable;
-						memcpy(chBuffer + bytesAvailable, s->data, loopBytes);
+						// a stream that's skipped starts again from the new position when it's next heard
+						streams[channel].isActive = false;
 						
-						ch->dataPos = loopBytes;
-						bytesUsed = bytesNeeded;
+						SkipFrames(ch, s, bytesNeeded, loop);
+						return;
 					}
+					
+					// each channel's samples are mixed in before the next channel's are read, so they share scratch space
+					memory_arena *arena = Audio_GetFrameArena();
+					size_t mark = Memory_Arena_GetMark(arena);
+					
+					uint8 *chBuffer = Memory_Arena_Push(arena, bytesNeeded * sizeof(uint8));
+					if(!chBuffer)
+					{ return; }
+					
+					// sounds in the device's format, at their own rate, are copied straight through; a stream carries on
+					// until the channel's given another sound, so it never skips what it's read ahead
+					channel_stream *stream = &streams[channel];
+					bool copy = !stream->isActive && ch->rate == 1 && ch->dataFrac == 0 && Audio_Sounds_SpecsMatch(s->spec, Audio_GetSpec());
+					
+					uint32 bytesUsed = 0;
+					if(copy)
+					{ bytesUsed = CopyFrames(ch, &decodeCaches[channel], s, chBuffer, bytesNeeded, loop); }
+					else if(stream->isActive || StartStream(stream, ch, s))
+					{ bytesUsed = StreamFrames(ch, stream, &decodeCaches[channel], s, chBuffer, bytesNeeded, loop); }
 					else
-					{
-						memset(chBuffer + bytesAvailable, 0, bytesNeeded - bytesAvailable);
-						
-						ch->dataPos += bytesAvailable;
-						bytesUsed = bytesAvailable;
-					}
+					{ LogError("couldn't advance channel %i: couldn't create its resampler", channel); }
 					
-					Audio_Mixer_Mix_AddSamples(chBuffer, bytesUsed, ch->volume, ch->panning);
-					free(chBuffer);
+					Audio_Mixer_Mix_AddSamples(chBuffer, bytesUsed, ch->volume, ch->panning, ch->bus);
+					Memory_Arena_PopTo(arena, mark);
 				}
 				else
 				{ LogWarning("couldn't advance channel %i: channel has finished playing its sound (ID: %i)", channel, ch->soundID); }
@@ -150,28 +649,89 @@ HEXPORT(void) Audio_Mixer_Channels_Advance(int channel, bool loop)
 	{ LogError("couldn't advance channel %i: channel index is invalid (max: %i)", channel, channelCount); }
 }
 
-struct audio_mixer_channels_state Audio_Mixer_Channels_GetSnapshot()
+HEXPORT(void) Audio_Mixer_Channels_Advance(int channel, bool loop)
+{
+	AdvanceChannel(channel, loop, true);
+}
+
+typedef struct
+{
+	int channel;
+	uint32 score;
+} voice_score;
+
+intern int CompareVoices(const void *a, const void *b)
+{
+	voice_score *va = (voice_score*)(a);
+	voice_score *vb = (voice_score*)(b);
+	
+	// highest score first; ties go to the lower channel, so the selection is stable from push to push
+	if(va->score != vb->score)
+	{ return (va->score > vb->score) ? -1 : 1; }
+	
+	return va->channel - vb->channel;
+}
+
+HEXPORT(void) Audio_Mixer_Channels_AdvanceBatch(int *channelIDs, int count, bool loop)
+{
+	AssertPtr(channelIDs);
+	
+	if(count > AUDIO_MIXER_CHANNELS_MAX)
+	{
+		LogWarning("can't advance %i channels in one batch; only the first %i will be advanced", count, AUDIO_MIXER_CHANNELS_MAX);
+		count = AUDIO_MIXER_CHANNELS_MAX;
+	}
+	
+	voice_score voices[AUDIO_MIXER_CHANNELS_MAX];
+	for(int i = 0; i < count; i++)
+	{
+		voices[i].channel = channelIDs[i];
+		voices[i].score = GetVoiceScore(channelIDs[i]);
+	}
+	
+	// only the most important audible voices are mixed; the rest are virtualized,
+	// so mixing cost is bounded by the real voice count rather than the channel count
+	if(count > realVoiceCount)
+	{ qsort(voices, count, sizeof(voice_score), &CompareVoices); }
+	
+	for(int i = 0; i < count; i++)
+	{
+		bool real = (i < realVoiceCount) && (voices[i].score > 0);
+		AdvanceChannel(voices[i].channel, loop, real);
+	}
+}
+
+uint64 Audio_Mixer_Channels_GetChanges()
+{
+	return snapshotChanges + Audio_Sounds_GetChanges();
+}
+
+void Audio_Mixer_Channels_GetSnapshot(struct audio_mixer_channels_state *state)
 {
-	struct audio_mixer_channels_state state;
-	state.channelCount = channelCount;
+	state->channelCount = channelCount;
+	state->realVoiceCount = realVoiceCount;
 	
+	// fields are set one by one, so the (zeroed) padding is left alone
 	for(int i = 0; i < channelCount; i++)
 	{
 		mixer_channel *ch = &channels[i];
-		state.channels[i] = (struct audio_mixer_channels_channel)
-		{
-			.soundID = ch->soundID,
-			.dataPos = ch->dataPos,
-			.volume = ch->volume,
-			.panning = ch->panning
-		};
+		struct audio_mixer_channels_channel *chState = &state->channels[i];
+		
+		chState->soundID = ch->soundID;
+		chState->voice = ch->voice;
+		chState->dataPos = ch->dataPos;
+		chState->volume = ch->volume;
+		chState->panning = ch->panning;
+		chState->priority = ch->priority;
+		chState->bus = ch->bus;
+		chState->rate = ch->rate;
+		chState->isVirtual = ch->isVirtual;
 		
 		if(ch->soundID > -1 && Audio_Sounds_CheckSound(ch->soundID))
 		{
 			sound *s = Audio_Sounds_GetSound(ch->soundID);
-			state.channels[i].dataLen = s->dataLen;
+			chState->dataLen = s ? s->dataLen : 0;
+			chState->isLoading = Audio_Sounds_IsLoading(ch->soundID);
 		}
 	}
-	
-	return state;
 }
\ No newline at end of file
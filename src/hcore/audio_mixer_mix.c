@@ -3,16 +3,27 @@
 extern SDL_AudioSpec Audio_GetSpec();
 extern uint32 Audio_GetSampleSize();
 
+extern void Audio_Mixer_Buses_Accumulate(int bus, float *samples, uint32 sampleCount);
+extern void Audio_Mixer_Buses_Render(float *output, uint32 sampleCount);
+
 intern uint32 accumulatorSize;
-intern int64 *accumulator;
+intern float *accumulator;
+intern float *channelBuffer;
 
 intern float falloffExp;
 
-#define MixSamples(destType, dest, srcType, src, count) \
+intern uint64 snapshotChanges;
+
+// samples are mixed as floats in the -1 to 1 range, whatever the device format
+#define DecodeSamples(srcType, src, offset, scale, dest, count) \
+for(uint32 sMixI = 0; sMixI < (count); sMixI++) \
+{ (dest)[sMixI] = ((float)(((srcType*)(src))[sMixI]) - (offset)) * (scale); }
+
+#define EncodeSamples(destType, dest, offset, scale, lower, upper, src, count) \
 for(uint32 sMixI = 0; sMixI < (count); sMixI++) \
-{ ((destType*)(dest))[sMixI] += (destType)(((srcType*)(src))[sMixI]); }
+{ ((destType*)(dest))[sMixI] = (destType)(Clamp(lrint(((double)((src)[sMixI]) * (scale)) + (offset)), (lower), (upper))); }
 
-intern void MixSamplesIn(int64 *dest, void *src, SDL_AudioFormat srcFormat, uint32 sampleCount)
+intern void MixSamplesIn(float *dest, void *src, SDL_AudioFormat srcFormat, uint32 sampleCount)
 {
 	AssertPtr(dest);
 	AssertPtr(src);
@@ -20,22 +31,22 @@ intern void MixSamplesIn(int64 *dest, void *src, SDL_AudioFormat srcFormat, uint
 	switch(srcFormat)
 	{
 		case AUDIO_U8:
-			MixSamples(int64, dest, uint8, src, sampleCount);
+			DecodeSamples(uint8, src, 128.0f, 1.0f / 128, dest, sampleCount);
 			break;
 		case AUDIO_S8:
-			MixSamples(int64, dest, int8, src, sampleCount);
+			DecodeSamples(int8, src, 0.0f, 1.0f / 128, dest, sampleCount);
 			break;
 		case AUDIO_U16:
-			MixSamples(int64, dest, uint16, src, sampleCount);
+			DecodeSamples(uint16, src, 32768.0f, 1.0f / 32768, dest, sampleCount);
 			break;
 		case AUDIO_S16:
-			MixSamples(int64, dest, int16, src, sampleCount);
+			DecodeSamples(int16, src, 0.0f, 1.0f / 32768, dest, sampleCount);
 			break;
 		case AUDIO_S32:
-			MixSamples(int64, dest, int32, src, sampleCount);
+			DecodeSamples(int32, src, 0.0f, 1.0f / 2147483648.0f, dest, sampleCount);
 			break;
 		case AUDIO_F32:
-			MixSamples(int64, dest, float, src, sampleCount);
+			DecodeSamples(float, src, 0.0f, 1.0f, dest, sampleCount);
 			break;
 		default:
 			LogError("can't mix samples: unknown format");
@@ -43,7 +54,7 @@ intern void MixSamplesIn(int64 *dest, void *src, SDL_AudioFormat srcFormat, uint
 	}
 }
 
-intern void MixSamplesOut(void *dest, int64 *src, SDL_AudioFormat destFormat, uint32 sampleCount)
+intern void MixSamplesOut(void *dest, float *src, SDL_AudioFormat destFormat, uint32 sampleCount)
 {
 	AssertPtr(dest);
 	AssertPtr(src);
@@ -51,22 +62,23 @@ intern void MixSamplesOut(void *dest, int64 *src, SDL_AudioFormat destFormat, ui
 	switch(destFormat)
 	{
 		case AUDIO_U8:
-			MixSamples(uint8, dest, int64, src, sampleCount);
+			EncodeSamples(uint8, dest, 128, 128, 0, UCHAR_MAX, src, sampleCount);
 			break;
 		case AUDIO_S8:
-			MixSamples(int8, dest, int64, src, sampleCount);
+			EncodeSamples(int8, dest, 0, 128, SCHAR_MIN, SCHAR_MAX, src, sampleCount);
 			break;
 		case AUDIO_U16:
-			MixSamples(uint16, dest, int64, src, sampleCount);
+			EncodeSamples(uint16, dest, 32768, 32768, 0, USHRT_MAX, src, sampleCount);
 			break;
 		case AUDIO_S16:
-			MixSamples(int16, dest, int64, src, sampleCount);
+			EncodeSamples(int16, dest, 0, 32768, SHRT_MIN, SHRT_MAX, src, sampleCount);
 			break;
 		case AUDIO_S32:
-			MixSamples(int32, dest, int64, src, sampleCount);
+			EncodeSamples(int32, dest, 0, 2147483648.0, INT_MIN, INT_MAX, src, sampleCount);
 			break;
 		case AUDIO_F32:
-			MixSamples(float, dest, int64, src, sampleCount);
+			for(uint32 i = 0; i < sampleCount; i++)
+			{ ((float*)(dest))[i] = Clamp(src[i], -1.0f, 1.0f); }
 			break;
 		default:
 			LogError("can't mix samples: unknown format");
@@ -74,64 +86,33 @@ intern void MixSamplesOut(void *dest, int64 *src, SDL_AudioFormat destFormat, ui
 	}
 }
 
-intern void AttenuateSamples(int64 *samples, uint32 sampleCount, uint8 volume, mixer_channel_panning panning)
+intern void AttenuateSamples(float *samples, uint32 sampleCount, uint8 volume, mixer_channel_panning panning)
 {
 	AssertPtr(samples);
 	Assert((sampleCount % 2) == 0, "uneven number of samples");
 	
+	// these only depend on the channel's settings, so they're the same for every sample
+	float lScale = (float)(panning.left) / 255;
+	float rScale = (float)(panning.right) / 255;
+	float dScale = (float)(255 - volume) / 255;
+	float falloff = (float)(pow(dScale, falloffExp));
+	
+	float lMod = (1 - rScale) + falloff;
+	float rMod = (1 - lScale) + falloff;
+	
 	for(uint32 i = 0; i < sampleCount; i += 2)
 	{	
-		int64 *sL = &samples[i];
-		int64 *sR = &samples[i + 1];
-		
-		float lScale = (float)(panning.left) / 255;
-		float rScale = (float)(panning.right) / 255;
-		float dScale = (float)(255 - volume) / 255;
-		
-		float lMod = (1 - rScale) + (float)(pow(dScale, falloffExp));
-		float rMod = (1 - lScale) + (float)(pow(dScale, falloffExp));
+		float *sL = &samples[i];
+		float *sR = &samples[i + 1];
 		
-		int64 lAdd = (int64)((float)(*sR) * lMod);
-		int64 rAdd = (int64)((float)(*sL) * rMod);
+		float lAdd = *sR * lMod;
+		float rAdd = *sL * rMod;
 
 		*sL += lAdd;
 		*sR += rAdd;
 		
-		*sL = (int64)((float)(*sL) * lScale * (1 - dScale));
-		*sR = (int64)((float)(*sR) * rScale * (1 - dScale));
-	}
-}
-
-intern void NormalizeSamples(int64 *samples, uint32 sampleCount)
-{
-	AssertPtr(samples);
-	
-	// we'll use long doubles to be extra sure we don't lose any data
-	long double scalar = 1;
-	
-	// we first need to check each sample to find the largest value
-	for(uint32 s = 0; s < sampleCount; s++)
-	{
-		int64 *smp = &samples[s];
-		
-		// avoid divide by zero issues
-		if(*smp != 0)
-		{
-			// get size of sample relative to the output format's limit
-			long double sampleSize = (long double)(llabs(*smp));
-			long double sizeLimit = SHRT_MAX;
-			
-			// adjust scalar if we've exceeded the limit more than a previous sample
-			scalar = min(sizeLimit / sampleSize, scalar);
-		}
-	}
-	
-	// don't waste time normalizing if it isn't needed
-	if(scalar < 1)
-	{
-		// just scale down each sample
-		for(uint32 s = 0; s < sampleCount; s++)
-		{ samples[s] = (int64)((long double)(samples[s]) * scalar); }
+		*sL *= lScale * (1 - dScale);
+		*sR *= rScale * (1 - dScale);
 	}
 }
 
@@ -141,9 +122,11 @@ bool Audio_Mixer_Mix_Init(float stereoFalloff)
 	accumulatorSize = spec.channels * spec.samples;
 	
 	falloffExp = stereoFalloff;
+	snapshotChanges++;
 	
-	accumulator = calloc(accumulatorSize, sizeof(int64));
-	if(accumulator)
+	accumulator = Memory_Calloc(MEMORY_TAG_AUDIO, accumulatorSize, sizeof(float));
+	channelBuffer = Memory_Calloc(MEMORY_TAG_AUDIO, accumulatorSize, sizeof(float));
+	if(accumulator && channelBuffer)
 	{
 		LogNote("audio mixer mix successfully initialized");
 		return true;
@@ -157,32 +140,32 @@ bool Audio_Mixer_Mix_Init(float stereoFalloff)
 void Audio_Mixer_Mix_Quit()
 {
 	accumulatorSize = 0;
+	snapshotChanges++;
 	
-	free(accumulator);
+	Memory_Free(accumulator);
 	accumulator = NULL;
+	
+	Memory_Free(channelBuffer);
+	channelBuffer = NULL;
 }
 
-void Audio_Mixer_Mix_AddSamples(void *data, uint32 dataLen, uint8 volume, mixer_channel_panning panning)
+void Audio_Mixer_Mix_AddSamples(void *data, uint32 dataLen, uint8 volume, mixer_channel_panning panning, int bus)
 {
 	AssertPtr(data);
-	AssertPtr(accumulator);
+	AssertPtr(channelBuffer);
 	
 	SDL_AudioSpec spec = Audio_GetSpec();
 	uint32 sampleSize = Audio_GetSampleSize();
-	uint32 sampleCount = dataLen / sampleSize;
+	uint32 sampleCount = min(dataLen / sampleSize, accumulatorSize);
 	
-	int64 *buffer = calloc(sampleCount, sizeof(int64));
-	MixSamplesIn(buffer, data, spec.format, sampleCount);
+	MixSamplesIn(channelBuffer, data, spec.format, sampleCount);
 	
 	if(spec.channels == 2)
-	{ AttenuateSamples(buffer, sampleCount, volume, panning); }
+	{ AttenuateSamples(channelBuffer, sampleCount, volume, panning); }
 	else
 	{ LogWarning("couldn't attenuate samples: i haven't gotten around to anything but stereo yet"); }
 	
-	for(uint32 i = 0; i < sampleCount; i++)
-	{ accumulator[i] += buffer[i]; }
-
-	free(buffer);
+	Audio_Mixer_Buses_Accumulate(bus, channelBuffer, sampleCount);
 }
 
 void Audio_Mixer_Mix_GetMixedSamples(void *data, uint32 dataLen)
@@ -192,21 +175,20 @@ void Audio_Mixer_Mix_GetMixedSamples(void *data, uint32 dataLen)
 	
 	SDL_AudioSpec spec = Audio_GetSpec();
 	uint32 sampleSize = Audio_GetSampleSize();
-	uint32 sampleCount = dataLen / sampleSize;
+	uint32 sampleCount = min(dataLen / sampleSize, accumulatorSize);
 	
-	NormalizeSamples(accumulator, sampleCount);
+	// buses are processed once per block, and the master's limiter keeps the result within range
+	Audio_Mixer_Buses_Render(accumulator, sampleCount);
 	MixSamplesOut(data, accumulator, spec.format, sampleCount);
-	
-	memset(accumulator, 0, accumulatorSize * sizeof(int64));
 }
 
-struct audio_mixer_mix_state Audio_Mixer_Mix_GetSnapshot()
+uint64 Audio_Mixer_Mix_GetChanges()
 {
-	struct audio_mixer_mix_state state = 
-	{
-		.accumulatorSize = accumulatorSize,
-		.stereoFalloffExp = falloffExp
-	};
-	
-	return state;
+	return snapshotChanges;
+}
+
+void Audio_Mixer_Mix_GetSnapshot(struct audio_mixer_mix_state *state)
+{
+	state->accumulatorSize = accumulatorSize;
+	state->stereoFalloffExp = falloffExp;
 }
\ No newline at end of file
@@ -0,0 +1,470 @@
+#include "audio.h"
+
+#define RESAMPLER_BLOCK_FRAMES 1024
+#define RESAMPLER_SINC_TAPS 16
+#define RESAMPLER_SINC_PHASES 64
+#define RESAMPLER_SINC_CUTOFF 0.97
+#define RESAMPLER_RATE_BITS 16	// fixed-point precision of the playback rate
+
+struct audio_resampler
+{
+	SDL_AudioSpec srcSpec;
+	SDL_AudioSpec dstSpec;
+	uint32 srcFrameSize;
+	uint32 dstFrameSize;
+
+	// resampling is done with the smaller of the two channel counts;
+	// downmixing happens while reading input, and upmixing while writing output
+	int channels;
+
+	int taps;
+	int lead;		// zero frames primed before the first input frame, so the first output is centered on it
+	float *filter;	// (phases + 1) rows of taps; NULL when interpolating linearly
+
+	// the read position is kept as an exact fraction of input frames, over the output rate (in fixed point, so the
+	// playback rate can scale the step), so it never drifts over long streams; it's relative to the start of the buffer
+	uint64 position;
+	uint64 positionScale;
+	uint64 step;
+
+	float *buffer;
+	uint32 bufferFrames;
+	uint32 bufferCapacity;
+	uint64 bufferBase;	// padded frame index of the start of the buffer
+
+	uint64 inputFrames;
+	int flushFrames;	// zero frames still to be appended when flushing
+	bool flushing;
+};
+
+intern uint32 GetFormatSize(SDL_AudioFormat format)
+{
+	switch(format)
+	{
+		case AUDIO_U8:
+		case AUDIO_S8:
+			return 1;
+		case AUDIO_U16:
+		case AUDIO_S16:
+			return 2;
+		case AUDIO_S32:
+		case AUDIO_F32:
+			return 4;
+		default:
+			return 0;
+	}
+}
+
+intern float ReadSample(uint8 *src, SDL_AudioFormat format)
+{
+	switch(format)
+	{
+		case AUDIO_U8:
+			return ((float)(*src) - 128) / 128;
+		case AUDIO_S8:
+			return (float)(*(int8*)(src)) / 128;
+		case AUDIO_U16:
+			return ((float)(*(uint16*)(src)) - 32768) / 32768;
+		case AUDIO_S16:
+			return (float)(*(int16*)(src)) / 32768;
+		case AUDIO_S32:
+			return (float)((double)(*(int32*)(src)) / 2147483648.0);
+		case AUDIO_F32:
+			return *(float*)(src);
+		default:
+			return 0;
+	}
+}
+
+intern void WriteSample(uint8 *dest, SDL_AudioFormat format, float sample)
+{
+	sample = Clamp(sample, -1.0f, 1.0f);
+
+	switch(format)
+	{
+		case AUDIO_U8:
+			*dest = (uint8)(Clamp(lrintf(sample * 128) + 128, 0, UCHAR_MAX));
+			break;
+		case AUDIO_S8:
+			*(int8*)(dest) = (int8)(Clamp(lrintf(sample * 128), SCHAR_MIN, SCHAR_MAX));
+			break;
+		case AUDIO_U16:
+			*(uint16*)(dest) = (uint16)(Clamp(lrintf(sample * 32768) + 32768, 0, USHRT_MAX));
+			break;
+		case AUDIO_S16:
+			*(int16*)(dest) = (int16)(Clamp(lrintf(sample * 32768), SHRT_MIN, SHRT_MAX));
+			break;
+		case AUDIO_S32:
+			*(int32*)(dest) = (int32)(Clamp(llrint((double)(sample) * 2147483648.0), INT_MIN, INT_MAX));
+			break;
+		case AUDIO_F32:
+			*(float*)(dest) = sample;
+			break;
+	}
+}
+
+intern double Sinc(double x)
+{
+	if(x == 0)
+	{ return 1; }
+
+	return sin(M_PI * x) / (M_PI * x);
+}
+
+intern double Blackman(double t)
+{
+	// t is in the range [-1, 1]
+	return 0.42 + (0.5 * cos(M_PI * t)) + (0.08 * cos(2 * M_PI * t));
+}
+
+intern float *BuildSincFilter(double step)
+{
+	float *filter = Memory_Alloc(MEMORY_TAG_AUDIO, (RESAMPLER_SINC_PHASES + 1) * RESAMPLER_SINC_TAPS * sizeof(float));
+	if(filter)
+	{
+		// when downsampling, lower the cutoff to the destination's nyquist frequency
+		double cutoff = min(1.0, 1.0 / step) * RESAMPLER_SINC_CUTOFF;
+		int half = RESAMPLER_SINC_TAPS / 2;
+
+		for(int p = 0; p <= RESAMPLER_SINC_PHASES; p++)
+		{
+			float *row = &filter[p * RESAMPLER_SINC_TAPS];
+			double frac = (double)(p) / RESAMPLER_SINC_PHASES;
+			double sum = 0;
+
+			for(int k = 0; k < RESAMPLER_SINC_TAPS; k++)
+			{
+				double x = (k - (half - 1)) - frac;
+				double w = cutoff * Sinc(cutoff * x) * Blackman(x / half);
+
+				row[k] = (float)(w);
+				sum += w;
+			}
+
+			// normalize each phase to unity gain, so DC passes through unchanged
+			for(int k = 0; k < RESAMPLER_SINC_TAPS; k++)
+			{ row[k] = (float)(row[k] / sum); }
+		}
+	}
+
+	return filter;
+}
+
+intern void DecodeFrames(audio_resampler *r, uint8 *src, uint32 frameCount, float *dest)
+{
+	int srcChannels = r->srcSpec.channels;
+	uint32 sampleSize = GetFormatSize(r->srcSpec.format);
+
+	for(uint32 f = 0; f < frameCount; f++)
+	{
+		uint8 *frame = src + (f * r->srcFrameSize);
+		float *out = dest + (f * r->channels);
+
+		if(srcChannels > r->channels && r->channels == 1)
+		{
+			// downmix to mono
+			float sum = 0;
+			for(int c = 0; c < srcChannels; c++)
+			{ sum += ReadSample(frame + (c * sampleSize), r->srcSpec.format); }
+
+			out[0] = sum / srcChannels;
+		}
+		else
+		{
+			// otherwise, extra source channels are dropped
+			for(int c = 0; c < r->channels; c++)
+			{ out[c] = ReadSample(frame + (c * sampleSize), r->srcSpec.format); }
+		}
+	}
+}
+
+intern void EncodeFrame(audio_resampler *r, float *frame, uint8 *dest)
+{
+	int dstChannels = r->dstSpec.channels;
+	uint32 sampleSize = GetFormatSize(r->dstSpec.format);
+
+	for(int c = 0; c < dstChannels; c++)
+	{
+		// upmixed channels repeat the last working channel (i.e. mono is copied to every channel)
+		float sample = frame[min(c, r->channels - 1)];
+		WriteSample(dest + (c * sampleSize), r->dstSpec.format, sample);
+	}
+}
+
+intern uint32 GetReadFrame(audio_resampler *r)
+{
+	// relative to the start of the buffer
+	return (uint32)(r->position / r->positionScale);
+}
+
+intern void InterpolateFrame(audio_resampler *r, float *frame)
+{
+	uint32 base = GetReadFrame(r);
+	float frac = (float)((double)(r->position % r->positionScale) / r->positionScale);
+
+	if(r->filter)
+	{
+		// blend between the two nearest filter phases
+		float phasePos = frac * RESAMPLER_SINC_PHASES;
+		int phase = min((int)(phasePos), RESAMPLER_SINC_PHASES - 1);
+		float t = phasePos - phase;
+
+		float *rowA = &r->filter[phase * r->taps];
+		float *rowB = &r->filter[(phase + 1) * r->taps];
+		float *src = &r->buffer[(base - (r->lead)) * r->channels];
+
+		for(int c = 0; c < r->channels; c++)
+		{ frame[c] = 0; }
+
+		for(int k = 0; k < r->taps; k++)
+		{
+			float w = rowA[k] + ((rowB[k] - rowA[k]) * t);
+			float *tap = &src[k * r->channels];
+
+			for(int c = 0; c < r->channels; c++)
+			{ frame[c] += tap[c] * w; }
+		}
+	}
+	else
+	{
+		float *a = &r->buffer[base * r->channels];
+		float *b = a + r->channels;
+
+		for(int c = 0; c < r->channels; c++)
+		{ frame[c] = (a[c] * (1 - frac)) + (b[c] * frac); }
+	}
+}
+
+intern uint32 ProduceFrames(audio_resampler *r, uint8 *output, uint32 maxFrames)
+{
+	float frame[UCHAR_MAX];
+	uint32 produced = 0;
+	int half = r->taps / 2;
+
+	while(produced < maxFrames)
+	{
+		// every tap needs to be buffered
+		uint32 base = GetReadFrame(r);
+		if(base + half >= r->bufferFrames)
+		{ break; }
+
+		// while flushing, stop at the end of the real input
+		if(r->flushing && (r->bufferBase + base) >= (r->lead + r->inputFrames))
+		{ break; }
+
+		InterpolateFrame(r, frame);
+		EncodeFrame(r, frame, output + (produced * r->dstFrameSize));
+
+		r->position += r->step;
+		produced++;
+	}
+
+	return produced;
+}
+
+intern void CompactBuffer(audio_resampler *r)
+{
+	// drop frames that no future output can reach
+	int64 discard = (int64)(GetReadFrame(r)) - r->lead;
+	if(discard > 0)
+	{
+		uint32 d = (uint32)(min((uint64)(discard), r->bufferFrames));
+
+		memmove(r->buffer, r->buffer + (d * r->channels), (r->bufferFrames - d) * r->channels * sizeof(float));
+		r->bufferFrames -= d;
+		r->bufferBase += d;
+		r->position -= d * r->positionScale;
+	}
+}
+
+intern void Restart(audio_resampler *r)
+{
+	// the first output is centered on the first input frame, with the lead primed with zeros
+	memset(r->buffer, 0, r->lead * r->channels * sizeof(float));
+	r->bufferFrames = r->lead;
+	r->bufferBase = 0;
+	r->position = r->lead * r->positionScale;
+
+	r->inputFrames = 0;
+	r->flushFrames = 0;
+	r->flushing = false;
+}
+
+audio_resampler *Audio_Resampler_Create(SDL_AudioSpec srcSpec, SDL_AudioSpec dstSpec, resampler_quality quality)
+{
+	uint32 srcSampleSize = GetFormatSize(srcSpec.format);
+	uint32 dstSampleSize = GetFormatSize(dstSpec.format);
+
+	if(srcSampleSize == 0 || dstSampleSize == 0)
+	{
+		LogError("couldn't create resampler: unsupported sample format (source: %i, destination: %i)", srcSpec.format, dstSpec.format);
+		return NULL;
+	}
+
+	if(srcSpec.channels == 0 || dstSpec.channels == 0 || srcSpec.freq <= 0 || dstSpec.freq <= 0)
+	{
+		LogError("couldn't create resampler: channel count and sample rate must be positive");
+		return NULL;
+	}
+
+	audio_resampler *r = Memory_Calloc(MEMORY_TAG_AUDIO, 1, sizeof(audio_resampler));
+	if(r)
+	{
+		r->srcSpec = srcSpec;
+		r->dstSpec = dstSpec;
+		r->srcFrameSize = srcSampleSize * srcSpec.channels;
+		r->dstFrameSize = dstSampleSize * dstSpec.channels;
+		r->channels = min(srcSpec.channels, dstSpec.channels);
+
+		// matching rates are just a copy - the linear path reproduces input exactly at whole positions
+		if(quality == RESAMPLER_QUALITY_SINC && srcSpec.freq != dstSpec.freq)
+		{
+			r->taps = RESAMPLER_SINC_TAPS;
+			r->filter = BuildSincFilter((double)(srcSpec.freq) / dstSpec.freq);
+		}
+		else
+		{ r->taps = 2; }
+
+		r->lead = (r->taps / 2) - 1;
+		r->positionScale = (uint64)(dstSpec.freq) << RESAMPLER_RATE_BITS;
+		r->step = (uint64)(srcSpec.freq) << RESAMPLER_RATE_BITS;
+
+		r->bufferCapacity = RESAMPLER_BLOCK_FRAMES + r->taps;
+		r->buffer = Memory_Alloc(MEMORY_TAG_AUDIO, r->bufferCapacity * r->channels * sizeof(float));
+
+		if(r->buffer && (r->filter || r->taps == 2))
+		{
+			Restart(r);
+			return r;
+		}
+
+		LogError("couldn't create resampler: failed to allocate buffers");
+		Audio_Resampler_Free(r);
+	}
+	else
+	{ LogError("couldn't create resampler: failed to allocate memory"); }
+
+	return NULL;
+}
+
+void Audio_Resampler_Free(audio_resampler *r)
+{
+	if(r)
+	{
+		Memory_Free(r->filter);
+		Memory_Free(r->buffer);
+		Memory_Free(r);
+	}
+}
+
+void Audio_Resampler_Reset(audio_resampler *r)
+{
+	AssertPtr(r);
+
+	Restart(r);
+}
+
+void Audio_Resampler_SetRate(audio_resampler *r, float rate)
+{
+	AssertPtr(r);
+	Assert(rate >= 0, "resampler playback rate can't be negative (%f)", rate);
+
+	// only the step changes, so the stream carries on from where it is
+	uint64 rateFixed = (uint64)(llrint((double)(rate) * (1 << RESAMPLER_RATE_BITS)));
+	r->step = (uint64)(r->srcSpec.freq) * rateFixed;
+}
+
+uint64 Audio_Resampler_GetPosition(audio_resampler *r)
+{
+	AssertPtr(r);
+
+	return (r->bufferBase + GetReadFrame(r)) - r->lead;
+}
+
+uint32 Audio_Resampler_GetFrameSize(SDL_AudioSpec spec)
+{
+	return GetFormatSize(spec.format) * spec.channels;
+}
+
+uint32 Audio_Resampler_GetMaxOutputLength(audio_resampler *r, uint32 inputLen)
+{
+	AssertPtr(r);
+	Assert(r->step > 0, "a paused resampler's output never ends");
+
+	// total input frames (including any already buffered), scaled by the rate ratio, plus rounding slack
+	uint64 frames = (uint64)(inputLen / r->srcFrameSize) + r->bufferFrames;
+	uint64 outFrames = (uint64)(((double)(frames) * r->positionScale) / r->step) + 2;
+
+	return (uint32)(outFrames * r->dstFrameSize);
+}
+
+uint32 Audio_Resampler_Process(audio_resampler *r, void *input, uint32 inputLen, uint32 *inputUsed, void *output, uint32 outputLen)
+{
+	AssertPtr(r);
+	AssertPtr(output);
+
+	uint32 inFrames = input ? (inputLen / r->srcFrameSize) : 0;
+	uint32 outFrames = outputLen / r->dstFrameSize;
+	uint32 inDone = 0;
+	uint32 outDone = 0;
+
+	for(;;)
+	{
+		// decode the next block of input
+		uint32 n = min(r->bufferCapacity - r->bufferFrames, inFrames - inDone);
+		if(n > 0)
+		{
+			DecodeFrames(r, (uint8*)(input) + (inDone * r->srcFrameSize), n, r->buffer + (r->bufferFrames * r->channels));
+			r->bufferFrames += n;
+			r->inputFrames += n;
+			inDone += n;
+		}
+
+		outDone += ProduceFrames(r, (uint8*)(output) + (outDone * r->dstFrameSize), outFrames - outDone);
+		CompactBuffer(r);
+
+		if(outDone == outFrames || inDone == inFrames)
+		{ break; }
+	}
+
+	if(inputUsed)
+	{ *inputUsed = inDone * r->srcFrameSize; }
+
+	return outDone * r->dstFrameSize;
+}
+
+uint32 Audio_Resampler_Flush(audio_resampler *r, void *output, uint32 outputLen)
+{
+	AssertPtr(r);
+	AssertPtr(output);
+
+	if(!r->flushing)
+	{
+		r->flushing = true;
+		r->flushFrames = r->taps / 2;
+	}
+
+	uint32 outFrames = outputLen / r->dstFrameSize;
+	uint32 outDone = 0;
+
+	for(;;)
+	{
+		// pad the end of the input with silence, so the last frames have all their taps
+		uint32 n = min(r->bufferCapacity - r->bufferFrames, (uint32)(r->flushFrames));
+		if(n > 0)
+		{
+			memset(r->buffer + (r->bufferFrames * r->channels), 0, n * r->channels * sizeof(float));
+			r->bufferFrames += n;
+			r->flushFrames -= n;
+		}
+
+		uint32 produced = ProduceFrames(r, (uint8*)(output) + (outDone * r->dstFrameSize), outFrames - outDone);
+		outDone += produced;
+		CompactBuffer(r);
+
+		if(outDone == outFrames || (produced == 0 && r->flushFrames == 0))
+		{ break; }
+	}
+
+	return outDone * r->dstFrameSize;
+}
\ No newline at end of file
@@ -1,18 +1,45 @@
 #include "audio.h"
+#include "pack.h"
 #include "resource_map.h"
 
 extern SDL_AudioSpec Audio_GetSpec();
-extern sound *Audio_Sounds_WAV_Load(char *filePath);
-extern sound *Audio_Sounds_OGG_Load(char *filePath);
+extern sound *Audio_Sounds_WAV_Load(SDL_RWops *rw, char *name);
+extern sound *Audio_Sounds_OGG_Load(SDL_RWops *rw, char *name);
+extern uint32 Audio_Sounds_ADPCM_GetEncodedLength(uint32 frameCount, int channels);
+extern void Audio_Sounds_ADPCM_Encode(int16 *samples, uint32 frameCount, int channels, uint8 *dest);
+
+sound *Audio_Sounds_CreateSound(void *data, uint32 dataLen, SDL_AudioSpec spec);
 
 intern int maxSounds;
 intern resource_map *sounds;
+intern memory_pool soundPool;
 
-intern void *AllocSound(char *filePath)
+intern bool compressSounds;
+intern bool convertOnLoad;
+intern uint64 budgetBytes;
+
+// sounds are created on the resource loader's thread too
+intern SDL_SpinLock statsLock;
+intern uint64 decodedBytes;
+
+// bumped when the budget or decoded bytes change; the sound map counts its own changes
+intern uint64 snapshotChanges;
+
+// only what decides the samples' layout; SDL fills in the rest
+bool Audio_Sounds_SpecsMatch(SDL_AudioSpec a, SDL_AudioSpec b)
+{
+	return (a.format == b.format) && (a.channels == b.channels) && (a.freq == b.freq);
+}
+
+intern sound *LoadSound(char *filePath, SDL_RWops *rw)
 {
 	AssertPtr(filePath);
 	
-	LogDebug("loading sound from '%s'", filePath);
+	if(!rw)
+	{
+		LogError("couldn't open sound file at '%s'\n\tSDL error: %s", filePath, SDL_GetError());
+		return NULL;
+	}
 	
 	char *ext = strrchr(filePath, '.');
 	if(ext)
@@ -22,84 +49,240 @@ intern void *AllocSound(char *filePath)
 		LogDebug("sound has extension '%s'", ext);
 		
 		if(strcmp(ext, "wav") == 0)
-		{ return Audio_Sounds_WAV_Load(filePath); }
+		{ return Audio_Sounds_WAV_Load(rw, filePath); }
 		else if(strcmp(ext, "ogg") == 0)
-		{ return Audio_Sounds_OGG_Load(filePath); }
+		{ return Audio_Sounds_OGG_Load(rw, filePath); }
 	
 		LogError("couldn't load sound file at '%s': unrecognized extension ('%s')", filePath, ext);
 	}
 	else
 	{ LogError("couldn't load sound file at '%s': file has no extension", filePath); }
-
+	
+	SDL_RWclose(rw);
 	return NULL;
 }
 
-intern void FreeSound(void *data)
+// compressed samples are decoded into the mixer's per-channel caches, which are sized for the device's frames
+intern bool CanCompress(SDL_AudioSpec spec)
 {
-	if(data)
+	SDL_AudioSpec deviceSpec = Audio_GetSpec();
+	return (spec.format == AUDIO_S16) && (deviceSpec.format == AUDIO_S16) && (spec.channels <= deviceSpec.channels);
+}
+
+intern sound *LoadPackedSound(pack_asset *asset)
+{
+	AssertPtr(asset);
+	
+	pack_entry *e = asset->entry;
+	SDL_AudioSpec spec =
 	{
-		sound *s = (sound*)(data);
-		free(s->data);
-		free(s);
+		.freq = e->info.sound.freq,
+		.format = e->info.sound.format,
+		.channels = e->info.sound.channels
+	};
+	
+	uint32 dataLen = (uint32)(e->dataLen);
+	uint32 decodedLen = dataLen;
+	sound_encoding encoding = (e->info.sound.encoding == SOUND_ENCODING_ADPCM) ? SOUND_ENCODING_ADPCM : SOUND_ENCODING_PCM;
+	
+	if(encoding == SOUND_ENCODING_ADPCM)
+	{
+		// make sure the blocks are all there, so the mixer never reads past them
+		decodedLen = e->info.sound.decodedLen;
+		uint32 frameCount = decodedLen / (sizeof(int16) * max(spec.channels, 1));
+		if(Audio_Sounds_ADPCM_GetEncodedLength(frameCount, spec.channels) > dataLen)
+		{
+			LogError("couldn't load packed sound: its ADPCM data is truncated");
+			Pack_ReleaseAsset(asset->packID);
+			return NULL;
+		}
+	}
+	
+	bool matches = Audio_Sounds_SpecsMatch(spec, Audio_GetSpec());
+	
+	if(Audio_Resampler_GetFrameSize(spec) == 0)
+	{ LogError("couldn't load packed sound: its sample format (%i) isn't supported", spec.format); }
+	else if(encoding == SOUND_ENCODING_ADPCM && !matches && !CanCompress(spec))
+	{ LogError("couldn't load packed sound: its ADPCM samples can't be decoded for the audio device's format"); }
+	else if(encoding == SOUND_ENCODING_PCM && !matches && convertOnLoad)
+	{
+		LogDebug("packed sound doesn't match the audio device's format; converting it");
+		
+		sound *s = Audio_Sounds_CreateSound(asset->data, dataLen, spec);
+		Pack_ReleaseAsset(asset->packID);
+		
+		return s;
 	}
 	else
-	{ LogWarning("couldn't free sound: data pointer is already NULL"); }
+	{
+		// play it straight out of the mapped pack, converting it as it plays if it isn't in the device's format;
+		// the pack stays referenced until the sound is freed
+		sound *s = Memory_Pool_Alloc(&soundPool);
+		if(s)
+		{
+			s->data = asset->data;
+			s->dataLen = decodedLen;
+			s->spec = spec;
+			s->encoding = encoding;
+			s->encodedLen = dataLen;
+			s->packID = asset->packID;
+			
+			SDL_AtomicLock(&statsLock);
+			decodedBytes += s->dataLen;
+			snapshotChanges++;
+			SDL_AtomicUnlock(&statsLock);
+			
+			LogDebug("successfully mapped sound from pack %i", asset->packID);
+			return s;
+		}
+		else
+		{ LogError("couldn't create sound: failed to allocate memory for sound structure"); }
+	}
+	
+	Pack_ReleaseAsset(asset->packID);
+	return NULL;
 }
 
-intern bool ConvertSound(sound *s, SDL_AudioSpec soundSpec, SDL_AudioSpec desiredSpec)
+intern void *AllocSound(char *filePath)
 {
-	AssertPtr(s);
+	AssertPtr(filePath);
 	
-	bool cvtResult;
-
-	SDL_AudioCVT cvt;
-	SDL_BuildAudioCVT(&cvt,
-		soundSpec.format, soundSpec.channels, soundSpec.freq,
-		desiredSpec.format, desiredSpec.channels, desiredSpec.freq);
+	LogDebug("loading sound from '%s'", filePath);
 	
-	if(cvt.needed)
+	pack_asset asset;
+	if(Pack_FindAsset(filePath, &asset))
 	{
-		LogDebug("converting sound");
+		if(asset.entry->type == PACK_ENTRY_SOUND)
+		{ return LoadPackedSound(&asset); }
 		
-		size_t bufferSize = (s->dataLen * cvt.len_mult);
-		uint8 *buffer = malloc(bufferSize * sizeof(uint8));
+		// the original file was packed as-is, so it only saves the open
+		sound *s = LoadSound(filePath, SDL_RWFromConstMem(asset.data, (int)(asset.entry->dataLen)));
+		Pack_ReleaseAsset(asset.packID);
+		
+		return s;
+	}
+	
+	return LoadSound(filePath, SDL_RWFromFile(filePath, "rb"));
+}
 
-		memcpy(buffer, s->data, s->dataLen);
+intern void FreeSound(void *data)
+{
+	if(data)
+	{
+		sound *s = (sound*)(data);
 		
-		cvt.buf = buffer;
-		cvt.len = s->dataLen;
+		SDL_AtomicLock(&statsLock);
+		decodedBytes -= s->dataLen;
+		snapshotChanges++;
+		SDL_AtomicUnlock(&statsLock);
+		
+		if(s->packID > -1)
+		{ Pack_ReleaseAsset(s->packID); }
+		else
+		{ Memory_Free(s->data); }
+		
+		Memory_Pool_Free(&soundPool, s);
+	}
+	else
+	{ LogWarning("couldn't free sound: data pointer is already NULL"); }
+}
 
-		cvtResult = (SDL_ConvertAudio(&cvt) >= 0);
+intern uint64 SoundSize(void *data)
+{
+	return ((sound*)(data))->encodedLen;
+}
 
-		if(cvtResult)
+intern uint8 *ConvertSamples(void *data, uint32 dataLen, SDL_AudioSpec soundSpec, SDL_AudioSpec desiredSpec, uint32 *convertedLen)
+{
+	AssertPtr(data);
+	AssertPtr(convertedLen);
+	
+	LogDebug("converting sound");
+	
+	uint8 *converted = NULL;
+	
+	audio_resampler *r = Audio_Resampler_Create(soundSpec, desiredSpec, RESAMPLER_QUALITY_SINC);
+	if(r)
+	{
+		// convert straight from the source samples into a single allocation, then trim it
+		uint32 bufferLen = Audio_Resampler_GetMaxOutputLength(r, dataLen);
+		converted = Memory_Alloc(MEMORY_TAG_SOUNDS, bufferLen);
+		if(converted)
 		{
-			size_t convertedSize = (size_t)(s->dataLen * cvt.len_ratio);
-			s->data = realloc(s->data, convertedSize);
-			s->dataLen = (uint32)(convertedSize);
-			memcpy(s->data, buffer, convertedSize);
+			uint32 inputUsed;
+			uint32 len = Audio_Resampler_Process(r, data, dataLen, &inputUsed, converted, bufferLen);
+			len += Audio_Resampler_Flush(r, converted + len, bufferLen - len);
+			
+			if(inputUsed < dataLen)
+			{ LogWarning("sound conversion ran out of room: %u of %u bytes converted", inputUsed, dataLen); }
+			
+			uint8 *trimmed = Memory_Realloc(MEMORY_TAG_SOUNDS, converted, max(len, 1));
+			if(trimmed)
+			{ converted = trimmed; }
 			
+			*convertedLen = len;
 			LogDebug("successfully converted sound");
 		}
 		else
-		{ LogError("couldn't convert sound\n\tSDL error: %s", SDL_GetError()); }
-
-		free(buffer);
+		{ LogError("couldn't convert sound: failed to allocate memory for converted samples"); }
+		
+		Audio_Resampler_Free(r);
 	}
+	
+	return converted;
+}
 
-	return (!cvt.needed || cvtResult);
+intern uint8 *CompressSamples(uint8 *pcm, uint32 pcmLen, int channels, uint32 *compressedLen)
+{
+	AssertPtr(pcm);
+	AssertPtr(compressedLen);
+	
+	uint32 frameCount = pcmLen / (sizeof(int16) * channels);
+	uint32 len = Audio_Sounds_ADPCM_GetEncodedLength(frameCount, channels);
+	
+	uint8 *compressed = Memory_Alloc(MEMORY_TAG_SOUNDS, max(len, 1));
+	if(compressed)
+	{
+		Audio_Sounds_ADPCM_Encode((int16*)(pcm), frameCount, channels, compressed);
+		*compressedLen = len;
+	}
+	else
+	{ LogError("couldn't compress sound: failed to allocate memory for compressed samples"); }
+	
+	return compressed;
 }
 
 bool Audio_Sounds_Init(struct audio_sounds_config config)
 {
 	AssertSign(config.maxSounds);
 	
-	sounds = ResourceMap_Create(config.maxSounds, &AllocSound, &FreeSound);
+	// every loaded sound holds one slot in the map, so the pool only overflows while a slot's sound is being replaced
+	if(!Memory_Pool_Init(&soundPool, MEMORY_TAG_SOUNDS, sizeof(sound), config.maxSounds))
+	{ return false; }
+	
+	sounds = ResourceMap_Create(config.maxSounds, &AllocSound, &FreeSound, &SoundSize);
 	if(sounds)
 	{
 		maxSounds = config.maxSounds;
+		
+		// ADPCM only encodes 16-bit samples
+		compressSounds = config.compressSounds;
+		if(compressSounds && Audio_GetSpec().format != AUDIO_S16)
+		{
+			LogWarning("sound compression needs an S16 audio device; sounds will be kept uncompressed");
+			compressSounds = false;
+		}
+		
+		convertOnLoad = config.convertOnLoad;
+		
+		budgetBytes = 0;
+		decodedBytes = 0;
+		snapshotChanges++;
+		
 		return true;
 	}
 	
+	Memory_Pool_Release(&soundPool);
 	return false;
 }
 
@@ -108,40 +291,87 @@ void Audio_Sounds_Quit()
 	ResourceMap_Free(sounds);
 	sounds = NULL;
 	
+	Memory_Pool_Release(&soundPool);
+	
 	maxSounds = 0;
+	compressSounds = false;
+	convertOnLoad = false;
 }
 
 sound *Audio_Sounds_CreateSound(void *data, uint32 dataLen, SDL_AudioSpec spec)
 {
 	AssertPtr(data);
 	
-	sound *s = malloc(sizeof(sound));
+	if(Audio_Resampler_GetFrameSize(spec) == 0)
+	{
+		LogError("couldn't create sound: its sample format (%i) isn't supported", spec.format);
+		return NULL;
+	}
+	
+	sound *s = Memory_Pool_Alloc(&soundPool);
 	if(s)
 	{
-		s->data = malloc(dataLen);
+		SDL_AudioSpec deviceSpec = Audio_GetSpec();
+		
+		uint8 *pcm = data;
+		uint32 pcmLen = dataLen;
+		uint8 *converted = NULL;
+		
+		// otherwise, the samples are kept in their own format, and converted by the mixer as they play
+		if(convertOnLoad && !Audio_Sounds_SpecsMatch(spec, deviceSpec))
+		{
+			pcm = converted = ConvertSamples(data, dataLen, spec, deviceSpec, &pcmLen);
+			spec = deviceSpec;
+		}
+		
+		s->data = NULL;
+		s->packID = -1;
+		s->dataLen = pcmLen;
+		s->spec = spec;
+		s->encodedLen = pcmLen;
+		s->encoding = SOUND_ENCODING_PCM;
+		
+		if(pcm && compressSounds && CanCompress(spec))
+		{
+			// compress straight from the samples; they're not kept around
+			s->data = CompressSamples(pcm, pcmLen, spec.channels, &s->encodedLen);
+			s->encoding = SOUND_ENCODING_ADPCM;
+			
+			Memory_Free(converted);
+		}
+		else if(converted)
+		{ s->data = converted; }
+		else if(pcm)
+		{
+			s->data = Memory_Alloc(MEMORY_TAG_SOUNDS, pcmLen);
+			if(s->data)
+			{ memcpy(s->data, pcm, pcmLen); }
+		}
+		
 		if(s->data)
 		{
-			s->dataLen = dataLen;
-			memcpy(s->data, data, dataLen);
+			SDL_AtomicLock(&statsLock);
+			decodedBytes += s->dataLen;
+			snapshotChanges++;
+			SDL_AtomicUnlock(&statsLock);
 			
-			if(!ConvertSound(s, spec, Audio_GetSpec()))
-			{
-				LogError("couldn't create sound: failed to convert to desired format");
-				
-				free(s->data);
-				free(s);
-			}
+			LogDebug("successfully created sound");
 		}
 		else
-		{ LogError("couldn't create sound: failed to allocate memory for sound samples"); }
+		{
+			LogError("couldn't create sound: failed to prepare its samples");
+			
+			Memory_Pool_Free(&soundPool, s);
+			s = NULL;
+		}
 	}
 	else
 	{ LogError("couldn't create sound: failed to allocate memory for sound structure"); }
 	
-	LogDebug("successfully created sound");
 	return s;
 }
 
+// NULL while a requested sound is still loading, or if it failed to
 sound *Audio_Sounds_GetSound(int soundID)
 {
 	AssertSound(soundID);
@@ -158,6 +388,14 @@ HEXPORT(int) Audio_Sounds_LoadSound(char *filePath)
 	return ResourceMap_AllocResource(sounds, filePath);
 }
 
+HEXPORT(int) Audio_Sounds_RequestSound(char *filePath)
+{
+	AssertPtr(filePath);
+	AssertPtr(sounds);
+	
+	return ResourceMap_RequestResource(sounds, filePath);
+}
+
 HEXPORT(void) Audio_Sounds_FreeSound(int soundID)
 {
 	AssertPtr(sounds);
@@ -184,15 +422,50 @@ HEXPORT(bool) Audio_Sounds_CheckSound(int soundID)
 	return true;
 }
 
-struct audio_sounds_state Audio_Sounds_GetSnapshot()
+bool Audio_Sounds_IsLoading(int soundID)
 {
+	AssertSound(soundID);
 	AssertPtr(sounds);
 	
-	struct audio_sounds_state state =
-	{
-		.maxSounds = maxSounds,
-		.soundCount = ResourceMap_GetResourceCount(sounds)
-	};
+	return ResourceMap_GetStatus(sounds, soundID) == RESOURCE_STATUS_LOADING;
+}
+
+HEXPORT(uint64) Audio_Sounds_GetSoundSize(int soundID)
+{
+	AssertSound(soundID);
+	AssertPtr(sounds);
+	
+	return ResourceMap_GetResourceSize(sounds, soundID);
+}
+
+HEXPORT(void) Audio_Sounds_SetBudget(uint64 bytes)
+{
+	budgetBytes = bytes;
+	
+	SDL_AtomicLock(&statsLock);
+	snapshotChanges++;
+	SDL_AtomicUnlock(&statsLock);
+}
+
+uint64 Audio_Sounds_GetChanges()
+{
+	AssertPtr(sounds);
+	
+	SDL_AtomicLock(&statsLock);
+	uint64 changes = snapshotChanges;
+	SDL_AtomicUnlock(&statsLock);
+	
+	return changes + ResourceMap_GetChanges(sounds);
+}
+
+void Audio_Sounds_GetSnapshot(struct audio_sounds_state *state)
+{
+	AssertPtr(sounds);
 	
-	return state;
+	state->maxSounds = maxSounds;
+	state->soundCount = ResourceMap_GetResourceCount(sounds);
+	state->pendingCount = ResourceMap_GetPendingCount(sounds);
+	state->residentBytes = ResourceMap_GetResidentBytes(sounds);
+	state->decodedBytes = decodedBytes;
+	state->budgetBytes = budgetBytes;
 }
\ No newline at end of file
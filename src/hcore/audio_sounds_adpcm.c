@@ -0,0 +1,149 @@
+#include "audio.h"
+
+#define HEADER_SIZE 4
+#define NIBBLES_SIZE (AUDIO_SOUNDS_ADPCM_BLOCK_FRAMES / 2)
+
+intern const int8 indexTable[16] =
+{
+	-1, -1, -1, -1, 2, 4, 6, 8,
+	-1, -1, -1, -1, 2, 4, 6, 8
+};
+
+intern const int16 stepTable[89] =
+{
+	7, 8, 9, 10, 11, 12, 13, 14, 16, 17,
+	19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+	50, 55, 60, 66, 73, 80, 88, 97, 107, 118,
+	130, 143, 157, 173, 190, 209, 230, 253, 279, 307,
+	337, 371, 408, 449, 494, 544, 598, 658, 724, 796,
+	876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066,
+	2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871, 5358,
+	5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899,
+	15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+};
+
+typedef struct
+{
+	int predictor;
+	int index;
+} adpcm_state;
+
+HINLINE int16 DecodeNibble(adpcm_state *state, uint8 nibble)
+{
+	int step = stepTable[state->index];
+	int diff = step >> 3;
+
+	if(nibble & 4)
+	{ diff += step; }
+	if(nibble & 2)
+	{ diff += step >> 1; }
+	if(nibble & 1)
+	{ diff += step >> 2; }
+
+	state->predictor += (nibble & 8) ? -diff : diff;
+	state->predictor = Clamp(state->predictor, SHRT_MIN, SHRT_MAX);
+	state->index = Clamp(state->index + indexTable[nibble], 0, 88);
+
+	return (int16)(state->predictor);
+}
+
+intern uint8 EncodeSample(adpcm_state *state, int16 sample)
+{
+	int step = stepTable[state->index];
+	int diff = sample - state->predictor;
+	uint8 nibble = 0;
+
+	if(diff < 0)
+	{
+		nibble = 8;
+		diff = -diff;
+	}
+
+	// quantize the difference to 3 bits of the current step size
+	if(diff >= step)
+	{
+		nibble |= 4;
+		diff -= step;
+	}
+
+	if(diff >= (step >> 1))
+	{
+		nibble |= 2;
+		diff -= (step >> 1);
+	}
+
+	if(diff >= (step >> 2))
+	{ nibble |= 1; }
+
+	// then track exactly what the decoder will reconstruct, so errors don't accumulate
+	DecodeNibble(state, nibble);
+	return nibble;
+}
+
+uint32 Audio_Sounds_ADPCM_GetEncodedLength(uint32 frameCount, int channels)
+{
+	uint32 blockCount = (frameCount + AUDIO_SOUNDS_ADPCM_BLOCK_FRAMES - 1) / AUDIO_SOUNDS_ADPCM_BLOCK_FRAMES;
+	return blockCount * AUDIO_SOUNDS_ADPCM_BLOCK_SIZE(channels);
+}
+
+void Audio_Sounds_ADPCM_Encode(int16 *samples, uint32 frameCount, int channels, uint8 *dest)
+{
+	AssertPtr(samples);
+	AssertPtr(dest);
+
+	adpcm_state states[UCHAR_MAX] = { 0 };
+	uint32 blockSize = AUDIO_SOUNDS_ADPCM_BLOCK_SIZE(channels);
+
+	for(uint32 start = 0; start < frameCount; start += AUDIO_SOUNDS_ADPCM_BLOCK_FRAMES)
+	{
+		uint8 *block = dest + ((start / AUDIO_SOUNDS_ADPCM_BLOCK_FRAMES) * blockSize);
+		uint32 frames = min(frameCount - start, AUDIO_SOUNDS_ADPCM_BLOCK_FRAMES);
+
+		memset(block, 0, blockSize);
+
+		for(int c = 0; c < channels; c++)
+		{
+			adpcm_state *state = &states[c];
+
+			// each block restarts from its first sample, so blocks can be decoded on their own
+			state->predictor = samples[(start * channels) + c];
+
+			uint8 *header = block + (c * HEADER_SIZE);
+			*(int16*)(header) = (int16)(state->predictor);
+			header[2] = (uint8)(state->index);
+
+			uint8 *nibbles = block + (channels * HEADER_SIZE) + (c * NIBBLES_SIZE);
+			for(uint32 f = 0; f < frames; f++)
+			{
+				uint8 nibble = EncodeSample(state, samples[((start + f) * channels) + c]);
+				nibbles[f / 2] |= (f & 1) ? (uint8)(nibble << 4) : nibble;
+			}
+		}
+	}
+}
+
+void Audio_Sounds_ADPCM_DecodeBlock(uint8 *data, uint32 blockIndex, uint32 frameCount, int channels, int16 *dest)
+{
+	AssertPtr(data);
+	AssertPtr(dest);
+
+	uint8 *block = data + (blockIndex * AUDIO_SOUNDS_ADPCM_BLOCK_SIZE(channels));
+	uint32 frames = min(frameCount - (blockIndex * AUDIO_SOUNDS_ADPCM_BLOCK_FRAMES), AUDIO_SOUNDS_ADPCM_BLOCK_FRAMES);
+
+	for(int c = 0; c < channels; c++)
+	{
+		uint8 *header = block + (c * HEADER_SIZE);
+		adpcm_state state =
+		{
+			.predictor = *(int16*)(header),
+			.index = min(header[2], 88)
+		};
+
+		uint8 *nibbles = block + (channels * HEADER_SIZE) + (c * NIBBLES_SIZE);
+		for(uint32 f = 0; f < frames; f++)
+		{
+			uint8 nibble = (f & 1) ? (nibbles[f / 2] >> 4) : (nibbles[f / 2] & 0x0F);
+			dest[(f * channels) + c] = DecodeNibble(&state, nibble);
+		}
+	}
+}
\ No newline at end of file
@@ -3,12 +3,45 @@
 
 extern sound *Audio_Sounds_CreateSound(void *data, uint32 dataLen, SDL_AudioSpec spec);
 
-sound *Audio_Sounds_OGG_Load(char *filePath)
+// vorbisfile reads through these, so ogg data can come from files and packs alike
+intern size_t ReadRW(void *ptr, size_t size, size_t count, void *rw)
 {
+	return SDL_RWread(rw, ptr, size, count);
+}
+
+intern int SeekRW(void *rw, ogg_int64_t offset, int whence)
+{
+	return (SDL_RWseek(rw, offset, whence) < 0) ? -1 : 0;
+}
+
+intern int CloseRW(void *rw)
+{
+	return SDL_RWclose(rw);
+}
+
+intern long TellRW(void *rw)
+{
+	return (long)(SDL_RWtell(rw));
+}
+
+sound *Audio_Sounds_OGG_Load(SDL_RWops *rw, char *name)
+{
+	AssertPtr(rw);
+	AssertPtr(name);
+	
 	sound *s = NULL;
 
+	ov_callbacks callbacks =
+	{
+		.read_func = &ReadRW,
+		.seek_func = &SeekRW,
+		.close_func = &CloseRW,
+		.tell_func = &TellRW
+	};
+
+	// once opened, the stream is closed along with the file
 	OggVorbis_File file;
-	if(ov_fopen(filePath, &file) >= 0)
+	if(ov_open_callbacks(rw, &file, NULL, 0, callbacks) >= 0)
 	{
 		uint32 sampleCount = (uint32)(ov_pcm_total(&file, -1));
 		uint32 sampleRate = (uint32)(file.vi->rate);
@@ -16,7 +49,7 @@ sound *Audio_Sounds_OGG_Load(char *filePath)
 		
 		// bytes = samples * channels * 2-byte sample size
 		uint32 dataLen = sampleCount * channels * 2;
-		uint8 *data = malloc(dataLen * sizeof(uint8));
+		uint8 *data = Memory_Alloc(MEMORY_TAG_SOUNDS, dataLen * sizeof(uint8));
 		
 		char buffer[4096];
 		int bitstream = -1;
@@ -47,12 +80,15 @@ sound *Audio_Sounds_OGG_Load(char *filePath)
 			s = Audio_Sounds_CreateSound(data, dataLen, soundSpec);
 		}
 		else
-		{ LogError("couldn't read ogg data"); }
+		{ LogError("couldn't read ogg data from '%s'", name); }
 
-		free(data);
+		Memory_Free(data);
 	}
 	else
-	{ LogError("couldn't load ogg file"); }
+	{
+		LogError("couldn't load ogg file at '%s'", name);
+		SDL_RWclose(rw);
+	}
 	
 	return s;
 }
\ No newline at end of file
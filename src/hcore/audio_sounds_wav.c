@@ -3,17 +3,19 @@
 extern SDL_AudioSpec Audio_GetSpec();
 extern sound *Audio_Sounds_CreateSound(void *data, uint32 dataLen, SDL_AudioSpec spec);
 
-sound *Audio_Sounds_WAV_Load(char *filePath)
+sound *Audio_Sounds_WAV_Load(SDL_RWops *rw, char *name)
 {
-	AssertPtr(filePath);
+	AssertPtr(rw);
+	AssertPtr(name);
 	
 	uint8 *data;
 	uint32 dataLen;
 	SDL_AudioSpec wavSpec = Audio_GetSpec();
 	
-	if(SDL_LoadWAV(filePath, &wavSpec, &data, &dataLen))
+	// SDL closes the stream for us, whether or not this succeeds
+	if(SDL_LoadWAV_RW(rw, 1, &wavSpec, &data, &dataLen))
 	{
-		LogDebug("successfully loaded data from wav file '%s'", filePath);
+		LogDebug("successfully loaded data from wav file '%s'", name);
 		
 		sound *s = Audio_Sounds_CreateSound(data, dataLen, wavSpec);
 		SDL_FreeWAV(data);
@@ -21,7 +23,7 @@ sound *Audio_Sounds_WAV_Load(char *filePath)
 		return s;
 	}
 	else
-	{ LogError("couldn't load WAV file at '%s'\n\tSDL error: %s", filePath, SDL_GetError()); }
+	{ LogError("couldn't load WAV file at '%s'\n\tSDL error: %s", name, SDL_GetError()); }
 
 	return NULL;
 }
\ No newline at end of file
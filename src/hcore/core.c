@@ -1,4 +1,5 @@
 #include "core.h"
+#include "resource_map.h"
 
 extern bool Core_Events_Init(struct core_events_config config);
 extern void Core_Events_Quit();
@@ -7,7 +8,9 @@ HEXPORT(bool) Core_Init(core_config config)
 {
 	if(SDL_Init(0) >= 0)
 	{
-		if(Log_Init(config.log) && Core_Events_Init(config.events) && Video_Init() && Audio_Init(config.audio))
+		Time_Profiler_SetThreadName("main");
+
+		if(Log_Init(config.log) && Core_Events_Init(config.events) && ResourceLoader_Init() && Video_Init(config.video) && Audio_Init(config.audio))
 		{
 			LogNote("core successfully initialized");
 			return true;
@@ -21,9 +24,13 @@ HEXPORT(bool) Core_Init(core_config config)
 
 HEXPORT(void) Core_Quit()
 {
+	ResourceLoader_Quit();
 	Audio_Quit();
 	Video_Quit();
+	Pack_Quit();
 	Core_Events_Quit();
+	Time_Profiler_Quit();
+	Memory_Quit();
 	Log_Quit();
 
 	SDL_Quit();
@@ -3,6 +3,7 @@
 #include "_shared.h"
 #include "audio.h"
 #include "input.h"
+#include "pack.h"
 #include "time.h"
 #include "video.h"
 
@@ -44,6 +45,7 @@ typedef struct
 	} events;
 
 	audio_config audio;
+	video_config video;
 } core_config;
 
 HEXPORT(bool) Core_Init(core_config config);
@@ -1,4 +1,5 @@
 #include "core.h"
+#include "resource_map.h"
 
 extern bool Core_Events_Log_Init(event_log_mode mode);
 extern void Core_Events_Log_Quit();
@@ -37,6 +38,11 @@ intern void HandleEvent(SDL_Event *ev)
 		case SDL_WINDOWEVENT:
 			Video_Windows_Event(&ev->window);
 			break;
+		case SDL_RENDER_TARGETS_RESET:
+		case SDL_RENDER_DEVICE_RESET:
+			Video_Targets_Event(ev);
+			Video_Tilemaps_Event(ev);
+			break;
 		case SDL_QUIT:
 			quitRequested = true;
 			break;
@@ -69,7 +75,11 @@ void Core_Events_Quit()
 
 HEXPORT(void) Core_Events_Pump()
 {
+	ProfileBegin("Core_Events_Pump");
+	uint64 statStart = SDL_GetPerformanceCounter();
+
 	SDL_Event ev;
+	Input_NewFrame();
 
 	while(Core_Events_Log_PollEvent(&ev, Time_GetTicks()))
 	{ SDL_PushEvent(&ev); }
@@ -79,6 +89,12 @@ HEXPORT(void) Core_Events_Pump()
 		Core_Events_Log_LogEvent(&ev);
 		HandleEvent(&ev);
 	}
+
+	// resources finished loading in the background become usable once per frame, here
+	ResourceLoader_Pump();
+
+	Time_AddFrameTime(FRAME_STAT_EVENTS, statStart);
+	ProfileEnd();
 }
 
 HEXPORT(bool) Core_Events_IsQuitRequested()
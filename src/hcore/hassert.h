@@ -4,8 +4,9 @@
 
 #ifdef NDEBUG
 
-#define Assert(cond, msg) noop
-#define AssertPtr(prt) noop
+#define Assert(cond, msg, ...) noop
+#define AssertPtr(ptr) noop
+#define AssertSign(n) noop
 #define AssertIndex(i, len) noop
 #define AssertCount(i, ct) noop
 
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "_shared.h"
+
+// - - - - - -
+// tagged allocation
+// - - - - - -
+
+typedef enum
+{
+	MEMORY_TAG_CORE,
+	MEMORY_TAG_AUDIO,		// device buffers, mixer state and resamplers
+	MEMORY_TAG_SOUNDS,		// sound structures and samples
+	MEMORY_TAG_VIDEO,
+	MEMORY_TAG_RESOURCES,	// resource map slots and paths
+	MEMORY_TAG_MAX
+} memory_tag;
+
+typedef struct
+{
+	struct memory_tag_state
+	{
+		uint64 liveBytes;
+		uint64 peakBytes;
+		uint64 liveCount;
+		uint64 totalCount;
+		uint64 scratchPeakBytes;	// the most any of the tag's arenas held between resets
+	} tags[MEMORY_TAG_MAX];
+} memory_state;
+
+void Memory_Quit();
+
+// tagged allocations carry a small header, so they must be freed through Memory_Free
+void *Memory_Alloc(memory_tag tag, size_t size);
+void *Memory_Calloc(memory_tag tag, size_t count, size_t size);
+void *Memory_Realloc(memory_tag tag, void *ptr, size_t size);
+void Memory_Free(void *ptr);
+
+void Memory_ResetPeaks();	// peaks start again from what's live, so one workload's can be measured
+
+HEXPORT(void) Core_GetMemorySnapshot(memory_state *state);
+
+// - - - - - -
+// arenas
+// - - - - - -
+
+// linear scratch space, for allocations that only live until the next reset
+typedef struct
+{
+	memory_tag tag;
+	uint8 *base;
+	size_t capacity;
+	size_t used;
+	size_t peak;
+} memory_arena;
+
+bool Memory_Arena_Init(memory_arena *arena, memory_tag tag, size_t capacity);
+void Memory_Arena_Release(memory_arena *arena);
+
+void *Memory_Arena_Push(memory_arena *arena, size_t size);
+void Memory_Arena_Reset(memory_arena *arena);
+
+// marks let a caller hand back everything it pushed, without resetting the whole arena
+HINLINE size_t Memory_Arena_GetMark(memory_arena *arena) { return arena->used; }
+HINLINE void Memory_Arena_PopTo(memory_arena *arena, size_t mark) { arena->used = min(mark, arena->used); }
+
+// - - - - - -
+// pools
+// - - - - - -
+
+// fixed-size blocks; safe to use from the resource loader's thread
+typedef struct
+{
+	memory_tag tag;
+	size_t blockSize;
+	int capacity;
+	uint8 *blocks;
+	void *freeList;
+	int usedCount;
+	SDL_SpinLock lock;
+} memory_pool;
+
+bool Memory_Pool_Init(memory_pool *pool, memory_tag tag, size_t blockSize, int capacity);
+void Memory_Pool_Release(memory_pool *pool);
+
+// a full pool falls back to a tagged allocation, so callers never have to handle it
+void *Memory_Pool_Alloc(memory_pool *pool);
+void Memory_Pool_Free(memory_pool *pool, void *block);
\ No newline at end of file
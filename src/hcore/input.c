@@ -1,7 +1,19 @@
 #include "input.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define INPUT_SSE2
+#include <emmintrin.h>
+#endif
+
 intern SDL_GameController *controllers[INPUT_CONTROLLERS_MAX];
 intern input_state currentState;
+intern input_events frameEvents;
+
+intern input_state frameStartState;
+intern input_edges frameEdges;
+
+intern input_state deltaBase;	// as of the last delta
+intern input_state_delta delta;
 
 intern void OpenController(int index)
 {
@@ -14,6 +26,28 @@ intern void OpenController(int index)
 	{ LogError("couldn't open controller %i\n\tSDL error: %s", SDL_GetError()); }
 }
 
+intern void AddEvent(uint32 timestamp, input_event_type type, int device, int code, int value)
+{
+	if(frameEvents.count < INPUT_EVENTS_MAX)
+	{
+		frameEvents.events[frameEvents.count++] = (input_event)
+		{
+			.timestamp = timestamp,
+			.type = (uint8)(type),
+			.device = (uint8)(device),
+			.code = (uint16)(code),
+			.value = value
+		};
+	}
+	else
+	{
+		if(frameEvents.overflowCount == 0)
+		{ LogWarning("input event timeline is full (%i events); dropping the rest of frame %u's events", INPUT_EVENTS_MAX, frameEvents.frame); }
+
+		frameEvents.overflowCount++;
+	}
+}
+
 intern void CloseController(int index)
 {
 	AssertIndex(index, INPUT_CONTROLLERS_MAX);
@@ -43,6 +77,7 @@ void Input_Quit()
 	{ CloseController(i); }
 
 	memset(&currentState, 0, sizeof(input_state));
+	memset(&frameEvents, 0, sizeof(input_events));
 	SDL_QuitSubSystem(SDL_INIT_GAMECONTROLLER);
 }
 
@@ -50,16 +85,12 @@ void Input_KeyEvent(SDL_KeyboardEvent *ev)
 {
 	AssertPtr(ev);
 
-	bool *key = &currentState.keyboard[ev->keysym.scancode];
-	switch(ev->type)
-	{
-		case SDL_KEYDOWN:
-			*key = true;
-			break;
-		case SDL_KEYUP:
-			*key = false;
-			break;
-	}
+	bool down = (ev->type == SDL_KEYDOWN);
+	Input_SetKey(&currentState, ev->keysym.scancode, down);
+
+	// held keys repeat, but they don't transition
+	if(!ev->repeat)
+	{ AddEvent(ev->timestamp, INPUT_EVENT_KEY, 0, ev->keysym.scancode, down); }
 }
 
 void Input_MButtonEvent(SDL_MouseButtonEvent *ev)
@@ -68,17 +99,16 @@ void Input_MButtonEvent(SDL_MouseButtonEvent *ev)
 
 	// stealthily align SDL macros to our mbutton enum
 	uint8 buttonID = ev->button - 1;
-	bool *button = &currentState.mouse.buttons[buttonID];
+	if(buttonID >= MBUTTON_COUNT)
+	{ return; }
 
-	switch(ev->type)
-	{
-		case SDL_MOUSEBUTTONDOWN:
-			*button = true;
-			break;
-		case SDL_MOUSEBUTTONUP:
-			*button = false;
-			break;
-	}
+	bool down = (ev->type == SDL_MOUSEBUTTONDOWN);
+	if(down)
+	{ FlagSet(currentState.mouse.buttons, 1u << buttonID); }
+	else
+	{ FlagClear(currentState.mouse.buttons, 1u << buttonID); }
+
+	AddEvent(ev->timestamp, INPUT_EVENT_MBUTTON, 0, buttonID, down);
 }
 
 void Input_CButtonEvent(SDL_ControllerButtonEvent *ev)
@@ -87,16 +117,16 @@ void Input_CButtonEvent(SDL_ControllerButtonEvent *ev)
 	AssertIndex(ev->which, INPUT_CONTROLLERS_MAX);
 	AssertPtr(controllers[ev->which]);
 
-	bool *button = &currentState.controllers[ev->which].buttons[ev->button];
-	switch(ev->type)
-	{
-		case SDL_CONTROLLERBUTTONDOWN:
-			*button = true;
-			break;
-		case SDL_CONTROLLERBUTTONUP:
-			*button = false;
-			break;
-	}
+	AssertIndex(ev->button, CBUTTON_COUNT);
+
+	uint32 *buttons = &currentState.controllers[ev->which].buttons;
+	bool down = (ev->type == SDL_CONTROLLERBUTTONDOWN);
+	if(down)
+	{ FlagSet(*buttons, 1u << ev->button); }
+	else
+	{ FlagClear(*buttons, 1u << ev->button); }
+
+	AddEvent(ev->timestamp, INPUT_EVENT_CBUTTON, ev->which, ev->button, down);
 }
 
 void Input_AxisEvent(SDL_ControllerAxisEvent *ev)
@@ -107,6 +137,8 @@ void Input_AxisEvent(SDL_ControllerAxisEvent *ev)
 
 	short *axis = &currentState.controllers[ev->which].axes[ev->axis];
 	*axis = ev->value;
+
+	AddEvent(ev->timestamp, INPUT_EVENT_AXIS, ev->which, ev->axis, ev->value);
 }
 
 void Input_JoystickOpenEvent(SDL_JoyDeviceEvent *ev)
@@ -125,7 +157,95 @@ void Input_JoystickCloseEvent(SDL_JoyDeviceEvent *ev)
 	{ CloseController(ev->which); }
 }
 
+void Input_GetEdges(input_state *previous, input_state *current, input_edges *edges)
+{
+	AssertPtr(previous);
+	AssertPtr(current);
+	AssertPtr(edges);
+
+	// pressed is now & ~before, released is before & ~now
+#ifdef INPUT_SSE2
+	for(int i = 0; i < INPUT_KEY_WORDS; i += 2)
+	{
+		__m128i before = _mm_loadu_si128((__m128i*)(&previous->keyboard[i]));
+		__m128i now = _mm_loadu_si128((__m128i*)(&current->keyboard[i]));
+		_mm_storeu_si128((__m128i*)(&edges->keysPressed[i]), _mm_andnot_si128(before, now));
+		_mm_storeu_si128((__m128i*)(&edges->keysReleased[i]), _mm_andnot_si128(now, before));
+	}
+#else
+	for(int i = 0; i < INPUT_KEY_WORDS; i++)
+	{
+		edges->keysPressed[i] = current->keyboard[i] & ~previous->keyboard[i];
+		edges->keysReleased[i] = previous->keyboard[i] & ~current->keyboard[i];
+	}
+#endif
+
+	edges->mousePressed = current->mouse.buttons & ~previous->mouse.buttons;
+	edges->mouseReleased = previous->mouse.buttons & ~current->mouse.buttons;
+
+	for(int i = 0; i < INPUT_CONTROLLERS_MAX; i++)
+	{
+		edges->controllersPressed[i] = current->controllers[i].buttons & ~previous->controllers[i].buttons;
+		edges->controllersReleased[i] = previous->controllers[i].buttons & ~current->controllers[i].buttons;
+	}
+}
+
+void Input_NewFrame()
+{
+	frameStartState = currentState;
+
+	frameEvents.frame++;
+	frameEvents.count = 0;
+	frameEvents.overflowCount = 0;
+}
+
+HEXPORT(input_events*) Input_GetEvents()
+{
+	return &frameEvents;
+}
+
 HEXPORT(void) Input_GetSnapshot(input_state *state)
 {
 	*state = currentState;
+}
+
+HEXPORT(input_edges*) Input_GetFrameEdges()
+{
+	Input_GetEdges(&frameStartState, &currentState, &frameEdges);
+	return &frameEdges;
+}
+
+HEXPORT(input_state_delta*) Input_GetSnapshotDelta()
+{
+	uint32 *base = (uint32*)(&deltaBase);
+	uint32 *now = (uint32*)(&currentState);
+
+	delta.changedMask = 0;
+	delta.changedCount = 0;
+	delta.wordsOffset = (int)(offsetof(input_state_delta, words));
+
+	// find the changed words 4 at a time, then pack just those
+	int w = 0;
+#ifdef INPUT_SSE2
+	for(; w + 4 <= (int)(INPUT_STATE_WORDS); w += 4)
+	{
+		__m128i same = _mm_cmpeq_epi32(_mm_loadu_si128((__m128i*)(&base[w])), _mm_loadu_si128((__m128i*)(&now[w])));
+		uint64 changed = (uint64)(~_mm_movemask_ps(_mm_castsi128_ps(same)) & 0xF);
+		delta.changedMask |= changed << w;
+	}
+#endif
+	for(; w < (int)(INPUT_STATE_WORDS); w++)
+	{
+		if(base[w] != now[w])
+		{ delta.changedMask |= 1ull << w; }
+	}
+
+	for(w = 0; w < (int)(INPUT_STATE_WORDS); w++)
+	{
+		if(delta.changedMask & (1ull << w))
+		{ delta.words[delta.changedCount++] = now[w]; }
+	}
+
+	deltaBase = currentState;
+	return &delta;
 }
\ No newline at end of file
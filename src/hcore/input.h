@@ -329,25 +329,117 @@ void Input_AxisEvent(SDL_ControllerAxisEvent *ev);
 void Input_JoystickOpenEvent(SDL_JoyDeviceEvent *ev);
 void Input_JoystickCloseEvent(SDL_JoyDeviceEvent *ev);
 
+// - - - - - -
+// event timeline
+// - - - - - -
+
+// every transition within a frame, in order, so presses shorter than a frame aren't lost
+#define INPUT_EVENTS_MAX 256
+
+typedef enum
+{
+	INPUT_EVENT_KEY,
+	INPUT_EVENT_MBUTTON,
+	INPUT_EVENT_CBUTTON,
+	INPUT_EVENT_AXIS
+} input_event_type;
+
+typedef struct
+{
+	uint32 timestamp;	// SDL ticks (ms) of when the event was queued
+	uint8 type;			// an input_event_type
+	uint8 device;		// the controller; 0 for the keyboard and mouse
+	uint16 code;		// the key, button, or axis
+	int32 value;		// 1 or 0 for buttons; the new position for axes
+} input_event;
+
+typedef struct
+{
+	uint32 frame;
+	int count;
+	int overflowCount;	// events dropped this frame, after the buffer filled up
+	input_event events[INPUT_EVENTS_MAX];
+} input_events;
+
+// starts a new frame's timeline; called before the frame's events are handled
+void Input_NewFrame();
+
+// the current frame's events; stays valid until the next frame starts
+HEXPORT(input_events*) Input_GetEvents();
+
 // - - - - - -
 // state snapshot
 // - - - - - -
 
+// buttons are packed a bit each, so the state is a few words that can be compared wholesale;
+// the layout is mirrored in heng, word for word:
+//	0-15 keyboard | 16 mouse x | 17 mouse y | 18 mouse buttons | 19-34 controllers (4 words each) | 35 padding
+#define INPUT_KEY_WORDS 8	// a 512-bit set, which fits every SDL scancode
+
 typedef struct
 {
-	bool keyboard[KEY_COUNT];
+	uint64 keyboard[INPUT_KEY_WORDS];	// a bit per input_key
 
 	struct mouse_state
 	{
 		int x, y;
-		bool buttons[MBUTTON_COUNT];
+		uint32 buttons;	// a bit per input_mbutton
 	} mouse;
 
 	struct controller_state
 	{
-		bool buttons[CBUTTON_COUNT];
+		uint32 buttons;	// a bit per input_cbutton
 		int16 axes[AXIS_COUNT];
 	} controllers[INPUT_CONTROLLERS_MAX];
 } input_state;
 
-HEXPORT(void) Input_GetSnapshot(input_state *state);
\ No newline at end of file
+#define INPUT_STATE_WORDS (sizeof(input_state) / sizeof(uint32))
+
+HINLINE bool Input_TestKey(input_state *state, int key)
+{
+	return (key >= 0 && key < INPUT_KEY_WORDS * 64) && (state->keyboard[key >> 6] & (1ull << (key & 63))) != 0;
+}
+
+HINLINE void Input_SetKey(input_state *state, int key, bool down)
+{
+	if(key >= 0 && key < INPUT_KEY_WORDS * 64)
+	{
+		if(down)
+		{ FlagSet(state->keyboard[key >> 6], 1ull << (key & 63)); }
+		else
+		{ FlagClear(state->keyboard[key >> 6], 1ull << (key & 63)); }
+	}
+}
+
+HEXPORT(void) Input_GetSnapshot(input_state *state);
+
+// - - - - - -
+// edges and deltas
+// - - - - - -
+
+// what went down and up between the start of the frame and now
+typedef struct
+{
+	uint64 keysPressed[INPUT_KEY_WORDS];
+	uint64 keysReleased[INPUT_KEY_WORDS];
+	uint32 mousePressed;
+	uint32 mouseReleased;
+	uint32 controllersPressed[INPUT_CONTROLLERS_MAX];
+	uint32 controllersReleased[INPUT_CONTROLLERS_MAX];
+} input_edges;
+
+// just the words of input_state that changed since the previous delta was taken
+typedef struct
+{
+	uint64 changedMask;	// a bit per word of input_state
+	int changedCount;
+	int wordsOffset;	// offsetof words, in bytes; heng checks its own layout against it
+	uint32 words[INPUT_STATE_WORDS];	// the changed words, in order
+} input_state_delta;
+
+void Input_GetEdges(input_state *previous, input_state *current, input_edges *edges);
+
+HEXPORT(input_edges*) Input_GetFrameEdges();
+
+// deltas start from an all-zero state; stays valid until the next call
+HEXPORT(input_state_delta*) Input_GetSnapshotDelta();
\ No newline at end of file
@@ -9,6 +9,9 @@ extern void Log_File_Quit();
 
 intern time_t initTime;
 
+// messages can come from the resource loader's thread too; keep each one whole
+intern SDL_SpinLock printLock;
+
 bool Log_Init(log_config config)
 {
 	initTime = time(NULL);
@@ -50,8 +53,10 @@ void Log_PrintToAll(log_level level, char *msg)
 {
 	AssertPtr(msg);
 
+	SDL_AtomicLock(&printLock);
 	Log_Console_Print(level, msg);
 	Log_File_Print(level, msg);
+	SDL_AtomicUnlock(&printLock);
 }
 
 void Log_GetTimestamp(char *out)
@@ -0,0 +1,306 @@
+#include "hmemory.h"
+
+// keeps the caller's pointer aligned to 16 bytes
+typedef struct
+{
+	uint64 size;
+	uint32 tag;
+	uint32 check;
+} alloc_header;
+
+#define ALLOC_CHECK 0x4D454D48	// "HMEM"
+#define ARENA_ALIGNMENT 16
+
+intern memory_state stats;
+
+// allocations happen on the resource loader's thread too
+intern SDL_SpinLock statsLock;
+
+intern char *tagNames[MEMORY_TAG_MAX] =
+{
+	"core",
+	"audio",
+	"sounds",
+	"video",
+	"resources"
+};
+
+intern void TrackAlloc(memory_tag tag, size_t size)
+{
+	SDL_AtomicLock(&statsLock);
+
+	struct memory_tag_state *t = &stats.tags[tag];
+	t->liveBytes += size;
+	t->peakBytes = max(t->peakBytes, t->liveBytes);
+	t->liveCount++;
+	t->totalCount++;
+
+	SDL_AtomicUnlock(&statsLock);
+}
+
+intern void TrackFree(memory_tag tag, size_t size)
+{
+	SDL_AtomicLock(&statsLock);
+
+	struct memory_tag_state *t = &stats.tags[tag];
+	t->liveBytes -= min(size, t->liveBytes);
+	t->liveCount -= min(1, t->liveCount);
+
+	SDL_AtomicUnlock(&statsLock);
+}
+
+void Memory_Quit()
+{
+	for(int i = 0; i < MEMORY_TAG_MAX; i++)
+	{
+		struct memory_tag_state *t = &stats.tags[i];
+		if(t->liveCount > 0)
+		{ LogWarning("%llu %s allocations (%llu bytes) were never freed", (unsigned long long)(t->liveCount), tagNames[i], (unsigned long long)(t->liveBytes)); }
+
+		LogDebug("%s memory peaked at %llu bytes, over %llu allocations", tagNames[i], (unsigned long long)(t->peakBytes), (unsigned long long)(t->totalCount));
+	}
+}
+
+void *Memory_Alloc(memory_tag tag, size_t size)
+{
+	AssertIndex((int)(tag), MEMORY_TAG_MAX);
+
+	alloc_header *h = malloc(sizeof(alloc_header) + size);
+	if(!h)
+	{ return NULL; }
+
+	h->size = size;
+	h->tag = tag;
+	h->check = ALLOC_CHECK;
+
+	TrackAlloc(tag, size);
+	return h + 1;
+}
+
+void *Memory_Calloc(memory_tag tag, size_t count, size_t size)
+{
+	if(size > 0 && count > (SIZE_MAX - sizeof(alloc_header)) / size)
+	{ return NULL; }
+
+	void *ptr = Memory_Alloc(tag, count * size);
+	if(ptr)
+	{ memset(ptr, 0, count * size); }
+
+	return ptr;
+}
+
+void *Memory_Realloc(memory_tag tag, void *ptr, size_t size)
+{
+	if(!ptr)
+	{ return Memory_Alloc(tag, size); }
+
+	alloc_header *h = (alloc_header*)(ptr) - 1;
+	Assert(h->check == ALLOC_CHECK, "pointer %p wasn't allocated by Memory_Alloc", ptr);
+	Assert(h->tag == (uint32)(tag), "pointer %p was allocated as %s memory, not %s", ptr, tagNames[h->tag], tagNames[tag]);
+
+	size_t oldSize = (size_t)(h->size);
+
+	alloc_header *resized = realloc(h, sizeof(alloc_header) + size);
+	if(!resized)
+	{ return NULL; }
+
+	resized->size = size;
+
+	SDL_AtomicLock(&statsLock);
+
+	struct memory_tag_state *t = &stats.tags[tag];
+	t->liveBytes = t->liveBytes - min(oldSize, t->liveBytes) + size;
+	t->peakBytes = max(t->peakBytes, t->liveBytes);
+
+	SDL_AtomicUnlock(&statsLock);
+
+	return resized + 1;
+}
+
+void Memory_Free(void *ptr)
+{
+	if(ptr)
+	{
+		alloc_header *h = (alloc_header*)(ptr) - 1;
+		Assert(h->check == ALLOC_CHECK, "pointer %p wasn't allocated by Memory_Alloc", ptr);
+
+		TrackFree(h->tag, (size_t)(h->size));
+
+		h->check = 0;
+		free(h);
+	}
+}
+
+void Memory_ResetPeaks()
+{
+	SDL_AtomicLock(&statsLock);
+
+	for(int i = 0; i < MEMORY_TAG_MAX; i++)
+	{ stats.tags[i].peakBytes = stats.tags[i].liveBytes; }
+
+	SDL_AtomicUnlock(&statsLock);
+}
+
+HEXPORT(void) Core_GetMemorySnapshot(memory_state *state)
+{
+	AssertPtr(state);
+
+	SDL_AtomicLock(&statsLock);
+	*state = stats;
+	SDL_AtomicUnlock(&statsLock);
+}
+
+bool Memory_Arena_Init(memory_arena *arena, memory_tag tag, size_t capacity)
+{
+	AssertPtr(arena);
+
+	*arena = (memory_arena)
+	{
+		.tag = tag,
+		.base = Memory_Alloc(tag, capacity),
+		.capacity = capacity
+	};
+
+	if(!arena->base)
+	{
+		LogError("couldn't create %s arena: failed to allocate %llu bytes", tagNames[tag], (unsigned long long)(capacity));
+		arena->capacity = 0;
+		return false;
+	}
+
+	return true;
+}
+
+void Memory_Arena_Release(memory_arena *arena)
+{
+	AssertPtr(arena);
+
+	Memory_Free(arena->base);
+	*arena = (memory_arena){ .tag = arena->tag };
+}
+
+void *Memory_Arena_Push(memory_arena *arena, size_t size)
+{
+	AssertPtr(arena);
+
+	size_t start = (arena->used + (ARENA_ALIGNMENT - 1)) & ~(size_t)(ARENA_ALIGNMENT - 1);
+	if(start > arena->capacity || size > arena->capacity - start)
+	{
+		LogError("couldn't push %llu bytes onto %s arena: %llu of %llu bytes are in use", (unsigned long long)(size), tagNames[arena->tag],
+			(unsigned long long)(arena->used), (unsigned long long)(arena->capacity));
+		return NULL;
+	}
+
+	arena->used = start + size;
+	arena->peak = max(arena->peak, arena->used);
+
+	return arena->base + start;
+}
+
+void Memory_Arena_Reset(memory_arena *arena)
+{
+	AssertPtr(arena);
+
+	// the peak is only published once per reset, so pushes stay lock-free
+	SDL_AtomicLock(&statsLock);
+
+	struct memory_tag_state *t = &stats.tags[arena->tag];
+	t->scratchPeakBytes = max(t->scratchPeakBytes, (uint64)(arena->peak));
+
+	SDL_AtomicUnlock(&statsLock);
+
+	arena->used = 0;
+}
+
+bool Memory_Pool_Init(memory_pool *pool, memory_tag tag, size_t blockSize, int capacity)
+{
+	AssertPtr(pool);
+	AssertSign(capacity);
+
+	// blocks double as free list links, and stay as aligned as the allocator's
+	blockSize = (max(blockSize, sizeof(void*)) + (ARENA_ALIGNMENT - 1)) & ~(size_t)(ARENA_ALIGNMENT - 1);
+
+	*pool = (memory_pool)
+	{
+		.tag = tag,
+		.blockSize = blockSize,
+		.capacity = capacity,
+		.blocks = Memory_Alloc(tag, blockSize * (size_t)(max(capacity, 1)))
+	};
+
+	if(!pool->blocks)
+	{
+		LogError("couldn't create %s pool: failed to allocate %i blocks of %llu bytes", tagNames[tag], capacity, (unsigned long long)(blockSize));
+		pool->capacity = 0;
+		return false;
+	}
+
+	for(int i = capacity - 1; i > -1; i--)
+	{
+		void **block = (void**)(pool->blocks + (size_t)(i) * blockSize);
+		*block = pool->freeList;
+		pool->freeList = block;
+	}
+
+	return true;
+}
+
+void Memory_Pool_Release(memory_pool *pool)
+{
+	AssertPtr(pool);
+
+	if(pool->usedCount > 0)
+	{ LogWarning("released %s pool with %i blocks still in use", tagNames[pool->tag], pool->usedCount); }
+
+	Memory_Free(pool->blocks);
+	*pool = (memory_pool){ .tag = pool->tag };
+}
+
+intern bool InPool(memory_pool *pool, void *block)
+{
+	uint8 *b = block;
+	return pool->blocks && b >= pool->blocks && b < pool->blocks + pool->blockSize * (size_t)(pool->capacity);
+}
+
+void *Memory_Pool_Alloc(memory_pool *pool)
+{
+	AssertPtr(pool);
+
+	SDL_AtomicLock(&pool->lock);
+
+	void **block = pool->freeList;
+	if(block)
+	{
+		pool->freeList = *block;
+		pool->usedCount++;
+	}
+
+	SDL_AtomicUnlock(&pool->lock);
+
+	if(block)
+	{ return block; }
+
+	LogDebug("%s pool is full (%i blocks); falling back to the heap", tagNames[pool->tag], pool->capacity);
+	return Memory_Alloc(pool->tag, pool->blockSize);
+}
+
+void Memory_Pool_Free(memory_pool *pool, void *block)
+{
+	AssertPtr(pool);
+
+	if(!block)
+	{ return; }
+
+	if(InPool(pool, block))
+	{
+		SDL_AtomicLock(&pool->lock);
+
+		*(void**)(block) = pool->freeList;
+		pool->freeList = block;
+		pool->usedCount--;
+
+		SDL_AtomicUnlock(&pool->lock);
+	}
+	else
+	{ Memory_Free(block); }
+}
\ No newline at end of file
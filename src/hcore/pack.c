@@ -0,0 +1,353 @@
+#include "pack.h"
+
+#if defined(_WIN64) || defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+typedef struct
+{
+	bool mounted;
+	uint32 mountOrder;
+	int refCount;
+
+	uint8 *base;
+	uint64 size;
+
+	pack_header *header;
+	uint32 *buckets;
+	pack_entry *entries;
+	char *strings;
+
+#if defined(_WIN64) || defined(_WIN32)
+	HANDLE file;
+	HANDLE mapping;
+#endif
+} mounted_pack;
+
+intern mounted_pack packs[PACK_MOUNT_MAX];
+intern uint32 nextMountOrder;
+
+// assets are found and released from the resource loader's thread too
+intern SDL_SpinLock packLock;
+
+intern bool MapFile(mounted_pack *pack, char *filePath)
+{
+#if defined(_WIN64) || defined(_WIN32)
+	pack->file = CreateFileA(filePath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if(pack->file != INVALID_HANDLE_VALUE)
+	{
+		LARGE_INTEGER size;
+		if(GetFileSizeEx(pack->file, &size) && size.QuadPart > 0)
+		{
+			pack->mapping = CreateFileMappingA(pack->file, NULL, PAGE_READONLY, 0, 0, NULL);
+			if(pack->mapping)
+			{
+				pack->base = MapViewOfFile(pack->mapping, FILE_MAP_READ, 0, 0, 0);
+				if(pack->base)
+				{
+					pack->size = (uint64)(size.QuadPart);
+					return true;
+				}
+
+				CloseHandle(pack->mapping);
+			}
+		}
+
+		CloseHandle(pack->file);
+	}
+
+	LogError("couldn't map pack file at '%s'\n\tWindows error: %lu", filePath, GetLastError());
+#else
+	int fd = open(filePath, O_RDONLY);
+	if(fd > -1)
+	{
+		struct stat st;
+		if(fstat(fd, &st) == 0 && st.st_size > 0)
+		{
+			void *base = mmap(NULL, (size_t)(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+			if(base != MAP_FAILED)
+			{
+				// the mapping keeps the file alive on its own
+				close(fd);
+
+				pack->base = base;
+				pack->size = (uint64)(st.st_size);
+				return true;
+			}
+		}
+
+		close(fd);
+	}
+
+	LogError("couldn't map pack file at '%s'", filePath);
+#endif
+
+	return false;
+}
+
+intern void UnmapFile(mounted_pack *pack)
+{
+#if defined(_WIN64) || defined(_WIN32)
+	UnmapViewOfFile(pack->base);
+	CloseHandle(pack->mapping);
+	CloseHandle(pack->file);
+#else
+	munmap(pack->base, (size_t)(pack->size));
+#endif
+
+	pack->base = NULL;
+	pack->size = 0;
+}
+
+intern bool CheckRange(mounted_pack *pack, uint64 offset, uint64 len)
+{
+	return (offset <= pack->size) && (len <= pack->size - offset);
+}
+
+// validate the whole directory up front, so lookups can trust it
+intern bool ValidatePack(mounted_pack *pack, char *filePath)
+{
+	if(pack->size < sizeof(pack_header))
+	{
+		LogError("couldn't mount pack '%s': file is too small", filePath);
+		return false;
+	}
+
+	pack_header *header = (pack_header*)(pack->base);
+	if(header->magic != PACK_MAGIC || header->version != PACK_VERSION)
+	{
+		LogError("couldn't mount pack '%s': not a version %i pack", filePath, PACK_VERSION);
+		return false;
+	}
+
+	if(header->bucketCount == 0 || (header->bucketCount & (header->bucketCount - 1)) != 0 || header->entryCount > header->bucketCount)
+	{
+		LogError("couldn't mount pack '%s': invalid bucket count (%u)", filePath, header->bucketCount);
+		return false;
+	}
+
+	if(header->fileSize != pack->size ||
+		!CheckRange(pack, header->bucketsOffset, (uint64)(header->bucketCount) * sizeof(uint32)) ||
+		!CheckRange(pack, header->entriesOffset, (uint64)(header->entryCount) * sizeof(pack_entry)) ||
+		!CheckRange(pack, header->stringsOffset, 0) ||
+		(header->bucketsOffset % sizeof(uint32)) != 0 || (header->entriesOffset % sizeof(uint64)) != 0)
+	{
+		LogError("couldn't mount pack '%s': directory is out of bounds", filePath);
+		return false;
+	}
+
+	pack->header = header;
+	pack->buckets = (uint32*)(pack->base + header->bucketsOffset);
+	pack->entries = (pack_entry*)(pack->base + header->entriesOffset);
+	pack->strings = (char*)(pack->base + header->stringsOffset);
+
+	for(uint32 i = 0; i < header->bucketCount; i++)
+	{
+		if(pack->buckets[i] != PACK_BUCKET_EMPTY && pack->buckets[i] >= header->entryCount)
+		{
+			LogError("couldn't mount pack '%s': bucket %u is out of bounds", filePath, i);
+			return false;
+		}
+	}
+
+	for(uint32 i = 0; i < header->entryCount; i++)
+	{
+		pack_entry *e = &pack->entries[i];
+		if(!CheckRange(pack, header->stringsOffset + e->pathOffset, e->pathLen) || !CheckRange(pack, e->dataOffset, e->dataLen))
+		{
+			LogError("couldn't mount pack '%s': entry %u is out of bounds", filePath, i);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+intern bool PathsMatch(char *path, char *normalized, uint32 normalizedLen)
+{
+	for(uint32 i = 0; i < normalizedLen; i++)
+	{
+		if(!path[i] || Pack_NormalizePathChar(path[i]) != normalized[i])
+		{ return false; }
+	}
+
+	return path[normalizedLen] == '\0';
+}
+
+intern pack_entry *FindEntry(mounted_pack *pack, char *path, uint64 hash)
+{
+	uint32 mask = pack->header->bucketCount - 1;
+
+	// open addressing, with linear probing
+	for(uint32 probe = 0; probe <= mask; probe++)
+	{
+		uint32 index = pack->buckets[(hash + probe) & mask];
+		if(index == PACK_BUCKET_EMPTY)
+		{ break; }
+
+		pack_entry *e = &pack->entries[index];
+		if(e->hash == hash && PathsMatch(path, pack->strings + e->pathOffset, e->pathLen))
+		{ return e; }
+	}
+
+	return NULL;
+}
+
+void Pack_Quit()
+{
+	for(int i = 0; i < PACK_MOUNT_MAX; i++)
+	{
+		mounted_pack *pack = &packs[i];
+		if(pack->mounted)
+		{
+			if(pack->refCount > 0)
+			{ LogWarning("pack %i still has %i assets in use; unmounting anyway", i, pack->refCount); }
+
+			UnmapFile(pack);
+			pack->mounted = false;
+			pack->refCount = 0;
+		}
+	}
+}
+
+bool Pack_FindAsset(char *path, pack_asset *asset)
+{
+	AssertPtr(path);
+	AssertPtr(asset);
+
+	uint64 hash = Pack_HashPath(path);
+
+	int foundID = -1;
+	pack_entry *found = NULL;
+
+	SDL_AtomicLock(&packLock);
+
+	// later mounts override earlier ones
+	for(int i = 0; i < PACK_MOUNT_MAX; i++)
+	{
+		mounted_pack *pack = &packs[i];
+		if(pack->mounted && (!found || pack->mountOrder > packs[foundID].mountOrder))
+		{
+			pack_entry *e = FindEntry(pack, path, hash);
+			if(e)
+			{
+				foundID = i;
+				found = e;
+			}
+		}
+	}
+
+	if(found)
+	{
+		packs[foundID].refCount++;
+
+		asset->packID = foundID;
+		asset->entry = found;
+		asset->data = packs[foundID].base + found->dataOffset;
+	}
+
+	SDL_AtomicUnlock(&packLock);
+
+	if(found)
+	{ LogDebug("found '%s' in pack %i", path, foundID); }
+
+	return found != NULL;
+}
+
+void Pack_ReleaseAsset(int packID)
+{
+	AssertIndex(packID, PACK_MOUNT_MAX);
+
+	SDL_AtomicLock(&packLock);
+	packs[packID].refCount = max(packs[packID].refCount - 1, 0);
+	SDL_AtomicUnlock(&packLock);
+}
+
+HEXPORT(int) Pack_Mount(char *filePath)
+{
+	if(!filePath)
+	{
+		LogError("couldn't mount pack: file path is NULL");
+		return -1;
+	}
+
+	// map and validate before taking a slot, so the lock is only held briefly
+	mounted_pack pack = { 0 };
+	if(!MapFile(&pack, filePath))
+	{ return -1; }
+
+	if(!ValidatePack(&pack, filePath))
+	{
+		UnmapFile(&pack);
+		return -1;
+	}
+
+	int packID = -1;
+
+	SDL_AtomicLock(&packLock);
+
+	for(int i = 0; i < PACK_MOUNT_MAX && packID < 0; i++)
+	{
+		if(!packs[i].mounted)
+		{
+			packID = i;
+
+			packs[i] = pack;
+			packs[i].mounted = true;
+			packs[i].mountOrder = nextMountOrder++;
+			packs[i].refCount = 0;
+		}
+	}
+
+	SDL_AtomicUnlock(&packLock);
+
+	if(packID < 0)
+	{
+		LogError("couldn't mount pack '%s': all %i pack slots are in use", filePath, PACK_MOUNT_MAX);
+		UnmapFile(&pack);
+	}
+	else
+	{ LogNote("mounted pack '%s' (%u assets) as pack %i", filePath, pack.header->entryCount, packID); }
+
+	return packID;
+}
+
+HEXPORT(bool) Pack_Unmount(int packID)
+{
+	if(packID < 0 || packID >= PACK_MOUNT_MAX)
+	{
+		LogError("couldn't unmount pack: pack ID %i is invalid", packID);
+		return false;
+	}
+
+	SDL_AtomicLock(&packLock);
+
+	mounted_pack pack = packs[packID];
+	bool unmounted = pack.mounted && pack.refCount == 0;
+	if(unmounted)
+	{ packs[packID].mounted = false; }
+
+	SDL_AtomicUnlock(&packLock);
+
+	if(!pack.mounted)
+	{
+		LogError("couldn't unmount pack: pack ID %i is invalid", packID);
+		return false;
+	}
+
+	if(!unmounted)
+	{
+		LogError("couldn't unmount pack %i: %i assets loaded from it are still in use", packID, pack.refCount);
+		return false;
+	}
+
+	UnmapFile(&pack);
+
+	LogNote("unmounted pack %i", packID);
+	return true;
+}
\ No newline at end of file
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "_shared.h"
+
+// - - - - - -
+// pack format
+// - - - - - -
+
+// a pack is laid out as:
+//	header | buckets (uint32 entry indices) | entries | path strings | blobs
+// every blob starts on a PACK_BLOB_ALIGNMENT boundary, so mapped data can be used in place
+
+#define PACK_MAGIC 0x4B415048	// "HPAK"
+#define PACK_VERSION 1
+#define PACK_BLOB_ALIGNMENT 64
+#define PACK_BUCKET_EMPTY UINT32_MAX
+
+typedef enum
+{
+	PACK_ENTRY_RAW,		// the original file, as-is
+	PACK_ENTRY_SOUND,	// samples pre-converted to an audio format
+	PACK_ENTRY_SURFACE	// pixels pre-converted to a pixel format
+} pack_entry_type;
+
+typedef struct
+{
+	uint32 magic;
+	uint32 version;
+	uint32 entryCount;
+	uint32 bucketCount;	// always a power of two
+	uint64 bucketsOffset;
+	uint64 entriesOffset;
+	uint64 stringsOffset;
+	uint64 fileSize;
+} pack_header;
+
+typedef struct
+{
+	uint64 hash;
+	uint64 dataOffset;
+	uint64 dataLen;
+	uint32 pathOffset;	// from the start of the strings; paths are stored normalized, without a terminator
+	uint32 pathLen;
+	uint32 type;
+	uint32 reserved;
+
+	union
+	{
+		struct
+		{
+			int32 freq;
+			uint16 format;
+			uint8 channels;
+			uint8 encoding;
+			uint32 decodedLen;
+		} sound;
+
+		struct
+		{
+			int32 w, h;
+			int32 pitch;
+			uint32 pixelFormat;
+		} surface;
+	} info;
+} pack_entry;
+
+// paths are matched case-insensitively, and with either kind of slash
+HINLINE char Pack_NormalizePathChar(char c)
+{
+	if(c == '\\')
+	{ return '/'; }
+	if(c >= 'A' && c <= 'Z')
+	{ return c - 'A' + 'a'; }
+
+	return c;
+}
+
+// djb algorithm, over the normalized path
+HINLINE uint64 Pack_HashPath(char *path)
+{
+	uint64 hash = 5381;
+	char c;
+
+	while((c = *(path++)))
+	{ hash = ((hash << 5) + hash) + (uint8)(Pack_NormalizePathChar(c)); }
+
+	return hash;
+}
+
+// - - - - - -
+// packs
+// - - - - - -
+
+#define PACK_MOUNT_MAX 8
+
+typedef struct
+{
+	int packID;
+	pack_entry *entry;
+	void *data;	// points into the mapped pack; stays valid until the asset is released
+} pack_asset;
+
+void Pack_Quit();
+
+// finds an asset in the mounted packs, newest mount first; a found asset holds its pack
+// mounted until it's released
+bool Pack_FindAsset(char *path, pack_asset *asset);
+void Pack_ReleaseAsset(int packID);
+
+HEXPORT(int) Pack_Mount(char *filePath);
+HEXPORT(bool) Pack_Unmount(int packID);
\ No newline at end of file
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "_shared.h"
+
+// - - - - - -
+// collision
+// - - - - - -
+
+typedef struct
+{
+	vector2 position;	// position relative to the collider's group origin
+	vector2 velocity;
+	int32 group;		// only colliders within the same group are tested against each other
+	int32 pointStart;	// index of the collider's first vertex in the shared points array
+	int32 pointCount;
+} physics_collider;
+
+typedef struct
+{
+	int32 a, b;		// collider indices; a is always less than b
+	vector2 mtv;	// minimum translation vector, moving a out of b
+} physics_contact;
+
+HEXPORT(int32) Physics_Collision_TestColliders(vector2 *points, physics_collider *colliders, int32 colliderCount,
+	physics_contact *contacts, int32 contactCapacity);
+
+// - - - - - -
+// integration
+// - - - - - -
+
+typedef struct
+{
+	vector2 position;	// position relative to the body's sector origin
+	vector2 velocity;
+	vector2 forces;
+	float mass;
+} physics_body;
+
+HEXPORT(void) Physics_Integration_IntegrateBodies(physics_body *bodies, int32 bodyCount, vector2 gravity, float deltaT);
\ No newline at end of file
@@ -0,0 +1,119 @@
+#include "physics.h"
+#include "vector_batch.h"
+
+typedef struct
+{
+	float min, max;
+} projection;
+
+intern projection ProjectPoints(vector2 *points, int32 count, vector2 position, vector2 axis)
+{
+	projection proj;
+	Vector_Batch_ProjectMinMax(points, count, position, axis, &proj.min, &proj.max);
+
+	return proj;
+}
+
+intern float GetOverlap(projection a, projection b)
+{
+	if((a.min <= b.max) && (b.min <= a.max))
+	{ return min(a.max, b.max) - max(a.min, b.min); }
+
+	return 0;
+}
+
+intern bool TestAxes(vector2 *points, physics_collider *owner, physics_collider *a, physics_collider *b,
+	float *minOverlap, vector2 *mtv)
+{
+	if(owner->pointCount > 1)
+	{
+		vector2 *shape = points + owner->pointStart;
+		vector2 prev = shape[owner->pointCount - 1];
+
+		for(int32 i = 0; i < owner->pointCount; i++)
+		{
+			// seperating axis is simply the normal of each edge
+			vector2 edge = VectorSubtract(shape[i], prev);
+			vector2 axis = VectorLeftNormal(VectorNormalize(edge));
+			prev = shape[i];
+
+			projection projA = ProjectPoints(points + a->pointStart, a->pointCount, a->position, axis);
+			projection projB = ProjectPoints(points + b->pointStart, b->pointCount, b->position, axis);
+
+			// SAT is early-out; if any axis doesn't overlap, we're not colliding
+			float overlap = GetOverlap(projA, projB);
+			if(overlap > 0)
+			{
+				if(overlap < *minOverlap)
+				{
+					*minOverlap = overlap;
+					*mtv = axis;
+				}
+			}
+			else
+			{ return false; }
+		}
+	}
+
+	return true;
+}
+
+intern bool TestPair(vector2 *points, physics_collider *a, physics_collider *b, vector2 *mtv)
+{
+	float minOverlap = FLT_MAX;
+	*mtv = VECTOR2_ZERO;
+
+	if(TestAxes(points, a, a, b, &minOverlap, mtv) && TestAxes(points, b, a, b, &minOverlap, mtv))
+	{
+		// make sure the mtv points from b towards a
+		vector2 diff = VectorSubtract(a->position, b->position);
+		if(VectorDot(diff, *mtv) < 0)
+		{ *mtv = VectorNegate(*mtv); }
+
+		*mtv = VectorScale(*mtv, minOverlap);
+		return true;
+	}
+
+	return false;
+}
+
+HEXPORT(int32) Physics_Collision_TestColliders(vector2 *points, physics_collider *colliders, int32 colliderCount,
+	physics_contact *contacts, int32 contactCapacity)
+{
+	AssertPtr(points);
+	AssertPtr(colliders);
+
+	int32 found = 0;
+
+	// colliders are expected to be sorted by group, so each group is a contiguous run;
+	// each collider is only checked against those at larger indices within its run
+	for(int32 a = 0; a < colliderCount - 1; a++)
+	{
+		physics_collider *ca = &colliders[a];
+
+		for(int32 b = a + 1; (b < colliderCount) && (colliders[b].group == ca->group); b++)
+		{
+			physics_collider *cb = &colliders[b];
+
+			// don't bother checking collisions between non-moving colliders
+			if(VectorEquals(ca->velocity, VECTOR2_ZERO) && VectorEquals(cb->velocity, VECTOR2_ZERO))
+			{ continue; }
+
+			vector2 mtv;
+			if(TestPair(points, ca, cb, &mtv))
+			{
+				// keep counting past capacity, so the caller knows how much room it needs
+				if(found < contactCapacity)
+				{
+					contacts[found].a = a;
+					contacts[found].b = b;
+					contacts[found].mtv = mtv;
+				}
+
+				found++;
+			}
+		}
+	}
+
+	return found;
+}
\ No newline at end of file
@@ -0,0 +1,26 @@
+#include "physics.h"
+
+HEXPORT(void) Physics_Integration_IntegrateBodies(physics_body *bodies, int32 bodyCount, vector2 gravity, float deltaT)
+{
+	AssertPtr(bodies);
+
+	float halfT2 = 0.5f * deltaT * deltaT;
+
+	for(int32 i = 0; i < bodyCount; i++)
+	{
+		physics_body *body = &bodies[i];
+
+		vector2 f = VectorAdd(body->forces, gravity);
+		vector2 a = VectorScale(f, 1 / body->mass);
+
+		// p' = (a / 2)t^2 + vt + p
+		vector2 p = VectorAdd(VectorAdd(VectorScale(a, halfT2), VectorScale(body->velocity, deltaT)), body->position);
+
+		// v' = at + v
+		vector2 v = VectorAdd(VectorScale(a, deltaT), body->velocity);
+
+		body->position = p;
+		body->velocity = v;
+		body->forces = VECTOR2_ZERO;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,164 @@
+#include "resource_map.h"
+#include "time.h"
+
+typedef struct
+{
+	resource_map *map;
+	int index;
+	char *filePath;
+	void *data;
+} loader_job;
+
+// jobs wait in the queue, then sit in the finished list until they're pumped; both are rings,
+// and between them never hold more than RESOURCE_LOADER_QUEUE_MAX jobs
+intern loader_job queued[RESOURCE_LOADER_QUEUE_MAX];
+intern int queuedStart;
+intern int queuedCount;
+
+intern loader_job finished[RESOURCE_LOADER_QUEUE_MAX];
+intern int finishedStart;
+intern int finishedCount;
+
+intern int jobCount;
+
+intern SDL_mutex *lock;
+intern SDL_cond *wake;
+intern SDL_Thread *thread;
+intern bool quitting;
+
+intern int RunLoader(void *unused)
+{
+	Time_Profiler_SetThreadName("resource loader");
+
+	SDL_LockMutex(lock);
+
+	while(!quitting)
+	{
+		if(queuedCount == 0)
+		{
+			SDL_CondWait(wake, lock);
+			continue;
+		}
+
+		loader_job job = queued[queuedStart];
+		queuedStart = (queuedStart + 1) % RESOURCE_LOADER_QUEUE_MAX;
+		queuedCount--;
+
+		// the slow part -- reading, decoding, converting -- happens outside the lock
+		SDL_UnlockMutex(lock);
+		ProfileBegin("ResourceMap_LoadResource");
+		job.data = ResourceMap_LoadResource(job.map, job.filePath);
+		ProfileEnd();
+		SDL_LockMutex(lock);
+
+		finished[(finishedStart + finishedCount) % RESOURCE_LOADER_QUEUE_MAX] = job;
+		finishedCount++;
+	}
+
+	SDL_UnlockMutex(lock);
+	return 0;
+}
+
+bool ResourceLoader_Init()
+{
+	queuedStart = queuedCount = 0;
+	finishedStart = finishedCount = 0;
+	jobCount = 0;
+	quitting = false;
+
+	lock = SDL_CreateMutex();
+	wake = SDL_CreateCond();
+	if(lock && wake)
+	{
+		thread = SDL_CreateThread(&RunLoader, "resource loader", NULL);
+		if(thread)
+		{
+			LogNote("resource loader successfully initialized");
+			return true;
+		}
+	}
+
+	LogFailure("failed to initialize resource loader\n\tSDL error: %s", SDL_GetError());
+	return false;
+}
+
+void ResourceLoader_Quit()
+{
+	if(thread)
+	{
+		SDL_LockMutex(lock);
+		quitting = true;
+		SDL_CondSignal(wake);
+		SDL_UnlockMutex(lock);
+
+		// waits out the job in progress; anything still queued is abandoned
+		SDL_WaitThread(thread, NULL);
+		thread = NULL;
+
+		// finished jobs are handed back, so their maps can free them
+		ResourceLoader_Pump();
+	}
+
+	SDL_DestroyCond(wake);
+	SDL_DestroyMutex(lock);
+	wake = NULL;
+	lock = NULL;
+}
+
+void ResourceLoader_Pump()
+{
+	if(!lock)
+	{ return; }
+
+	loader_job done[RESOURCE_LOADER_QUEUE_MAX];
+	int doneCount = 0;
+
+	SDL_LockMutex(lock);
+
+	for(; doneCount < finishedCount; doneCount++)
+	{ done[doneCount] = finished[(finishedStart + doneCount) % RESOURCE_LOADER_QUEUE_MAX]; }
+
+	finishedStart = (finishedStart + doneCount) % RESOURCE_LOADER_QUEUE_MAX;
+	finishedCount = 0;
+	jobCount -= doneCount;
+
+	SDL_UnlockMutex(lock);
+
+	// maps aren't thread-safe, so they're only ever touched here, on the main thread
+	for(int i = 0; i < doneCount; i++)
+	{ ResourceMap_CompleteResource(done[i].map, done[i].index, done[i].data); }
+}
+
+bool ResourceLoader_Enqueue(resource_map *map, int index, char *filePath)
+{
+	AssertPtr(map);
+	AssertPtr(filePath);
+
+	bool enqueued = false;
+
+	if(lock && !quitting)
+	{
+		SDL_LockMutex(lock);
+
+		if(jobCount < RESOURCE_LOADER_QUEUE_MAX)
+		{
+			queued[(queuedStart + queuedCount) % RESOURCE_LOADER_QUEUE_MAX] = (loader_job)
+			{
+				.map = map,
+				.index = index,
+				.filePath = filePath,
+				.data = NULL
+			};
+
+			queuedCount++;
+			jobCount++;
+			enqueued = true;
+
+			SDL_CondSignal(wake);
+		}
+
+		SDL_UnlockMutex(lock);
+	}
+
+	return enqueued;
+}
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "resource_map.h"
+#include "time.h"
 
 struct resource_map
 {
@@ -6,13 +7,24 @@ struct resource_map
 	{
 		void *data;
 		int refCount;
+
+		resource_status status;
+		char *filePath;
+		uint64 hash;
+		uint64 size;
+
+		bool wasUsed;	// values are found by probing past used ones, so freed values can't end a probe
 	} *values;
 
 	int valueCount;
 	int maxCount;
+	int pendingCount;
+	uint64 residentBytes;
+	uint64 changes;		// bumped whenever a value is claimed, loaded, failed or released
 
 	void *(*allocResource)(char *filePath);
 	void (*freeResource)(void *resource);
+	uint64 (*sizeResource)(void *resource);
 };
 
 // djb algorithm
@@ -30,28 +42,125 @@ HINLINE uint64 HashString(char *str)
 	return hash;
 }
 
-resource_map *ResourceMap_Create(int maxCount, void *(*allocResource)(char *filePath), void (*freeResource)(void *data))
+intern char *CopyString(char *str)
+{
+	size_t len = strlen(str) + 1;
+
+	char *copy = Memory_Alloc(MEMORY_TAG_RESOURCES, len);
+	if(copy)
+	{ memcpy(copy, str, len); }
+
+	return copy;
+}
+
+// finds the value holding a path, or the value it should be loaded into if there isn't one yet;
+// paths are spread across the map by hash, with linear probing to resolve collisions
+intern struct resource_map_value *FindValue(resource_map *map, char *filePath, uint64 hash, int *index)
+{
+	// djb hashes of similar paths differ mostly in their low bits, so mix them before reducing
+	uint64 mixed = hash * 0x9E3779B97F4A7C15ull;
+	int start = (int)((mixed >> 32) % (uint64)(map->maxCount));
+	int freeIndex = -1;
+
+	for(int probe = 0; probe < map->maxCount; probe++)
+	{
+		int i = (start + probe) % map->maxCount;
+		struct resource_map_value *v = &map->values[i];
+
+		if(v->status == RESOURCE_STATUS_NONE)
+		{
+			if(freeIndex < 0)
+			{ freeIndex = i; }
+
+			if(!v->wasUsed)
+			{ break; }
+		}
+		else if(v->hash == hash && strcmp(v->filePath, filePath) == 0)
+		{
+			*index = i;
+			return v;
+		}
+	}
+
+	*index = freeIndex;
+	return (freeIndex > -1) ? &map->values[freeIndex] : NULL;
+}
+
+intern bool ClaimValue(resource_map *map, struct resource_map_value *v, char *filePath, uint64 hash, resource_status status)
+{
+	v->filePath = CopyString(filePath);
+	if(!v->filePath)
+	{
+		LogError("couldn't allocate '%s' to resource map: failed to copy its path", filePath);
+		return false;
+	}
+
+	v->status = status;
+	v->refCount = 1;
+	v->hash = hash;
+	v->size = 0;
+	v->wasUsed = true;
+	map->valueCount++;
+	map->changes++;
+
+	return true;
+}
+
+intern void SetData(resource_map *map, struct resource_map_value *v, void *data)
+{
+	v->data = data;
+	v->status = RESOURCE_STATUS_READY;
+	v->size = map->sizeResource ? map->sizeResource(data) : 0;
+	map->residentBytes += v->size;
+	map->changes++;
+}
+
+intern void ReleaseValue(resource_map *map, struct resource_map_value *v)
+{
+	if(v->data)
+	{
+		map->freeResource(v->data);
+		map->residentBytes -= v->size;
+	}
+
+	Memory_Free(v->filePath);
+
+	v->data = NULL;
+	v->filePath = NULL;
+	v->status = RESOURCE_STATUS_NONE;
+	v->size = 0;
+	map->valueCount--;
+	map->changes++;
+}
+
+resource_map *ResourceMap_Create(int maxCount, void *(*allocResource)(char *filePath), void (*freeResource)(void *data),
+	uint64 (*sizeResource)(void *data))
 {
 	AssertSign(maxCount);
 	AssertPtr(allocResource);
 	AssertPtr(freeResource);
 
-	resource_map *map = malloc(sizeof(resource_map));
+	resource_map *map = Memory_Alloc(MEMORY_TAG_RESOURCES, sizeof(resource_map));
 	if(map)
 	{
-		map->values = calloc(maxCount, sizeof(struct resource_map_value));
+		map->values = Memory_Calloc(MEMORY_TAG_RESOURCES, maxCount, sizeof(struct resource_map_value));
 		if(map->values)
 		{
 			map->maxCount = maxCount;
 			map->valueCount = 0;
+			map->pendingCount = 0;
+			map->residentBytes = 0;
+			map->changes = 0;
 
 			map->allocResource = allocResource;
 			map->freeResource = freeResource;
+			map->sizeResource = sizeResource;
 		}
 		else
 		{
 			LogError("couldn't allocate memory for resource map value containers");
-			free(map);
+			Memory_Free(map);
+			map = NULL;
 		}
 	}
 	else
@@ -64,23 +173,18 @@ void ResourceMap_Free(resource_map *map)
 {
 	if(map)
 	{
-		if(map->valueCount > 0)
+		// anything still loading was abandoned when the loader quit
+		for(int i = 0; i < map->maxCount; i++)
 		{
-			for(int i = 0; i < map->maxCount; i++)
-			{
-				struct resource_map_value *v = &map->values[i];
-				if(v->data)
-				{ map->freeResource(v->data); }
-			}
-		}
+			struct resource_map_value *v = &map->values[i];
+			if(v->data)
+			{ map->freeResource(v->data); }
 
-		free(map->values);
-		free(map);
+			Memory_Free(v->filePath);
+		}
 
-		map->values = NULL;
-		map->maxCount = 0;
-		map->allocResource = NULL;
-		map->freeResource = NULL;
+		Memory_Free(map->values);
+		Memory_Free(map);
 	}
 	else
 	{ LogWarning("couldn't free resource map: pointer is already NULL"); }
@@ -91,24 +195,66 @@ int ResourceMap_AllocResource(resource_map *map, char *filePath)
 	AssertPtr(map);
 	AssertPtr(filePath);
 
-	if(map->valueCount < map->maxCount)
+	int i;
+	uint64 hash = HashString(filePath);
+	struct resource_map_value *v = FindValue(map, filePath, hash, &i);
+	if(v)
 	{
-		int i = (int)(HashString(filePath) % map->maxCount);
-		struct resource_map_value *v = &map->values[i];
-
-		// is data at this index already loaded?
-		if(v->refCount > 0)
+		// is data for this path already loaded, or on its way?
+		if(v->status != RESOURCE_STATUS_NONE)
 		{
 			v->refCount++;
 			return i;
 		}
 
 		// if not, try loading
-		v->data = map->allocResource(filePath);
-		if(v->data)
+		ProfileBegin("ResourceMap_AllocResource");
+		void *data = map->allocResource(filePath);
+		ProfileEnd();
+		if(data)
+		{
+			if(ClaimValue(map, v, filePath, hash, RESOURCE_STATUS_READY))
+			{
+				SetData(map, v, data);
+				return i;
+			}
+
+			map->freeResource(data);
+		}
+	}
+	else
+	{ LogError("couldn't allocate to resource map: no free value slots (limit: %i)", map->maxCount); }
+
+	return -1;
+}
+
+int ResourceMap_RequestResource(resource_map *map, char *filePath)
+{
+	AssertPtr(map);
+	AssertPtr(filePath);
+
+	int i;
+	uint64 hash = HashString(filePath);
+	struct resource_map_value *v = FindValue(map, filePath, hash, &i);
+	if(v)
+	{
+		if(v->status != RESOURCE_STATUS_NONE)
+		{
+			v->refCount++;
+			return i;
+		}
+
+		if(ClaimValue(map, v, filePath, hash, RESOURCE_STATUS_LOADING))
 		{
-			v->refCount = 1;
-			map->valueCount++;
+			map->pendingCount++;
+
+			// the loader reads the value's own copy of the path, which lives until the load completes
+			if(!ResourceLoader_Enqueue(map, i, v->filePath))
+			{
+				LogWarning("resource loader queue is full; loading '%s' immediately", filePath);
+				ResourceMap_CompleteResource(map, i, map->allocResource(filePath));
+			}
+
 			return i;
 		}
 	}
@@ -118,30 +264,64 @@ int ResourceMap_AllocResource(resource_map *map, char *filePath)
 	return -1;
 }
 
+void *ResourceMap_LoadResource(resource_map *map, char *filePath)
+{
+	AssertPtr(map);
+
+	return map->allocResource(filePath);
+}
+
+void ResourceMap_CompleteResource(resource_map *map, int index, void *data)
+{
+	AssertPtr(map);
+	AssertIndex(index, map->maxCount);
+
+	struct resource_map_value *v = &map->values[index];
+	Assert(v->status == RESOURCE_STATUS_LOADING, "resource map value %i isn't loading", index);
+
+	map->pendingCount--;
+	map->changes++;
+
+	if(v->refCount == 0)
+	{
+		// everyone lost interest while it was loading
+		if(data)
+		{ map->freeResource(data); }
+
+		ReleaseValue(map, v);
+	}
+	else if(data)
+	{ SetData(map, v, data); }
+	else
+	{
+		LogError("couldn't load resource '%s'", v->filePath);
+		v->status = RESOURCE_STATUS_FAILED;
+	}
+}
+
 void ResourceMap_FreeResource(resource_map *map, int index)
 {
 	AssertPtr(map);
 	AssertIndex(index, map->maxCount);
 
 	struct resource_map_value *v = &map->values[index];
-	if(v->data)
+	if(v->status != RESOURCE_STATUS_NONE)
 	{
 		v->refCount = max(v->refCount - 1, 0);
-		if(v->refCount == 0)
-		{
-			map->freeResource(v->data);
-			v->data = NULL;
-			map->valueCount--;
-		}
+
+		// values still loading are released once the loader hands them back
+		if(v->refCount == 0 && v->status != RESOURCE_STATUS_LOADING)
+		{ ReleaseValue(map, v); }
 	}
 	else
-	{ LogWarning("couldn't free resource map value at index %i: pointer is already NULL"); }
+	{ LogWarning("couldn't free resource map value at index %i: pointer is already NULL", index); }
 }
 
 void *ResourceMap_GetResource(resource_map *map, int index)
 {
 	Assert(ResourceMap_CheckResource(map, index), "resource map value at %i is invalid", index);
 
+	// NULL until an async load is ready
 	return map->values[index].data;
 }
 
@@ -155,7 +335,7 @@ bool ResourceMap_CheckResource(resource_map *map, int index)
 		return false;
 	}
 
-	if(!map->values[index].data)
+	if(map->values[index].status == RESOURCE_STATUS_NONE)
 	{
 		LogError("resource map value %i has no data", index);
 		return false;
@@ -170,6 +350,22 @@ bool ResourceMap_CheckResource(resource_map *map, int index)
 	return true;
 }
 
+resource_status ResourceMap_GetStatus(resource_map *map, int index)
+{
+	AssertPtr(map);
+	AssertIndex(index, map->maxCount);
+
+	return map->values[index].status;
+}
+
+uint64 ResourceMap_GetResourceSize(resource_map *map, int index)
+{
+	AssertPtr(map);
+	AssertIndex(index, map->maxCount);
+
+	return map->values[index].size;
+}
+
 int ResourceMap_GetResourceCount(resource_map *map)
 {
 	AssertPtr(map);
@@ -190,4 +386,25 @@ int ResourceMap_GetRefCount(resource_map *map, int index)
 	Assert(ResourceMap_CheckResource(map, index), "resource map value at %i is invalid", index);
 
 	return map->values[index].refCount;
+}
+
+int ResourceMap_GetPendingCount(resource_map *map)
+{
+	AssertPtr(map);
+
+	return map->pendingCount;
+}
+
+uint64 ResourceMap_GetResidentBytes(resource_map *map)
+{
+	AssertPtr(map);
+
+	return map->residentBytes;
+}
+
+uint64 ResourceMap_GetChanges(resource_map *map)
+{
+	AssertPtr(map);
+
+	return map->changes;
 }
\ No newline at end of file
@@ -2,16 +2,51 @@
 
 #include "_shared.h"
 
+typedef enum
+{
+	RESOURCE_STATUS_NONE,		// nothing is using this value
+	RESOURCE_STATUS_LOADING,	// queued on the loader, or being loaded
+	RESOURCE_STATUS_READY,
+	RESOURCE_STATUS_FAILED		// an async load failed; the value stays referenced until it's freed
+} resource_status;
+
 typedef struct resource_map resource_map;
 
-resource_map *ResourceMap_Create(int maxCount, void *(*allocResource)(char *filePath), void(*freeResource)(void *data));
+resource_map *ResourceMap_Create(int maxCount, void *(*allocResource)(char *filePath), void(*freeResource)(void *data),
+	uint64 (*sizeResource)(void *data));
 void ResourceMap_Free(resource_map *map);
 
 int ResourceMap_AllocResource(resource_map *map, char *filePath);
+int ResourceMap_RequestResource(resource_map *map, char *filePath);
 void ResourceMap_FreeResource(resource_map *map, int index);
 void *ResourceMap_GetResource(resource_map *map, int index);
 bool ResourceMap_CheckResource(resource_map *map, int index);
 
+resource_status ResourceMap_GetStatus(resource_map *map, int index);
+uint64 ResourceMap_GetResourceSize(resource_map *map, int index);
+
 int ResourceMap_GetResourceCount(resource_map *map);
 int ResourceMap_GetMaxCount(resource_map *map);
-int ResourceMap_GetRefCount(resource_map *map, int index);
\ No newline at end of file
+int ResourceMap_GetRefCount(resource_map *map, int index);
+int ResourceMap_GetPendingCount(resource_map *map);
+uint64 ResourceMap_GetResidentBytes(resource_map *map);
+
+// only ever grows, and moves whenever the counts or any value's status do
+uint64 ResourceMap_GetChanges(resource_map *map);
+
+// - - - - - -
+// loader
+// - - - - - -
+
+// resources requested with ResourceMap_RequestResource are loaded on a background thread,
+// then handed back to their maps when the loader is pumped, on the main thread
+
+#define RESOURCE_LOADER_QUEUE_MAX 256
+
+bool ResourceLoader_Init();
+void ResourceLoader_Quit();
+void ResourceLoader_Pump();
+
+bool ResourceLoader_Enqueue(resource_map *map, int index, char *filePath);
+void *ResourceMap_LoadResource(resource_map *map, char *filePath);
+void ResourceMap_CompleteResource(resource_map *map, int index, void *data);
\ No newline at end of file
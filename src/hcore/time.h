@@ -5,4 +5,76 @@
 HEXPORT(uint32) Time_GetTicks();
 HEXPORT(void) Time_Delay(uint32 ms);
 
-HEXPORT(double) Time_TimeProcedure(void(*proc)());
\ No newline at end of file
+HEXPORT(double) Time_TimeProcedure(void(*proc)());
+
+// - - - - - -
+// profiler
+// - - - - - -
+
+#define TIME_PROFILER_THREADS_MAX 8
+#define TIME_PROFILER_RING_SIZE 16384	// zones kept per thread; the oldest are overwritten
+#define TIME_PROFILER_DEPTH_MAX 32
+#define TIME_PROFILER_ZONES_MAX 256		// zone names registered from outside core
+
+// read inline by the zone macros, so a disabled profiler costs a single branch
+extern bool timeProfilerEnabled;
+
+// wrapped so they're single statements, and safe in an unbraced if/else
+#define ProfileBegin(name) do { if(timeProfilerEnabled) { Time_Profiler_Begin(name); } } while(0)
+#define ProfileEnd() do { if(timeProfilerEnabled) { Time_Profiler_End(); } } while(0)
+
+void Time_Profiler_Quit();
+void Time_Profiler_SetThreadName(const char *name);
+
+// zone names aren't copied, so they need to outlive the capture
+void Time_Profiler_Begin(const char *name);
+void Time_Profiler_End();
+
+HEXPORT(void) Time_Profiler_SetEnabled(bool enabled);
+HEXPORT(int) Time_Profiler_RegisterZone(char *name);
+HEXPORT(void) Time_Profiler_BeginZone(int zoneID);
+HEXPORT(void) Time_Profiler_EndZone();
+HEXPORT(bool) Time_Profiler_WriteTrace(char *filePath);
+
+// - - - - - -
+// frame stats
+// - - - - - -
+
+#define TIME_FRAME_STATS_WINDOW 4096		// frames the percentiles are taken over
+#define TIME_FRAME_STATS_BUCKETS 1344		// log-linear buckets, exact below 128us and within 1.6% above
+#define TIME_FRAME_STATS_MAX_US 67108863	// longer times are clamped, at just over a minute
+
+typedef enum
+{
+	FRAME_STAT_FRAME,	// the whole frame, from one mark to the next
+	FRAME_STAT_EVENTS,	// Core_Events_Pump
+	FRAME_STAT_VIDEO,	// Video_Queue_Pump, over every window
+	FRAME_STAT_AUDIO,	// Audio_PushSound
+	FRAME_STAT_MAX
+} frame_stat_type;
+
+typedef struct
+{
+	// all times are in microseconds
+	struct frame_stat_info
+	{
+		uint32 sampleCount;
+		uint32 p50;
+		uint32 p95;
+		uint32 p99;
+		uint32 max;
+		uint32 hitchCount;	// samples in the window over the hitch threshold
+	} stats[FRAME_STAT_MAX];
+
+	uint64 frameCount;
+	uint64 totalHitchCount;	// frames over the hitch threshold, since stats were last reset
+	uint32 hitchThreshold;
+} time_frame_stats;
+
+// subsystem times are summed over a frame, and recorded when it's marked
+void Time_AddFrameTime(frame_stat_type type, uint64 startCounter);
+
+HEXPORT(void) Time_MarkFrame();
+HEXPORT(void) Time_GetFrameStats(time_frame_stats *stats);
+HEXPORT(void) Time_SetHitchThreshold(uint32 us);
+HEXPORT(void) Time_ResetFrameStats();
\ No newline at end of file
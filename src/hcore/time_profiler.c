@@ -0,0 +1,285 @@
+#include "time.h"
+
+typedef struct
+{
+	const char *name;
+	uint64 start;
+	uint64 duration;
+} profiler_zone;
+
+typedef struct
+{
+	const char *name;
+	SDL_threadID threadID;
+
+	// zones are written before the count is published; zone n goes in zones[n % TIME_PROFILER_RING_SIZE]
+	profiler_zone zones[TIME_PROFILER_RING_SIZE];
+	SDL_atomic_t written;
+
+	uint64 openStarts[TIME_PROFILER_DEPTH_MAX];
+	const char *openNames[TIME_PROFILER_DEPTH_MAX];
+	int depth;
+
+	uint32 capture;
+} profiler_ring;
+
+bool timeProfilerEnabled;
+
+intern profiler_ring *rings[TIME_PROFILER_THREADS_MAX];
+intern SDL_atomic_t ringCount;
+
+// bumped on every quit, so threads outliving it don't keep using freed rings
+intern uint32 ringGeneration = 1;
+intern HTHREADLOCAL profiler_ring *threadRing;
+intern HTHREADLOCAL uint32 threadRingGeneration;
+intern HTHREADLOCAL const char *threadName;
+
+// bumped whenever the profiler is enabled, so each capture starts with empty rings
+intern uint32 capture;
+intern uint64 captureStart;
+
+intern char *zoneNames[TIME_PROFILER_ZONES_MAX];
+intern int zoneCount;
+
+intern profiler_ring *GetThreadRing()
+{
+	if(threadRingGeneration != ringGeneration)
+	{
+		threadRingGeneration = ringGeneration;
+		threadRing = NULL;
+
+		int index = SDL_AtomicAdd(&ringCount, 1);
+		if(index < TIME_PROFILER_THREADS_MAX)
+		{
+			profiler_ring *ring = Memory_Calloc(MEMORY_TAG_CORE, 1, sizeof(profiler_ring));
+			if(ring)
+			{
+				ring->name = threadName;
+				ring->threadID = SDL_ThreadID();
+				ring->capture = capture;
+
+				threadRing = ring;
+			}
+
+			rings[index] = ring;
+		}
+		else
+		{ LogWarning("profiler only records %i threads; ignoring zones from thread %lu", TIME_PROFILER_THREADS_MAX, SDL_ThreadID()); }
+	}
+
+	profiler_ring *ring = threadRing;
+	if(ring && ring->capture != capture)
+	{
+		ring->capture = capture;
+		ring->depth = 0;
+		SDL_AtomicSet(&ring->written, 0);
+	}
+
+	return ring;
+}
+
+intern void WriteEscaped(FILE *file, const char *s)
+{
+	for(; *s; s++)
+	{
+		if(*s == '"' || *s == '\\')
+		{ fputc('\\', file); }
+
+		if((uint8)(*s) >= 0x20)
+		{ fputc(*s, file); }
+	}
+}
+
+void Time_Profiler_Quit()
+{
+	timeProfilerEnabled = false;
+
+	for(int i = 0; i < TIME_PROFILER_THREADS_MAX; i++)
+	{
+		Memory_Free(rings[i]);
+		rings[i] = NULL;
+	}
+
+	SDL_AtomicSet(&ringCount, 0);
+	ringGeneration++;
+
+	for(int i = 0; i < zoneCount; i++)
+	{
+		Memory_Free(zoneNames[i]);
+		zoneNames[i] = NULL;
+	}
+
+	zoneCount = 0;
+}
+
+void Time_Profiler_SetThreadName(const char *name)
+{
+	threadName = name;
+
+	if(threadRingGeneration == ringGeneration && threadRing)
+	{ threadRing->name = name; }
+}
+
+void Time_Profiler_Begin(const char *name)
+{
+	profiler_ring *ring = GetThreadRing();
+	if(ring)
+	{
+		// zones nested past the limit are dropped, but still counted so their ends match up
+		if(ring->depth < TIME_PROFILER_DEPTH_MAX)
+		{
+			ring->openNames[ring->depth] = name;
+			ring->openStarts[ring->depth] = SDL_GetPerformanceCounter();
+		}
+
+		ring->depth++;
+	}
+}
+
+void Time_Profiler_End()
+{
+	uint64 end = SDL_GetPerformanceCounter();
+
+	profiler_ring *ring = GetThreadRing();
+	if(ring && ring->depth > 0)
+	{
+		ring->depth--;
+		if(ring->depth < TIME_PROFILER_DEPTH_MAX)
+		{
+			// complete zones are recorded on end, so an overwritten ring never leaves a zone half-open
+			uint32 written = (uint32)(SDL_AtomicGet(&ring->written));
+			profiler_zone *z = &ring->zones[written % TIME_PROFILER_RING_SIZE];
+			z->name = ring->openNames[ring->depth];
+			z->start = ring->openStarts[ring->depth];
+			z->duration = end - z->start;
+
+			SDL_AtomicSet(&ring->written, (int)(written + 1));
+		}
+	}
+}
+
+HEXPORT(void) Time_Profiler_SetEnabled(bool enabled)
+{
+	if(enabled && !timeProfilerEnabled)
+	{
+		capture++;
+		captureStart = SDL_GetPerformanceCounter();
+
+		LogNote("profiler capture started");
+	}
+
+	timeProfilerEnabled = enabled;
+}
+
+HEXPORT(int) Time_Profiler_RegisterZone(char *name)
+{
+	if(!name)
+	{
+		LogError("couldn't register profiler zone: name is NULL");
+		return -1;
+	}
+
+	for(int i = 0; i < zoneCount; i++)
+	{
+		if(strcmp(zoneNames[i], name) == 0)
+		{ return i; }
+	}
+
+	if(zoneCount < TIME_PROFILER_ZONES_MAX)
+	{
+		size_t len = strlen(name) + 1;
+		char *copy = Memory_Alloc(MEMORY_TAG_CORE, len);
+		if(copy)
+		{
+			memcpy(copy, name, len);
+			zoneNames[zoneCount] = copy;
+			return zoneCount++;
+		}
+	}
+	else
+	{ LogError("couldn't register profiler zone '%s': all %i zones are in use", name, TIME_PROFILER_ZONES_MAX); }
+
+	return -1;
+}
+
+HEXPORT(void) Time_Profiler_BeginZone(int zoneID)
+{
+	if(timeProfilerEnabled)
+	{
+		if(zoneID > -1 && zoneID < zoneCount)
+		{ Time_Profiler_Begin(zoneNames[zoneID]); }
+		else
+		{ LogError("couldn't begin profiler zone: zone ID %i is invalid", zoneID); }
+	}
+}
+
+HEXPORT(void) Time_Profiler_EndZone()
+{
+	ProfileEnd();
+}
+
+HEXPORT(bool) Time_Profiler_WriteTrace(char *filePath)
+{
+	if(!filePath)
+	{
+		LogError("couldn't write profiler trace: file path is NULL");
+		return false;
+	}
+
+	FILE *file = fopen(filePath, "w");
+	if(!file)
+	{
+		LogError("couldn't write profiler trace: couldn't open '%s'", filePath);
+		return false;
+	}
+
+	// chrome's trace event format, which perfetto reads too
+	double usPerCount = 1000000.0 / (double)(SDL_GetPerformanceFrequency());
+	bool first = true;
+
+	fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", file);
+
+	int threads = min(SDL_AtomicGet(&ringCount), TIME_PROFILER_THREADS_MAX);
+	for(int i = 0; i < threads; i++)
+	{
+		profiler_ring *ring = rings[i];
+		if(!ring || ring->capture != capture)
+		{ continue; }
+
+		fprintf(file, "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%lu,\"args\":{\"name\":\"", first ? "" : ",", ring->threadID);
+		WriteEscaped(file, ring->name ? ring->name : "thread");
+		fputs("\"}}", file);
+		first = false;
+
+		// the ring's thread keeps recording while it's read, so each zone is copied out, then checked against
+		// the count again; once the ring has lapped a zone, the copy may be half-overwritten, and is dropped
+		uint32 written = (uint32)(SDL_AtomicGet(&ring->written));
+		uint32 oldest = (written > TIME_PROFILER_RING_SIZE) ? written - TIME_PROFILER_RING_SIZE : 0;
+		for(uint32 j = oldest; j < written; j++)
+		{
+			profiler_zone z = ring->zones[j % TIME_PROFILER_RING_SIZE];
+			if((uint32)(SDL_AtomicGet(&ring->written)) - j >= TIME_PROFILER_RING_SIZE)
+			{ continue; }
+
+			if(!z.name || z.start < captureStart)
+			{ continue; }
+
+			fputs(",\n{\"name\":\"", file);
+			WriteEscaped(file, z.name);
+			fprintf(file, "\",\"cat\":\"hcore\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%lu}",
+				(double)(z.start - captureStart) * usPerCount, (double)(z.duration) * usPerCount, ring->threadID);
+		}
+	}
+
+	fputs("\n]}\n", file);
+
+	bool ok = !ferror(file);
+	fclose(file);
+
+	if(ok)
+	{ LogNote("wrote profiler trace to '%s'", filePath); }
+	else
+	{ LogError("couldn't write profiler trace: failed writing to '%s'", filePath); }
+
+	return ok;
+}
\ No newline at end of file
@@ -0,0 +1,188 @@
+#include "time.h"
+
+#define HITCH_THRESHOLD_DEFAULT 33333	// two frames at 60Hz
+
+// a rolling window of samples, with a histogram kept in step so percentiles don't need a sort
+typedef struct
+{
+	uint32 samples[TIME_FRAME_STATS_WINDOW];
+	int next;
+	int count;
+
+	uint32 buckets[TIME_FRAME_STATS_BUCKETS];
+	uint32 hitchCount;
+} frame_stat;
+
+intern frame_stat stats[FRAME_STAT_MAX];
+intern uint64 frameTimes[FRAME_STAT_MAX];
+
+intern uint64 lastMark;
+intern uint64 frameCount;
+intern uint64 totalHitchCount;
+intern uint32 hitchThreshold = HITCH_THRESHOLD_DEFAULT;
+
+intern int MostSignificantBit(uint32 v)
+{
+	int bit = 0;
+	while(v >>= 1)
+	{ bit++; }
+
+	return bit;
+}
+
+// values under 128 get a bucket each; above that, each power of two is split into 64 buckets
+intern int GetBucket(uint32 us)
+{
+	if(us < 128)
+	{ return (int)(us); }
+
+	int shift = MostSignificantBit(us) - 6;
+	return 128 + ((shift - 1) * 64) + (int)((us >> shift) - 64);
+}
+
+intern uint32 GetBucketValue(int bucket)
+{
+	if(bucket < 128)
+	{ return (uint32)(bucket); }
+
+	int shift = ((bucket - 128) / 64) + 1;
+	uint32 lower = (uint32)(((bucket - 128) % 64) + 64) << shift;
+
+	// the middle of the bucket's range
+	return lower + ((1u << shift) >> 1);
+}
+
+intern void AddSample(frame_stat *s, uint32 us)
+{
+	us = min(us, TIME_FRAME_STATS_MAX_US);
+
+	if(s->count == TIME_FRAME_STATS_WINDOW)
+	{
+		uint32 old = s->samples[s->next];
+		s->buckets[GetBucket(old)]--;
+		if(old > hitchThreshold)
+		{ s->hitchCount--; }
+	}
+	else
+	{ s->count++; }
+
+	s->samples[s->next] = us;
+	s->next = (s->next + 1) % TIME_FRAME_STATS_WINDOW;
+
+	s->buckets[GetBucket(us)]++;
+	if(us > hitchThreshold)
+	{ s->hitchCount++; }
+}
+
+intern uint32 GetPercentile(frame_stat *s, int percent)
+{
+	// the smallest value with at least the given share of samples at or below it
+	uint32 rank = (uint32)(((uint64)(s->count) * (uint64)(percent) + 99) / 100);
+	uint32 seen = 0;
+
+	for(int i = 0; i < TIME_FRAME_STATS_BUCKETS; i++)
+	{
+		seen += s->buckets[i];
+		if(seen >= rank && seen > 0)
+		{ return GetBucketValue(i); }
+	}
+
+	return 0;
+}
+
+intern uint32 CountersToMicroseconds(uint64 counters)
+{
+	uint64 us = (counters * 1000000) / SDL_GetPerformanceFrequency();
+	return (uint32)(min(us, TIME_FRAME_STATS_MAX_US));
+}
+
+void Time_AddFrameTime(frame_stat_type type, uint64 startCounter)
+{
+	AssertIndex((int)(type), FRAME_STAT_MAX);
+
+	frameTimes[type] += SDL_GetPerformanceCounter() - startCounter;
+}
+
+HEXPORT(void) Time_MarkFrame()
+{
+	uint64 now = SDL_GetPerformanceCounter();
+
+	// the first mark only starts the first frame
+	if(lastMark > 0)
+	{
+		uint32 frameUs = CountersToMicroseconds(now - lastMark);
+		AddSample(&stats[FRAME_STAT_FRAME], frameUs);
+
+		for(int i = FRAME_STAT_FRAME + 1; i < FRAME_STAT_MAX; i++)
+		{ AddSample(&stats[i], CountersToMicroseconds(frameTimes[i])); }
+
+		frameCount++;
+		if(frameUs > hitchThreshold)
+		{ totalHitchCount++; }
+	}
+
+	for(int i = 0; i < FRAME_STAT_MAX; i++)
+	{ frameTimes[i] = 0; }
+
+	lastMark = now;
+}
+
+HEXPORT(void) Time_GetFrameStats(time_frame_stats *state)
+{
+	AssertPtr(state);
+
+	*state = (time_frame_stats)
+	{
+		.frameCount = frameCount,
+		.totalHitchCount = totalHitchCount,
+		.hitchThreshold = hitchThreshold
+	};
+
+	for(int i = 0; i < FRAME_STAT_MAX; i++)
+	{
+		frame_stat *s = &stats[i];
+		struct frame_stat_info *info = &state->stats[i];
+
+		info->sampleCount = (uint32)(s->count);
+		info->hitchCount = s->hitchCount;
+
+		if(s->count > 0)
+		{
+			info->p50 = GetPercentile(s, 50);
+			info->p95 = GetPercentile(s, 95);
+			info->p99 = GetPercentile(s, 99);
+
+			// the max is taken from the raw samples, so it's exact
+			for(int j = 0; j < s->count; j++)
+			{ info->max = max(info->max, s->samples[j]); }
+		}
+	}
+}
+
+HEXPORT(void) Time_SetHitchThreshold(uint32 us)
+{
+	hitchThreshold = us;
+
+	// recount the window against the new threshold
+	for(int i = 0; i < FRAME_STAT_MAX; i++)
+	{
+		frame_stat *s = &stats[i];
+		s->hitchCount = 0;
+
+		for(int j = 0; j < s->count; j++)
+		{
+			if(s->samples[j] > hitchThreshold)
+			{ s->hitchCount++; }
+		}
+	}
+}
+
+HEXPORT(void) Time_ResetFrameStats()
+{
+	memset(stats, 0, sizeof(stats));
+	memset(frameTimes, 0, sizeof(frameTimes));
+
+	lastMark = 0;
+	frameCount = 0;
+	totalHitchCount = 0;
+}
\ No newline at end of file
@@ -153,4 +153,14 @@ HINLINE vector2 AngleToVector(float degrees)
 	vector2 v = { (float)(cos(rad)), (float)(sin(rad)) };
 	
 	return v;
+}
+
+HINLINE vector2 VectorRotate(vector2 v, float degrees)
+{
+	float rad = (float)(degrees / (180.0f / M_PI));
+	float c = (float)(cos(rad));
+	float s = (float)(sin(rad));
+
+	vector2 r = { (v.x * c) - (v.y * s), (v.x * s) + (v.y * c) };
+	return r;
 }
\ No newline at end of file
@@ -0,0 +1,490 @@
+#include "vector_batch.h"
+
+#ifdef VECTOR_BATCH_SSE2
+#include <emmintrin.h>
+
+// splits 4 interleaved vectors into x and y lanes
+#define LoadAoS(v, xs, ys) \
+	{ \
+		__m128 lo = _mm_loadu_ps(&(v)[0].x); \
+		__m128 hi = _mm_loadu_ps(&(v)[2].x); \
+		xs = _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0)); \
+		ys = _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 1, 3, 1)); \
+	}
+
+// re-interleaves x and y lanes into 4 vectors
+#define StoreAoS(v, xs, ys) \
+	{ \
+		_mm_storeu_ps(&(v)[0].x, _mm_unpacklo_ps(xs, ys)); \
+		_mm_storeu_ps(&(v)[2].x, _mm_unpackhi_ps(xs, ys)); \
+	}
+
+HINLINE void NormalizeLanes(__m128 *xs, __m128 *ys)
+{
+	__m128 sqrMag = _mm_add_ps(_mm_mul_ps(*xs, *xs), _mm_mul_ps(*ys, *ys));
+	__m128 mag = _mm_sqrt_ps(sqrMag);
+	__m128 s = _mm_div_ps(_mm_set1_ps(1), mag);
+
+	// zero-length vectors are left as-is, like VectorNormalize()
+	__m128 mask = _mm_cmpgt_ps(mag, _mm_setzero_ps());
+	*xs = _mm_or_ps(_mm_and_ps(mask, _mm_mul_ps(*xs, s)), _mm_andnot_ps(mask, *xs));
+	*ys = _mm_or_ps(_mm_and_ps(mask, _mm_mul_ps(*ys, s)), _mm_andnot_ps(mask, *ys));
+}
+
+HINLINE void RotateLanes(__m128 *xs, __m128 *ys, __m128 c, __m128 s)
+{
+	__m128 x = _mm_sub_ps(_mm_mul_ps(*xs, c), _mm_mul_ps(*ys, s));
+	__m128 y = _mm_add_ps(_mm_mul_ps(*xs, s), _mm_mul_ps(*ys, c));
+
+	*xs = x;
+	*ys = y;
+}
+
+HINLINE __m128 ProjectLanes(__m128 xs, __m128 ys, __m128 ox, __m128 oy, __m128 ax, __m128 ay)
+{
+	return _mm_add_ps(_mm_mul_ps(_mm_add_ps(xs, ox), ax), _mm_mul_ps(_mm_add_ps(ys, oy), ay));
+}
+
+intern void ReduceMinMax(__m128 vMin, __m128 vMax, float *outMin, float *outMax)
+{
+	float mins[4], maxs[4];
+	_mm_storeu_ps(mins, vMin);
+	_mm_storeu_ps(maxs, vMax);
+
+	for(int i = 0; i < 4; i++)
+	{
+		*outMin = min(*outMin, mins[i]);
+		*outMax = max(*outMax, maxs[i]);
+	}
+}
+#endif
+
+// - - - - - -
+// scalar helpers
+// - - - - - -
+
+HINLINE void GetRotation(float degrees, float *c, float *s)
+{
+	// same as VectorRotate(), but only calculated once per batch
+	float rad = (float)(degrees / (180.0f / M_PI));
+	*c = (float)(cos(rad));
+	*s = (float)(sin(rad));
+}
+
+HINLINE vector2 RotateScalar(vector2 v, float c, float s)
+{
+	vector2 r = { (v.x * c) - (v.y * s), (v.x * s) + (v.y * c) };
+	return r;
+}
+
+HINLINE vector2 TransformScalar(vector2 v, vector2 scale, float c, float s, vector2 translation)
+{
+	vector2 scaled = { v.x * scale.x, v.y * scale.y };
+	return VectorAdd(RotateScalar(scaled, c, s), translation);
+}
+
+HINLINE float ProjectScalar(vector2 v, vector2 offset, vector2 axis)
+{
+	return VectorDot(VectorAdd(v, offset), axis);
+}
+
+// - - - - - -
+// AoS
+// - - - - - -
+
+void Vector_Batch_Add(vector2 *out, vector2 *a, vector2 *b, int32 count)
+{
+	int32 i = 0;
+
+#ifdef VECTOR_BATCH_SSE2
+	for(; i + 2 <= count; i += 2)
+	{ _mm_storeu_ps(&out[i].x, _mm_add_ps(_mm_loadu_ps(&a[i].x), _mm_loadu_ps(&b[i].x))); }
+#endif
+
+	for(; i < count; i++)
+	{ out[i] = VectorAdd(a[i], b[i]); }
+}
+
+void Vector_Batch_Scale(vector2 *out, vector2 *v, float s, int32 count)
+{
+	int32 i = 0;
+
+#ifdef VECTOR_BATCH_SSE2
+	__m128 vs = _mm_set1_ps(s);
+	for(; i + 2 <= count; i += 2)
+	{ _mm_storeu_ps(&out[i].x, _mm_mul_ps(_mm_loadu_ps(&v[i].x), vs)); }
+#endif
+
+	for(; i < count; i++)
+	{ out[i] = VectorScale(v[i], s); }
+}
+
+void Vector_Batch_Dot(float *out, vector2 *a, vector2 *b, int32 count)
+{
+	int32 i = 0;
+
+#ifdef VECTOR_BATCH_SSE2
+	for(; i + 4 <= count; i += 4)
+	{
+		__m128 ax, ay, bx, by;
+		LoadAoS(a + i, ax, ay);
+		LoadAoS(b + i, bx, by);
+
+		_mm_storeu_ps(out + i, _mm_add_ps(_mm_mul_ps(ax, bx), _mm_mul_ps(ay, by)));
+	}
+#endif
+
+	for(; i < count; i++)
+	{ out[i] = VectorDot(a[i], b[i]); }
+}
+
+void Vector_Batch_Normalize(vector2 *out, vector2 *v, int32 count)
+{
+	int32 i = 0;
+
+#ifdef VECTOR_BATCH_SSE2
+	for(; i + 4 <= count; i += 4)
+	{
+		__m128 xs, ys;
+		LoadAoS(v + i, xs, ys);
+		NormalizeLanes(&xs, &ys);
+		StoreAoS(out + i, xs, ys);
+	}
+#endif
+
+	for(; i < count; i++)
+	{ out[i] = VectorNormalize(v[i]); }
+}
+
+void Vector_Batch_Rotate(vector2 *out, vector2 *v, float degrees, int32 count)
+{
+	float c, s;
+	GetRotation(degrees, &c, &s);
+
+	int32 i = 0;
+
+#ifdef VECTOR_BATCH_SSE2
+	__m128 vc = _mm_set1_ps(c);
+	__m128 vs = _mm_set1_ps(s);
+
+	for(; i + 4 <= count; i += 4)
+	{
+		__m128 xs, ys;
+		LoadAoS(v + i, xs, ys);
+		RotateLanes(&xs, &ys, vc, vs);
+		StoreAoS(out + i, xs, ys);
+	}
+#endif
+
+	for(; i < count; i++)
+	{ out[i] = RotateScalar(v[i], c, s); }
+}
+
+void Vector_Batch_Transform(vector2 *out, vector2 *v, vector2 scale, float degrees, vector2 translation, int32 count)
+{
+	float c, s;
+	GetRotation(degrees, &c, &s);
+
+	int32 i = 0;
+
+#ifdef VECTOR_BATCH_SSE2
+	__m128 vc = _mm_set1_ps(c);
+	__m128 vs = _mm_set1_ps(s);
+	__m128 sx = _mm_set1_ps(scale.x);
+	__m128 sy = _mm_set1_ps(scale.y);
+	__m128 tx = _mm_set1_ps(translation.x);
+	__m128 ty = _mm_set1_ps(translation.y);
+
+	for(; i + 4 <= count; i += 4)
+	{
+		__m128 xs, ys;
+		LoadAoS(v + i, xs, ys);
+
+		xs = _mm_mul_ps(xs, sx);
+		ys = _mm_mul_ps(ys, sy);
+		RotateLanes(&xs, &ys, vc, vs);
+		xs = _mm_add_ps(xs, tx);
+		ys = _mm_add_ps(ys, ty);
+
+		StoreAoS(out + i, xs, ys);
+	}
+#endif
+
+	for(; i < count; i++)
+	{ out[i] = TransformScalar(v[i], scale, c, s, translation); }
+}
+
+void Vector_Batch_ProjectMinMax(vector2 *v, int32 count, vector2 offset, vector2 axis, float *outMin, float *outMax)
+{
+	float projMin = FLT_MAX;
+	float projMax = -FLT_MAX;
+	int32 i = 0;
+
+#ifdef VECTOR_BATCH_SSE2
+	if(count >= 4)
+	{
+		__m128 ox = _mm_set1_ps(offset.x);
+		__m128 oy = _mm_set1_ps(offset.y);
+		__m128 ax = _mm_set1_ps(axis.x);
+		__m128 ay = _mm_set1_ps(axis.y);
+
+		__m128 vMin = _mm_set1_ps(FLT_MAX);
+		__m128 vMax = _mm_set1_ps(-FLT_MAX);
+
+		for(; i + 4 <= count; i += 4)
+		{
+			__m128 xs, ys;
+			LoadAoS(v + i, xs, ys);
+
+			__m128 dots = ProjectLanes(xs, ys, ox, oy, ax, ay);
+			vMin = _mm_min_ps(vMin, dots);
+			vMax = _mm_max_ps(vMax, dots);
+		}
+
+		ReduceMinMax(vMin, vMax, &projMin, &projMax);
+	}
+#endif
+
+	for(; i < count; i++)
+	{
+		float dot = ProjectScalar(v[i], offset, axis);
+		projMin = min(projMin, dot);
+		projMax = max(projMax, dot);
+	}
+
+	*outMin = projMin;
+	*outMax = projMax;
+}
+
+// - - - - - -
+// SoA
+// - - - - - -
+
+void Vector_Batch_AddSoA(vector2_soa out, vector2_soa a, vector2_soa b, int32 count)
+{
+	int32 i = 0;
+
+#ifdef VECTOR_BATCH_SSE2
+	for(; i + 4 <= count; i += 4)
+	{
+		_mm_storeu_ps(out.x + i, _mm_add_ps(_mm_loadu_ps(a.x + i), _mm_loadu_ps(b.x + i)));
+		_mm_storeu_ps(out.y + i, _mm_add_ps(_mm_loadu_ps(a.y + i), _mm_loadu_ps(b.y + i)));
+	}
+#endif
+
+	for(; i < count; i++)
+	{
+		out.x[i] = a.x[i] + b.x[i];
+		out.y[i] = a.y[i] + b.y[i];
+	}
+}
+
+void Vector_Batch_ScaleSoA(vector2_soa out, vector2_soa v, float s, int32 count)
+{
+	int32 i = 0;
+
+#ifdef VECTOR_BATCH_SSE2
+	__m128 vs = _mm_set1_ps(s);
+	for(; i + 4 <= count; i += 4)
+	{
+		_mm_storeu_ps(out.x + i, _mm_mul_ps(_mm_loadu_ps(v.x + i), vs));
+		_mm_storeu_ps(out.y + i, _mm_mul_ps(_mm_loadu_ps(v.y + i), vs));
+	}
+#endif
+
+	for(; i < count; i++)
+	{
+		out.x[i] = v.x[i] * s;
+		out.y[i] = v.y[i] * s;
+	}
+}
+
+void Vector_Batch_DotSoA(float *out, vector2_soa a, vector2_soa b, int32 count)
+{
+	int32 i = 0;
+
+#ifdef VECTOR_BATCH_SSE2
+	for(; i + 4 <= count; i += 4)
+	{
+		__m128 xx = _mm_mul_ps(_mm_loadu_ps(a.x + i), _mm_loadu_ps(b.x + i));
+		__m128 yy = _mm_mul_ps(_mm_loadu_ps(a.y + i), _mm_loadu_ps(b.y + i));
+		_mm_storeu_ps(out + i, _mm_add_ps(xx, yy));
+	}
+#endif
+
+	for(; i < count; i++)
+	{ out[i] = (a.x[i] * b.x[i]) + (a.y[i] * b.y[i]); }
+}
+
+void Vector_Batch_NormalizeSoA(vector2_soa out, vector2_soa v, int32 count)
+{
+	int32 i = 0;
+
+#ifdef VECTOR_BATCH_SSE2
+	for(; i + 4 <= count; i += 4)
+	{
+		__m128 xs = _mm_loadu_ps(v.x + i);
+		__m128 ys = _mm_loadu_ps(v.y + i);
+		NormalizeLanes(&xs, &ys);
+
+		_mm_storeu_ps(out.x + i, xs);
+		_mm_storeu_ps(out.y + i, ys);
+	}
+#endif
+
+	for(; i < count; i++)
+	{
+		vector2 n = VectorNormalize((vector2) { v.x[i], v.y[i] });
+		out.x[i] = n.x;
+		out.y[i] = n.y;
+	}
+}
+
+void Vector_Batch_RotateSoA(vector2_soa out, vector2_soa v, float degrees, int32 count)
+{
+	float c, s;
+	GetRotation(degrees, &c, &s);
+
+	int32 i = 0;
+
+#ifdef VECTOR_BATCH_SSE2
+	__m128 vc = _mm_set1_ps(c);
+	__m128 vs = _mm_set1_ps(s);
+
+	for(; i + 4 <= count; i += 4)
+	{
+		__m128 xs = _mm_loadu_ps(v.x + i);
+		__m128 ys = _mm_loadu_ps(v.y + i);
+		RotateLanes(&xs, &ys, vc, vs);
+
+		_mm_storeu_ps(out.x + i, xs);
+		_mm_storeu_ps(out.y + i, ys);
+	}
+#endif
+
+	for(; i < count; i++)
+	{
+		vector2 r = RotateScalar((vector2) { v.x[i], v.y[i] }, c, s);
+		out.x[i] = r.x;
+		out.y[i] = r.y;
+	}
+}
+
+void Vector_Batch_TransformSoA(vector2_soa out, vector2_soa v, vector2 scale, float degrees, vector2 translation, int32 count)
+{
+	float c, s;
+	GetRotation(degrees, &c, &s);
+
+	int32 i = 0;
+
+#ifdef VECTOR_BATCH_SSE2
+	__m128 vc = _mm_set1_ps(c);
+	__m128 vs = _mm_set1_ps(s);
+	__m128 sx = _mm_set1_ps(scale.x);
+	__m128 sy = _mm_set1_ps(scale.y);
+	__m128 tx = _mm_set1_ps(translation.x);
+	__m128 ty = _mm_set1_ps(translation.y);
+
+	for(; i + 4 <= count; i += 4)
+	{
+		__m128 xs = _mm_mul_ps(_mm_loadu_ps(v.x + i), sx);
+		__m128 ys = _mm_mul_ps(_mm_loadu_ps(v.y + i), sy);
+		RotateLanes(&xs, &ys, vc, vs);
+
+		_mm_storeu_ps(out.x + i, _mm_add_ps(xs, tx));
+		_mm_storeu_ps(out.y + i, _mm_add_ps(ys, ty));
+	}
+#endif
+
+	for(; i < count; i++)
+	{
+		vector2 t = TransformScalar((vector2) { v.x[i], v.y[i] }, scale, c, s, translation);
+		out.x[i] = t.x;
+		out.y[i] = t.y;
+	}
+}
+
+void Vector_Batch_ProjectMinMaxSoA(vector2_soa v, int32 count, vector2 offset, vector2 axis, float *outMin, float *outMax)
+{
+	float projMin = FLT_MAX;
+	float projMax = -FLT_MAX;
+	int32 i = 0;
+
+#ifdef VECTOR_BATCH_SSE2
+	if(count >= 4)
+	{
+		__m128 ox = _mm_set1_ps(offset.x);
+		__m128 oy = _mm_set1_ps(offset.y);
+		__m128 ax = _mm_set1_ps(axis.x);
+		__m128 ay = _mm_set1_ps(axis.y);
+
+		__m128 vMin = _mm_set1_ps(FLT_MAX);
+		__m128 vMax = _mm_set1_ps(-FLT_MAX);
+
+		for(; i + 4 <= count; i += 4)
+		{
+			__m128 dots = ProjectLanes(_mm_loadu_ps(v.x + i), _mm_loadu_ps(v.y + i), ox, oy, ax, ay);
+			vMin = _mm_min_ps(vMin, dots);
+			vMax = _mm_max_ps(vMax, dots);
+		}
+
+		ReduceMinMax(vMin, vMax, &projMin, &projMax);
+	}
+#endif
+
+	for(; i < count; i++)
+	{
+		float dot = ProjectScalar((vector2) { v.x[i], v.y[i] }, offset, axis);
+		projMin = min(projMin, dot);
+		projMax = max(projMax, dot);
+	}
+
+	*outMin = projMin;
+	*outMax = projMax;
+}
+
+// - - - - - -
+// conversion
+// - - - - - -
+
+void Vector_Batch_ToSoA(vector2_soa out, vector2 *v, int32 count)
+{
+	int32 i = 0;
+
+#ifdef VECTOR_BATCH_SSE2
+	for(; i + 4 <= count; i += 4)
+	{
+		__m128 xs, ys;
+		LoadAoS(v + i, xs, ys);
+
+		_mm_storeu_ps(out.x + i, xs);
+		_mm_storeu_ps(out.y + i, ys);
+	}
+#endif
+
+	for(; i < count; i++)
+	{
+		out.x[i] = v[i].x;
+		out.y[i] = v[i].y;
+	}
+}
+
+void Vector_Batch_ToAoS(vector2 *out, vector2_soa v, int32 count)
+{
+	int32 i = 0;
+
+#ifdef VECTOR_BATCH_SSE2
+	for(; i + 4 <= count; i += 4)
+	{
+		__m128 xs = _mm_loadu_ps(v.x + i);
+		__m128 ys = _mm_loadu_ps(v.y + i);
+		StoreAoS(out + i, xs, ys);
+	}
+#endif
+
+	for(; i < count; i++)
+	{
+		out[i].x = v.x[i];
+		out[i].y = v.y[i];
+	}
+}
\ No newline at end of file
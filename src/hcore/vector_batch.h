@@ -0,0 +1,52 @@
+#pragma once
+
+#include "_shared.h"
+
+// batched versions of the vector.h operations, over whole arrays at once.
+// each operation comes in two layouts:
+//   - AoS: an array of vector2 (x, y, x, y, ...)
+//   - SoA: separate x and y arrays (x, x, ..., y, y, ...)
+// with SSE2 available, 4 vectors are processed per iteration; otherwise, the scalar vector.h functions are used.
+// both paths perform the same floating point operations in the same order, so results are identical.
+// output arrays may alias input arrays.
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define VECTOR_BATCH_SSE2
+#endif
+
+typedef struct
+{
+	float *x;
+	float *y;
+} vector2_soa;
+
+// - - - - - -
+// AoS
+// - - - - - -
+
+void Vector_Batch_Add(vector2 *out, vector2 *a, vector2 *b, int32 count);
+void Vector_Batch_Scale(vector2 *out, vector2 *v, float s, int32 count);
+void Vector_Batch_Dot(float *out, vector2 *a, vector2 *b, int32 count);
+void Vector_Batch_Normalize(vector2 *out, vector2 *v, int32 count);
+void Vector_Batch_Rotate(vector2 *out, vector2 *v, float degrees, int32 count);
+void Vector_Batch_Transform(vector2 *out, vector2 *v, vector2 scale, float degrees, vector2 translation, int32 count);
+void Vector_Batch_ProjectMinMax(vector2 *v, int32 count, vector2 offset, vector2 axis, float *outMin, float *outMax);
+
+// - - - - - -
+// SoA
+// - - - - - -
+
+void Vector_Batch_AddSoA(vector2_soa out, vector2_soa a, vector2_soa b, int32 count);
+void Vector_Batch_ScaleSoA(vector2_soa out, vector2_soa v, float s, int32 count);
+void Vector_Batch_DotSoA(float *out, vector2_soa a, vector2_soa b, int32 count);
+void Vector_Batch_NormalizeSoA(vector2_soa out, vector2_soa v, int32 count);
+void Vector_Batch_RotateSoA(vector2_soa out, vector2_soa v, float degrees, int32 count);
+void Vector_Batch_TransformSoA(vector2_soa out, vector2_soa v, vector2 scale, float degrees, vector2 translation, int32 count);
+void Vector_Batch_ProjectMinMaxSoA(vector2_soa v, int32 count, vector2 offset, vector2 axis, float *outMin, float *outMax);
+
+// - - - - - -
+// conversion
+// - - - - - -
+
+void Vector_Batch_ToSoA(vector2_soa out, vector2 *v, int32 count);
+void Vector_Batch_ToAoS(vector2 *out, vector2_soa v, int32 count);
\ No newline at end of file
@@ -1,47 +1,111 @@
 #include "video.h"
 
-extern bool Video_Windows_Init();
+extern bool Video_Windows_Init(video_backend backend);
 extern void Video_Windows_Quit();
-extern struct video_windows_state Video_Windows_GetSnapshot();
+extern uint64 Video_Windows_GetChanges();
+extern void Video_Windows_GetSnapshot(struct video_windows_state *state);
 
 extern bool Video_Textures_Init();
 extern void Video_Textures_Quit();
-extern struct video_textures_state Video_Textures_GetSnapshot();
+extern uint64 Video_Textures_GetChanges();
+extern void Video_Textures_GetSnapshot(struct video_textures_state *state);
 
-extern struct video_queue_state Video_Queue_GetSnapshot();
+extern void Video_Targets_Quit();
+extern void Video_Tilemaps_Quit();
+extern void Video_Primitives_Quit();
 
-bool Video_Init()
+extern void Video_Queue_Quit();
+extern uint64 Video_Queue_GetChanges();
+extern void Video_Queue_GetSnapshot(struct video_queue_state *state);
+
+intern video_state snapshot;
+intern uint64 gatheredAt[VIDEO_SNAPSHOT_COUNT];	// each section's source's change count, as of its last gather
+intern bool hasSDLVideo;
+
+bool Video_Init(video_config config)
 {
-	if(SDL_InitSubSystem(SDL_INIT_VIDEO) >= 0)
+	// offscreen backends never open a real window, so they don't need a display, or SDL video
+	hasSDLVideo = (config.backend == VIDEO_BACKEND_WINDOWED);
+
+	// no change count gets this high, so every section is gathered on its first request
+	memset(gatheredAt, 0xFF, sizeof(gatheredAt));
+
+	if(hasSDLVideo)
 	{
-		LogNote("SDL video successfully initialized");
-		
-		if(Video_Windows_Init() && Video_Textures_Init())
+		if(SDL_InitSubSystem(SDL_INIT_VIDEO) >= 0)
+		{ LogNote("SDL video successfully initialized"); }
+		else
 		{
-			LogNote("video successfully initialized");
-			return true;
+			LogFailure("SDL video failed to initialized\n\tSDL error: %s", SDL_GetError());
+			return false;
 		}
 	}
-	else
-	{ LogFailure("SDL video failed to initialized\n\tSDL error: %s", SDL_GetError()); }
+
+	if(Video_Windows_Init(config.backend) && Video_Textures_Init())
+	{
+		LogNote("video successfully initialized");
+		return true;
+	}
 
 	return false;
 }
 
 void Video_Quit()
 {
+	Video_Queue_Quit();
+	Video_Tilemaps_Quit();
 	Video_Textures_Quit();
+	Video_Targets_Quit();
 	Video_Windows_Quit();
+	Video_Primitives_Quit();
 
-	SDL_QuitSubSystem(SDL_INIT_VIDEO);
+	if(hasSDLVideo)
+	{ SDL_QuitSubSystem(SDL_INIT_VIDEO); }
 }
 
 HEXPORT(void) Video_GetSnapshot(video_state *state)
 {
-	*state = (video_state)
+	AssertPtr(state);
+	*state = *Video_GetSnapshotView(UINT32_MAX);
+}
+
+HEXPORT(video_state*) Video_GetSnapshotView(uint32 sectionMask)
+{
+	snapshot.header.version = VIDEO_SNAPSHOT_VERSION;
+	snapshot.header.size = sizeof(video_state);
+	snapshot.header.sectionCount = VIDEO_SNAPSHOT_COUNT;
+	snapshot.header.sectionOffsets[VIDEO_SNAPSHOT_WINDOWS] = offsetof(video_state, windows);
+	snapshot.header.sectionOffsets[VIDEO_SNAPSHOT_TEXTURES] = offsetof(video_state, textures);
+	snapshot.header.sectionOffsets[VIDEO_SNAPSHOT_QUEUE] = offsetof(video_state, queue);
+
+	// sections are only gathered once their source has changed, and only copied over (with a new generation)
+	// if what was gathered differs; a frame that didn't touch a source skips its section entirely
+	if(FlagTest(sectionMask, 1 << VIDEO_SNAPSHOT_WINDOWS) &&
+		Snapshot_CheckSection(Video_Windows_GetChanges(), &gatheredAt[VIDEO_SNAPSHOT_WINDOWS]))
 	{
-		.windows = Video_Windows_GetSnapshot(),
-		.textures = Video_Textures_GetSnapshot(),
-		.queue = Video_Queue_GetSnapshot()
-	};
+		struct video_windows_state fresh;
+		memset(&fresh, 0, sizeof(fresh));
+		Video_Windows_GetSnapshot(&fresh);
+		Snapshot_UpdateSection(&snapshot.windows, &fresh, sizeof(fresh));
+	}
+
+	if(FlagTest(sectionMask, 1 << VIDEO_SNAPSHOT_TEXTURES) &&
+		Snapshot_CheckSection(Video_Textures_GetChanges(), &gatheredAt[VIDEO_SNAPSHOT_TEXTURES]))
+	{
+		struct video_textures_state fresh;
+		memset(&fresh, 0, sizeof(fresh));
+		Video_Textures_GetSnapshot(&fresh);
+		Snapshot_UpdateSection(&snapshot.textures, &fresh, sizeof(fresh));
+	}
+
+	if(FlagTest(sectionMask, 1 << VIDEO_SNAPSHOT_QUEUE) &&
+		Snapshot_CheckSection(Video_Queue_GetChanges(), &gatheredAt[VIDEO_SNAPSHOT_QUEUE]))
+	{
+		struct video_queue_state fresh;
+		memset(&fresh, 0, sizeof(fresh));
+		Video_Queue_GetSnapshot(&fresh);
+		Snapshot_UpdateSection(&snapshot.queue, &fresh, sizeof(fresh));
+	}
+
+	return &snapshot;
 }
\ No newline at end of file
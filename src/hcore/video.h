@@ -41,7 +41,24 @@ typedef struct
 // video
 // - - - - - -
 
-bool Video_Init();
+// SDL_RenderGeometry arrived in SDL 2.0.18; older versions batch primitives as points and rects instead, and draw each tilemap chunk once into a cached texture
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+#define VIDEO_GEOMETRY
+#endif
+
+typedef enum
+{
+	VIDEO_BACKEND_WINDOWED,	// real windows, drawn by whichever renderer their flags ask for
+	VIDEO_BACKEND_SOFTWARE,	// no windows or display; each draws to an offscreen surface, with SDL's software renderer
+	VIDEO_BACKEND_NULL		// no windows, and nothing drawn; draws are only counted
+} video_backend;
+
+typedef struct
+{
+	video_backend backend;
+} video_config;
+
+bool Video_Init(video_config config);
 void Video_Quit();
 
 // - - - - - -
@@ -66,6 +83,14 @@ typedef struct
 	screen_rect viewportRect;
 } window_info;
 
+// kept by every backend, so the null backend can still be measured
+typedef struct
+{
+	uint64 drawCalls;	// primitives, textures, render targets and tilemaps
+	uint64 points;		// drawn by point, line and polygon calls
+	uint64 presents;
+} window_draw_stats;
+
 typedef enum
 {
 	POINTS_DRAW_POINTS,
@@ -77,6 +102,8 @@ void Video_Windows_Event(SDL_WindowEvent *ev);
 HEXPORT(void) Video_Windows_OpenWindow(int windowID, char *title, screen_rect rect, uint32 windowFlags, uint32 rendererFlags);
 HEXPORT(void) Video_Windows_CloseWindow(int windowID);
 HEXPORT(bool) Video_Windows_CheckWindow(int windowID);
+HEXPORT(void) Video_Windows_GetDrawStats(int windowID, window_draw_stats *stats);
+HEXPORT(bool) Video_Windows_SaveImage(int windowID, char *filePath);	// as a BMP; only the software backend keeps a frame after it's presented
 
 HEXPORT(void) Video_Windows_SetWindowColor(int windowID, color color);
 HEXPORT(void) Video_Windows_ClearWindow(int windowID);
@@ -86,8 +113,13 @@ HEXPORT(void) Video_Windows_DrawPoint(int windowID, screen_point point);
 HEXPORT(void) Video_Windows_DrawLine(int windowID, screen_line line);
 HEXPORT(void) Video_Windows_DrawPoints(int windowID, points_draw_mode mode, screen_point *points, int count);
 HEXPORT(void) Video_Windows_DrawRect(int windowID, screen_rect rect, bool fill);
+HEXPORT(void) Video_Windows_FillPolygon(int windowID, screen_point *points, int count);
 HEXPORT(void) Video_Windows_DrawTexture(int windowID, int textureID, screen_point position, float rotation);
 
+HEXPORT(void) Video_Windows_SetTarget(int windowID, int targetID);	// -1 draws to the window itself again
+HEXPORT(void) Video_Windows_DrawTarget(int windowID, int targetID, screen_point position);
+HEXPORT(void) Video_Windows_DrawTilemap(int windowID, int tilemapID, int32 chunkX, int32 chunkY, screen_point position);
+
 // - - - - - -
 // textures
 // - - - - - -
@@ -95,11 +127,59 @@ HEXPORT(void) Video_Windows_DrawTexture(int windowID, int textureID, screen_poin
 #define AssertTexture(id) Assert(Video_Textures_CheckTexture(id), "texture %i is invalid", id)
 
 HEXPORT(int) Video_Textures_LoadTexture(char *filePath);
+HEXPORT(int) Video_Textures_RequestTexture(char *filePath);	// loads in the background; the texture isn't drawn until it's ready
 HEXPORT(void) Video_Textures_FreeTexture(int textureID);
 HEXPORT(bool) Video_Textures_CheckTexture(int textureID);
+HEXPORT(uint64) Video_Textures_GetTextureSize(int textureID);
+HEXPORT(void) Video_Textures_SetBudget(uint64 bytes);		// only reported; streaming code enforces it
 
 HEXPORT(void) Video_Textures_ClearCache();
 
+// - - - - - -
+// render targets
+// - - - - - -
+
+#define VIDEO_TARGETS_MAX 64
+
+#define AssertTarget(id) Assert(Video_Targets_CheckTarget(id), "render target %i is invalid", id)
+
+void Video_Targets_Event(SDL_Event *ev);
+
+// targets are offscreen textures, drawn to and drawn with by a single window
+HEXPORT(int) Video_Targets_CreateTarget(int windowID, int w, int h);
+HEXPORT(void) Video_Targets_FreeTarget(int targetID);
+HEXPORT(bool) Video_Targets_CheckTarget(int targetID);
+HEXPORT(bool) Video_Targets_IsLost(int targetID);	// true until first drawn, and whenever the renderer drops its contents
+
+// - - - - - -
+// tilemaps
+// - - - - - -
+
+#define VIDEO_TILESETS_MAX 64
+#define VIDEO_TILEMAPS_MAX 64
+
+// tiles are numbered from 1, left-to-right then top-to-bottom across the tileset's texture
+#define VIDEO_TILE_EMPTY 0
+
+#define AssertTileset(id) Assert(Video_Tilemaps_CheckTileset(id), "tileset %i is invalid", id)
+#define AssertTilemap(id) Assert(Video_Tilemaps_CheckTilemap(id), "tilemap %i is invalid", id)
+
+void Video_Tilemaps_Event(SDL_Event *ev);
+
+HEXPORT(int) Video_Tilemaps_CreateTileset(int textureID, int tileW, int tileH);
+HEXPORT(void) Video_Tilemaps_FreeTileset(int tilesetID);	// fails while tilemaps still use it
+HEXPORT(bool) Video_Tilemaps_CheckTileset(int tilesetID);
+
+// tilemaps are split into square chunks, chunkTiles to a side, which are only stored once they hold tiles
+HEXPORT(int) Video_Tilemaps_CreateTilemap(int tilesetID, int chunkTiles);
+HEXPORT(void) Video_Tilemaps_FreeTilemap(int tilemapID);
+HEXPORT(bool) Video_Tilemaps_CheckTilemap(int tilemapID);
+
+// tiles within a chunk are y-up, from its bottom-left corner
+HEXPORT(void) Video_Tilemaps_SetTile(int tilemapID, int32 chunkX, int32 chunkY, int x, int y, uint16 tile);
+HEXPORT(uint16) Video_Tilemaps_GetTile(int tilemapID, int32 chunkX, int32 chunkY, int x, int y);
+HEXPORT(void) Video_Tilemaps_SetChunk(int tilemapID, int32 chunkX, int32 chunkY, uint16 *tiles);	// chunkTiles^2 tiles, bottom row first; NULL empties it
+
 // - - - - - -
 // command queue
 // - - - - - -
@@ -115,10 +195,14 @@ typedef enum
 	VID_COMMAND_LINE,
 	VID_COMMAND_POLYGON,
 	VID_COMMAND_RECT,
-	VID_COMMAND_TEXTURE
+	VID_COMMAND_TEXTURE,
+	VID_COMMAND_TARGET,		// redirects the commands after it to a render target
+	VID_COMMAND_BLIT,		// draws a render target
+	VID_COMMAND_TILEMAP
 } vid_command_type;
 
-#define VIDEO_QUEUE_SIZE 1024
+// queues grow as needed; this is only how many of a queue's commands its snapshot lists
+#define VIDEO_QUEUE_SNAPSHOT_COMMANDS 1024
 
 HEXPORT(void) Video_Queue_OpenWindow(int windowID, char *title, screen_rect rect, uint32 windowFlags, uint32 rendererFlags);
 HEXPORT(void) Video_Queue_CloseWindow(int windowID);
@@ -130,10 +214,15 @@ HEXPORT(void) Video_Queue_DrawLine(int windowID, color color, screen_line line);
 HEXPORT(void) Video_Queue_DrawPoints(int windowID, color color, screen_point *points, int count);
 HEXPORT(void) Video_Queue_DrawPolygon(int windowID, color color, screen_point *points, int count);
 HEXPORT(void) Video_Queue_DrawRect(int windowID, color color, screen_rect rect, bool fill);
+HEXPORT(void) Video_Queue_FillPolygon(int windowID, color color, screen_point *points, int count);
 HEXPORT(void) Video_Queue_DrawTexture(int windowID, int textureID, screen_point position, float rotation);
+HEXPORT(void) Video_Queue_SetTarget(int windowID, int targetID);
+HEXPORT(void) Video_Queue_DrawTarget(int windowID, int targetID, screen_point position);
+HEXPORT(void) Video_Queue_DrawTilemap(int windowID, int tilemapID, int32 chunkX, int32 chunkY, screen_point position);	// position is chunk (chunkX, chunkY)'s bottom-left corner
 
 HEXPORT(void) Video_Queue_Pump(int windowID);
 HEXPORT(void) Video_Queue_ClearQueue(int windowID);
+HEXPORT(void) Video_Queue_SetBudget(int windowID, int maxCommands, int maxPoints);	// 0 for no budget; anything past it is dropped
 
 HEXPORT(void) Video_Queue_PumpAll();
 HEXPORT(void) Video_Queue_ClearAll();
@@ -142,17 +231,36 @@ HEXPORT(void) Video_Queue_ClearAll();
 // state snapshot
 // - - - - - -
 
+#define VIDEO_SNAPSHOT_VERSION 3
+
+typedef enum
+{
+	VIDEO_SNAPSHOT_WINDOWS,
+	VIDEO_SNAPSHOT_TEXTURES,
+	VIDEO_SNAPSHOT_QUEUE,
+	VIDEO_SNAPSHOT_COUNT
+} video_snapshot_section;
+
 typedef struct
 {
+	snapshot_header header;
+
 	struct video_windows_state
 	{
+		uint64 generation;
 		window_info windowInfo[VIDEO_WINDOWS_MAX];
 	} windows;
 
 	struct video_textures_state
 	{
+		uint64 generation;
+
 		int maxSurfaces;
 		int surfaceCount;
+		int pendingCount;	// requested, but not loaded yet
+
+		uint64 residentBytes;
+		uint64 budgetBytes;	// 0 if there's no budget
 
 		int cacheSize;
 		int cacheUsage;
@@ -160,12 +268,24 @@ typedef struct
 
 	struct video_queue_state
 	{
+		uint64 generation;
+
 		struct video_queue_info
 		{
 			int commandCount;
-			uint8 commands[VIDEO_QUEUE_SIZE];
+			int pointCount;
+			int commandHighWater;	// the most commands and points queued in a frame so far
+			int pointHighWater;
+			int droppedCount;		// over budget or out of memory, since video started
+
+			uint8 commands[VIDEO_QUEUE_SNAPSHOT_COMMANDS];
 		} queues[VIDEO_WINDOWS_MAX];
 	} queue;
 } video_state;
 
-HEXPORT(void) Video_GetSnapshot(video_state *state);
\ No newline at end of file
+HEXPORT(void) Video_GetSnapshot(video_state *state);
+
+// refreshes the sections in sectionMask (bits of video_snapshot_section) and returns the
+// persistent snapshot; it stays valid until video quits, and the other sections are left as
+// they were last refreshed
+HEXPORT(video_state*) Video_GetSnapshotView(uint32 sectionMask);
\ No newline at end of file
@@ -0,0 +1,429 @@
+#include "video.h"
+
+// primitives arrive in sdl coordinates (y-down), already converted by the window drawing them
+
+#if defined(VIDEO_GEOMETRY)
+
+// every primitive becomes colored triangles, gathered until something else needs drawing;
+// a window's whole run of lines, rects and polygons then goes out in one SDL_RenderGeometry call
+typedef struct
+{
+	SDL_Vertex *vertices;
+	int vertexCount;
+	int capacity;
+} primitive_batch;
+
+intern primitive_batch batches[VIDEO_WINDOWS_MAX];
+
+intern SDL_Vertex *PushVertices(int windowID, int count)
+{
+	AssertIndex(windowID, VIDEO_WINDOWS_MAX);
+
+	primitive_batch *b = &batches[windowID];
+	if(b->vertexCount + count > b->capacity)
+	{
+		int capacity = max(b->vertexCount + count, max(b->capacity * 2, 1024));
+		SDL_Vertex *vertices = Memory_Realloc(MEMORY_TAG_VIDEO, b->vertices, sizeof(SDL_Vertex) * capacity);
+		if(!vertices)
+		{
+			LogError("couldn't batch primitives for window %i: out of memory", windowID);
+			return NULL;
+		}
+
+		b->vertices = vertices;
+		b->capacity = capacity;
+	}
+
+	SDL_Vertex *v = &b->vertices[b->vertexCount];
+	b->vertexCount += count;
+
+	return v;
+}
+
+intern void PushTriangle(int windowID, color c, float x0, float y0, float x1, float y1, float x2, float y2)
+{
+	SDL_Vertex *v = PushVertices(windowID, 3);
+	if(v)
+	{
+		SDL_Color sc = { c.r, c.g, c.b, c.a };
+
+		v[0] = (SDL_Vertex) { { x0, y0 }, sc, { 0, 0 } };
+		v[1] = (SDL_Vertex) { { x1, y1 }, sc, { 0, 0 } };
+		v[2] = (SDL_Vertex) { { x2, y2 }, sc, { 0, 0 } };
+	}
+}
+
+// an axis-aligned quad covering whole pixels
+intern void PushRect(int windowID, color c, float x, float y, float w, float h)
+{
+	if(w <= 0 || h <= 0)
+	{ return; }
+
+	PushTriangle(windowID, c, x, y, x + w, y, x, y + h);
+	PushTriangle(windowID, c, x + w, y, x + w, y + h, x, y + h);
+}
+
+// a one-pixel-wide line through the centers of its end pixels, like SDL_RenderDrawLine
+intern void PushLine(int windowID, color c, screen_point start, screen_point end)
+{
+	float x0 = start.x + 0.5f;
+	float y0 = start.y + 0.5f;
+	float x1 = end.x + 0.5f;
+	float y1 = end.y + 0.5f;
+
+	float dx = x1 - x0;
+	float dy = y1 - y0;
+	float len = sqrtf(dx * dx + dy * dy);
+
+	if(len < 0.5f)
+	{
+		PushRect(windowID, c, (float)(start.x), (float)(start.y), 1, 1);
+		return;
+	}
+
+	// half a pixel along the line for the end caps, and half a pixel across it for the width
+	float ax = dx / len * 0.5f;
+	float ay = dy / len * 0.5f;
+
+	x0 -= ax;
+	y0 -= ay;
+	x1 += ax;
+	y1 += ay;
+
+	float nx = -ay;
+	float ny = ax;
+
+	PushTriangle(windowID, c, x0 + nx, y0 + ny, x1 + nx, y1 + ny, x0 - nx, y0 - ny);
+	PushTriangle(windowID, c, x1 + nx, y1 + ny, x1 - nx, y1 - ny, x0 - nx, y0 - ny);
+}
+
+void Video_Primitives_Quit()
+{
+	for(int i = 0; i < VIDEO_WINDOWS_MAX; i++)
+	{
+		Memory_Free(batches[i].vertices);
+		batches[i] = (primitive_batch) { 0 };
+	}
+}
+
+// draws everything batched so far; call before drawing anything that isn't a primitive
+void Video_Primitives_Flush(int windowID, SDL_Renderer *renderer)
+{
+	AssertIndex(windowID, VIDEO_WINDOWS_MAX);
+	AssertPtr(renderer);
+
+	primitive_batch *b = &batches[windowID];
+	if(b->vertexCount > 0)
+	{
+		if(SDL_RenderGeometry(renderer, NULL, b->vertices, b->vertexCount, NULL, 0) < 0)
+		{ LogError("couldn't draw primitives on window %i\n\tSDL error: %s", windowID, SDL_GetError()); }
+
+		b->vertexCount = 0;
+	}
+}
+
+// anything still batched is drawn to nothing, since the renderer's gone
+void Video_Primitives_Discard(int windowID)
+{
+	AssertIndex(windowID, VIDEO_WINDOWS_MAX);
+	batches[windowID].vertexCount = 0;
+}
+
+void Video_Primitives_DrawPoints(int windowID, SDL_Renderer *renderer, color c, screen_point *points, int count)
+{
+	for(int i = 0; i < count; i++)
+	{ PushRect(windowID, c, (float)(points[i].x), (float)(points[i].y), 1, 1); }
+}
+
+void Video_Primitives_DrawLines(int windowID, SDL_Renderer *renderer, color c, screen_point *points, int count)
+{
+	if(count == 1)
+	{ PushRect(windowID, c, (float)(points[0].x), (float)(points[0].y), 1, 1); }
+
+	for(int i = 1; i < count; i++)
+	{ PushLine(windowID, c, points[i - 1], points[i]); }
+}
+
+void Video_Primitives_DrawRect(int windowID, SDL_Renderer *renderer, color c, SDL_Rect rect, bool fill)
+{
+	float x = (float)(rect.x);
+	float y = (float)(rect.y);
+	float w = (float)(rect.w);
+	float h = (float)(rect.h);
+
+	if(fill || rect.w < 3 || rect.h < 3)
+	{ PushRect(windowID, c, x, y, w, h); }
+	else
+	{
+		// the outline sits just inside the rect, like SDL_RenderDrawRect
+		PushRect(windowID, c, x, y, w, 1);
+		PushRect(windowID, c, x, y + h - 1, w, 1);
+		PushRect(windowID, c, x, y + 1, 1, h - 2);
+		PushRect(windowID, c, x + w - 1, y + 1, 1, h - 2);
+	}
+}
+
+// the polygon must be convex; it's filled as a fan from its first point
+void Video_Primitives_FillPolygon(int windowID, SDL_Renderer *renderer, color c, screen_point *points, int count)
+{
+	for(int i = 2; i < count; i++)
+	{
+		PushTriangle(windowID, c,
+			(float)(points[0].x), (float)(points[0].y),
+			(float)(points[i - 1].x), (float)(points[i - 1].y),
+			(float)(points[i].x), (float)(points[i].y));
+	}
+}
+
+#else
+
+// without geometry support, every primitive becomes pixels and filled rects, gathered until the color changes or
+// something else needs drawing; a window's whole run of one color then costs one SDL_RenderFillRects and one
+// SDL_RenderDrawPoints call, rather than a color change and a draw call per primitive
+typedef struct
+{
+	color c;
+
+	SDL_Point *points;
+	int pointCount;
+	int pointCapacity;
+
+	SDL_Rect *rects;
+	int rectCount;
+	int rectCapacity;
+} primitive_batch;
+
+intern primitive_batch batches[VIDEO_WINDOWS_MAX];
+
+void Video_Primitives_Quit()
+{
+	for(int i = 0; i < VIDEO_WINDOWS_MAX; i++)
+	{
+		Memory_Free(batches[i].points);
+		Memory_Free(batches[i].rects);
+		batches[i] = (primitive_batch) { 0 };
+	}
+}
+
+// draws everything batched so far; call before drawing anything that isn't a primitive
+void Video_Primitives_Flush(int windowID, SDL_Renderer *renderer)
+{
+	AssertIndex(windowID, VIDEO_WINDOWS_MAX);
+	AssertPtr(renderer);
+
+	primitive_batch *b = &batches[windowID];
+	if(b->pointCount == 0 && b->rectCount == 0)
+	{ return; }
+
+	// a batch is all one color, so it doesn't matter which kind goes first
+	SDL_SetRenderDrawColor(renderer, b->c.r, b->c.g, b->c.b, b->c.a);
+
+	if(b->rectCount > 0 && SDL_RenderFillRects(renderer, b->rects, b->rectCount) < 0)
+	{ LogError("couldn't draw primitives on window %i\n\tSDL error: %s", windowID, SDL_GetError()); }
+
+	if(b->pointCount > 0 && SDL_RenderDrawPoints(renderer, b->points, b->pointCount) < 0)
+	{ LogError("couldn't draw primitives on window %i\n\tSDL error: %s", windowID, SDL_GetError()); }
+
+	b->pointCount = 0;
+	b->rectCount = 0;
+}
+
+// anything still batched is drawn to nothing, since the renderer's gone
+void Video_Primitives_Discard(int windowID)
+{
+	AssertIndex(windowID, VIDEO_WINDOWS_MAX);
+
+	batches[windowID].pointCount = 0;
+	batches[windowID].rectCount = 0;
+}
+
+// primitives of another color can't join the batch, so whatever's in it is drawn first
+intern void SetBatchColor(int windowID, SDL_Renderer *renderer, color c)
+{
+	primitive_batch *b = &batches[windowID];
+	if(b->c.r != c.r || b->c.g != c.g || b->c.b != c.b || b->c.a != c.a)
+	{
+		Video_Primitives_Flush(windowID, renderer);
+		b->c = c;
+	}
+}
+
+intern void PushPoint(int windowID, int x, int y)
+{
+	primitive_batch *b = &batches[windowID];
+	if(b->pointCount == b->pointCapacity)
+	{
+		int capacity = max(b->pointCapacity * 2, 1024);
+		SDL_Point *points = Memory_Realloc(MEMORY_TAG_VIDEO, b->points, sizeof(SDL_Point) * capacity);
+		if(!points)
+		{
+			LogError("couldn't batch primitives for window %i: out of memory", windowID);
+			return;
+		}
+
+		b->points = points;
+		b->pointCapacity = capacity;
+	}
+
+	b->points[b->pointCount++] = (SDL_Point) { x, y };
+}
+
+intern void PushRect(int windowID, int x, int y, int w, int h)
+{
+	if(w <= 0 || h <= 0)
+	{ return; }
+
+	primitive_batch *b = &batches[windowID];
+	if(b->rectCount == b->rectCapacity)
+	{
+		int capacity = max(b->rectCapacity * 2, 256);
+		SDL_Rect *rects = Memory_Realloc(MEMORY_TAG_VIDEO, b->rects, sizeof(SDL_Rect) * capacity);
+		if(!rects)
+		{
+			LogError("couldn't batch primitives for window %i: out of memory", windowID);
+			return;
+		}
+
+		b->rects = rects;
+		b->rectCapacity = capacity;
+	}
+
+	b->rects[b->rectCount++] = (SDL_Rect) { x, y, w, h };
+}
+
+// straight lines are one-pixel rects; anything else is stepped out pixel by pixel, like SDL_RenderDrawLine
+// skipStart leaves out the first pixel, so joined lines don't draw (and blend) their shared pixels twice
+intern void PushLine(int windowID, screen_point start, screen_point end, bool skipStart)
+{
+	int dx = abs(end.x - start.x);
+	int dy = abs(end.y - start.y);
+	int sx = (start.x < end.x) ? 1 : -1;
+	int sy = (start.y < end.y) ? 1 : -1;
+
+	if(dy == 0)
+	{
+		int x = skipStart ? start.x + sx : start.x;
+		PushRect(windowID, min(x, end.x), start.y, abs(end.x - x) + 1, 1);
+		return;
+	}
+
+	if(dx == 0)
+	{
+		int y = skipStart ? start.y + sy : start.y;
+		PushRect(windowID, start.x, min(y, end.y), 1, abs(end.y - y) + 1);
+		return;
+	}
+
+	int x = start.x;
+	int y = start.y;
+	int err = dx - dy;
+
+	if(!skipStart)
+	{ PushPoint(windowID, x, y); }
+
+	while(x != end.x || y != end.y)
+	{
+		int e2 = err * 2;
+		if(e2 > -dy)
+		{
+			err -= dy;
+			x += sx;
+		}
+		if(e2 < dx)
+		{
+			err += dx;
+			y += sy;
+		}
+
+		PushPoint(windowID, x, y);
+	}
+}
+
+void Video_Primitives_DrawPoints(int windowID, SDL_Renderer *renderer, color c, screen_point *points, int count)
+{
+	SetBatchColor(windowID, renderer, c);
+
+	for(int i = 0; i < count; i++)
+	{ PushPoint(windowID, points[i].x, points[i].y); }
+}
+
+void Video_Primitives_DrawLines(int windowID, SDL_Renderer *renderer, color c, screen_point *points, int count)
+{
+	SetBatchColor(windowID, renderer, c);
+
+	if(count == 1)
+	{ PushPoint(windowID, points[0].x, points[0].y); }
+
+	for(int i = 1; i < count; i++)
+	{ PushLine(windowID, points[i - 1], points[i], i > 1); }
+}
+
+void Video_Primitives_DrawRect(int windowID, SDL_Renderer *renderer, color c, SDL_Rect rect, bool fill)
+{
+	SetBatchColor(windowID, renderer, c);
+
+	if(fill || rect.w < 3 || rect.h < 3)
+	{ PushRect(windowID, rect.x, rect.y, rect.w, rect.h); }
+	else
+	{
+		// the outline sits just inside the rect, like SDL_RenderDrawRect
+		PushRect(windowID, rect.x, rect.y, rect.w, 1);
+		PushRect(windowID, rect.x, rect.y + rect.h - 1, rect.w, 1);
+		PushRect(windowID, rect.x, rect.y + 1, 1, rect.h - 2);
+		PushRect(windowID, rect.x + rect.w - 1, rect.y + 1, 1, rect.h - 2);
+	}
+}
+
+// the polygon must be convex; without geometry support it's filled one row at a time
+void Video_Primitives_FillPolygon(int windowID, SDL_Renderer *renderer, color c, screen_point *points, int count)
+{
+	if(count < 1)
+	{ return; }
+
+	int top = points[0].y;
+	int bottom = points[0].y;
+	for(int i = 1; i < count; i++)
+	{
+		top = min(top, points[i].y);
+		bottom = max(bottom, points[i].y);
+	}
+
+	SetBatchColor(windowID, renderer, c);
+
+	for(int y = top; y <= bottom; y++)
+	{
+		float left = FLT_MAX;
+		float right = -FLT_MAX;
+
+		// a convex polygon's row is a single span, between its leftmost and rightmost edge crossings
+		for(int i = 0; i < count; i++)
+		{
+			screen_point a = points[i];
+			screen_point b = points[(i + 1) % count];
+
+			if((y < a.y && y < b.y) || (y > a.y && y > b.y))
+			{ continue; }
+
+			if(a.y == b.y)
+			{
+				left = min(left, (float)(min(a.x, b.x)));
+				right = max(right, (float)(max(a.x, b.x)));
+			}
+			else
+			{
+				float x = a.x + (float)(y - a.y) * (b.x - a.x) / (b.y - a.y);
+				left = min(left, x);
+				right = max(right, x);
+			}
+		}
+
+		if(left <= right)
+		{
+			int x0 = (int)(left + 0.5f);
+			int x1 = (int)(right + 0.5f);
+			PushRect(windowID, x0, y, x1 - x0 + 1, 1);
+		}
+	}
+}
+
+#endif
\ No newline at end of file
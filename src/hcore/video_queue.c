@@ -1,3 +1,4 @@
+#include "time.h"
 #include "video.h"
 
 // - - - - - -
@@ -19,10 +20,10 @@ typedef struct
 	screen_rect viewport;
 } vid_command_mode;
 
-#define VIDEO_MAX_POINTS 1024
+// points live in the queue's point arena, so a command stays small however many it draws
 typedef struct
 {
-	screen_point points[VIDEO_MAX_POINTS];
+	int firstPoint;
 	int pointCount;
 } vid_command_points;
 
@@ -31,11 +32,11 @@ typedef struct
 	screen_line line;
 } vid_command_line;
 
-#define VIDEO_MAX_POLYGON_POINTS 64
 typedef struct
 {
-	screen_point points[VIDEO_MAX_POLYGON_POINTS];
+	int firstPoint;
 	int pointCount;
+	bool fill;
 } vid_command_polygon;
 
 typedef struct
@@ -51,6 +52,19 @@ typedef struct
 	float rotation;
 } vid_command_texture;
 
+typedef struct
+{
+	int targetID;
+	screen_point position;
+} vid_command_target;
+
+typedef struct
+{
+	int tilemapID;
+	int32 chunkX, chunkY;
+	screen_point position;
+} vid_command_tilemap;
+
 typedef struct
 {
 	vid_command_type type;
@@ -65,6 +79,8 @@ typedef struct
 		vid_command_polygon polygon;
 		vid_command_rect rect;
 		vid_command_texture texture;
+		vid_command_target target;
+		vid_command_tilemap tilemap;
 	};
 } vid_command;
 
@@ -72,29 +88,127 @@ typedef struct
 // render queue
 // - - - - - -
 
+// both grow as needed, and keep their size between frames
 typedef struct
 {
-	vid_command queue[VIDEO_QUEUE_SIZE];
+	vid_command *queue;
 	int head;
+	int capacity;
+
+	screen_point *points;
+	int pointHead;
+	int pointCapacity;
+
+	int commandBudget;		// 0 if there's no budget
+	int pointBudget;
+
+	int commandHighWater;
+	int pointHighWater;
+	int frameDropped;		// commands dropped since the last clear
+	int droppedCount;
 } render_queue;
 
 intern render_queue renderQueues[VIDEO_WINDOWS_MAX];
+intern uint64 snapshotChanges;	// bumped by anything that moves a queue's heads, counts or commands
+
+intern void DropCommand(int windowID, char const *reason)
+{
+	render_queue *queue = &renderQueues[windowID];
+
+	// once a frame is plenty; the rest are only counted
+	if(queue->frameDropped++ == 0)
+	{ LogWarning("dropping render commands for window %i: %s", windowID, reason); }
+
+	queue->droppedCount++;
+	snapshotChanges++;
+}
+
+intern bool GrowQueue(void **buffer, int *capacity, int needed, size_t size)
+{
+	if(needed <= *capacity)
+	{ return true; }
+
+	int newCapacity = max(needed, max(*capacity * 2, 256));
+	void *newBuffer = Memory_Realloc(MEMORY_TAG_VIDEO, *buffer, size * newCapacity);
+	if(!newBuffer)
+	{ return false; }
+
+	*buffer = newBuffer;
+	*capacity = newCapacity;
+
+	return true;
+}
 
 intern vid_command *QueueNextFreeCommand(int windowID)
 {
+	AssertIndex(windowID, VIDEO_WINDOWS_MAX);
+
 	render_queue *queue = &renderQueues[windowID];
-	if(queue->head < VIDEO_QUEUE_SIZE)
+	if(queue->commandBudget > 0 && queue->head >= queue->commandBudget)
 	{
-		// default to white
-		vid_command *c = &queue->queue[queue->head++];
-		c->color = COLOR_WHITE;
+		DropCommand(windowID, "over the command budget");
+		return NULL;
+	}
 
-		return c;
+	if(!GrowQueue((void**)(&queue->queue), &queue->capacity, queue->head + 1, sizeof(vid_command)))
+	{
+		DropCommand(windowID, "out of memory");
+		return NULL;
 	}
-	else
-	{ LogError("can't queue any more render elements for window %i (limit: %i)", windowID, VIDEO_QUEUE_SIZE); }
 
-	return NULL;
+	// default to white
+	vid_command *c = &queue->queue[queue->head++];
+	memset(c, 0, sizeof(vid_command));
+	c->color = COLOR_WHITE;
+
+	queue->commandHighWater = max(queue->commandHighWater, queue->head);
+	snapshotChanges++;
+
+	return c;
+}
+
+// copies points into the arena, with room for extra points after them; returns the first's index, or -1
+intern int QueuePoints(int windowID, screen_point *points, int count, int extra)
+{
+	AssertIndex(windowID, VIDEO_WINDOWS_MAX);
+	AssertPtr(points);
+
+	render_queue *queue = &renderQueues[windowID];
+	int needed = queue->pointHead + count + extra;
+
+	if(queue->pointBudget > 0 && needed > queue->pointBudget)
+	{
+		DropCommand(windowID, "over the point budget");
+		return -1;
+	}
+
+	if(!GrowQueue((void**)(&queue->points), &queue->pointCapacity, needed, sizeof(screen_point)))
+	{
+		DropCommand(windowID, "out of memory");
+		return -1;
+	}
+
+	// who knows what might happen to the points array between now and render. better copy it
+	int first = queue->pointHead;
+	memcpy(&queue->points[first], points, sizeof(screen_point) * count);
+
+	queue->pointHead = needed;
+	queue->pointHighWater = max(queue->pointHighWater, needed);
+	snapshotChanges++;
+
+	return first;
+}
+
+void Video_Queue_Quit()
+{
+	for(int i = 0; i < VIDEO_WINDOWS_MAX; i++)
+	{
+		Memory_Free(renderQueues[i].queue);
+		Memory_Free(renderQueues[i].points);
+		renderQueues[i] = (render_queue) { 0 };
+	}
+
+	snapshotChanges++;
 }
 
 HEXPORT(void) Video_Queue_OpenWindow(int windowID, char *title, screen_rect rect, uint32 windowFlags, uint32 rendererFlags)
@@ -144,7 +258,7 @@ HEXPORT(void) Video_Queue_ClearWindow(int windowID, color color)
 
 HEXPORT(void) Video_Queue_DrawPoint(int windowID, color color, screen_point point)
 {
-	// DrawPoints does a memcpy, so we can safely get away with just passing a reference to this point
+	// DrawPoints copies into the arena, so we can safely get away with just passing a reference to this point
 	Video_Queue_DrawPoints(windowID, color, &point, 1);
 }
 
@@ -164,21 +278,26 @@ HEXPORT(void) Video_Queue_DrawPoints(int windowID, color color, screen_point *po
 {
 	if(points)
 	{
-		if(count > -1 && count < VIDEO_MAX_POINTS)
+		if(count > 0)
 		{
-			vid_command *c = QueueNextFreeCommand(windowID);
-			if(c)
+			int first = QueuePoints(windowID, points, count, 0);
+			if(first > -1)
 			{
-				c->type = VID_COMMAND_POINTS;
-				c->color = color;
+				vid_command *c = QueueNextFreeCommand(windowID);
+				if(c)
+				{
+					c->type = VID_COMMAND_POINTS;
+					c->color = color;
 
-				// who knows what might happen to the points array between now and render. better copy it
-				memcpy(c->points.points, points, sizeof(screen_point) * count);
-				c->points.pointCount = count;
+					c->points.firstPoint = first;
+					c->points.pointCount = count;
+				}
+				else
+				{ renderQueues[windowID].pointHead = first; }
 			}
 		}
 		else
-		{ LogError("can't queue points: point count (%i) is invalid (max: %i)", count, VIDEO_MAX_POINTS); }
+		{ LogError("can't queue points: point count (%i) is invalid", count); }
 	}
 	else
 	{ LogError("can't queue points: points array is NULL"); }
@@ -188,24 +307,60 @@ HEXPORT(void) Video_Queue_DrawPolygon(int windowID, color color, screen_point *p
 {
 	if(points)
 	{
-		if(count > -1 && count < VIDEO_MAX_POINTS)
+		if(count > 0)
 		{
-			vid_command *c = QueueNextFreeCommand(windowID);
-			if(c)
+			// polygon needs to draw an extra line connecting the last point to the first
+			int first = QueuePoints(windowID, points, count, 1);
+			if(first > -1)
 			{
-				c->type = VID_COMMAND_POLYGON;
-				c->color = color;
+				vid_command *c = QueueNextFreeCommand(windowID);
+				if(c)
+				{
+					c->type = VID_COMMAND_POLYGON;
+					c->color = color;
 
-				// who knows what might happen to the points array between now and render. better copy it
-				memcpy(c->polygon.points, points, sizeof(screen_point) * count);
+					render_queue *queue = &renderQueues[windowID];
+					queue->points[first + count] = queue->points[first];
 
-				// polygon needs to draw an extra line connecting the last point to the first
-				c->polygon.pointCount = count;
-				c->polygon.points[c->polygon.pointCount++] = c->polygon.points[0];
+					c->polygon.firstPoint = first;
+					c->polygon.pointCount = count + 1;
+				}
+				else
+				{ renderQueues[windowID].pointHead = first; }
 			}
 		}
 		else
-		{ LogError("can't queue polygon: point count (%i) is invalid (max: %i)", count, VIDEO_MAX_POINTS); }
+		{ LogError("can't queue polygon: point count (%i) is invalid", count); }
+	}
+	else
+	{ LogError("can't queue polygon: points array is NULL"); }
+}
+
+HEXPORT(void) Video_Queue_FillPolygon(int windowID, color color, screen_point *points, int count)
+{
+	if(points)
+	{
+		if(count > 0)
+		{
+			int first = QueuePoints(windowID, points, count, 0);
+			if(first > -1)
+			{
+				vid_command *c = QueueNextFreeCommand(windowID);
+				if(c)
+				{
+					c->type = VID_COMMAND_POLYGON;
+					c->color = color;
+
+					c->polygon.firstPoint = first;
+					c->polygon.pointCount = count;
+					c->polygon.fill = true;
+				}
+				else
+				{ renderQueues[windowID].pointHead = first; }
+			}
+		}
+		else
+		{ LogError("can't queue polygon: point count (%i) is invalid", count); }
 	}
 	else
 	{ LogError("can't queue polygon: points array is NULL"); }
@@ -243,10 +398,67 @@ HEXPORT(void) Video_Queue_DrawTexture(int windowID, int textureID, screen_point
 	{ LogError("can't queue texture: texture with ID %i is invalid", textureID); }
 }
 
+HEXPORT(void) Video_Queue_SetTarget(int windowID, int targetID)
+{
+	// -1 goes back to drawing to the window
+	if(targetID == -1 || Video_Targets_CheckTarget(targetID))
+	{
+		vid_command *c = QueueNextFreeCommand(windowID);
+		if(c)
+		{
+			c->type = VID_COMMAND_TARGET;
+			c->target.targetID = targetID;
+		}
+	}
+	else
+	{ LogError("can't queue render target: target with ID %i is invalid", targetID); }
+}
+
+HEXPORT(void) Video_Queue_DrawTarget(int windowID, int targetID, screen_point position)
+{
+	if(Video_Targets_CheckTarget(targetID))
+	{
+		vid_command *c = QueueNextFreeCommand(windowID);
+		if(c)
+		{
+			c->type = VID_COMMAND_BLIT;
+
+			c->target.targetID = targetID;
+			c->target.position = position;
+		}
+	}
+	else
+	{ LogError("can't queue render target: target with ID %i is invalid", targetID); }
+}
+
+HEXPORT(void) Video_Queue_DrawTilemap(int windowID, int tilemapID, int32 chunkX, int32 chunkY, screen_point position)
+{
+	if(Video_Tilemaps_CheckTilemap(tilemapID))
+	{
+		vid_command *c = QueueNextFreeCommand(windowID);
+		if(c)
+		{
+			c->type = VID_COMMAND_TILEMAP;
+			c->tilemap = (vid_command_tilemap)
+			{
+				.tilemapID = tilemapID,
+				.chunkX = chunkX,
+				.chunkY = chunkY,
+				.position = position
+			};
+		}
+	}
+	else
+	{ LogError("can't queue tilemap: tilemap with ID %i is invalid", tilemapID); }
+}
+
 HEXPORT(void) Video_Queue_Pump(int windowID)
 {
 	if(Video_Windows_CheckWindow(windowID))
 	{
+		ProfileBegin("Video_Queue_Pump");
+		uint64 statStart = SDL_GetPerformanceCounter();
+
 		render_queue *queue = &renderQueues[windowID];
 
 		// don't bother if there's nothing to do
@@ -276,7 +488,7 @@ HEXPORT(void) Video_Queue_Pump(int windowID)
 						break;
 					case VID_COMMAND_POINTS:
 						Video_Windows_SetWindowColor(windowID, c->color);
-						Video_Windows_DrawPoints(windowID, POINTS_DRAW_POINTS, c->points.points, c->points.pointCount);
+						Video_Windows_DrawPoints(windowID, POINTS_DRAW_POINTS, &queue->points[c->points.firstPoint], c->points.pointCount);
 						break;
 					case VID_COMMAND_LINE:
 						Video_Windows_SetWindowColor(windowID, c->color);
@@ -284,7 +496,10 @@ HEXPORT(void) Video_Queue_Pump(int windowID)
 						break;
 					case VID_COMMAND_POLYGON:
 						Video_Windows_SetWindowColor(windowID, c->color);
-						Video_Windows_DrawPoints(windowID, POINTS_DRAW_LINES, c->polygon.points, c->polygon.pointCount);
+						if(c->polygon.fill)
+						{ Video_Windows_FillPolygon(windowID, &queue->points[c->polygon.firstPoint], c->polygon.pointCount); }
+						else
+						{ Video_Windows_DrawPoints(windowID, POINTS_DRAW_LINES, &queue->points[c->polygon.firstPoint], c->polygon.pointCount); }
 						break;
 					case VID_COMMAND_RECT:
 						Video_Windows_SetWindowColor(windowID, c->color);
@@ -293,14 +508,29 @@ HEXPORT(void) Video_Queue_Pump(int windowID)
 					case VID_COMMAND_TEXTURE:
 						Video_Windows_DrawTexture(windowID, c->texture.textureID, c->texture.position, c->texture.rotation);
 						break;
+					case VID_COMMAND_TARGET:
+						Video_Windows_SetTarget(windowID, c->target.targetID);
+						break;
+					case VID_COMMAND_BLIT:
+						Video_Windows_DrawTarget(windowID, c->target.targetID, c->target.position);
+						break;
+					case VID_COMMAND_TILEMAP:
+						Video_Windows_DrawTilemap(windowID, c->tilemap.tilemapID, c->tilemap.chunkX, c->tilemap.chunkY, c->tilemap.position);
+						break;
 				}
 			}
 
+			// a target left bound would swallow the present
+			Video_Windows_SetTarget(windowID, -1);
+
 			// present anything newly drawn
 			Video_Windows_PresentWindow(windowID);
 		}
 
 		Video_Queue_ClearQueue(windowID);
+
+		Time_AddFrameTime(FRAME_STAT_VIDEO, statStart);
+		ProfileEnd();
 	}
 	else
 	{ LogError("can't pump queue for window %i: window is invalid", windowID); }
@@ -311,13 +541,27 @@ HEXPORT(void) Video_Queue_ClearQueue(int windowID)
 	if(Video_Windows_CheckWindow(windowID))
 	{
 		render_queue *queue = &renderQueues[windowID];
-		memset(queue->queue, 0, sizeof(vid_command) * queue->head);
 		queue->head = 0;
+		queue->pointHead = 0;
+		queue->frameDropped = 0;
+		snapshotChanges++;
 	}
 	else
 	{ LogError("can't clear queue for window %i: window is invalid", windowID); }
 }
 
+HEXPORT(void) Video_Queue_SetBudget(int windowID, int maxCommands, int maxPoints)
+{
+	if(windowID > -1 && windowID < VIDEO_WINDOWS_MAX)
+	{
+		render_queue *queue = &renderQueues[windowID];
+		queue->commandBudget = max(maxCommands, 0);
+		queue->pointBudget = max(maxPoints, 0);
+	}
+	else
+	{ LogError("can't set queue budget for window %i: ID is invalid", windowID); }
+}
+
 HEXPORT(void) Video_Queue_PumpAll()
 {
 	for(int i = 0; i < VIDEO_WINDOWS_MAX; i++)
@@ -330,16 +574,27 @@ HEXPORT(void) Video_Queue_ClearAll()
 	{ Video_Queue_ClearQueue(i); }
 }
 
-struct video_queue_state Video_Queue_GetSnapshot()
+uint64 Video_Queue_GetChanges()
+{
+	return snapshotChanges;
+}
+
+void Video_Queue_GetSnapshot(struct video_queue_state *state)
 {
-	struct video_queue_state state;
 	for(int i = 0; i < VIDEO_WINDOWS_MAX; i++)
 	{
-		state.queues[i].commandCount = renderQueues[i].head;
-
-		for(int c = 0; c < renderQueues[i].head; c++)
-		{ state.queues[i].commands[c] = renderQueues[i].queue[c].type; }
+		render_queue *queue = &renderQueues[i];
+		struct video_queue_info *info = &state->queues[i];
+
+		info->commandCount = queue->head;
+		info->pointCount = queue->pointHead;
+		info->commandHighWater = queue->commandHighWater;
+		info->pointHighWater = queue->pointHighWater;
+		info->droppedCount = queue->droppedCount;
+
+		// only the start of a long queue fits
+		int count = min(queue->head, VIDEO_QUEUE_SNAPSHOT_COMMANDS);
+		for(int c = 0; c < count; c++)
+		{ info->commands[c] = queue->queue[c].type; }
 	}
-
-	return state;
 }
\ No newline at end of file
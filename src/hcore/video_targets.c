@@ -0,0 +1,224 @@
+#include "video.h"
+
+typedef struct
+{
+	bool inUse;
+	bool lost;			// contents are gone, and need to be drawn again
+
+	int windowID;
+	int w, h;
+
+	SDL_Texture *tex;	// created on first use, since it belongs to the window's renderer
+} render_target;
+
+intern render_target targets[VIDEO_TARGETS_MAX];
+
+intern void DestroyTargetTexture(render_target *t)
+{
+	AssertPtr(t);
+
+	if(t->tex)
+	{
+		SDL_DestroyTexture(t->tex);
+		t->tex = NULL;
+	}
+
+	t->lost = true;
+}
+
+intern bool CreateTargetTexture(int targetID, SDL_Renderer *renderer)
+{
+	AssertIndex(targetID, VIDEO_TARGETS_MAX);
+	AssertPtr(renderer);
+
+	render_target *t = &targets[targetID];
+	if(!t->tex)
+	{
+		t->tex = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, t->w, t->h);
+		if(!t->tex)
+		{
+			LogError("couldn't create texture for render target %i\n\tSDL error: %s", targetID, SDL_GetError());
+			return false;
+		}
+
+		// targets are cleared to transparent, so what's under them shows through
+		SDL_SetTextureBlendMode(t->tex, SDL_BLENDMODE_BLEND);
+		t->lost = true;
+	}
+
+	return true;
+}
+
+void Video_Targets_Quit()
+{
+	for(int i = 0; i < VIDEO_TARGETS_MAX; i++)
+	{
+		DestroyTargetTexture(&targets[i]);
+		targets[i].inUse = false;
+	}
+}
+
+// SDL may throw target contents away whenever the device resets
+void Video_Targets_Event(SDL_Event *ev)
+{
+	AssertPtr(ev);
+
+	if(ev->type == SDL_RENDER_DEVICE_RESET)
+	{
+		// the textures themselves are gone too, and have to be recreated
+		for(int i = 0; i < VIDEO_TARGETS_MAX; i++)
+		{ DestroyTargetTexture(&targets[i]); }
+	}
+	else if(ev->type == SDL_RENDER_TARGETS_RESET)
+	{
+		for(int i = 0; i < VIDEO_TARGETS_MAX; i++)
+		{ targets[i].lost = true; }
+	}
+}
+
+// called before a window's renderer goes away, taking its textures with it
+void Video_Targets_FreeWindow(int windowID)
+{
+	for(int i = 0; i < VIDEO_TARGETS_MAX; i++)
+	{
+		if(targets[i].inUse && targets[i].windowID == windowID)
+		{ DestroyTargetTexture(&targets[i]); }
+	}
+}
+
+// binds the target for drawing, or the window itself if targetID is -1
+bool Video_Targets_BindToRenderer(int windowID, int targetID, SDL_Renderer *renderer, screen_rect *rect)
+{
+	AssertPtr(renderer);
+	AssertPtr(rect);
+
+	SDL_Texture *tex = NULL;
+
+	if(targetID > -1)
+	{
+		AssertTarget(targetID);
+
+		render_target *t = &targets[targetID];
+		if(t->windowID != windowID)
+		{
+			LogError("couldn't bind render target %i: it belongs to window %i, not window %i", targetID, t->windowID, windowID);
+			return false;
+		}
+
+		if(!CreateTargetTexture(targetID, renderer))
+		{ return false; }
+
+		tex = t->tex;
+		*rect = (screen_rect) { .w = t->w, .h = t->h };
+	}
+
+	if(SDL_SetRenderTarget(renderer, tex) < 0)
+	{
+		LogError("couldn't bind render target %i on window %i\n\tSDL error: %s", targetID, windowID, SDL_GetError());
+		return false;
+	}
+
+	// whoever bound it is about to draw its contents
+	if(targetID > -1)
+	{ targets[targetID].lost = false; }
+
+	return true;
+}
+
+void Video_Targets_DrawToRenderer(int windowID, int targetID, SDL_Renderer *renderer, screen_rect viewport, screen_point position)
+{
+	AssertTarget(targetID);
+	AssertPtr(renderer);
+
+	render_target *t = &targets[targetID];
+	if(t->windowID != windowID)
+	{
+		LogError("couldn't draw render target %i: it belongs to window %i, not window %i", targetID, t->windowID, windowID);
+		return;
+	}
+
+	// nothing's been drawn to it yet
+	if(!t->tex)
+	{ return; }
+
+	// convert to sdl coordinates (y-down, top-left origin)
+	int y = (viewport.h - position.y) - t->h;
+
+	SDL_Rect r = { position.x, y, t->w, t->h };
+	SDL_RenderCopy(renderer, t->tex, NULL, &r);
+}
+
+HEXPORT(int) Video_Targets_CreateTarget(int windowID, int w, int h)
+{
+	if(windowID < 0 || windowID >= VIDEO_WINDOWS_MAX)
+	{
+		LogError("couldn't create render target: window ID %i is invalid", windowID);
+		return -1;
+	}
+
+	if(w < 1 || h < 1)
+	{
+		LogError("couldn't create render target: size (%i, %i) is invalid", w, h);
+		return -1;
+	}
+
+	for(int i = 0; i < VIDEO_TARGETS_MAX; i++)
+	{
+		render_target *t = &targets[i];
+		if(!t->inUse)
+		{
+			*t = (render_target)
+			{
+				.inUse = true,
+				.lost = true,
+				.windowID = windowID,
+				.w = w,
+				.h = h
+			};
+
+			LogDebug("created %ix%i render target %i for window %i", w, h, i, windowID);
+			return i;
+		}
+	}
+
+	LogError("couldn't create render target: all %i targets are in use", VIDEO_TARGETS_MAX);
+	return -1;
+}
+
+HEXPORT(void) Video_Targets_FreeTarget(int targetID)
+{
+	if(Video_Targets_CheckTarget(targetID))
+	{
+		DestroyTargetTexture(&targets[targetID]);
+		targets[targetID].inUse = false;
+	}
+	else
+	{ LogError("couldn't free render target %i", targetID); }
+}
+
+HEXPORT(bool) Video_Targets_CheckTarget(int targetID)
+{
+	if(targetID < 0 || targetID >= VIDEO_TARGETS_MAX)
+	{
+		LogError("render target ID is invalid: %i", targetID);
+		return false;
+	}
+
+	if(!targets[targetID].inUse)
+	{
+		LogError("no render target exists for ID: %i", targetID);
+		return false;
+	}
+
+	return true;
+}
+
+HEXPORT(bool) Video_Targets_IsLost(int targetID)
+{
+	if(Video_Targets_CheckTarget(targetID))
+	{ return targets[targetID].lost; }
+	else
+	{ LogError("couldn't check render target %i", targetID); }
+
+	return true;
+}
\ No newline at end of file
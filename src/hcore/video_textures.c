@@ -1,4 +1,6 @@
+#include "pack.h"
 #include "resource_map.h"
+#include "time.h"
 #include "video.h"
 
 typedef struct
@@ -10,19 +12,75 @@ typedef struct
 
 #define MAX_SURFACES 1024
 intern resource_map *surfaces;
+intern uint64 budgetBytes;
 
 #define TEX_CACHE_SIZE 256
 intern int textureCacheUsage;
 intern texture_instc textureCache[TEX_CACHE_SIZE];
 
+// bumped when the budget or cache usage change; the surface map counts its own changes
+intern uint64 snapshotChanges;
+
+// surfaces mapped from a pack keep its ID in their userdata, offset by one so unpacked surfaces have none
+#define PACK_USERDATA(packID) ((void*)((intptr_t)(packID) + 1))
+#define USERDATA_PACK(userdata) ((int)((intptr_t)(userdata) - 1))
+
 intern void *AllocSurface(char *filePath)
 {
+	AssertPtr(filePath);
+
+	pack_asset asset;
+	if(Pack_FindAsset(filePath, &asset))
+	{
+		pack_entry *e = asset.entry;
+		SDL_Surface *s = NULL;
+
+		if(e->type == PACK_ENTRY_SURFACE)
+		{
+			uint32 format = e->info.surface.pixelFormat;
+			if(e->info.surface.h > 0 && (uint64)(e->info.surface.pitch) * (uint64)(e->info.surface.h) <= e->dataLen)
+			{
+				// the pixels are already converted, so the surface can use them straight out of the mapped pack;
+				// the pack stays referenced until the surface is freed
+				s = SDL_CreateRGBSurfaceWithFormatFrom(asset.data, e->info.surface.w, e->info.surface.h,
+					SDL_BITSPERPIXEL(format), e->info.surface.pitch, format);
+				if(s)
+				{
+					s->userdata = PACK_USERDATA(asset.packID);
+					return s;
+				}
+			}
+			else
+			{ LogError("couldn't load packed surface '%s': its pixel data is truncated", filePath); }
+		}
+		else
+		{ s = SDL_LoadBMP_RW(SDL_RWFromConstMem(asset.data, (int)(e->dataLen)), 1); }
+
+		if(!s)
+		{ LogError("couldn't load surface '%s' from pack %i\n\tSDL error: %s", filePath, asset.packID, SDL_GetError()); }
+
+		Pack_ReleaseAsset(asset.packID);
+		return s;
+	}
+
 	return SDL_LoadBMP(filePath);
 }
 
 intern void FreeSurface(void *surface)
 {
-	SDL_FreeSurface(surface);
+	SDL_Surface *s = surface;
+	int packID = s ? USERDATA_PACK(s->userdata) : -1;
+
+	SDL_FreeSurface(s);
+
+	if(packID > -1)
+	{ Pack_ReleaseAsset(packID); }
+}
+
+intern uint64 SurfaceSize(void *surface)
+{
+	SDL_Surface *s = surface;
+	return (uint64)(s->pitch) * (uint64)(s->h);
 }
 
 intern void DestroyTextureInstc(int texInstcID)
@@ -91,6 +149,7 @@ intern int GetTextureInstc(int windowID, int textureID, SDL_Renderer *renderer)
 		}
 
 		textureCacheUsage++;
+		snapshotChanges++;
 		return nextFree;
 	}
 
@@ -100,9 +159,12 @@ intern int GetTextureInstc(int windowID, int textureID, SDL_Renderer *renderer)
 
 bool Video_Textures_Init()
 {
-	surfaces = ResourceMap_Create(MAX_SURFACES, &AllocSurface, &FreeSurface);
+	surfaces = ResourceMap_Create(MAX_SURFACES, &AllocSurface, &FreeSurface, &SurfaceSize);
 	if(surfaces)
 	{
+		budgetBytes = 0;
+		snapshotChanges++;
+
 		Video_Textures_ClearCache();
 
 		LogNote("video textures successfully initialized");
@@ -127,7 +189,14 @@ void Video_Textures_DrawToRenderer(int windowID, int textureID, SDL_Renderer *re
 	AssertPtr(renderer);
 	AssertPtr(surfaces);
 
+	// requested textures aren't drawn until they've loaded
+	if(!ResourceMap_GetResource(surfaces, textureID))
+	{ return; }
+
+	ProfileBegin("Video_Textures_GetTextureInstc");
 	int texInstcID = GetTextureInstc(windowID, textureID, renderer);
+	ProfileEnd();
+
 	if(texInstcID > -1)
 	{
 		texture_instc *t = &textureCache[texInstcID];
@@ -145,6 +214,31 @@ void Video_Textures_DrawToRenderer(int windowID, int textureID, SDL_Renderer *re
 	{ LogError("couldn't draw texture with ID %i: couldn't get texture instance for window %i", textureID, windowID); }
 }
 
+// NULL until a requested texture has loaded
+SDL_Texture *Video_Textures_GetRendererTexture(int windowID, int textureID, SDL_Renderer *renderer, int *w, int *h)
+{
+	AssertTexture(textureID);
+	AssertPtr(renderer);
+	AssertPtr(w);
+	AssertPtr(h);
+	AssertPtr(surfaces);
+
+	SDL_Surface *s = ResourceMap_GetResource(surfaces, textureID);
+	if(!s)
+	{ return NULL; }
+
+	int texInstcID = GetTextureInstc(windowID, textureID, renderer);
+	if(texInstcID < 0)
+	{
+		LogError("couldn't get texture instance of texture %i for window %i", textureID, windowID);
+		return NULL;
+	}
+
+	*w = s->w;
+	*h = s->h;
+	return textureCache[texInstcID].tex;
+}
+
 HEXPORT(int) Video_Textures_LoadTexture(char *filePath)
 {
 	AssertPtr(surfaces);
@@ -157,6 +251,18 @@ HEXPORT(int) Video_Textures_LoadTexture(char *filePath)
 	return -1;
 }
 
+HEXPORT(int) Video_Textures_RequestTexture(char *filePath)
+{
+	AssertPtr(surfaces);
+
+	if(filePath)
+	{ return ResourceMap_RequestResource(surfaces, filePath); }
+	else
+	{ LogError("couldn't request texture: file path is NULL"); }
+
+	return -1;
+}
+
 HEXPORT(void) Video_Textures_FreeTexture(int textureID)
 {
 	AssertPtr(surfaces);
@@ -183,24 +289,44 @@ HEXPORT(bool) Video_Textures_CheckTexture(int textureID)
 	return true;
 }
 
+HEXPORT(uint64) Video_Textures_GetTextureSize(int textureID)
+{
+	AssertTexture(textureID);
+	AssertPtr(surfaces);
+
+	return ResourceMap_GetResourceSize(surfaces, textureID);
+}
+
+HEXPORT(void) Video_Textures_SetBudget(uint64 bytes)
+{
+	budgetBytes = bytes;
+	snapshotChanges++;
+}
+
 HEXPORT(void) Video_Textures_ClearCache()
 {
 	for(int i = 0; i < TEX_CACHE_SIZE; i++)
 	{ DestroyTextureInstc(i); }
 }
 
-struct video_textures_state Video_Textures_GetSnapshot()
+uint64 Video_Textures_GetChanges()
 {
 	AssertPtr(surfaces);
 
-	struct video_textures_state state =
-	{
-		.maxSurfaces = MAX_SURFACES,
-		.surfaceCount = ResourceMap_GetResourceCount(surfaces),
+	return snapshotChanges + ResourceMap_GetChanges(surfaces);
+}
+
+void Video_Textures_GetSnapshot(struct video_textures_state *state)
+{
+	AssertPtr(surfaces);
+
+	state->maxSurfaces = MAX_SURFACES;
+	state->surfaceCount = ResourceMap_GetResourceCount(surfaces);
+	state->pendingCount = ResourceMap_GetPendingCount(surfaces);
 
-		.cacheSize = TEX_CACHE_SIZE,
-		.cacheUsage = textureCacheUsage
-	};
+	state->residentBytes = ResourceMap_GetResidentBytes(surfaces);
+	state->budgetBytes = budgetBytes;
 
-	return state;
+	state->cacheSize = TEX_CACHE_SIZE;
+	state->cacheUsage = textureCacheUsage;
 }
\ No newline at end of file
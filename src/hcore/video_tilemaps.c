@@ -0,0 +1,855 @@
+#include "hmemory.h"
+#include "time.h"
+#include "video.h"
+
+extern SDL_Texture *Video_Textures_GetRendererTexture(int windowID, int textureID, SDL_Renderer *renderer, int *w, int *h);
+
+#define CHUNK_TILES_MAX 256
+#define BUILT_CHUNKS_MAX 256	// chunks holding built geometry at once, per tilemap
+#define CACHED_CHUNKS_MAX 64	// chunks holding a cached texture at once, per tilemap (without geometry support)
+
+typedef struct
+{
+	bool inUse;
+	int textureID;
+	int tileW, tileH;
+} tileset;
+
+typedef struct
+{
+	int32 x, y;
+
+	uint16 *tiles;			// chunkTiles * chunkTiles, rows from the bottom up
+	int tileCount;			// non-empty tiles
+	bool dirty;				// edited since its geometry was last built
+
+	// built the first time the chunk is visible, relative to its top-left corner (y-down)
+#if defined(VIDEO_GEOMETRY)
+	SDL_Vertex *vertices;	// four per quad
+#else
+	SDL_Rect *quads;		// source and destination rects, two per quad
+
+	// the chunk's tiles, drawn once into a texture of the window's renderer, and copied from then on
+	SDL_Texture *cache;
+	SDL_Texture *cacheAtlas;	// the atlas it was drawn from
+	int cacheWindowID;
+	bool cacheStale;		// the tiles changed, or sdl threw the texture's contents away
+#endif
+	int quadCount;
+	int atlasW, atlasH;		// the atlas size the geometry was built for
+	uint32 lastDrawn;
+} tile_chunk;
+
+typedef struct
+{
+	bool inUse;
+	int tilesetID;
+	int chunkTiles;
+
+	tile_chunk *chunks;
+	int chunkCount;
+	int chunkCapacity;
+
+	// chunk indices keyed by chunk position, -1 where empty
+	int *buckets;
+	int bucketCount;
+
+	int builtCount;
+	uint32 drawCount;
+
+#if !defined(VIDEO_GEOMETRY)
+	int cachedCount;
+	bool cacheFailed;		// the renderer couldn't make a chunk texture; tiles are drawn one at a time
+#endif
+} tilemap;
+
+intern tileset tilesets[VIDEO_TILESETS_MAX];
+intern tilemap tilemaps[VIDEO_TILEMAPS_MAX];
+
+#if defined(VIDEO_GEOMETRY)
+// visible chunks are moved to screen space here, so a whole tilemap goes out in one call
+intern SDL_Vertex *scratchVertices;
+intern int *scratchIndices;
+intern int scratchQuadCapacity;
+#endif
+
+intern int FloorDiv(int a, int b)
+{
+	Assert(b > 0, "divisor must be positive (%i)", b);
+
+	int q = a / b;
+	return (a % b != 0 && a < 0) ? q - 1 : q;
+}
+
+intern uint32 HashChunk(int32 x, int32 y)
+{
+	uint32 h = ((uint32)(x) * 0x9E3779B1u) ^ ((uint32)(y) * 0x85EBCA77u);
+	return h ^ (h >> 15);
+}
+
+intern int FindChunk(tilemap *m, int32 x, int32 y)
+{
+	AssertPtr(m);
+
+	if(m->bucketCount == 0)
+	{ return -1; }
+
+	uint32 mask = (uint32)(m->bucketCount - 1);
+
+	// open addressing, with linear probing
+	for(uint32 probe = 0, h = HashChunk(x, y); probe <= mask; probe++)
+	{
+		int index = m->buckets[(h + probe) & mask];
+		if(index < 0)
+		{ break; }
+
+		tile_chunk *c = &m->chunks[index];
+		if(c->x == x && c->y == y)
+		{ return index; }
+	}
+
+	return -1;
+}
+
+intern void InsertBucket(tilemap *m, int index)
+{
+	uint32 mask = (uint32)(m->bucketCount - 1);
+	uint32 h = HashChunk(m->chunks[index].x, m->chunks[index].y);
+
+	while(m->buckets[h & mask] > -1)
+	{ h++; }
+
+	m->buckets[h & mask] = index;
+}
+
+intern int AddChunk(tilemap *m, int32 x, int32 y)
+{
+	AssertPtr(m);
+
+	if(m->chunkCount == m->chunkCapacity)
+	{
+		int capacity = max(m->chunkCapacity * 2, 16);
+		tile_chunk *chunks = Memory_Realloc(MEMORY_TAG_VIDEO, m->chunks, sizeof(tile_chunk) * capacity);
+		if(!chunks)
+		{
+			LogError("couldn't add chunk (%i, %i) to tilemap: out of memory", x, y);
+			return -1;
+		}
+
+		m->chunks = chunks;
+		m->chunkCapacity = capacity;
+	}
+
+	// keep the buckets at most half full
+	if((m->chunkCount + 1) * 2 > m->bucketCount)
+	{
+		int bucketCount = max(m->bucketCount * 2, 32);
+		int *buckets = Memory_Alloc(MEMORY_TAG_VIDEO, sizeof(int) * bucketCount);
+		if(!buckets)
+		{
+			LogError("couldn't add chunk (%i, %i) to tilemap: out of memory", x, y);
+			return -1;
+		}
+
+		Memory_Free(m->buckets);
+		m->buckets = buckets;
+		m->bucketCount = bucketCount;
+
+		for(int i = 0; i < bucketCount; i++)
+		{ buckets[i] = -1; }
+
+		for(int i = 0; i < m->chunkCount; i++)
+		{ InsertBucket(m, i); }
+	}
+
+	uint16 *tiles = Memory_Calloc(MEMORY_TAG_VIDEO, m->chunkTiles * m->chunkTiles, sizeof(uint16));
+	if(!tiles)
+	{
+		LogError("couldn't add chunk (%i, %i) to tilemap: out of memory", x, y);
+		return -1;
+	}
+
+	int index = m->chunkCount++;
+	m->chunks[index] = (tile_chunk) { .x = x, .y = y, .tiles = tiles, .dirty = true };
+	InsertBucket(m, index);
+
+	return index;
+}
+
+intern void FreeChunkGeometry(tilemap *m, tile_chunk *c)
+{
+#if defined(VIDEO_GEOMETRY)
+	if(c->vertices)
+	{
+		Memory_Free(c->vertices);
+		c->vertices = NULL;
+		m->builtCount--;
+	}
+#else
+	if(c->quads)
+	{
+		Memory_Free(c->quads);
+		c->quads = NULL;
+		m->builtCount--;
+	}
+#endif
+
+	c->quadCount = 0;
+	c->dirty = true;
+}
+
+intern bool IsChunkBuilt(tile_chunk *c)
+{
+#if defined(VIDEO_GEOMETRY)
+	return c->vertices != NULL;
+#else
+	return c->quads != NULL;
+#endif
+}
+
+// makes room for one more chunk's geometry, by dropping whichever went undrawn the longest
+intern void EvictChunkGeometry(tilemap *m)
+{
+	int oldest = -1;
+	for(int i = 0; i < m->chunkCount; i++)
+	{
+		tile_chunk *c = &m->chunks[i];
+		if(IsChunkBuilt(c) && c->lastDrawn != m->drawCount && (oldest < 0 || c->lastDrawn < m->chunks[oldest].lastDrawn))
+		{ oldest = i; }
+	}
+
+	if(oldest > -1)
+	{ FreeChunkGeometry(m, &m->chunks[oldest]); }
+}
+
+intern void BuildChunk(tilemap *m, tile_chunk *c, int atlasW, int atlasH)
+{
+	tileset *ts = &tilesets[m->tilesetID];
+	int n = m->chunkTiles;
+
+	if(!IsChunkBuilt(c) && m->builtCount >= BUILT_CHUNKS_MAX)
+	{ EvictChunkGeometry(m); }
+
+	bool wasBuilt = IsChunkBuilt(c);
+
+#if defined(VIDEO_GEOMETRY)
+	SDL_Vertex *vertices = Memory_Realloc(MEMORY_TAG_VIDEO, c->vertices, sizeof(SDL_Vertex) * 4 * max(c->tileCount, 1));
+	if(!vertices)
+	{
+		LogError("couldn't build tilemap chunk (%i, %i): out of memory", c->x, c->y);
+		return;
+	}
+
+	c->vertices = vertices;
+#else
+	SDL_Rect *quads = Memory_Realloc(MEMORY_TAG_VIDEO, c->quads, sizeof(SDL_Rect) * 2 * max(c->tileCount, 1));
+	if(!quads)
+	{
+		LogError("couldn't build tilemap chunk (%i, %i): out of memory", c->x, c->y);
+		return;
+	}
+
+	c->quads = quads;
+#endif
+
+	if(!wasBuilt)
+	{ m->builtCount++; }
+
+	int columns = atlasW / ts->tileW;
+	int tileLimit = columns * (atlasH / ts->tileH);
+	int chunkH = n * ts->tileH;
+
+	int q = 0;
+	int outside = 0;
+
+	for(int y = 0; y < n; y++)
+	{
+		for(int x = 0; x < n; x++)
+		{
+			uint16 tile = c->tiles[y * n + x];
+			if(tile == VIDEO_TILE_EMPTY)
+			{ continue; }
+
+			int i = tile - 1;
+			if(i >= tileLimit)
+			{
+				outside++;
+				continue;
+			}
+
+			int srcX = (i % columns) * ts->tileW;
+			int srcY = (i / columns) * ts->tileH;
+
+			// rows go bottom-up, but sdl is y-down
+			int dstX = x * ts->tileW;
+			int dstY = chunkH - (y + 1) * ts->tileH;
+
+#if defined(VIDEO_GEOMETRY)
+			float u0 = (float)(srcX) / atlasW;
+			float v0 = (float)(srcY) / atlasH;
+			float u1 = (float)(srcX + ts->tileW) / atlasW;
+			float v1 = (float)(srcY + ts->tileH) / atlasH;
+
+			float x0 = (float)(dstX);
+			float y0 = (float)(dstY);
+			float x1 = (float)(dstX + ts->tileW);
+			float y1 = (float)(dstY + ts->tileH);
+
+			SDL_Color white = { 0xFF, 0xFF, 0xFF, 0xFF };
+			SDL_Vertex *v = &c->vertices[q * 4];
+			v[0] = (SDL_Vertex) { { x0, y0 }, white, { u0, v0 } };
+			v[1] = (SDL_Vertex) { { x1, y0 }, white, { u1, v0 } };
+			v[2] = (SDL_Vertex) { { x0, y1 }, white, { u0, v1 } };
+			v[3] = (SDL_Vertex) { { x1, y1 }, white, { u1, v1 } };
+#else
+			c->quads[q * 2] = (SDL_Rect) { srcX, srcY, ts->tileW, ts->tileH };
+			c->quads[q * 2 + 1] = (SDL_Rect) { dstX, dstY, ts->tileW, ts->tileH };
+#endif
+
+			q++;
+		}
+	}
+
+	if(outside > 0)
+	{ LogWarning("tilemap chunk (%i, %i) has %i tiles past the end of its tileset", c->x, c->y, outside); }
+
+	c->quadCount = q;
+	c->atlasW = atlasW;
+	c->atlasH = atlasH;
+	c->dirty = false;
+
+#if !defined(VIDEO_GEOMETRY)
+	c->cacheStale = true;
+#endif
+}
+
+#if defined(VIDEO_GEOMETRY)
+intern bool ReserveScratch(int quadCount)
+{
+	if(quadCount <= scratchQuadCapacity)
+	{ return true; }
+
+	int capacity = max(quadCount, scratchQuadCapacity * 2);
+
+	SDL_Vertex *vertices = Memory_Realloc(MEMORY_TAG_VIDEO, scratchVertices, sizeof(SDL_Vertex) * 4 * capacity);
+	if(!vertices)
+	{ return false; }
+
+	scratchVertices = vertices;
+
+	int *indices = Memory_Realloc(MEMORY_TAG_VIDEO, scratchIndices, sizeof(int) * 6 * capacity);
+	if(!indices)
+	{ return false; }
+
+	scratchIndices = indices;
+
+	// every quad is the same two triangles, so the indices only need filling once
+	for(int q = scratchQuadCapacity; q < capacity; q++)
+	{
+		int *i = &scratchIndices[q * 6];
+		int v = q * 4;
+
+		i[0] = v;
+		i[1] = v + 1;
+		i[2] = v + 2;
+		i[3] = v + 2;
+		i[4] = v + 1;
+		i[5] = v + 3;
+	}
+
+	scratchQuadCapacity = capacity;
+	return true;
+}
+#else
+intern void FreeChunkCache(tilemap *m, tile_chunk *c)
+{
+	if(c->cache)
+	{
+		SDL_DestroyTexture(c->cache);
+		c->cache = NULL;
+		m->cachedCount--;
+	}
+}
+
+// makes room for one more chunk's texture, by dropping whichever went undrawn the longest
+intern void EvictChunkCache(tilemap *m)
+{
+	int oldest = -1;
+	for(int i = 0; i < m->chunkCount; i++)
+	{
+		tile_chunk *c = &m->chunks[i];
+		if(c->cache && c->lastDrawn != m->drawCount && (oldest < 0 || c->lastDrawn < m->chunks[oldest].lastDrawn))
+		{ oldest = i; }
+	}
+
+	if(oldest > -1)
+	{ FreeChunkCache(m, &m->chunks[oldest]); }
+}
+
+// draws the chunk's tiles into its texture, if they aren't already; false if the chunk has to be drawn tile by tile
+intern bool CacheChunk(int windowID, tilemap *m, tile_chunk *c, SDL_Renderer *renderer, SDL_Texture *atlas, int chunkW, int chunkH)
+{
+	// textures belong to a single renderer, so other windows draw the chunk tile by tile rather than trade it back and forth
+	if(c->cache && c->cacheWindowID != windowID)
+	{ return false; }
+
+	if(!c->cache)
+	{
+		if(m->cacheFailed)
+		{ return false; }
+
+		if(m->cachedCount >= CACHED_CHUNKS_MAX)
+		{ EvictChunkCache(m); }
+
+		// every cached chunk is on screen
+		if(m->cachedCount >= CACHED_CHUNKS_MAX)
+		{ return false; }
+
+		c->cache = SDL_RenderTargetSupported(renderer) ?
+			SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, chunkW, chunkH) : NULL;
+		if(!c->cache)
+		{
+			LogWarning("couldn't cache %ix%i tilemap chunks on window %i; drawing them tile by tile\n\tSDL error: %s", chunkW, chunkH, windowID, SDL_GetError());
+			m->cacheFailed = true;
+			return false;
+		}
+
+		SDL_SetTextureBlendMode(c->cache, SDL_BLENDMODE_BLEND);
+		c->cacheWindowID = windowID;
+		c->cacheStale = true;
+		m->cachedCount++;
+	}
+
+	if(!c->cacheStale && c->cacheAtlas == atlas)
+	{ return true; }
+
+	// whatever's bound is restored afterwards, along with the state sdl resets when switching targets
+	SDL_Texture *target = SDL_GetRenderTarget(renderer);
+	SDL_Rect viewport;
+	SDL_Rect clip;
+	SDL_RenderGetViewport(renderer, &viewport);
+	SDL_RenderGetClipRect(renderer, &clip);
+
+	uint8 r, g, b, a;
+	SDL_GetRenderDrawColor(renderer, &r, &g, &b, &a);
+
+	SDL_BlendMode atlasBlend;
+	SDL_GetTextureBlendMode(atlas, &atlasBlend);
+
+	bool drawn = (SDL_SetRenderTarget(renderer, c->cache) == 0);
+	if(drawn)
+	{
+		SDL_SetRenderDrawColor(renderer, 0x00, 0x00, 0x00, 0x00);
+		SDL_RenderClear(renderer);
+
+		// tiles don't overlap, so they're copied as they are; they're blended once the chunk is drawn
+		SDL_SetTextureBlendMode(atlas, SDL_BLENDMODE_NONE);
+		for(int q = 0; q < c->quadCount; q++)
+		{ SDL_RenderCopy(renderer, atlas, &c->quads[q * 2], &c->quads[q * 2 + 1]); }
+
+		SDL_SetTextureBlendMode(atlas, atlasBlend);
+	}
+	else
+	{ LogError("couldn't draw tilemap chunk (%i, %i) into its texture\n\tSDL error: %s", c->x, c->y, SDL_GetError()); }
+
+	SDL_SetRenderTarget(renderer, target);
+	SDL_RenderSetViewport(renderer, &viewport);
+	SDL_RenderSetClipRect(renderer, SDL_RectEmpty(&clip) ? NULL : &clip);
+	SDL_SetRenderDrawColor(renderer, r, g, b, a);
+
+	c->cacheAtlas = atlas;
+	c->cacheStale = !drawn;
+	return drawn;
+}
+#endif
+
+intern void FreeTilemap(tilemap *m)
+{
+	for(int i = 0; i < m->chunkCount; i++)
+	{
+		FreeChunkGeometry(m, &m->chunks[i]);
+#if !defined(VIDEO_GEOMETRY)
+		FreeChunkCache(m, &m->chunks[i]);
+#endif
+		Memory_Free(m->chunks[i].tiles);
+	}
+
+	Memory_Free(m->chunks);
+	Memory_Free(m->buckets);
+
+	*m = (tilemap) { 0 };
+}
+
+void Video_Tilemaps_Quit()
+{
+	for(int i = 0; i < VIDEO_TILEMAPS_MAX; i++)
+	{ FreeTilemap(&tilemaps[i]); }
+
+	for(int i = 0; i < VIDEO_TILESETS_MAX; i++)
+	{ tilesets[i].inUse = false; }
+
+#if defined(VIDEO_GEOMETRY)
+	Memory_Free(scratchVertices);
+	Memory_Free(scratchIndices);
+
+	scratchVertices = NULL;
+	scratchIndices = NULL;
+	scratchQuadCapacity = 0;
+#endif
+}
+
+// SDL may throw chunk textures' contents away whenever the device resets
+void Video_Tilemaps_Event(SDL_Event *ev)
+{
+	AssertPtr(ev);
+
+#if !defined(VIDEO_GEOMETRY)
+	for(int i = 0; i < VIDEO_TILEMAPS_MAX; i++)
+	{
+		tilemap *m = &tilemaps[i];
+		for(int j = 0; j < m->chunkCount; j++)
+		{
+			// the textures themselves are gone too, and have to be recreated
+			if(ev->type == SDL_RENDER_DEVICE_RESET)
+			{ FreeChunkCache(m, &m->chunks[j]); }
+			else if(ev->type == SDL_RENDER_TARGETS_RESET)
+			{ m->chunks[j].cacheStale = true; }
+		}
+	}
+#endif
+}
+
+// called before a window's renderer goes away, taking its textures with it
+void Video_Tilemaps_FreeWindow(int windowID)
+{
+#if !defined(VIDEO_GEOMETRY)
+	for(int i = 0; i < VIDEO_TILEMAPS_MAX; i++)
+	{
+		tilemap *m = &tilemaps[i];
+		for(int j = 0; j < m->chunkCount; j++)
+		{
+			if(m->chunks[j].cache && m->chunks[j].cacheWindowID == windowID)
+			{ FreeChunkCache(m, &m->chunks[j]); }
+		}
+	}
+#endif
+}
+
+// position is the viewport-space bottom-left corner of chunk (chunkX, chunkY)
+void Video_Tilemaps_DrawToRenderer(int windowID, int tilemapID, SDL_Renderer *renderer, screen_rect viewport, int32 chunkX, int32 chunkY, screen_point position)
+{
+	AssertTilemap(tilemapID);
+	AssertPtr(renderer);
+
+	tilemap *m = &tilemaps[tilemapID];
+	tileset *ts = &tilesets[m->tilesetID];
+
+	// requested atlases aren't drawn until they've loaded
+	int atlasW, atlasH;
+	SDL_Texture *atlas = Video_Textures_GetRendererTexture(windowID, ts->textureID, renderer, &atlasW, &atlasH);
+	if(!atlas)
+	{ return; }
+
+	ProfileBegin("Video_Tilemaps_DrawToRenderer");
+
+	int chunkW = m->chunkTiles * ts->tileW;
+	int chunkH = m->chunkTiles * ts->tileH;
+
+	// only chunks overlapping the viewport are looked at
+	int x0 = FloorDiv(-position.x, chunkW);
+	int x1 = FloorDiv(viewport.w - 1 - position.x, chunkW);
+	int y0 = FloorDiv(-position.y, chunkH);
+	int y1 = FloorDiv(viewport.h - 1 - position.y, chunkH);
+
+	m->drawCount++;
+
+#if defined(VIDEO_GEOMETRY)
+	int quadCount = 0;
+#endif
+
+	for(int y = y0; y <= y1; y++)
+	{
+		for(int x = x0; x <= x1; x++)
+		{
+			int index = FindChunk(m, chunkX + x, chunkY + y);
+			if(index < 0)
+			{ continue; }
+
+			tile_chunk *c = &m->chunks[index];
+			if(c->tileCount == 0)
+			{ continue; }
+
+			// only edited chunks are rebuilt
+			if(c->dirty || !IsChunkBuilt(c) || c->atlasW != atlasW || c->atlasH != atlasH)
+			{ BuildChunk(m, c, atlasW, atlasH); }
+
+			if(!IsChunkBuilt(c))
+			{ continue; }
+
+			c->lastDrawn = m->drawCount;
+
+			// the chunk's top-left corner, in sdl coordinates
+			int originX = position.x + x * chunkW;
+			int originY = viewport.h - (position.y + (y + 1) * chunkH);
+
+#if defined(VIDEO_GEOMETRY)
+			// sdl copies the vertices into its own command buffer regardless, so moving them on the way costs little
+			if(!ReserveScratch(quadCount + c->quadCount))
+			{
+				LogError("couldn't draw tilemap %i: out of memory", tilemapID);
+				break;
+			}
+
+			SDL_Vertex *dst = &scratchVertices[quadCount * 4];
+			for(int v = 0; v < c->quadCount * 4; v++)
+			{
+				dst[v] = c->vertices[v];
+				dst[v].position.x += originX;
+				dst[v].position.y += originY;
+			}
+
+			quadCount += c->quadCount;
+#else
+			if(CacheChunk(windowID, m, c, renderer, atlas, chunkW, chunkH))
+			{
+				SDL_Rect r = { originX, originY, chunkW, chunkH };
+				SDL_RenderCopy(renderer, c->cache, NULL, &r);
+				continue;
+			}
+
+			for(int q = 0; q < c->quadCount; q++)
+			{
+				SDL_Rect r = c->quads[q * 2 + 1];
+				r.x += originX;
+				r.y += originY;
+
+				SDL_RenderCopy(renderer, atlas, &c->quads[q * 2], &r);
+			}
+#endif
+		}
+	}
+
+#if defined(VIDEO_GEOMETRY)
+	if(quadCount > 0 && SDL_RenderGeometry(renderer, atlas, scratchVertices, quadCount * 4, scratchIndices, quadCount * 6) < 0)
+	{ LogError("couldn't draw tilemap %i on window %i\n\tSDL error: %s", tilemapID, windowID, SDL_GetError()); }
+#endif
+
+	ProfileEnd();
+}
+
+HEXPORT(int) Video_Tilemaps_CreateTileset(int textureID, int tileW, int tileH)
+{
+	if(!Video_Textures_CheckTexture(textureID))
+	{
+		LogError("couldn't create tileset: texture ID %i is invalid", textureID);
+		return -1;
+	}
+
+	if(tileW < 1 || tileH < 1)
+	{
+		LogError("couldn't create tileset: tile size (%i, %i) is invalid", tileW, tileH);
+		return -1;
+	}
+
+	for(int i = 0; i < VIDEO_TILESETS_MAX; i++)
+	{
+		tileset *ts = &tilesets[i];
+		if(!ts->inUse)
+		{
+			*ts = (tileset) { .inUse = true, .textureID = textureID, .tileW = tileW, .tileH = tileH };
+
+			LogDebug("created tileset %i from texture %i, with %ix%i tiles", i, textureID, tileW, tileH);
+			return i;
+		}
+	}
+
+	LogError("couldn't create tileset: all %i tilesets are in use", VIDEO_TILESETS_MAX);
+	return -1;
+}
+
+HEXPORT(void) Video_Tilemaps_FreeTileset(int tilesetID)
+{
+	if(Video_Tilemaps_CheckTileset(tilesetID))
+	{
+		int users = 0;
+		for(int i = 0; i < VIDEO_TILEMAPS_MAX; i++)
+		{
+			if(tilemaps[i].inUse && tilemaps[i].tilesetID == tilesetID)
+			{ users++; }
+		}
+
+		if(users == 0)
+		{ tilesets[tilesetID].inUse = false; }
+		else
+		{ LogError("couldn't free tileset %i: %i tilemaps are still using it", tilesetID, users); }
+	}
+	else
+	{ LogError("couldn't free tileset %i", tilesetID); }
+}
+
+HEXPORT(bool) Video_Tilemaps_CheckTileset(int tilesetID)
+{
+	if(tilesetID < 0 || tilesetID >= VIDEO_TILESETS_MAX)
+	{
+		LogError("tileset ID is invalid: %i", tilesetID);
+		return false;
+	}
+
+	if(!tilesets[tilesetID].inUse)
+	{
+		LogError("no tileset exists for ID: %i", tilesetID);
+		return false;
+	}
+
+	return true;
+}
+
+HEXPORT(int) Video_Tilemaps_CreateTilemap(int tilesetID, int chunkTiles)
+{
+	if(!Video_Tilemaps_CheckTileset(tilesetID))
+	{
+		LogError("couldn't create tilemap: tileset ID %i is invalid", tilesetID);
+		return -1;
+	}
+
+	if(chunkTiles < 1 || chunkTiles > CHUNK_TILES_MAX)
+	{
+		LogError("couldn't create tilemap: chunk size (%i) is invalid (max: %i)", chunkTiles, CHUNK_TILES_MAX);
+		return -1;
+	}
+
+	for(int i = 0; i < VIDEO_TILEMAPS_MAX; i++)
+	{
+		tilemap *m = &tilemaps[i];
+		if(!m->inUse)
+		{
+			*m = (tilemap) { .inUse = true, .tilesetID = tilesetID, .chunkTiles = chunkTiles };
+
+			LogDebug("created tilemap %i using tileset %i, with %ix%i-tile chunks", i, tilesetID, chunkTiles, chunkTiles);
+			return i;
+		}
+	}
+
+	LogError("couldn't create tilemap: all %i tilemaps are in use", VIDEO_TILEMAPS_MAX);
+	return -1;
+}
+
+HEXPORT(void) Video_Tilemaps_FreeTilemap(int tilemapID)
+{
+	if(Video_Tilemaps_CheckTilemap(tilemapID))
+	{ FreeTilemap(&tilemaps[tilemapID]); }
+	else
+	{ LogError("couldn't free tilemap %i", tilemapID); }
+}
+
+HEXPORT(bool) Video_Tilemaps_CheckTilemap(int tilemapID)
+{
+	if(tilemapID < 0 || tilemapID >= VIDEO_TILEMAPS_MAX)
+	{
+		LogError("tilemap ID is invalid: %i", tilemapID);
+		return false;
+	}
+
+	if(!tilemaps[tilemapID].inUse)
+	{
+		LogError("no tilemap exists for ID: %i", tilemapID);
+		return false;
+	}
+
+	return true;
+}
+
+HEXPORT(void) Video_Tilemaps_SetTile(int tilemapID, int32 chunkX, int32 chunkY, int x, int y, uint16 tile)
+{
+	if(!Video_Tilemaps_CheckTilemap(tilemapID))
+	{
+		LogError("couldn't set tile in tilemap %i", tilemapID);
+		return;
+	}
+
+	tilemap *m = &tilemaps[tilemapID];
+	if(x < 0 || x >= m->chunkTiles || y < 0 || y >= m->chunkTiles)
+	{
+		LogError("couldn't set tile in tilemap %i: tile (%i, %i) is outside its %ix%i chunk", tilemapID, x, y, m->chunkTiles, m->chunkTiles);
+		return;
+	}
+
+	int index = FindChunk(m, chunkX, chunkY);
+	if(index < 0)
+	{
+		// no need for a chunk just to hold an empty tile
+		if(tile == VIDEO_TILE_EMPTY)
+		{ return; }
+
+		index = AddChunk(m, chunkX, chunkY);
+		if(index < 0)
+		{ return; }
+	}
+
+	tile_chunk *c = &m->chunks[index];
+	uint16 *t = &c->tiles[y * m->chunkTiles + x];
+
+	if(*t != tile)
+	{
+		c->tileCount += (tile != VIDEO_TILE_EMPTY) - (*t != VIDEO_TILE_EMPTY);
+		c->dirty = true;
+		*t = tile;
+	}
+}
+
+HEXPORT(uint16) Video_Tilemaps_GetTile(int tilemapID, int32 chunkX, int32 chunkY, int x, int y)
+{
+	if(!Video_Tilemaps_CheckTilemap(tilemapID))
+	{
+		LogError("couldn't get tile from tilemap %i", tilemapID);
+		return VIDEO_TILE_EMPTY;
+	}
+
+	tilemap *m = &tilemaps[tilemapID];
+	if(x < 0 || x >= m->chunkTiles || y < 0 || y >= m->chunkTiles)
+	{
+		LogError("couldn't get tile from tilemap %i: tile (%i, %i) is outside its %ix%i chunk", tilemapID, x, y, m->chunkTiles, m->chunkTiles);
+		return VIDEO_TILE_EMPTY;
+	}
+
+	int index = FindChunk(m, chunkX, chunkY);
+	return (index > -1) ? m->chunks[index].tiles[y * m->chunkTiles + x] : VIDEO_TILE_EMPTY;
+}
+
+HEXPORT(void) Video_Tilemaps_SetChunk(int tilemapID, int32 chunkX, int32 chunkY, uint16 *tiles)
+{
+	if(!Video_Tilemaps_CheckTilemap(tilemapID))
+	{
+		LogError("couldn't set chunk (%i, %i) in tilemap %i", chunkX, chunkY, tilemapID);
+		return;
+	}
+
+	tilemap *m = &tilemaps[tilemapID];
+	int tileCount = m->chunkTiles * m->chunkTiles;
+
+	int index = FindChunk(m, chunkX, chunkY);
+	if(index < 0)
+	{
+		if(!tiles)
+		{ return; }
+
+		index = AddChunk(m, chunkX, chunkY);
+		if(index < 0)
+		{ return; }
+	}
+
+	tile_chunk *c = &m->chunks[index];
+	c->tileCount = 0;
+	c->dirty = true;
+
+	// a NULL tiles array empties the chunk
+	if(tiles)
+	{
+		memcpy(c->tiles, tiles, sizeof(uint16) * tileCount);
+
+		for(int i = 0; i < tileCount; i++)
+		{ c->tileCount += (tiles[i] != VIDEO_TILE_EMPTY); }
+	}
+	else
+	{ memset(c->tiles, 0, sizeof(uint16) * tileCount); }
+}
\ No newline at end of file
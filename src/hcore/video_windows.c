@@ -2,16 +2,54 @@
 
 extern void Video_Textures_DrawToRenderer(int windowID, int textureID, SDL_Renderer *renderer, screen_rect viewport, screen_point position, float rotation);
 
+extern void Video_Targets_FreeWindow(int windowID);
+extern bool Video_Targets_BindToRenderer(int windowID, int targetID, SDL_Renderer *renderer, screen_rect *rect);
+extern void Video_Targets_DrawToRenderer(int windowID, int targetID, SDL_Renderer *renderer, screen_rect viewport, screen_point position);
+
+extern void Video_Tilemaps_FreeWindow(int windowID);
+extern void Video_Tilemaps_DrawToRenderer(int windowID, int tilemapID, SDL_Renderer *renderer, screen_rect viewport, int32 chunkX, int32 chunkY, screen_point position);
+
+extern void Video_Primitives_Flush(int windowID, SDL_Renderer *renderer);
+extern void Video_Primitives_Discard(int windowID);
+extern void Video_Primitives_DrawPoints(int windowID, SDL_Renderer *renderer, color c, screen_point *points, int count);
+extern void Video_Primitives_DrawLines(int windowID, SDL_Renderer *renderer, color c, screen_point *points, int count);
+extern void Video_Primitives_DrawRect(int windowID, SDL_Renderer *renderer, color c, SDL_Rect rect, bool fill);
+extern void Video_Primitives_FillPolygon(int windowID, SDL_Renderer *renderer, color c, screen_point *points, int count);
+
 typedef struct
 {
 	window_info info;
 	bool isOpen;
 
-	SDL_Window *window;
-	SDL_Renderer *renderer;
+	SDL_Window *window;		// only windowed backends have one
+	SDL_Surface *surface;	// what the software backend draws to, instead
+	SDL_Renderer *renderer;	// the null backend has nothing to draw with
+	color drawColor;		// primitives are batched, so they carry their color with them
+
+	int targetID;			// -1 while drawing to the window itself
+	screen_rect targetRect;
+
+	window_draw_stats stats;
 } window;
 
+intern video_backend backend;
 intern window windows[VIDEO_WINDOWS_MAX];
+intern uint64 snapshotChanges;	// bumped whenever any window's info does
+
+// drawing is y-up, relative to whatever's currently being drawn to
+intern screen_rect GetDrawArea(window *w)
+{
+	return (w->targetID > -1) ? w->targetRect : w->info.viewportRect;
+}
+
+// every backend counts the draw; returns whether there's anything to actually draw it with
+intern bool CountDraw(window *w, int points)
+{
+	w->stats.drawCalls++;
+	w->stats.points += points;
+
+	return w->renderer != NULL;
+}
 
 intern void UpdateWindowInfo(int windowID)
 {
@@ -38,43 +76,113 @@ intern void UpdateWindowInfo(int windowID)
 	info->displayRect = (screen_rect) { .w = mode.w, .h = mode.h };
 	info->windowRect = (screen_rect) { winX, winY, winW, winH };
 	info->viewportRect = (screen_rect) { viewport.x, viewport.y, viewport.w, viewport.h };
+	snapshotChanges++;
 }
 
-intern bool CreateWindow(int windowID, char *title, screen_rect rect, uint32 windowFlags, uint32 rendererFlags)
+intern bool CreateSDLWindow(int windowID, char *title, screen_rect rect, uint32 windowFlags, uint32 rendererFlags)
 {
 	AssertIndex(windowID, VIDEO_WINDOWS_MAX);
 	AssertPtr(title);
 
 	window *w = &windows[windowID];
 
-	LogDebug("creating new window with\n\tID %i\n\ttitle '%s'\n\tposition (%i, %i)\n\tsize (%i, %i)",
-			 windowID, title, rect.x, rect.y, rect.w, rect.h);
-
 	w->window = SDL_CreateWindow(title, rect.x, rect.y, rect.w, rect.h, windowFlags);
 	if(w->window)
 	{
 		w->renderer = SDL_CreateRenderer(w->window, -1, rendererFlags);
 		if(w->renderer)
-		{
-			SDL_SetRenderDrawColor(w->renderer, 0xFF, 0xFF, 0xFF, 0xFF);
+		{ return true; }
+
+		LogError("couldn't create SDL renderer for window %i\n\tSDL error: %s", windowID, SDL_GetError());
+		SDL_DestroyWindow(w->window);
+		w->window = NULL;
+	}
+	else
+	{ LogError("couldn't create SDL window for window %i\n\tSDL error: %s", windowID, SDL_GetError()); }
+
+	return false;
+}
 
-			w->info.id = windowID;
-			w->isOpen = true;
-			UpdateWindowInfo(windowID);
+// offscreen windows are exactly the size they're opened at, and aren't on any display
+intern bool CreateOffscreenWindow(int windowID, char *title, screen_rect rect)
+{
+	AssertIndex(windowID, VIDEO_WINDOWS_MAX);
+	AssertPtr(title);
+
+	window *w = &windows[windowID];
+
+	if(rect.w < 1 || rect.h < 1)
+	{
+		LogError("couldn't create offscreen window %i: size (%i, %i) is invalid", windowID, rect.w, rect.h);
+		return false;
+	}
 
-			LogNote("new window with ID %i successfully created", windowID);
-			return true;
+	if(backend == VIDEO_BACKEND_SOFTWARE)
+	{
+		w->surface = SDL_CreateRGBSurfaceWithFormat(0, rect.w, rect.h, 32, SDL_PIXELFORMAT_ARGB8888);
+		if(!w->surface)
+		{
+			LogError("couldn't create surface for offscreen window %i\n\tSDL error: %s", windowID, SDL_GetError());
+			return false;
 		}
-		else
+
+		w->renderer = SDL_CreateSoftwareRenderer(w->surface);
+		if(!w->renderer)
 		{
-			LogError("couldn't create SDL renderer for window %i\n\tSDL error: %s", windowID, SDL_GetError());
-			SDL_DestroyWindow(w->window);
+			LogError("couldn't create software renderer for offscreen window %i\n\tSDL error: %s", windowID, SDL_GetError());
+			SDL_FreeSurface(w->surface);
+			w->surface = NULL;
+			return false;
 		}
 	}
-	else
-	{ LogError("couldn't create SDL window for window %i\n\tSDL error: %s", windowID, SDL_GetError()); }
 
-	return false;
+	window_info *info = &w->info;
+	strncpy(info->title, title, VIDEO_WINDOWS_TITLE_MAX - 1);
+	info->displayIndex = -1;
+	info->refreshRate = 0;
+
+	info->displayRect = (screen_rect) { .w = rect.w, .h = rect.h };
+	info->windowRect = info->displayRect;
+	info->viewportRect = info->displayRect;
+
+	return true;
+}
+
+intern bool CreateWindow(int windowID, char *title, screen_rect rect, uint32 windowFlags, uint32 rendererFlags)
+{
+	AssertIndex(windowID, VIDEO_WINDOWS_MAX);
+	AssertPtr(title);
+
+	window *w = &windows[windowID];
+
+	LogDebug("creating new window with\n\tID %i\n\ttitle '%s'\n\tposition (%i, %i)\n\tsize (%i, %i)",
+			 windowID, title, rect.x, rect.y, rect.w, rect.h);
+
+	bool created = (backend == VIDEO_BACKEND_WINDOWED)
+		? CreateSDLWindow(windowID, title, rect, windowFlags, rendererFlags)
+		: CreateOffscreenWindow(windowID, title, rect);
+
+	if(created)
+	{
+		if(w->renderer)
+		{ SDL_SetRenderDrawColor(w->renderer, 0xFF, 0xFF, 0xFF, 0xFF); }
+
+		w->drawColor = COLOR_WHITE;
+		w->stats = (window_draw_stats) { 0 };
+
+		w->info.id = windowID;
+		w->isOpen = true;
+		w->targetID = -1;
+
+		if(w->window)
+		{ UpdateWindowInfo(windowID); }
+
+		snapshotChanges++;
+
+		LogNote("new window with ID %i successfully created", windowID);
+	}
+
+	return created;
 }
 
 intern void DestroyWindow(int windowID)
@@ -82,12 +190,27 @@ intern void DestroyWindow(int windowID)
 	AssertIndex(windowID, VIDEO_WINDOWS_MAX);
 
 	window *w = &windows[windowID];
-	SDL_DestroyRenderer(w->renderer);
-	SDL_DestroyWindow(w->window);
+
+	// targets and cached tilemap chunks are textures of this renderer, and go with it
+	Video_Primitives_Discard(windowID);
+	Video_Targets_FreeWindow(windowID);
+	Video_Tilemaps_FreeWindow(windowID);
+
+	if(w->renderer)
+	{ SDL_DestroyRenderer(w->renderer); }
+	if(w->window)
+	{ SDL_DestroyWindow(w->window); }
+	if(w->surface)
+	{ SDL_FreeSurface(w->surface); }
+
+	w->renderer = NULL;
+	w->window = NULL;
+	w->surface = NULL;
 
 	memset(&w->info, 0, sizeof(window_info));
 	w->info.id = -1;
 	w->isOpen = false;
+	snapshotChanges++;
 }
 
 intern int GetWindowBySDLID(uint32 id)
@@ -108,11 +231,20 @@ intern int GetWindowBySDLID(uint32 id)
 	return -1;
 }
 
-bool Video_Windows_Init()
+bool Video_Windows_Init(video_backend videoBackend)
 {
+	backend = videoBackend;
+
 	for(int i = 0; i < VIDEO_WINDOWS_MAX; i++)
 	{ windows[i].info.id = -1; }
 
+	snapshotChanges++;
+
+	if(backend == VIDEO_BACKEND_SOFTWARE)
+	{ LogNote("video windows are offscreen, drawn by the software renderer"); }
+	else if(backend == VIDEO_BACKEND_NULL)
+	{ LogNote("video windows are offscreen, and draws are only counted"); }
+
 	LogNote("video windows successfully initialized");
 	return true;
 }
@@ -188,13 +320,13 @@ HEXPORT(bool) Video_Windows_CheckWindow(int windowID)
 		return false;
 	}
 
-	if(!w->window)
+	if(backend == VIDEO_BACKEND_WINDOWED && !w->window)
 	{
 		LogError("window %i has no SDL window", windowID);
 		return false;
 	}
 
-	if(!w->renderer)
+	if(backend != VIDEO_BACKEND_NULL && !w->renderer)
 	{
 		LogError("window %i has no SDL renderer", windowID);
 		return false;
@@ -208,7 +340,10 @@ HEXPORT(void) Video_Windows_SetWindowColor(int windowID, color color)
 	if(Video_Windows_CheckWindow(windowID))
 	{
 		window *w = &windows[windowID];
-		SDL_SetRenderDrawColor(w->renderer, color.r, color.g, color.b, color.a);
+		w->drawColor = color;
+
+		if(w->renderer)
+		{ SDL_SetRenderDrawColor(w->renderer, color.r, color.g, color.b, color.a); }
 	}
 	else
 	{ LogError("couldn't set color for window %i", windowID); }
@@ -219,6 +354,12 @@ HEXPORT(void) Video_Windows_ClearWindow(int windowID)
 	if(Video_Windows_CheckWindow(windowID))
 	{
 		window *w = &windows[windowID];
+		if(!CountDraw(w, 0))
+		{ return; }
+
+		// drawing primitives leaves sdl's draw color wherever the last one set it
+		Video_Primitives_Flush(windowID, w->renderer);
+		SDL_SetRenderDrawColor(w->renderer, w->drawColor.r, w->drawColor.g, w->drawColor.b, w->drawColor.a);
 		SDL_RenderClear(w->renderer);
 	}
 	else
@@ -230,7 +371,13 @@ HEXPORT(void) Video_Windows_PresentWindow(int windowID)
 	if(Video_Windows_CheckWindow(windowID))
 	{
 		window *w = &windows[windowID];
-		SDL_RenderPresent(w->renderer);
+		w->stats.presents++;
+
+		if(w->renderer)
+		{
+			Video_Primitives_Flush(windowID, w->renderer);
+			SDL_RenderPresent(w->renderer);
+		}
 	}
 	else
 	{ LogError("couldn't present window %i", windowID); }
@@ -241,10 +388,12 @@ HEXPORT(void) Video_Windows_DrawPoint(int windowID, screen_point point)
 	if(Video_Windows_CheckWindow(windowID))
 	{
 		window *w = &windows[windowID];
+		if(!CountDraw(w, 1))
+		{ return; }
 
 		// convert to sdl coordinates (y-down)
-		point.y = w->info.viewportRect.h - point.y;
-		SDL_RenderDrawPoint(w->renderer, point.x, point.y);
+		point.y = GetDrawArea(w).h - point.y;
+		Video_Primitives_DrawPoints(windowID, w->renderer, w->drawColor, &point, 1);
 	}
 	else
 	{ LogError("couldn't draw point on window %i", windowID); }
@@ -255,13 +404,17 @@ HEXPORT(void) Video_Windows_DrawLine(int windowID, screen_line line)
 	if(Video_Windows_CheckWindow(windowID))
 	{
 		window *w = &windows[windowID];
-		int h = w->info.viewportRect.h;
+		if(!CountDraw(w, 2))
+		{ return; }
+
+		int h = GetDrawArea(w).h;
 
 		// convert to sdl coordinates (y-down)
 		line.start.y = h - line.start.y;
 		line.end.y = h - line.end.y;
 
-		SDL_RenderDrawLine(w->renderer, line.start.x, line.start.y, line.end.x, line.end.y);
+		screen_point points[2] = { line.start, line.end };
+		Video_Primitives_DrawLines(windowID, w->renderer, w->drawColor, points, 2);
 	}
 	else
 	{ LogError("couldn't draw line on window %i", windowID); }
@@ -276,22 +429,22 @@ HEXPORT(void) Video_Windows_DrawPoints(int windowID, points_draw_mode mode, scre
 			if(count > 0)
 			{
 				window *w = &windows[windowID];
-				int h = w->info.viewportRect.h;
+				if(!CountDraw(w, count))
+				{ return; }
+
+				int h = GetDrawArea(w).h;
 
 				// convert to sdl coordinates (y-down)
 				for(int i = 0; i < count; i++)
 				{ points[i].y = h - points[i].y; }
 
-				// HACK: this is probably less evil than other alternatives
-				SDL_Point *sdlPoints = (SDL_Point *)(points);
-
 				switch(mode)
 				{
 					case POINTS_DRAW_POINTS:
-						SDL_RenderDrawPoints(w->renderer, sdlPoints, count);
+						Video_Primitives_DrawPoints(windowID, w->renderer, w->drawColor, points, count);
 						break;
 					case POINTS_DRAW_LINES:
-						SDL_RenderDrawLines(w->renderer, sdlPoints, count);
+						Video_Primitives_DrawLines(windowID, w->renderer, w->drawColor, points, count);
 						break;
 				}
 			}
@@ -310,17 +463,50 @@ HEXPORT(void) Video_Windows_DrawRect(int windowID, screen_rect rect, bool fill)
 	if(Video_Windows_CheckWindow(windowID))
 	{
 		window *w = &windows[windowID];
-		int h = w->info.viewportRect.h;
+		if(!CountDraw(w, 0))
+		{ return; }
+
+		int h = GetDrawArea(w).h;
 
 		// convert to sdl coordinates (y-down, top-left origin)
-		float y = h - (rect.y + rect.h);
+		int y = h - (rect.y + rect.h);
 		SDL_Rect sdlRect = { .x = rect.x, .y = y, .w = rect.w, .h = rect.h };
-		(fill) ? SDL_RenderFillRect(w->renderer, &sdlRect) : SDL_RenderDrawRect(w->renderer, &sdlRect);
+		Video_Primitives_DrawRect(windowID, w->renderer, w->drawColor, sdlRect, fill);
 	}
 	else
 	{ LogError("couldn't draw rect on window %i", windowID); }
 }
 
+HEXPORT(void) Video_Windows_FillPolygon(int windowID, screen_point *points, int count)
+{
+	if(Video_Windows_CheckWindow(windowID))
+	{
+		if(points)
+		{
+			if(count > 0)
+			{
+				window *w = &windows[windowID];
+				if(!CountDraw(w, count))
+				{ return; }
+
+				int h = GetDrawArea(w).h;
+
+				// convert to sdl coordinates (y-down)
+				for(int i = 0; i < count; i++)
+				{ points[i].y = h - points[i].y; }
+
+				Video_Primitives_FillPolygon(windowID, w->renderer, w->drawColor, points, count);
+			}
+			else
+			{ LogError("couldn't fill polygon on window %i: point count (%i) is less than 1", windowID, count); }
+		}
+		else
+		{ LogError("couldn't fill polygon on window %i: points array is null", windowID); }
+	}
+	else
+	{ LogError("couldn't fill polygon on window %i", windowID); }
+}
+
 HEXPORT(void) Video_Windows_DrawTexture(int windowID, int textureID, screen_point position, float rotation)
 {
 	if(Video_Windows_CheckWindow(windowID))
@@ -328,7 +514,11 @@ HEXPORT(void) Video_Windows_DrawTexture(int windowID, int textureID, screen_poin
 		if(Video_Textures_CheckTexture(textureID))
 		{
 			window *w = &windows[windowID];
-			Video_Textures_DrawToRenderer(windowID, textureID, w->renderer, w->info.viewportRect, position, rotation);
+			if(!CountDraw(w, 0))
+			{ return; }
+
+			Video_Primitives_Flush(windowID, w->renderer);
+			Video_Textures_DrawToRenderer(windowID, textureID, w->renderer, GetDrawArea(w), position, rotation);
 		}
 		else
 		{ LogError("couldn't draw texture %i on window %i", textureID, windowID); }
@@ -337,11 +527,158 @@ HEXPORT(void) Video_Windows_DrawTexture(int windowID, int textureID, screen_poin
 	{ LogError("couldn't draw texture %i on window %i", textureID, windowID); }
 }
 
-struct video_windows_state Video_Windows_GetSnapshot()
+HEXPORT(void) Video_Windows_SetTarget(int windowID, int targetID)
 {
-	struct video_windows_state state;
-	for(int i = 0; i < VIDEO_WINDOWS_MAX; i++)
-	{ state.windowInfo[i] = windows[i].info; }
+	if(Video_Windows_CheckWindow(windowID))
+	{
+		window *w = &windows[windowID];
+		if(targetID != w->targetID && !w->renderer)
+		{
+			// nothing's drawn without a renderer, so there's nothing to bind either
+			w->targetID = targetID;
+			w->targetRect = w->info.viewportRect;
+		}
+		else if(targetID != w->targetID)
+		{
+			// whatever's batched belongs to the old target
+			Video_Primitives_Flush(windowID, w->renderer);
+
+			screen_rect rect = { 0 };
+			if(Video_Targets_BindToRenderer(windowID, targetID, w->renderer, &rect))
+			{
+				w->targetID = targetID;
+				w->targetRect = rect;
+			}
+		}
+	}
+	else
+	{ LogError("couldn't set render target %i on window %i", targetID, windowID); }
+}
+
+HEXPORT(void) Video_Windows_DrawTarget(int windowID, int targetID, screen_point position)
+{
+	if(Video_Windows_CheckWindow(windowID))
+	{
+		if(Video_Targets_CheckTarget(targetID))
+		{
+			window *w = &windows[windowID];
+			if(targetID == w->targetID)
+			{ LogError("couldn't draw render target %i on window %i: it's being drawn to", targetID, windowID); }
+			else if(CountDraw(w, 0))
+			{
+				Video_Primitives_Flush(windowID, w->renderer);
+				Video_Targets_DrawToRenderer(windowID, targetID, w->renderer, GetDrawArea(w), position);
+			}
+		}
+		else
+		{ LogError("couldn't draw render target %i on window %i", targetID, windowID); }
+	}
+	else
+	{ LogError("couldn't draw render target %i on window %i", targetID, windowID); }
+}
+
+HEXPORT(void) Video_Windows_DrawTilemap(int windowID, int tilemapID, int32 chunkX, int32 chunkY, screen_point position)
+{
+	if(Video_Windows_CheckWindow(windowID))
+	{
+		if(Video_Tilemaps_CheckTilemap(tilemapID))
+		{
+			window *w = &windows[windowID];
+			if(!CountDraw(w, 0))
+			{ return; }
 
-	return state;
+			Video_Primitives_Flush(windowID, w->renderer);
+			Video_Tilemaps_DrawToRenderer(windowID, tilemapID, w->renderer, GetDrawArea(w), chunkX, chunkY, position);
+		}
+		else
+		{ LogError("couldn't draw tilemap %i on window %i", tilemapID, windowID); }
+	}
+	else
+	{ LogError("couldn't draw tilemap %i on window %i", tilemapID, windowID); }
+}
+
+HEXPORT(void) Video_Windows_GetDrawStats(int windowID, window_draw_stats *stats)
+{
+	if(!stats)
+	{
+		LogError("couldn't get draw stats for window %i: stats pointer is null", windowID);
+		return;
+	}
+
+	*stats = (window_draw_stats) { 0 };
+
+	if(Video_Windows_CheckWindow(windowID))
+	{ *stats = windows[windowID].stats; }
+	else
+	{ LogError("couldn't get draw stats for window %i", windowID); }
+}
+
+// writes the window's current contents to a bmp; anything batched is drawn first
+HEXPORT(bool) Video_Windows_SaveImage(int windowID, char *filePath)
+{
+	if(!filePath)
+	{
+		LogError("couldn't save image of window %i: file path is null", windowID);
+		return false;
+	}
+
+	if(!Video_Windows_CheckWindow(windowID))
+	{
+		LogError("couldn't save image of window %i", windowID);
+		return false;
+	}
+
+	window *w = &windows[windowID];
+	if(!w->renderer)
+	{
+		LogError("couldn't save image of window %i: the null video backend doesn't draw anything", windowID);
+		return false;
+	}
+
+	Video_Primitives_Flush(windowID, w->renderer);
+
+	// the software backend's surface already holds the pixels; windowed ones have to read them back
+	SDL_Surface *s = w->surface;
+	if(!s)
+	{
+		int width = 0;
+		int height = 0;
+		SDL_GetRendererOutputSize(w->renderer, &width, &height);
+
+		s = SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, SDL_PIXELFORMAT_ARGB8888);
+		if(!s)
+		{
+			LogError("couldn't save image of window %i\n\tSDL error: %s", windowID, SDL_GetError());
+			return false;
+		}
+
+		if(SDL_RenderReadPixels(w->renderer, NULL, SDL_PIXELFORMAT_ARGB8888, s->pixels, s->pitch) < 0)
+		{
+			LogError("couldn't read pixels of window %i\n\tSDL error: %s", windowID, SDL_GetError());
+			SDL_FreeSurface(s);
+			return false;
+		}
+	}
+
+	bool saved = SDL_SaveBMP(s, filePath) == 0;
+	if(saved)
+	{ LogNote("saved image of window %i to '%s'", windowID, filePath); }
+	else
+	{ LogError("couldn't save image of window %i to '%s'\n\tSDL error: %s", windowID, filePath, SDL_GetError()); }
+
+	if(s != w->surface)
+	{ SDL_FreeSurface(s); }
+
+	return saved;
+}
+
+uint64 Video_Windows_GetChanges()
+{
+	return snapshotChanges;
+}
+
+void Video_Windows_GetSnapshot(struct video_windows_state *state)
+{
+	for(int i = 0; i < VIDEO_WINDOWS_MAX; i++)
+	{ state->windowInfo[i] = windows[i].info; }
 }
\ No newline at end of file
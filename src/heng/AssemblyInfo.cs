@@ -0,0 +1,4 @@
+﻿using System.Runtime.CompilerServices;
+
+// heng_bench checks the native kernels against the managed reference implementations
+[assembly: InternalsVisibleTo("heng_bench")]
\ No newline at end of file
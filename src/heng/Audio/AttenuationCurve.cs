@@ -0,0 +1,42 @@
+﻿namespace heng.Audio
+{
+	/// <summary>
+	/// Controls how <see cref="SoundInstance"/> volume falls off with distance from the <see cref="AudioState.ListenerPosition"/>.
+	/// <para>By default, volume falls off with the squared ratio of distance to maximum distance.
+	/// A custom curve replaces this with a table of gains, which is linearly interpolated.</para>
+	/// </summary>
+	public static class AttenuationCurve
+	{
+		/// <summary>
+		/// The maximum number of points a curve can have.
+		/// </summary>
+		public const int MaxPoints = Core.Audio.Mixer.Channels.AUDIO_MIXER_ATTENUATION_CURVE_MAX;
+
+		/// <summary>
+		/// Sets a custom attenuation curve.
+		/// <para>Gains range from 0 (silent) to 1 (full volume), and are spaced evenly from the listener's position
+		/// (the first point) to the maximum attenuation distance (the last point).</para>
+		/// </summary>
+		/// <param name="gains">At least 2, and at most <see cref="MaxPoints"/>, gain values.</param>
+		public static void Set(params float[] gains)
+		{
+			if(gains != null && gains.Length > 1)
+			{
+				if(gains.Length > MaxPoints)
+				{ Log.Warning($"attenuation curve has {gains.Length} points; only the first {MaxPoints} will be used"); }
+
+				Core.Audio.Mixer.Channels.SetAttenuationCurve(gains, System.Math.Min(gains.Length, MaxPoints));
+			}
+			else
+			{ Log.Error("couldn't set attenuation curve: at least 2 gain values are needed"); }
+		}
+
+		/// <summary>
+		/// Removes any custom attenuation curve, restoring the default squared distance falloff.
+		/// </summary>
+		public static void Reset()
+		{
+			Core.Audio.Mixer.Channels.SetAttenuationCurve(null, 0);
+		}
+	};
+}
\ No newline at end of file
@@ -11,6 +11,8 @@ namespace heng.Audio
 	/// </summary>
 	public class AudioState
 	{
+		const float attenuationDistance = 300;
+
 		/// <summary>
 		/// All available <see cref="SoundSource"/>s.
 		/// </summary>
@@ -36,24 +38,39 @@ namespace heng.Audio
 			Core.Audio.PushSound();
 		}
 
-		IReadOnlyList<SoundSource> AddSources(IEnumerable<SoundSource> sources)
+		/// <summary>
+		/// Computes which <see cref="SoundSource"/>s changed since a previous <see cref="AudioState"/>.
+		/// <para>Sources are identified by their <see cref="SoundSource.ID"/>, and only count as changed when they were moved,
+		/// retuned or rebused, or a sound started, stopped or was virtualized on them -- not just because their sounds kept playing.</para>
+		/// </summary>
+		/// <param name="previous">The preceding <see cref="AudioState"/>. If null, every source is reported as added.</param>
+		/// <returns>The delta between the two states' sources.</returns>
+		public StateDelta<SoundSource> GetDelta(AudioState previous)
+		{
+			return new StateDelta<SoundSource>(previous?.SoundSources, SoundSources, source => source.ID, SoundSource.StateComparer.Instance);
+		}
+
+		unsafe IReadOnlyList<SoundSource> AddSources(IEnumerable<SoundSource> sources)
 		{
 			if(sources != null)
 			{
 				List<SoundSource> newSources = new List<SoundSource>();
-				Core.Audio.GetSnapshot(out Core.Audio.State coreState);
+				Core.Audio.Mixer.Channels.View channels = new Core.Audio.Mixer.Channels.View(Core.Audio.Mixer.Channels.GetSnapshot());
 
+				ChannelBatch batch = new ChannelBatch();
 				foreach(SoundSource source in sources)
 				{
 					if(source != null)
 					{
-						SoundSource newSource = source.UpdateInstances(ListenerPosition, coreState.Mixer.Channels);
+						SoundSource newSource = source.UpdateInstances(ListenerPosition, channels, batch);
 						newSources.Add(newSource);
 					}
 					else
 					{ Log.Error("couldn't add SoundSource to AudioState: source is null"); }
 				}
 
+				batch.Submit(attenuationDistance);
+
 				return newSources;
 			}
 			else
@@ -0,0 +1,33 @@
+﻿using System.Collections.Generic;
+
+namespace heng.Audio
+{
+	internal class ChannelBatch
+	{
+		readonly List<int> channels;
+		readonly List<Vector2> offsets;
+
+		public ChannelBatch()
+		{
+			channels = new List<int>();
+			offsets = new List<Vector2>();
+		}
+
+		public void Add(int channel, Vector2 listenerOffset)
+		{
+			channels.Add(channel);
+			offsets.Add(listenerOffset);
+		}
+
+		public void Submit(float maxDist)
+		{
+			if(channels.Count > 0)
+			{
+				// attenuate and advance every active channel with a single call each
+				int[] channelIDs = channels.ToArray();
+				Core.Audio.Mixer.Channels.CalcAttenuationBatch(channelIDs, offsets.ToArray(), channelIDs.Length, maxDist);
+				Core.Audio.Mixer.Channels.AdvanceBatch(channelIDs, channelIDs.Length, false);
+			}
+		}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,15 @@
+﻿namespace heng.Audio
+{
+	/// <summary>
+	/// The mixer buses into which <see cref="SoundInstance"/>s are mixed.
+	/// <para>Each source bus (<see cref="Music"/>, <see cref="SFX"/> and <see cref="UI"/>) is processed once per
+	/// block, then summed into the <see cref="Master"/> bus. See <see cref="MixerBuses"/> for their settings.</para>
+	/// </summary>
+	public enum MixerBus
+	{
+		Music,
+		SFX,
+		UI,
+		Master
+	};
+}
\ No newline at end of file
@@ -0,0 +1,62 @@
+﻿namespace heng.Audio
+{
+	/// <summary>
+	/// Controls the gain and effects of each <see cref="MixerBus"/>.
+	/// <para>Effects process a whole bus at once, so their cost doesn't grow with the number of playing
+	/// <see cref="SoundInstance"/>s. The <see cref="MixerBus.Master"/> bus always ends in a limiter, which keeps
+	/// the final mix from clipping.</para>
+	/// </summary>
+	public static class MixerBuses
+	{
+		/// <summary>
+		/// Sets the gain of a bus, where 1 leaves it unchanged.
+		/// </summary>
+		/// <param name="bus">The bus to change.</param>
+		/// <param name="gain">The new gain, of at least 0.</param>
+		public static void SetGain(MixerBus bus, float gain)
+		{
+			Core.Audio.Mixer.Buses.SetGain((int)(bus), gain);
+		}
+
+		/// <summary>
+		/// Sets the cutoff frequency of a bus' low-pass filter (e.g. to muffle sound effects under water).
+		/// </summary>
+		/// <param name="bus">The bus to change.</param>
+		/// <param name="cutoffHz">The cutoff frequency, in hertz. 0 disables the filter.</param>
+		public static void SetLowPass(MixerBus bus, float cutoffHz)
+		{
+			Core.Audio.Mixer.Buses.SetLowPass((int)(bus), cutoffHz);
+		}
+
+		/// <summary>
+		/// Sets how much of a source bus is sent to the shared reverb.
+		/// </summary>
+		/// <param name="bus">The bus to change. <see cref="MixerBus.Master"/> can't send to the reverb.</param>
+		/// <param name="send">The send level, from 0 (dry) to 1.</param>
+		public static void SetReverbSend(MixerBus bus, float send)
+		{
+			Core.Audio.Mixer.Buses.SetReverbSend((int)(bus), send);
+		}
+
+		/// <summary>
+		/// Sets a bus' compressor, which reduces the level of the bus above a threshold.
+		/// </summary>
+		/// <param name="bus">The bus to change.</param>
+		/// <param name="thresholdDB">The level above which the bus is compressed, in decibels below full scale.</param>
+		/// <param name="ratio">How many decibels over the threshold become one decibel over it. 1 disables the compressor.</param>
+		public static void SetCompressor(MixerBus bus, float thresholdDB, float ratio)
+		{
+			Core.Audio.Mixer.Buses.SetCompressor((int)(bus), thresholdDB, ratio);
+		}
+
+		/// <summary>
+		/// Sets the character of the shared reverb.
+		/// </summary>
+		/// <param name="feedback">How long the reverb rings, from 0 to just under 1.</param>
+		/// <param name="damping">How quickly high frequencies die out, from 0 to 1.</param>
+		public static void SetReverb(float feedback, float damping)
+		{
+			Core.Audio.Mixer.Buses.SetReverb(feedback, damping);
+		}
+	};
+}
\ No newline at end of file
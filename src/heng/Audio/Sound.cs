@@ -26,6 +26,19 @@ namespace heng.Audio
 			if(soundID < 0)
 			{ isDisposed = true; }
 		}
+
+		// streamed sounds load on core's loader thread; channels playing them stay silent until they're ready
+		internal Sound(string filePath, bool streamed)
+		{
+			soundID = streamed ? Core.Audio.Sounds.RequestSound(filePath) : Core.Audio.Sounds.LoadSound(filePath);
+			if(soundID < 0)
+			{ isDisposed = true; }
+		}
+
+		internal bool IsDisposed => isDisposed;
+
+		// bytes held by the loaded samples; zero while the sound is still loading
+		internal UInt64 ResidentBytes => isDisposed ? 0 : Core.Audio.Sounds.GetSoundSize(soundID);
 		
 		/// <inheritdoc />
 		public void Dispose()
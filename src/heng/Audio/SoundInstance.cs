@@ -25,6 +25,18 @@
 		/// </summary>
 		public readonly float Progress;
 
+		/// <summary>
+		/// The priority with which this <see cref="SoundInstance"/> competes for mixing.
+		/// </summary>
+		public readonly byte Priority;
+
+		/// <summary>
+		/// Whether this <see cref="SoundInstance"/> was virtualized on the last update.
+		/// <para>Virtualized instances keep advancing, but aren't heard, because more important ones took up
+		/// all the mixed voices.</para>
+		/// </summary>
+		public readonly bool IsVirtual;
+
 		/// <summary>
 		/// The <see cref="SoundInstance"/>'s position relative to the <see cref="AudioState"/>'s
 		/// <see cref="AudioState.ListenerPosition"/>.
@@ -32,8 +44,11 @@
 		/// to which the <see cref="SoundInstance"/> is attached.</para>
 		/// </summary>
 		public readonly Vector2 ListenerOffset;
+
+		// the channel's voice when this instance started; once it changes, the channel was stolen for another sound
+		readonly uint voice;
 		
-		internal SoundInstance(Sound sound)
+		internal SoundInstance(Sound sound, float rate, byte priority, MixerBus bus)
 		{
 			Assert.Ref(sound);
 
@@ -43,44 +58,58 @@
 				Sound = sound;
 
 				Progress = 0;
+				Priority = priority;
+				IsVirtual = false;
 				ListenerOffset = Vector2.Zero;
 
 				Sound.PlayOn(Channel);
+				voice = Core.Audio.Mixer.Channels.GetVoice(Channel);
+				Core.Audio.Mixer.Channels.SetRate(Channel, rate);
+				Core.Audio.Mixer.Channels.SetPriority(Channel, priority);
+				Core.Audio.Mixer.Channels.SetBus(Channel, (byte)(bus));
 			}
 			else
 			{ Log.Error("couldn't construct SoundInstance: no free mixer channels"); }
 		}
 		
-		SoundInstance(Sound sound, int channel, float progress, Vector2 offset)
+		SoundInstance(Sound sound, int channel, uint voice, float progress, byte priority, bool isVirtual, Vector2 offset)
 		{
 			Assert.Ref(sound);
 			Assert.Index(channel, Core.Audio.Mixer.Channels.AUDIO_MIXER_CHANNELS_MAX);
 			
 			Sound = sound;
 			Channel = channel;
+			this.voice = voice;
 			
 			Progress = progress;
+			Priority = priority;
+			IsVirtual = isVirtual;
 			ListenerOffset = offset;
 		}
 		
-		internal SoundInstance Reposition(Vector2 offset)
-		{
-			return new SoundInstance(Sound, Channel, Progress, offset);
-		}
-		
-		internal SoundInstance Update(Core.Audio.Mixer.Channels.MixerChannel channelState)
+		internal SoundInstance Update(Core.Audio.Mixer.Channels.MixerChannel channelState, Vector2 offset, float rate, ChannelBatch batch)
 		{
-			float progress = (float)(channelState.DataPos) / (float)(channelState.DataLen);
+			// a stolen channel belongs to its new sound now, so this instance is simply done
+			if(channelState.Voice != voice)
+			{ return new SoundInstance(Sound, Channel, voice, 1, Priority, false, offset); }
+
+			// sounds still loading in the background haven't started; ones that failed to load are done
+			float progress = 0;
+			if(!channelState.IsLoading)
+			{ progress = (channelState.DataLen > 0) ? (float)(channelState.DataPos) / (float)(channelState.DataLen) : 1; }
 
+			// still-playing channels are attenuated and advanced together, once every source has been updated
 			if(progress < 1)
 			{
-				Core.Audio.Mixer.Channels.CalcAttenuation(Channel, ListenerOffset, 300);
-				Core.Audio.Mixer.Channels.Advance(Channel, false);
+				if(channelState.Rate != rate)
+				{ Core.Audio.Mixer.Channels.SetRate(Channel, rate); }
+
+				batch.Add(Channel, offset);
 			}
 			else
 			{ Core.Audio.Mixer.Channels.SetSound(Channel, -1); }
 
-			return new SoundInstance(Sound, Channel, progress, ListenerOffset);
+			return new SoundInstance(Sound, Channel, voice, progress, Priority, channelState.IsVirtual, offset);
 		}
 	};
-}
+}
\ No newline at end of file
@@ -1,4 +1,5 @@
-﻿using System.Collections.Generic;
+﻿using System;
+using System.Collections.Generic;
 
 namespace heng.Audio
 {
@@ -8,6 +9,49 @@ namespace heng.Audio
 	/// </summary>
 	public class SoundSource
 	{
+		/// <summary>
+		/// Compares <see cref="SoundSource"/>s by what they're playing, and how: their position, rate, bus, and
+		/// which <see cref="SoundInstance"/>s are playing on which channels.
+		/// <para>Playback progress and listener offsets are left out, since they move on every update
+		/// whether or not anything about the source changed.</para>
+		/// </summary>
+		internal sealed class StateComparer : IEqualityComparer<SoundSource>
+		{
+			public static readonly StateComparer Instance = new StateComparer();
+
+			public bool Equals(SoundSource a, SoundSource b)
+			{
+				if(ReferenceEquals(a, b))
+				{ return true; }
+
+				if(a == null || b == null)
+				{ return false; }
+
+				if(a.Position != b.Position || a.Rate != b.Rate || a.Bus != b.Bus || a.SoundInstances.Count != b.SoundInstances.Count)
+				{ return false; }
+
+				for(int i = 0; i < a.SoundInstances.Count; i++)
+				{
+					SoundInstance instcA = a.SoundInstances[i];
+					SoundInstance instcB = b.SoundInstances[i];
+
+					if(instcA.Sound != instcB.Sound || instcA.Channel != instcB.Channel ||
+						instcA.Priority != instcB.Priority || instcA.IsVirtual != instcB.IsVirtual)
+					{ return false; }
+				}
+
+				return true;
+			}
+
+			public int GetHashCode(SoundSource source) => source?.ID ?? 0;
+		};
+
+		/// <summary>
+		/// This <see cref="SoundSource"/>'s ID, which is unique, and carried over by every <see cref="SoundSource"/>
+		/// derived from it (by playing sounds, moving it, changing its rate, or updating it into a new <see cref="AudioState"/>).
+		/// </summary>
+		public readonly int ID;
+
 		/// <summary>
 		/// The world-space position of this <see cref="SoundSource"/>.
 		/// </summary>
@@ -18,24 +62,56 @@ namespace heng.Audio
 		/// <para>Expired instances will automatically be removed from this list when the <see cref="SoundSource"/>
 		/// is constructed into the <see cref="AudioState"/>.</para>
 		/// </summary>
-		public readonly IReadOnlyList<SoundInstance> SoundInstances;
+		public readonly PersistentList<SoundInstance> SoundInstances;
+
+		/// <summary>
+		/// The playback rate of every <see cref="SoundInstance"/> on this <see cref="SoundSource"/>, where 1 is the
+		/// <see cref="Sound"/>'s own rate.
+		/// <para>Higher rates play faster and at a higher pitch; lower rates play slower and at a lower pitch.</para>
+		/// </summary>
+		public readonly float Rate;
+
+		/// <summary>
+		/// The <see cref="MixerBus"/> into which this <see cref="SoundSource"/>'s <see cref="SoundInstance"/>s are mixed.
+		/// </summary>
+		public readonly MixerBus Bus;
 		
 		/// <summary>
 		/// Creates a new <see cref="SoundSource"/> at the given world-space position.
 		/// </summary>
 		/// <param name="position">The world-space position at which to locate the new <see cref="SoundSource"/>.</param>
-		public SoundSource(WorldPoint position)
+		public SoundSource(WorldPoint position) : this(position, MixerBus.SFX)
+		{ }
+
+		/// <summary>
+		/// Creates a new <see cref="SoundSource"/> at the given world-space position, mixed into the given bus.
+		/// </summary>
+		/// <param name="position">The world-space position at which to locate the new <see cref="SoundSource"/>.</param>
+		/// <param name="bus">The source bus into which to mix the new <see cref="SoundSource"/>'s sounds.</param>
+		public SoundSource(WorldPoint position, MixerBus bus)
 		{
+			if(bus == MixerBus.Master)
+			{
+				Log.Error("sound sources can't play directly into the master bus; using the SFX bus instead");
+				bus = MixerBus.SFX;
+			}
+
+			ID = EntityIDs.Next();
 			Position = position;
-			SoundInstances = new SoundInstance[0];
+			SoundInstances = PersistentList<SoundInstance>.Empty;
+			Rate = 1;
+			Bus = bus;
 		}
 		
-		SoundSource(WorldPoint position, IReadOnlyList<SoundInstance> instances)
+		SoundSource(int id, WorldPoint position, PersistentList<SoundInstance> instances, float rate, MixerBus bus)
 		{
 			Assert.Ref(instances);
 
+			ID = id;
 			Position = position;
 			SoundInstances = instances;
+			Rate = rate;
+			Bus = bus;
 		}
 		
 		/// <summary>
@@ -46,7 +122,25 @@ namespace heng.Audio
 		/// <returns>A new <see cref="SoundSource"/> at the new position.</returns>
 		public SoundSource Reposition(WorldPoint position)
 		{
-			return new SoundSource(position, SoundInstances);
+			return new SoundSource(ID, position, SoundInstances, Rate, Bus);
+		}
+
+		/// <summary>
+		/// Changes the playback rate of the <see cref="SoundSource"/>, preserving all <see cref="SoundInstance"/>s.
+		/// <para>The new rate is applied to every playing <see cref="SoundInstance"/> as the <see cref="AudioState"/>
+		/// updates, so it can be changed continuously (e.g. to follow an engine's speed).</para>
+		/// </summary>
+		/// <param name="rate">The new playback rate, between 0 and 8. 1 plays sounds at their own rate.</param>
+		/// <returns>A new <see cref="SoundSource"/> with the new rate.</returns>
+		public SoundSource SetRate(float rate)
+		{
+			if(rate < 0 || rate > Core.Audio.Mixer.Channels.AUDIO_MIXER_CHANNELS_RATE_MAX)
+			{
+				Log.Warning("sound source rate is out of range: " + rate);
+				rate = Math.Min(Math.Max(rate, 0), Core.Audio.Mixer.Channels.AUDIO_MIXER_CHANNELS_RATE_MAX);
+			}
+
+			return new SoundSource(ID, Position, SoundInstances, rate, Bus);
 		}
 		
 		/// <summary>
@@ -57,35 +151,48 @@ namespace heng.Audio
 		/// <param name="sound">The <see cref="Sound"/> from which to create a new <see cref="SoundInstance"/>.</param>
 		/// <returns>A new <see cref="SoundSource"/>, playing the sound through a new <see cref="SoundInstance"/>.</returns>
 		public SoundSource PlaySound(Sound sound)
+		{
+			return PlaySound(sound, Core.Audio.Mixer.Channels.AUDIO_MIXER_CHANNELS_PRIORITY_DEFAULT);
+		}
+
+		/// <summary>
+		/// Plays the given <see cref="Sound"/> on this <see cref="SoundSource"/>, with the given priority.
+		/// <para>When more sounds are playing than can be mixed, the lowest-priority (then quietest)
+		/// <see cref="SoundInstance"/>s are virtualized: they keep playing silently, and are heard again once
+		/// there's room for them. When every mixer channel is in use, the least important one (virtualized instances first)
+		/// is stopped to make room.</para>
+		/// </summary>
+		/// <param name="sound">The <see cref="Sound"/> from which to create a new <see cref="SoundInstance"/>.</param>
+		/// <param name="priority">The new <see cref="SoundInstance"/>'s priority. Higher values are mixed first.</param>
+		/// <returns>A new <see cref="SoundSource"/>, playing the sound through a new <see cref="SoundInstance"/>.</returns>
+		public SoundSource PlaySound(Sound sound, byte priority)
 		{
 			if(sound != null)
 			{
-				List<SoundInstance> instances = new List<SoundInstance>(SoundInstances);
-				instances.Add(new SoundInstance(sound));
-
-				return new SoundSource(Position, instances);
+				// only the trie's tail is copied; existing instances are shared
+				return new SoundSource(ID, Position, SoundInstances.Add(new SoundInstance(sound, Rate, priority, Bus)), Rate, Bus);
 			}
 			
 			return this;
 		}
 
-		internal SoundSource UpdateInstances(WorldPoint listenerPos, Core.Audio.Mixer.Channels.State channelState)
+		internal SoundSource UpdateInstances(WorldPoint listenerPos, Core.Audio.Mixer.Channels.View channels, ChannelBatch batch)
 		{
-			List<SoundInstance> newInstances = new List<SoundInstance>();
+			if(SoundInstances.Count == 0)
+			{ return this; }
+
+			Vector2 newOffset = Position.PixelDistance(listenerPos);
+
+			PersistentList<SoundInstance>.Builder newInstances = new PersistentList<SoundInstance>.Builder();
 			foreach(SoundInstance instc in SoundInstances)
 			{
-				SoundInstance newInstc = instc.Update(channelState.Channels[instc.Channel]);
+				SoundInstance newInstc = instc.Update(channels[instc.Channel], newOffset, Rate, batch);
 
 				if(newInstc.Progress < 1)
-				{
-					Vector2 newOffset = Position.PixelDistance(listenerPos);
-					newInstc = newInstc.Reposition(newOffset);
-
-					newInstances.Add(newInstc);
-				}
+				{ newInstances.Add(newInstc); }
 			}
 
-			return new SoundSource(Position, newInstances);
+			return new SoundSource(ID, Position, newInstances.ToList(), Rate, Bus);
 		}
 	};
 };
\ No newline at end of file
@@ -8,24 +8,43 @@ namespace heng
 	{
 		public static class Audio
 		{
-			[StructLayout(LayoutKind.Sequential)]
-			public struct State
+			public const UInt32 SnapshotVersion = 3;
+			
+			public enum Section
 			{
-				public readonly int DeviceID;
-				
-				public readonly AudioFormat Format;
-				public readonly int Channels;
-				public readonly int SampleRate;
-				public readonly int SampleSize;
-				
-				public readonly int SamplesNeeded;
-				
-				public readonly Sounds.State Sounds;
-				public readonly Mixer.State Mixer;
+				Device,
+				Sounds,
+				Channels,
+				Mix,
+				Buses
 			};
 			
-			[DllImport(coreLib, EntryPoint = "Audio_GetSnapshot")]
-			public static extern void GetSnapshot(out Audio.State state);
+			[DllImport(coreLib, EntryPoint = "Audio_GetSnapshotView")]
+			static extern unsafe SnapshotHeader* GetSnapshotView(UInt32 sectionMask);
+			
+			// only the asked-for section is refreshed; the pointer stays valid until the core quits
+			static unsafe T* GetSection<T>(Section section) where T : unmanaged
+			{ return GetSnapshotSection<T>(GetSnapshotView(1u << (int)(section)), SnapshotVersion, (int)(section)); }
+			
+			public static class Device
+			{
+				[StructLayout(LayoutKind.Sequential)]
+				public struct State
+				{
+					public readonly UInt64 Generation;
+					
+					public readonly int DeviceID;
+					
+					public readonly AudioFormat Format;
+					public readonly int Channels;
+					public readonly int SampleRate;
+					public readonly int SampleSize;
+					
+					public readonly int SamplesNeeded;
+				};
+				
+				public static unsafe State* GetSnapshot() => GetSection<State>(Section.Device);
+			};
 			
 			[DllImport(coreLib, EntryPoint = "Audio_PushSound")]
 			public static extern void PushSound();
@@ -35,33 +54,45 @@ namespace heng
 				[StructLayout(LayoutKind.Sequential)]
 				public struct State
 				{
+					public readonly UInt64 Generation;
+					
 					public readonly int MaxSounds;
 					public readonly int SoundCount;
+					public readonly int PendingCount;
+
+					public readonly UInt64 ResidentBytes;
+					public readonly UInt64 DecodedBytes;
+					public readonly UInt64 BudgetBytes;
 				};
 				
+				public static unsafe State* GetSnapshot() => GetSection<State>(Section.Sounds);
+				
 				[DllImport(coreLib, EntryPoint = "Audio_Sounds_LoadSound")]
 				public static extern int LoadSound(string filePath);
 				
+				[DllImport(coreLib, EntryPoint = "Audio_Sounds_RequestSound")]
+				public static extern int RequestSound(string filePath);
+				
 				[DllImport(coreLib, EntryPoint = "Audio_Sounds_FreeSound")]
 				public static extern void FreeSound(int soundID);
 				
 				[DllImport(coreLib, EntryPoint = "Audio_Sounds_CheckSound")]
 				[return: MarshalAs(UnmanagedType.U1)]
 				public static extern bool CheckSound(int soundID);
+				
+				[DllImport(coreLib, EntryPoint = "Audio_Sounds_GetSoundSize")]
+				public static extern UInt64 GetSoundSize(int soundID);
+				
+				[DllImport(coreLib, EntryPoint = "Audio_Sounds_SetBudget")]
+				public static extern void SetBudget(UInt64 bytes);
 			};
 			
 			public static class Mixer
 			{
-				[StructLayout(LayoutKind.Sequential)]
-				public struct State
-				{
-					public readonly Channels.State Channels;
-					public readonly Mix.State Mix;
-				};
-				
 				public static class Channels
 				{
-					public const int AUDIO_MIXER_CHANNELS_MAX = 64;
+					public const int AUDIO_MIXER_CHANNELS_MAX = 256;
+					public const byte AUDIO_MIXER_CHANNELS_PRIORITY_DEFAULT = 128;
 
 					[StructLayout(LayoutKind.Sequential)]
 					public struct MixerChannelPanning
@@ -80,25 +111,61 @@ namespace heng
 					public struct MixerChannel
 					{
 						public readonly int SoundID;
+						public readonly UInt32 Voice;
 						public readonly UInt32 DataPos;
 						public readonly UInt32 DataLen;
 						
 						public readonly Byte Volume;
 						public readonly MixerChannelPanning Panning;
+						public readonly Byte Priority;
+						public readonly Byte Bus;
+						public readonly float Rate;
+
+						readonly Byte isVirtual;
+						readonly Byte isLoading;
+
+						public bool IsVirtual => isVirtual != 0;
+						public bool IsLoading => isLoading != 0;
 					};
 					
+					// followed by AUDIO_MIXER_CHANNELS_MAX MixerChannels
 					[StructLayout(LayoutKind.Sequential)]
 					public struct State
 					{
+						public readonly UInt64 Generation;
+						
 						public readonly int ChannelCount;
-
-						[MarshalAs(UnmanagedType.ByValArray, SizeConst = AUDIO_MIXER_CHANNELS_MAX)]
-						public readonly MixerChannel[] Channels;
+						public readonly int RealVoiceCount;
+					};
+					
+					/// <summary>
+					/// Reads channels straight out of the core's snapshot, without copying them.
+					/// </summary>
+					public unsafe struct View
+					{
+						readonly MixerChannel* channels;
+						
+						public View(State* state)
+						{ channels = (MixerChannel*)(state + 1); }
+						
+						public MixerChannel this[int channel]
+						{
+							get
+							{
+								Assert.Index(channel, AUDIO_MIXER_CHANNELS_MAX);
+								return channels[channel];
+							}
+						}
 					};
+					
+					public static unsafe State* GetSnapshot() => GetSection<State>(Section.Channels);
 
 					[DllImport(coreLib, EntryPoint = "Audio_Mixer_Channels_GetNextFreeChannel")]
 					public static extern int GetNextFreeChannel();
 
+					[DllImport(coreLib, EntryPoint = "Audio_Mixer_Channels_GetVoice")]
+					public static extern UInt32 GetVoice(int channel);
+
 					[DllImport(coreLib, EntryPoint = "Audio_Mixer_Channels_SetSound")]
 					public static extern int SetSound(int channel, int soundID);
 					
@@ -108,11 +175,33 @@ namespace heng
 					[DllImport(coreLib, EntryPoint = "Audio_Mixer_Channels_SetPanning")]
 					public static extern void SetPanning(int channel, MixerChannelPanning panning);
 					
+					public const float AUDIO_MIXER_CHANNELS_RATE_MAX = 8;
+
+					[DllImport(coreLib, EntryPoint = "Audio_Mixer_Channels_SetRate")]
+					public static extern void SetRate(int channel, float rate);
+					
+					[DllImport(coreLib, EntryPoint = "Audio_Mixer_Channels_SetPriority")]
+					public static extern void SetPriority(int channel, Byte priority);
+					
+					[DllImport(coreLib, EntryPoint = "Audio_Mixer_Channels_SetBus")]
+					public static extern void SetBus(int channel, Byte bus);
+					
 					[DllImport(coreLib, EntryPoint = "Audio_Mixer_Channels_CalcAttenuation")]
 					public static extern void CalcAttenuation(int channel, Vector2 offsetFromListener, float maxDist);
 					
+					[DllImport(coreLib, EntryPoint = "Audio_Mixer_Channels_CalcAttenuationBatch")]
+					public static extern void CalcAttenuationBatch(int[] channelIDs, Vector2[] offsetsFromListener, int count, float maxDist);
+
+					public const int AUDIO_MIXER_ATTENUATION_CURVE_MAX = 64;
+
+					[DllImport(coreLib, EntryPoint = "Audio_Mixer_Channels_SetAttenuationCurve")]
+					public static extern void SetAttenuationCurve(float[] gains, int count);
+					
 					[DllImport(coreLib, EntryPoint = "Audio_Mixer_Channels_Advance")]
 					public static extern void Advance(int channel, bool loop);
+
+					[DllImport(coreLib, EntryPoint = "Audio_Mixer_Channels_AdvanceBatch")]
+					public static extern void AdvanceBatch(int[] channelIDs, int count, bool loop);
 				};
 				
 				public static class Mix
@@ -120,9 +209,60 @@ namespace heng
 					[StructLayout(LayoutKind.Sequential)]
 					public struct State
 					{
+						public readonly UInt64 Generation;
+						
 						public readonly int AccumulatorSize;
 						public readonly float StereoFalloffExponent;
 					};
+					
+					public static unsafe State* GetSnapshot() => GetSection<State>(Section.Mix);
+				};
+				
+				public static class Buses
+				{
+					public const int MIXER_BUS_COUNT = 4;
+
+					[StructLayout(LayoutKind.Sequential)]
+					public struct Bus
+					{
+						public readonly float Gain;
+						public readonly float LowPassCutoff;
+						public readonly float ReverbSend;
+						public readonly float CompressorThreshold;
+						public readonly float CompressorRatio;
+						public readonly float Peak;
+					};
+
+					// followed by BusCount Buses
+					[StructLayout(LayoutKind.Sequential)]
+					public struct State
+					{
+						public readonly UInt64 Generation;
+
+						public readonly int BusCount;
+						public readonly float ReverbFeedback;
+						public readonly float ReverbDamping;
+						public readonly float LimiterGain;
+					};
+
+					public static unsafe State* GetSnapshot() => GetSection<State>(Section.Buses);
+
+					public static unsafe Bus* GetBuses(State* state) => (Bus*)(state + 1);
+
+					[DllImport(coreLib, EntryPoint = "Audio_Mixer_Buses_SetGain")]
+					public static extern void SetGain(int bus, float gain);
+
+					[DllImport(coreLib, EntryPoint = "Audio_Mixer_Buses_SetLowPass")]
+					public static extern void SetLowPass(int bus, float cutoffHz);
+
+					[DllImport(coreLib, EntryPoint = "Audio_Mixer_Buses_SetReverbSend")]
+					public static extern void SetReverbSend(int bus, float send);
+
+					[DllImport(coreLib, EntryPoint = "Audio_Mixer_Buses_SetCompressor")]
+					public static extern void SetCompressor(int bus, float thresholdDB, float ratio);
+
+					[DllImport(coreLib, EntryPoint = "Audio_Mixer_Buses_SetReverb")]
+					public static extern void SetReverb(float feedback, float damping);
 				};
 			};
 		};
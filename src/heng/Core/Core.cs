@@ -1,4 +1,5 @@
-﻿using System.Runtime.InteropServices;
+﻿using System;
+using System.Runtime.InteropServices;
 
 namespace heng
 {
@@ -6,6 +7,29 @@ namespace heng
 	{
 		const string coreLib = "hcore";
 
+		public const int SnapshotSectionsMax = 8;
+
+		/// <summary>
+		/// Starts every snapshot view; sections are found through their offsets, and read in place.
+		/// </summary>
+		[StructLayout(LayoutKind.Sequential)]
+		public unsafe struct SnapshotHeader
+		{
+			public readonly UInt32 Version;
+			public readonly UInt32 Size;
+			public readonly UInt32 SectionCount;
+			public fixed UInt32 SectionOffsets[SnapshotSectionsMax];
+		};
+
+		// every section starts with a UInt64 generation, which only changes with the section's contents
+		static unsafe T* GetSnapshotSection<T>(SnapshotHeader* header, UInt32 version, int section) where T : unmanaged
+		{
+			Assert.Cond(header->Version == version, $"core snapshot is version {header->Version}, but heng expects {version}");
+			Assert.Index(section, (int)(header->SectionCount));
+
+			return (T*)((byte*)(header) + header->SectionOffsets[section]);
+		}
+
 		public static class Events
 		{
 			[DllImport(coreLib, EntryPoint = "Core_Events_Pump")]
@@ -16,6 +40,31 @@ namespace heng
 			public static extern bool IsQuitRequested();
 		};
 
+		public static class Memory
+		{
+			[StructLayout(LayoutKind.Sequential)]
+			public struct State
+			{
+				[MarshalAs(UnmanagedType.ByValArray, SizeConst = TagMax)]
+				public readonly TagState[] Tags;
+			};
+
+			[StructLayout(LayoutKind.Sequential)]
+			public struct TagState
+			{
+				public readonly UInt64 LiveBytes;
+				public readonly UInt64 PeakBytes;
+				public readonly UInt64 LiveCount;
+				public readonly UInt64 TotalCount;
+				public readonly UInt64 ScratchPeakBytes;
+			};
+
+			public const int TagMax = 5;
+
+			[DllImport(coreLib, EntryPoint = "Core_GetMemorySnapshot")]
+			public static extern void GetSnapshot(out Memory.State state);
+		};
+
 		[DllImport(coreLib, EntryPoint = "Core_Init")]
 		[return: MarshalAs(UnmanagedType.U1)]
 		public static extern bool Init(CoreConfig config);
@@ -2,6 +2,7 @@
 using System.Runtime.InteropServices;
 using heng.Audio;
 using heng.Logging;
+using heng.Video;
 
 namespace heng
 {
@@ -56,6 +57,25 @@ namespace heng
 				/// The maximum number of sound resources that can be loaded.
 				/// </summary>
 				public int MaxSounds;
+
+				/// <summary>
+				/// Whether to keep sound resources compressed in memory (as 4-bit IMA-ADPCM), at roughly a quarter of
+				/// their decoded size.
+				/// <para>Sounds are decoded by the mixer as they play, at a small CPU cost and some loss in quality.
+				/// Only 16-bit (<see cref="AudioFormat.S16"/>) output supports compression; otherwise, this is ignored.
+				/// Only 16-bit samples are compressed, so unless they're converted as they load, sounds in other formats
+				/// are kept uncompressed.</para>
+				/// </summary>
+				[MarshalAs(UnmanagedType.U1)]
+				public bool CompressSounds;
+
+				/// <summary>
+				/// Whether to convert sounds to the output's format, channel count and sample rate as they load.
+				/// <para>Otherwise, sounds are kept in their own format, and the mixer converts them as they play; that
+				/// keeps low-rate and mono sounds small, at some CPU cost for each channel playing one.</para>
+				/// </summary>
+				[MarshalAs(UnmanagedType.U1)]
+				public bool ConvertOnLoad;
 			};
 
 			/// <summary>
@@ -80,11 +100,20 @@ namespace heng
 				/// into a mono-channel sound the farther away from the listener it goes.</para>
 				/// </summary>
 				public float StereoFalloffExponent;
+
+				/// <summary>
+				/// The maximum number of channels that are actually mixed each frame.
+				/// <para>When more channels are playing, the quietest and lowest-priority ones are virtualized: they keep
+				/// advancing through their sounds, but aren't heard until they're important enough again.
+				/// 0 mixes every channel.</para>
+				/// </summary>
+				public int RealVoiceCount;
 			};
 
 			/// <summary>
 			/// The sample format at which audio should be played.
-			/// <para>Sound resources in different formats will be converted to this target format when loaded.</para>
+			/// <para>Sound resources in other formats keep their own, and the mixer converts them as they play,
+			/// unless <see cref="SoundsConfig.ConvertOnLoad"/> is set, in which case they're converted to this format as they load.</para>
 			/// </summary>
 			public AudioFormat Format;
 
@@ -110,6 +139,18 @@ namespace heng
 			public MixerConfig Mixer;
 		};
 
+		/// <summary>
+		/// Configuration settings for the engine core's video system.
+		/// </summary>
+		[StructLayout(LayoutKind.Sequential)]
+		public struct VideoConfig
+		{
+			/// <summary>
+			/// How the video system draws; see <see cref="VideoBackend"/>.
+			/// </summary>
+			public VideoBackend Backend;
+		};
+
 		/// <summary>
 		/// Configuration settings for the engine core's logging system.
 		/// </summary>
@@ -124,5 +165,10 @@ namespace heng
 		/// Configuration settings for the engine core's audio system.
 		/// </summary>
 		public AudioConfig Audio;
+
+		/// <summary>
+		/// Configuration settings for the engine core's video system.
+		/// </summary>
+		public VideoConfig Video;
 	};
 }
\ No newline at end of file
@@ -10,40 +10,78 @@ namespace heng
 		{
 			public const int ControllersMax = 4;
 			
+			// input_state, as raw words; see input.h for the layout
+			public const int StateWords = 36;
+			public const int KeyWords = 8;
+			public const int MouseXWord = 16;
+			public const int MouseYWord = 17;
+			public const int MouseButtonsWord = 18;
+			public const int ControllersWord = 19;
+			public const int ControllerWords = 4;	// buttons, then the axes as packed Int16s
+
+			// followed by StateWords UInt32s, of which ChangedCount are used
 			[StructLayout(LayoutKind.Sequential)]
-			public struct State
+			public struct StateDelta
 			{
-				[MarshalAs(UnmanagedType.ByValArray, ArraySubType = UnmanagedType.U1, SizeConst = (int)(KeyCode.Count))]
-				public readonly bool[] Keyboard;
-
-				public readonly MouseState Mouse;
-
-				[MarshalAs(UnmanagedType.ByValArray, SizeConst = ControllersMax)]
-				public readonly ControllerState[] Controllers;
+				public readonly UInt64 ChangedMask;
+				public readonly int ChangedCount;
+				public readonly int WordsOffset;
 			};
 
 			[StructLayout(LayoutKind.Sequential)]
-			public struct MouseState
+			public unsafe struct Edges
 			{
-				public readonly int X;
-				public readonly int Y;
-
-				[MarshalAs(UnmanagedType.ByValArray, ArraySubType = UnmanagedType.U1, SizeConst = (int)(MouseButtonCode.Count))]
-				public readonly bool[] Buttons;
+				public fixed UInt64 KeysPressed[KeyWords];
+				public fixed UInt64 KeysReleased[KeyWords];
+				public readonly UInt32 MousePressed;
+				public readonly UInt32 MouseReleased;
+				public fixed UInt32 ControllersPressed[ControllersMax];
+				public fixed UInt32 ControllersReleased[ControllersMax];
 			};
 
-			[StructLayout(LayoutKind.Sequential)]
-			public struct ControllerState
+			[DllImport(coreLib, EntryPoint = "Input_GetSnapshotDelta")]
+			static extern unsafe StateDelta* GetSnapshotDelta();
+
+			[DllImport(coreLib, EntryPoint = "Input_GetFrameEdges")]
+			public static extern unsafe Edges* GetFrameEdges();
+
+			// the core sends just the words that changed since the last call, which are applied here
+			static readonly UInt32[] stateWords = new UInt32[StateWords];
+
+			public static unsafe UInt32[] GetSnapshot()
 			{
-				[MarshalAs(UnmanagedType.ByValArray, ArraySubType = UnmanagedType.U1, SizeConst = (int)(ControllerButtonCode.Count))]
-				public readonly bool[] Buttons;
+				StateDelta* delta = GetSnapshotDelta();
 
-				[MarshalAs(UnmanagedType.ByValArray, SizeConst = (int)(AxisCode.Count))]
-				public readonly Int16[] Axes;
+				// the words start wherever the core's compiler put them; if that's not where ours would, the layouts have drifted
+				Assert.Cond(delta->WordsOffset == sizeof(StateDelta),
+					$"core's input delta words are at offset {delta->WordsOffset}, but heng expects {sizeof(StateDelta)}");
+				UInt32* changed = (UInt32*)((byte*)(delta) + delta->WordsOffset);
+
+				int c = 0;
+				for(int w = 0; w < StateWords && c < delta->ChangedCount; w++)
+				{
+					if((delta->ChangedMask & (1ul << w)) != 0)
+					{ stateWords[w] = changed[c++]; }
+				}
+
+				return (UInt32[])(stateWords.Clone());
+			}
+
+			public const int EventsMax = 256;
+
+			// followed by EventsMax InputEvents
+			[StructLayout(LayoutKind.Sequential)]
+			public struct Events
+			{
+				public readonly UInt32 Frame;
+				public readonly int Count;
+				public readonly int OverflowCount;
 			};
 
-			[DllImport(coreLib, EntryPoint = "Input_GetSnapshot")]
-			public static extern void GetSnapshot(out Input.State state);
+			[DllImport(coreLib, EntryPoint = "Input_GetEvents")]
+			public static extern unsafe Events* GetEvents();
+
+			public static unsafe InputEvent* GetEventList(Events* events) => (InputEvent*)(events + 1);
 		};
 	};
 }
\ No newline at end of file
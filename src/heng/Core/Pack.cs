@@ -0,0 +1,17 @@
+﻿using System.Runtime.InteropServices;
+
+namespace heng
+{
+	internal static partial class Core
+	{
+		public static class Pack
+		{
+			[DllImport(coreLib, EntryPoint = "Pack_Mount")]
+			public static extern int Mount(string filePath);
+
+			[DllImport(coreLib, EntryPoint = "Pack_Unmount")]
+			[return: MarshalAs(UnmanagedType.U1)]
+			public static extern bool Unmount(int packID);
+		};
+	};
+}
\ No newline at end of file
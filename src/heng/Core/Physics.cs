@@ -0,0 +1,66 @@
+﻿using System.Runtime.InteropServices;
+
+namespace heng
+{
+	internal static partial class Core
+	{
+		public static class Physics
+		{
+			public static class Collision
+			{
+				[StructLayout(LayoutKind.Sequential)]
+				public struct Collider
+				{
+					public readonly Vector2 Position;
+					public readonly Vector2 Velocity;
+					public readonly int Group;
+					public readonly int PointStart;
+					public readonly int PointCount;
+
+					public Collider(Vector2 position, Vector2 velocity, int group, int pointStart, int pointCount)
+					{
+						Position = position;
+						Velocity = velocity;
+						Group = group;
+						PointStart = pointStart;
+						PointCount = pointCount;
+					}
+				};
+
+				[StructLayout(LayoutKind.Sequential)]
+				public struct Contact
+				{
+					public readonly int A, B;
+					public readonly Vector2 MTV;
+				};
+
+				[DllImport(coreLib, EntryPoint = "Physics_Collision_TestColliders")]
+				public static extern int TestColliders(Vector2[] points, Collider[] colliders, int colliderCount,
+					[Out] Contact[] contacts, int contactCapacity);
+			};
+
+			public static class Integration
+			{
+				[StructLayout(LayoutKind.Sequential)]
+				public struct Body
+				{
+					public readonly Vector2 Position;
+					public readonly Vector2 Velocity;
+					public readonly Vector2 Forces;
+					public readonly float Mass;
+
+					public Body(Vector2 position, Vector2 velocity, Vector2 forces, float mass)
+					{
+						Position = position;
+						Velocity = velocity;
+						Forces = forces;
+						Mass = mass;
+					}
+				};
+
+				[DllImport(coreLib, EntryPoint = "Physics_Integration_IntegrateBodies")]
+				public static extern void IntegrateBodies([In, Out] Body[] bodies, int bodyCount, Vector2 gravity, float deltaT);
+			};
+		};
+	};
+}
\ No newline at end of file
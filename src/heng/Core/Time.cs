@@ -15,6 +15,61 @@ namespace heng
 
 			[DllImport(coreLib, EntryPoint = "Time_TimeProcedure")]
 			public static extern void TimeProcedure(Action proc);
+
+			[StructLayout(LayoutKind.Sequential)]
+			public struct FrameStats
+			{
+				[MarshalAs(UnmanagedType.ByValArray, SizeConst = FrameStatMax)]
+				public readonly FrameStatInfo[] Stats;
+
+				public readonly UInt64 FrameCount;
+				public readonly UInt64 TotalHitchCount;
+				public readonly UInt32 HitchThreshold;
+			};
+
+			[StructLayout(LayoutKind.Sequential)]
+			public struct FrameStatInfo
+			{
+				public readonly UInt32 SampleCount;
+				public readonly UInt32 P50;
+				public readonly UInt32 P95;
+				public readonly UInt32 P99;
+				public readonly UInt32 Max;
+				public readonly UInt32 HitchCount;
+			};
+
+			public const int FrameStatMax = 4;
+
+			[DllImport(coreLib, EntryPoint = "Time_MarkFrame")]
+			public static extern void MarkFrame();
+
+			[DllImport(coreLib, EntryPoint = "Time_GetFrameStats")]
+			public static extern void GetFrameStats(out FrameStats stats);
+
+			[DllImport(coreLib, EntryPoint = "Time_SetHitchThreshold")]
+			public static extern void SetHitchThreshold(UInt32 us);
+
+			[DllImport(coreLib, EntryPoint = "Time_ResetFrameStats")]
+			public static extern void ResetFrameStats();
+
+			public static class Profiler
+			{
+				[DllImport(coreLib, EntryPoint = "Time_Profiler_SetEnabled")]
+				public static extern void SetEnabled([MarshalAs(UnmanagedType.U1)] bool enabled);
+
+				[DllImport(coreLib, EntryPoint = "Time_Profiler_RegisterZone")]
+				public static extern int RegisterZone(string name);
+
+				[DllImport(coreLib, EntryPoint = "Time_Profiler_BeginZone")]
+				public static extern void BeginZone(int zoneID);
+
+				[DllImport(coreLib, EntryPoint = "Time_Profiler_EndZone")]
+				public static extern void EndZone();
+
+				[DllImport(coreLib, EntryPoint = "Time_Profiler_WriteTrace")]
+				[return: MarshalAs(UnmanagedType.U1)]
+				public static extern bool WriteTrace(string filePath);
+			};
 		};
 	};
 }
\ No newline at end of file
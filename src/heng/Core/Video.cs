@@ -8,30 +8,38 @@ namespace heng
 	{
 		public static class Video
 		{
-			[StructLayout(LayoutKind.Sequential)]
-			public struct State
+			public const UInt32 SnapshotVersion = 3;
+
+			public enum Section
 			{
-				public readonly Windows.State Windows;
-				public readonly Textures.State Textures;
-				public readonly Queue.State Queue;
+				Windows,
+				Textures,
+				Queue
 			};
 
 			public static class Windows
 			{
+				// followed by Max WindowInfos
 				[StructLayout(LayoutKind.Sequential)]
 				public struct State
 				{
-					[MarshalAs(UnmanagedType.ByValArray, SizeConst = Max)]
-					public readonly WindowInfo[] WindowInfo;
+					public readonly UInt64 Generation;
 				};
 
 				[StructLayout(LayoutKind.Sequential)]
-				public struct WindowInfo
+				public unsafe struct WindowInfo
 				{
 					public readonly int ID;
 
-					[MarshalAs(UnmanagedType.ByValTStr, SizeConst = TitleMax)]
-					public readonly string Title;
+					fixed byte title[TitleMax];
+					public string Title
+					{
+						get
+						{
+							fixed(byte* t = title)
+							{ return Marshal.PtrToStringAnsi((IntPtr)(t)); }
+						}
+					}
 
 					public readonly int DisplayIndex;
 					public readonly int RefreshRate;
@@ -41,6 +49,14 @@ namespace heng
 					public readonly ScreenRect ViewportRect;
 				};
 
+				[StructLayout(LayoutKind.Sequential)]
+				public struct DrawStats
+				{
+					public readonly UInt64 DrawCalls;
+					public readonly UInt64 Points;
+					public readonly UInt64 Presents;
+				};
+
 				public enum PointsDrawMode
 				{
 					Points,
@@ -50,6 +66,10 @@ namespace heng
 				public const int TitleMax = 128;
 				public const int Max = 4;
 
+				public static unsafe State* GetSnapshot() => GetSection<State>(Section.Windows);
+
+				public static unsafe WindowInfo* GetWindowInfo(State* state) => (WindowInfo*)(state + 1);
+
 				[DllImport(coreLib, EntryPoint = "Video_Windows_OpenWindow")]
 				public static extern void OpenWindow(int windowID, string title, ScreenRect rect, UInt32 windowFlags, UInt32 rendererFlags);
 
@@ -60,6 +80,13 @@ namespace heng
 				[return: MarshalAs(UnmanagedType.U1)]
 				public static extern bool CheckWindow(int windowID);
 
+				[DllImport(coreLib, EntryPoint = "Video_Windows_GetDrawStats")]
+				public static extern void GetDrawStats(int windowID, out DrawStats stats);
+
+				[DllImport(coreLib, EntryPoint = "Video_Windows_SaveImage")]
+				[return: MarshalAs(UnmanagedType.U1)]
+				public static extern bool SaveImage(int windowID, string filePath);
+
 				[DllImport(coreLib, EntryPoint = "Video_Windows_SetWindowColor")]
 				public static extern void SetWindowColor(int windowID, Color color);
 
@@ -81,8 +108,20 @@ namespace heng
 				[DllImport(coreLib, EntryPoint = "Video_Windows_DrawRect")]
 				public static extern void DrawRect(int windowID, ScreenRect rect, bool fill);
 
+				[DllImport(coreLib, EntryPoint = "Video_Windows_FillPolygon")]
+				public static extern void FillPolygon(int windowID, ScreenPoint[] points, int count);
+
 				[DllImport(coreLib, EntryPoint = "Video_Windows_DrawTexture")]
 				public static extern void DrawTexture(int windowID, int textureID, ScreenPoint position, float rotation);
+
+				[DllImport(coreLib, EntryPoint = "Video_Windows_SetTarget")]
+				public static extern void SetTarget(int windowID, int targetID);
+
+				[DllImport(coreLib, EntryPoint = "Video_Windows_DrawTarget")]
+				public static extern void DrawTarget(int windowID, int targetID, ScreenPoint position);
+
+				[DllImport(coreLib, EntryPoint = "Video_Windows_DrawTilemap")]
+				public static extern void DrawTilemap(int windowID, int tilemapID, int chunkX, int chunkY, ScreenPoint position);
 			};
 
 			public static class Textures
@@ -90,16 +129,27 @@ namespace heng
 				[StructLayout(LayoutKind.Sequential)]
 				public struct State
 				{
+					public readonly UInt64 Generation;
+
 					public readonly int MaxSurfaces;
 					public readonly int SurfaceCount;
+					public readonly int PendingCount;
+
+					public readonly UInt64 ResidentBytes;
+					public readonly UInt64 BudgetBytes;
 
 					public readonly int CacheSize;
 					public readonly int CacheUsage;
 				};
 
+				public static unsafe State* GetSnapshot() => GetSection<State>(Section.Textures);
+
 				[DllImport(coreLib, EntryPoint = "Video_Textures_LoadTexture")]
 				public static extern int LoadTexture(string filePath);
 
+				[DllImport(coreLib, EntryPoint = "Video_Textures_RequestTexture")]
+				public static extern int RequestTexture(string filePath);
+
 				[DllImport(coreLib, EntryPoint = "Video_Textures_FreeTexture")]
 				public static extern void FreeTexture(int textureID);
 
@@ -107,13 +157,75 @@ namespace heng
 				[return: MarshalAs(UnmanagedType.U1)]
 				public static extern bool CheckTexture(int textureID);
 
+				[DllImport(coreLib, EntryPoint = "Video_Textures_GetTextureSize")]
+				public static extern UInt64 GetTextureSize(int textureID);
+
+				[DllImport(coreLib, EntryPoint = "Video_Textures_SetBudget")]
+				public static extern void SetBudget(UInt64 bytes);
+
 				[DllImport(coreLib, EntryPoint = "Video_Textures_ClearCache")]
 				public static extern void ClearCache();
 			};
 
+			public static class Targets
+			{
+				public const int Max = 64;
+
+				[DllImport(coreLib, EntryPoint = "Video_Targets_CreateTarget")]
+				public static extern int CreateTarget(int windowID, int w, int h);
+
+				[DllImport(coreLib, EntryPoint = "Video_Targets_FreeTarget")]
+				public static extern void FreeTarget(int targetID);
+
+				[DllImport(coreLib, EntryPoint = "Video_Targets_CheckTarget")]
+				[return: MarshalAs(UnmanagedType.U1)]
+				public static extern bool CheckTarget(int targetID);
+
+				[DllImport(coreLib, EntryPoint = "Video_Targets_IsLost")]
+				[return: MarshalAs(UnmanagedType.U1)]
+				public static extern bool IsLost(int targetID);
+			};
+
+			public static class Tilemaps
+			{
+				public const int TilesetsMax = 64;
+				public const int TilemapsMax = 64;
+				public const UInt16 TileEmpty = 0;
+
+				[DllImport(coreLib, EntryPoint = "Video_Tilemaps_CreateTileset")]
+				public static extern int CreateTileset(int textureID, int tileW, int tileH);
+
+				[DllImport(coreLib, EntryPoint = "Video_Tilemaps_FreeTileset")]
+				public static extern void FreeTileset(int tilesetID);
+
+				[DllImport(coreLib, EntryPoint = "Video_Tilemaps_CheckTileset")]
+				[return: MarshalAs(UnmanagedType.U1)]
+				public static extern bool CheckTileset(int tilesetID);
+
+				[DllImport(coreLib, EntryPoint = "Video_Tilemaps_CreateTilemap")]
+				public static extern int CreateTilemap(int tilesetID, int chunkTiles);
+
+				[DllImport(coreLib, EntryPoint = "Video_Tilemaps_FreeTilemap")]
+				public static extern void FreeTilemap(int tilemapID);
+
+				[DllImport(coreLib, EntryPoint = "Video_Tilemaps_CheckTilemap")]
+				[return: MarshalAs(UnmanagedType.U1)]
+				public static extern bool CheckTilemap(int tilemapID);
+
+				[DllImport(coreLib, EntryPoint = "Video_Tilemaps_SetTile")]
+				public static extern void SetTile(int tilemapID, int chunkX, int chunkY, int x, int y, UInt16 tile);
+
+				[DllImport(coreLib, EntryPoint = "Video_Tilemaps_GetTile")]
+				public static extern UInt16 GetTile(int tilemapID, int chunkX, int chunkY, int x, int y);
+
+				[DllImport(coreLib, EntryPoint = "Video_Tilemaps_SetChunk")]
+				public static extern void SetChunk(int tilemapID, int chunkX, int chunkY, UInt16[] tiles);
+			};
+
 			public static class Queue
 			{
-				public const int QueueSize = 1024;
+				// queues grow as needed; this is only how many of a queue's commands its snapshot lists
+				public const int SnapshotCommands = 1024;
 
 				public enum VidCommandType : byte
 				{
@@ -126,25 +238,42 @@ namespace heng
 					Line,
 					Polygon,
 					Rect,
-					Texture
+					Texture,
+					Target,
+					Blit,
+					Tilemap
 				};
 
+				// followed by Windows.Max QueueInfos
 				[StructLayout(LayoutKind.Sequential)]
 				public struct State
 				{
-					[MarshalAs(UnmanagedType.ByValArray, SizeConst = Windows.Max)]
-					public readonly QueueInfo[] Queues;
+					public readonly UInt64 Generation;
 				};
 
 				[StructLayout(LayoutKind.Sequential)]
-				public struct QueueInfo
+				public unsafe struct QueueInfo
 				{
 					public readonly int CommandCount;
-
-					[MarshalAs(UnmanagedType.ByValArray, SizeConst = QueueSize)]
-					public readonly VidCommandType[] Commands;
+					public readonly int PointCount;
+					public readonly int CommandHighWater;
+					public readonly int PointHighWater;
+					public readonly int DroppedCount;
+
+					fixed byte commands[SnapshotCommands];
+					public VidCommandType GetCommand(int index)
+					{
+						Assert.Index(index, Math.Min(CommandCount, SnapshotCommands));
+
+						fixed(byte* c = commands)
+						{ return (VidCommandType)(c[index]); }
+					}
 				};
 
+				public static unsafe State* GetSnapshot() => GetSection<State>(Section.Queue);
+
+				public static unsafe QueueInfo* GetQueueInfo(State* state) => (QueueInfo*)(state + 1);
+
 				[DllImport(coreLib, EntryPoint = "Video_Queue_OpenWindow")]
 				public static extern void OpenWindow(int windowID, string title, ScreenRect rect, UInt32 windowFlags, UInt32 rendererFlags);
 
@@ -169,18 +298,33 @@ namespace heng
 				[DllImport(coreLib, EntryPoint = "Video_Queue_DrawPolygon")]
 				public static extern void DrawPolygon(int windowID, Color color, ScreenPoint[] points, int count);
 
+				[DllImport(coreLib, EntryPoint = "Video_Queue_FillPolygon")]
+				public static extern void FillPolygon(int windowID, Color color, ScreenPoint[] points, int count);
+
 				[DllImport(coreLib, EntryPoint = "Video_Queue_DrawRect")]
 				public static extern void DrawRect(int windowID, Color color, ScreenRect rect, bool fill);
 
 				[DllImport(coreLib, EntryPoint = "Video_Queue_DrawTexture")]
 				public static extern void DrawTexture(int windowID, int textureID, ScreenPoint position, float rotation);
 
+				[DllImport(coreLib, EntryPoint = "Video_Queue_SetTarget")]
+				public static extern void SetTarget(int windowID, int targetID);
+
+				[DllImport(coreLib, EntryPoint = "Video_Queue_DrawTarget")]
+				public static extern void DrawTarget(int windowID, int targetID, ScreenPoint position);
+
+				[DllImport(coreLib, EntryPoint = "Video_Queue_DrawTilemap")]
+				public static extern void DrawTilemap(int windowID, int tilemapID, int chunkX, int chunkY, ScreenPoint position);
+
 				[DllImport(coreLib, EntryPoint = "Video_Queue_Pump")]
 				public static extern void Pump(int windowID);
 
 				[DllImport(coreLib, EntryPoint = "Video_Queue_ClearQueue")]
 				public static extern void ClearQueue(int windowID);
 
+				[DllImport(coreLib, EntryPoint = "Video_Queue_SetBudget")]
+				public static extern void SetBudget(int windowID, int maxCommands, int maxPoints);
+
 				[DllImport(coreLib, EntryPoint = "Video_Queue_PumpAll")]
 				public static extern void PumpAll();
 
@@ -188,8 +332,12 @@ namespace heng
 				public static extern void ClearAll();
 			};
 
-			[DllImport(coreLib, EntryPoint = "Video_GetSnapshot")]
-			public static extern void GetSnapshot(out Video.State state);
+			[DllImport(coreLib, EntryPoint = "Video_GetSnapshotView")]
+			static extern unsafe SnapshotHeader* GetSnapshotView(UInt32 sectionMask);
+
+			// only the asked-for section is refreshed; the pointer stays valid until the core quits
+			static unsafe T* GetSection<T>(Section section) where T : unmanaged
+			{ return GetSnapshotSection<T>(GetSnapshotView(1u << (int)(section)), SnapshotVersion, (int)(section)); }
 		};
 	};
 }
\ No newline at end of file
@@ -0,0 +1,87 @@
+﻿using System;
+
+namespace heng.Diagnostics
+{
+	/// <summary>
+	/// Represents an immutable snapshot of core's memory use, per <see cref="MemoryTag"/>.
+	/// <para>Only memory core allocates itself is tracked; SDL's own allocations (textures, surfaces) aren't included.</para>
+	/// </summary>
+	public class MemoryState
+	{
+		/// <summary>
+		/// Memory use for a single <see cref="MemoryTag"/>.
+		/// </summary>
+		public struct TagInfo
+		{
+			/// <summary>
+			/// Bytes currently allocated.
+			/// </summary>
+			public readonly UInt64 LiveBytes;
+
+			/// <summary>
+			/// The most bytes ever allocated at once.
+			/// </summary>
+			public readonly UInt64 PeakBytes;
+
+			/// <summary>
+			/// Allocations currently live.
+			/// </summary>
+			public readonly UInt64 LiveCount;
+
+			/// <summary>
+			/// Allocations made since the engine started.
+			/// </summary>
+			public readonly UInt64 TotalCount;
+
+			/// <summary>
+			/// The most frame-scoped scratch space the tag's arenas used between resets.
+			/// </summary>
+			public readonly UInt64 ScratchPeakBytes;
+
+			internal TagInfo(Core.Memory.TagState state)
+			{
+				LiveBytes = state.LiveBytes;
+				PeakBytes = state.PeakBytes;
+				LiveCount = state.LiveCount;
+				TotalCount = state.TotalCount;
+				ScratchPeakBytes = state.ScratchPeakBytes;
+			}
+		};
+
+		readonly TagInfo[] tags;
+
+		/// <summary>
+		/// Bytes currently allocated, over every tag.
+		/// </summary>
+		public readonly UInt64 TotalLiveBytes;
+
+		/// <summary>
+		/// Takes a new snapshot of core's memory use.
+		/// </summary>
+		public MemoryState()
+		{
+			Core.Memory.GetSnapshot(out Core.Memory.State coreState);
+
+			tags = new TagInfo[Core.Memory.TagMax];
+			for(int i = 0; i < tags.Length; i++)
+			{
+				tags[i] = new TagInfo(coreState.Tags[i]);
+				TotalLiveBytes += tags[i].LiveBytes;
+			}
+		}
+
+		/// <summary>
+		/// Gets the memory use for the given <see cref="MemoryTag"/>.
+		/// </summary>
+		/// <param name="tag">The subsystem to get memory use for.</param>
+		/// <returns>The tag's memory use.</returns>
+		public TagInfo this[MemoryTag tag]
+		{
+			get
+			{
+				Assert.Index((int)(tag), tags.Length);
+				return tags[(int)(tag)];
+			}
+		}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,33 @@
+﻿namespace heng.Diagnostics
+{
+	/// <summary>
+	/// The engine subsystems core memory is tracked under.
+	/// </summary>
+	public enum MemoryTag
+	{
+		/// <summary>
+		/// Core services not covered by another tag.
+		/// </summary>
+		Core,
+
+		/// <summary>
+		/// Audio device buffers, mixer state and resamplers.
+		/// </summary>
+		Audio,
+
+		/// <summary>
+		/// Loaded sound structures and their samples.
+		/// </summary>
+		Sounds,
+
+		/// <summary>
+		/// Video system allocations.
+		/// </summary>
+		Video,
+
+		/// <summary>
+		/// Resource map slots and file paths.
+		/// </summary>
+		Resources
+	};
+}
\ No newline at end of file
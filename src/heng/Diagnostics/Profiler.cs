@@ -0,0 +1,70 @@
+﻿using System.Collections.Generic;
+
+namespace heng.Diagnostics
+{
+	/// <summary>
+	/// Records timed zones from both the engine and the game, and writes them out as a Chrome trace.
+	/// <para>Open traces in chrome://tracing or Perfetto to see where each frame's time went, per thread.</para>
+	/// While the profiler is disabled, zones cost next to nothing, so they can be left in production code.
+	/// </summary>
+	public static class Profiler
+	{
+		static readonly Dictionary<string, int> zoneIDs = new Dictionary<string, int>();
+		static bool isEnabled;
+
+		/// <summary>
+		/// Whether zones are currently being recorded.
+		/// </summary>
+		public static bool IsEnabled => isEnabled;
+
+		/// <summary>
+		/// Starts a new capture, discarding any previous one.
+		/// </summary>
+		public static void Enable()
+		{
+			Core.Time.Profiler.SetEnabled(true);
+			isEnabled = true;
+		}
+
+		/// <summary>
+		/// Stops recording zones. The capture is kept until the profiler is enabled again.
+		/// </summary>
+		public static void Disable()
+		{
+			Core.Time.Profiler.SetEnabled(false);
+			isEnabled = false;
+		}
+
+		/// <summary>
+		/// Opens a timed zone, which closes when the returned <see cref="ProfilerZone"/> is disposed.
+		/// <para>Use it with a using statement, so zones always nest properly.</para>
+		/// </summary>
+		/// <param name="name">The zone's name, as shown in the trace.</param>
+		/// <returns>The open zone.</returns>
+		public static ProfilerZone Zone(string name)
+		{
+			if(!isEnabled)
+			{ return new ProfilerZone(false); }
+
+			if(!zoneIDs.TryGetValue(name ?? "", out int zoneID))
+			{
+				// core keeps its own copy of each zone's name, since traces are written long after the zone ends
+				zoneID = Core.Time.Profiler.RegisterZone(name ?? "");
+				zoneIDs.Add(name ?? "", zoneID);
+			}
+
+			if(zoneID < 0)
+			{ return new ProfilerZone(false); }
+
+			Core.Time.Profiler.BeginZone(zoneID);
+			return new ProfilerZone(true);
+		}
+
+		/// <summary>
+		/// Writes the current capture to the given file, as Chrome trace event JSON.
+		/// </summary>
+		/// <param name="filePath">The file to write the trace to.</param>
+		/// <returns>True if the trace was written; false if not.</returns>
+		public static bool WriteTrace(string filePath) => Core.Time.Profiler.WriteTrace(filePath);
+	};
+}
\ No newline at end of file
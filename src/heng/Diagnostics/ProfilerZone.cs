@@ -0,0 +1,24 @@
+﻿using System;
+
+namespace heng.Diagnostics
+{
+	/// <summary>
+	/// A timed zone opened by <see cref="Profiler.Zone(string)"/>. Disposing of it closes the zone.
+	/// </summary>
+	public struct ProfilerZone : IDisposable
+	{
+		readonly bool isOpen;
+
+		internal ProfilerZone(bool isOpen)
+		{
+			this.isOpen = isOpen;
+		}
+
+		/// <inheritdoc />
+		public void Dispose()
+		{
+			if(isOpen)
+			{ Core.Time.Profiler.EndZone(); }
+		}
+	};
+}
\ No newline at end of file
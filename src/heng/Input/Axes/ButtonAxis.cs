@@ -7,6 +7,9 @@
 	{
 		readonly IButton negative;
 		readonly IButton positive;
+
+		internal IButton Negative => negative;
+		internal IButton Positive => positive;
 		
 		/// <summary>
 		/// Creates a new <see cref="ButtonAxis"/> using the given virtual <see cref="IButton"/>s.
@@ -26,8 +29,11 @@
 		{
 			Assert.Ref(data);
 
-			bool neg = negative.GetValue(data);
-			bool pos = positive.GetValue(data);
+			return GetValue(negative.GetValue(data), positive.GetValue(data));
+		}
+
+		internal static short GetValue(bool neg, bool pos)
+		{
 			short val = 0;
 		
 			if(neg)
@@ -8,6 +8,9 @@
 	{
 		readonly int controller;
 		readonly AxisCode code;
+
+		internal int Controller => controller;
+		internal AxisCode Code => code;
 		
 		/// <summary>
 		/// Constructs a new <see cref="ControllerAxis"/> using the given code.
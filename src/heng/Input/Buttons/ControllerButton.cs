@@ -9,6 +9,9 @@
 		readonly int controller;
 		readonly ControllerButtonCode code;
 
+		internal int Controller => controller;
+		internal ControllerButtonCode Code => code;
+
 		/// <summary>
 		/// Constructs a new <see cref="ControllerButton"/> using the given code.
 		/// </summary>
@@ -7,6 +7,8 @@
 	{
 		readonly KeyCode code;
 
+		internal KeyCode Code => code;
+
 		/// <summary>
 		/// Constructs a new <see cref="Key"/> using the given code.
 		/// </summary>
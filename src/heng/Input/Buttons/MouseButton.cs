@@ -6,6 +6,8 @@
 	public class MouseButton : IButton
 	{
 		readonly MouseButtonCode code;
+
+		internal MouseButtonCode Code => code;
 		
 		/// <summary>
 		/// Constructs a new <see cref="MouseButton"/> using the given code.
@@ -0,0 +1,175 @@
+﻿using System;
+using System.Collections.Generic;
+
+namespace heng.Input
+{
+	/// <summary>
+	/// An <see cref="InputDevice"/>'s bindings, compiled into flat tables indexed by action ID.
+	/// <para>Built-in buttons and axes become masks and descriptors that are evaluated in a single pass;
+	/// custom <see cref="IButton"/>s and <see cref="IAxis"/>es are kept, and called as a fallback.</para>
+	/// </summary>
+	internal sealed class InputBindings
+	{
+		public const int KeyWords = Core.Input.KeyWords;
+
+		enum AxisKind : byte
+		{
+			Controller,
+			Buttons,
+			Custom,
+			Unbound		// always 0, for axes that couldn't be bound
+		};
+
+		struct AxisBinding
+		{
+			public AxisKind Kind;
+			public int Controller;	// for Controller axes
+			public int Code;
+			public int Negative;	// button action IDs, for Buttons axes
+			public int Positive;
+		};
+
+		// buttons, including the hidden ones compiled out of ButtonAxis halves
+		readonly UInt64[] keyMasks;			// KeyWords per button
+		readonly UInt32[] mouseMasks;
+		readonly UInt32[] controllerMasks;	// ControllersMax per button
+		readonly IButton[] customButtons;	// null where the button compiled to masks
+		readonly bool anyCustomButtons;
+
+		readonly AxisBinding[] axisBindings;
+		readonly IAxis[] customAxes;
+
+		/// <summary>
+		/// How many button values <see cref="Evaluate"/> writes; IDs past the device's own buttons are hidden.
+		/// </summary>
+		public int ButtonValueCount => mouseMasks.Length;
+
+		public int AxisValueCount => axisBindings.Length;
+
+		public InputBindings(IReadOnlyList<IButton> buttons, IReadOnlyList<IAxis> axes)
+		{
+			Assert.Ref(buttons, axes);
+
+			List<IButton> allButtons = new List<IButton>(buttons);
+			axisBindings = new AxisBinding[axes.Count];
+			customAxes = new IAxis[axes.Count];
+
+			for(int i = 0; i < axes.Count; i++)
+			{
+				switch(axes[i])
+				{
+					case ControllerAxis ca:
+						if(IsControllerValid(ca.Controller, "axis", i))
+						{ axisBindings[i] = new AxisBinding { Kind = AxisKind.Controller, Controller = ca.Controller, Code = (int)(ca.Code) }; }
+						else
+						{ axisBindings[i] = new AxisBinding { Kind = AxisKind.Unbound }; }
+						break;
+					case ButtonAxis ba:
+						axisBindings[i] = new AxisBinding { Kind = AxisKind.Buttons, Negative = allButtons.Count, Positive = allButtons.Count + 1 };
+						allButtons.Add(ba.Negative);
+						allButtons.Add(ba.Positive);
+						break;
+					default:
+						axisBindings[i] = new AxisBinding { Kind = AxisKind.Custom };
+						customAxes[i] = axes[i];
+						break;
+				}
+			}
+
+			keyMasks = new UInt64[allButtons.Count * KeyWords];
+			mouseMasks = new UInt32[allButtons.Count];
+			controllerMasks = new UInt32[allButtons.Count * Core.Input.ControllersMax];
+			customButtons = new IButton[allButtons.Count];
+
+			for(int i = 0; i < allButtons.Count; i++)
+			{
+				switch(allButtons[i])
+				{
+					case Key k:
+						if(k.Code >= 0 && k.Code < KeyCode.Count)
+						{ keyMasks[i * KeyWords + ((int)(k.Code) >> 6)] |= 1ul << ((int)(k.Code) & 63); }
+						break;
+					case MouseButton mb:
+						if(mb.Code >= 0 && mb.Code < MouseButtonCode.Count)
+						{ mouseMasks[i] |= 1u << (int)(mb.Code); }
+						break;
+					case ControllerButton cb:
+						// an out-of-range controller would land in another button's masks, so it's left unbound
+						if(cb.Code >= 0 && cb.Code < ControllerButtonCode.Count && IsControllerValid(cb.Controller, "button", i))
+						{ controllerMasks[i * Core.Input.ControllersMax + cb.Controller] |= 1u << (int)(cb.Code); }
+						break;
+					default:
+						customButtons[i] = allButtons[i];
+						anyCustomButtons = true;
+						break;
+				}
+			}
+		}
+
+		static bool IsControllerValid(int controller, string kind, int id)
+		{
+			if(controller >= 0 && controller < Core.Input.ControllersMax)
+			{ return true; }
+
+			Log.Error($"couldn't bind {kind} {id}: controller {controller} is invalid; expected 0 to {Core.Input.ControllersMax - 1}");
+			return false;
+		}
+
+		/// <summary>
+		/// Computes every action's value for the given snapshot.
+		/// </summary>
+		/// <param name="data">The snapshot to read.</param>
+		/// <param name="buttonValues">Receives <see cref="ButtonValueCount"/> button values, indexed by ID.</param>
+		/// <param name="axisValues">Receives <see cref="AxisValueCount"/> axis values, indexed by ID.</param>
+		public void Evaluate(InputData data, bool[] buttonValues, short[] axisValues)
+		{
+			Assert.Ref(data, buttonValues, axisValues);
+			Assert.Cond(buttonValues.Length >= ButtonValueCount && axisValues.Length >= AxisValueCount, "value arrays are too small for the bindings");
+
+			UInt64[] keyBits = data.KeyBits;
+			UInt32[] controllerBits = data.ControllerButtonBits;
+
+			for(int i = 0; i < mouseMasks.Length; i++)
+			{
+				UInt64 keys = 0;
+				for(int w = 0; w < KeyWords; w++)
+				{ keys |= keyMasks[i * KeyWords + w] & keyBits[w]; }
+
+				UInt32 buttons = mouseMasks[i] & data.MouseButtonBits;
+				for(int c = 0; c < Core.Input.ControllersMax; c++)
+				{ buttons |= controllerMasks[i * Core.Input.ControllersMax + c] & controllerBits[c]; }
+
+				buttonValues[i] = (keys | buttons) != 0;
+			}
+
+			if(anyCustomButtons)
+			{
+				for(int i = 0; i < customButtons.Length; i++)
+				{
+					if(customButtons[i] != null)
+					{ buttonValues[i] = customButtons[i].GetValue(data); }
+				}
+			}
+
+			for(int i = 0; i < axisBindings.Length; i++)
+			{
+				AxisBinding a = axisBindings[i];
+				switch(a.Kind)
+				{
+					case AxisKind.Controller:
+						axisValues[i] = data.GetAxisValue(a.Controller, (AxisCode)(a.Code));
+						break;
+					case AxisKind.Buttons:
+						axisValues[i] = ButtonAxis.GetValue(buttonValues[a.Negative], buttonValues[a.Positive]);
+						break;
+					case AxisKind.Unbound:
+						axisValues[i] = 0;
+						break;
+					default:
+						axisValues[i] = customAxes[i].GetValue(data);
+						break;
+				}
+			}
+		}
+	};
+}
\ No newline at end of file
@@ -1,4 +1,7 @@
-﻿namespace heng.Input
+﻿using System;
+using System.Collections.Generic;
+
+namespace heng.Input
 {
 	/// <summary>
 	/// An immutable snapshot of all physical input devices' current state.
@@ -7,21 +10,73 @@
 	/// </summary>
 	public class InputData
 	{
-		readonly Core.Input.State coreState;
+		// the core's packed input_state, word for word
+		readonly UInt32[] stateWords;
+
+		readonly UInt64[] keysPressed;
+		readonly UInt64[] keysReleased;
+		readonly UInt32 mousePressed;
+		readonly UInt32 mouseReleased;
+		readonly UInt32[] controllersPressed;
+		readonly UInt32[] controllersReleased;
+
+		/// <summary>
+		/// Every input transition since the previous frame, in the order they happened.
+		/// <para>Presses shorter than a frame show up here, even though they're gone from the current state.</para>
+		/// </summary>
+		public readonly IReadOnlyList<InputEvent> Events;
+
+		/// <summary>
+		/// How many of this frame's events didn't fit in the timeline, and are missing from <see cref="Events"/>.
+		/// </summary>
+		public readonly int DroppedEventCount;
+
+		// read in place by compiled InputDevice bindings, to test a whole mask at a time
+		internal readonly UInt64[] KeyBits;
+		internal readonly UInt32 MouseButtonBits;
+		internal readonly UInt32[] ControllerButtonBits;
 
 		/// <summary>
 		/// Checks if the given key is currently down.
 		/// </summary>
 		/// <param name="code">The <see cref="KeyCode"/> representing the key to check.</param>
 		/// <returns>True if the key is currently down; false if not.</returns>
-		public bool GetKeyDown(KeyCode code) => coreState.Keyboard[(int)(code)];
+		public bool GetKeyDown(KeyCode code) => TestBit(KeyBits, (int)(code));
+
+		/// <summary>
+		/// Checks if the given key went down this frame.
+		/// </summary>
+		/// <param name="code">The <see cref="KeyCode"/> representing the key to check.</param>
+		/// <returns>True if the key is down now, but wasn't at the start of the frame.</returns>
+		public bool GetKeyPressed(KeyCode code) => TestBit(keysPressed, (int)(code));
+
+		/// <summary>
+		/// Checks if the given key went up this frame.
+		/// </summary>
+		/// <param name="code">The <see cref="KeyCode"/> representing the key to check.</param>
+		/// <returns>True if the key was down at the start of the frame, but isn't now.</returns>
+		public bool GetKeyReleased(KeyCode code) => TestBit(keysReleased, (int)(code));
 
 		/// <summary>
 		/// Checks if the given mouse button is currently down.
 		/// </summary>
 		/// <param name="code">The <see cref="MouseButtonCode"/> representing the button to check.</param>
 		/// <returns>True if the mouse button is currently down; false if not.</returns>
-		public bool GetMouseButtonDown(MouseButtonCode code) => coreState.Mouse.Buttons[(int)(code)];
+		public bool GetMouseButtonDown(MouseButtonCode code) => TestBit(MouseButtonBits, (int)(code));
+
+		/// <summary>
+		/// Checks if the given mouse button went down this frame.
+		/// </summary>
+		/// <param name="code">The <see cref="MouseButtonCode"/> representing the button to check.</param>
+		/// <returns>True if the mouse button is down now, but wasn't at the start of the frame.</returns>
+		public bool GetMouseButtonPressed(MouseButtonCode code) => TestBit(mousePressed, (int)(code));
+
+		/// <summary>
+		/// Checks if the given mouse button went up this frame.
+		/// </summary>
+		/// <param name="code">The <see cref="MouseButtonCode"/> representing the button to check.</param>
+		/// <returns>True if the mouse button was down at the start of the frame, but isn't now.</returns>
+		public bool GetMouseButtonReleased(MouseButtonCode code) => TestBit(mouseReleased, (int)(code));
 
 		/// <summary>
 		/// Checks if the given controller button is currently down.
@@ -33,7 +88,33 @@
 		{
 			Assert.Index(id, Core.Input.ControllersMax);
 
-			return coreState.Controllers[id].Buttons[(int)(code)];
+			return TestBit(ControllerButtonBits[id], (int)(code));
+		}
+
+		/// <summary>
+		/// Checks if the given controller button went down this frame.
+		/// </summary>
+		/// <param name="id">The device ID of the controller to check.</param>
+		/// <param name="code">The <see cref="ControllerButtonCode"/> representing the button to check.</param>
+		/// <returns>True if the controller button is down now, but wasn't at the start of the frame.</returns>
+		public bool GetControllerButtonPressed(int id, ControllerButtonCode code)
+		{
+			Assert.Index(id, Core.Input.ControllersMax);
+
+			return TestBit(controllersPressed[id], (int)(code));
+		}
+
+		/// <summary>
+		/// Checks if the given controller button went up this frame.
+		/// </summary>
+		/// <param name="id">The device ID of the controller to check.</param>
+		/// <param name="code">The <see cref="ControllerButtonCode"/> representing the button to check.</param>
+		/// <returns>True if the controller button was down at the start of the frame, but isn't now.</returns>
+		public bool GetControllerButtonReleased(int id, ControllerButtonCode code)
+		{
+			Assert.Index(id, Core.Input.ControllersMax);
+
+			return TestBit(controllersReleased[id], (int)(code));
 		}
 
 		/// <summary>
@@ -45,16 +126,65 @@
 		public short GetAxisValue(int id, AxisCode axis)
 		{
 			Assert.Index(id, Core.Input.ControllersMax);
+			Assert.Index((int)(axis), (int)(AxisCode.Count));
 
-			return coreState.Controllers[id].Axes[(int)(axis)];
+			// two axes to a word, after the buttons
+			UInt32 word = stateWords[Core.Input.ControllersWord + id * Core.Input.ControllerWords + 1 + ((int)(axis) >> 1)];
+			return (short)(word >> (((int)(axis) & 1) * 16));
 		}
 
 		/// <summary>
 		/// Constructs a new, immutable snapshot of the engine's input state.
 		/// </summary>
-		public InputData()
+		public unsafe InputData()
 		{
-			Core.Input.GetSnapshot(out coreState);
+			stateWords = Core.Input.GetSnapshot();
+
+			KeyBits = new UInt64[Core.Input.KeyWords];
+			for(int w = 0; w < Core.Input.KeyWords; w++)
+			{ KeyBits[w] = stateWords[w * 2] | ((UInt64)(stateWords[w * 2 + 1]) << 32); }
+
+			MouseButtonBits = stateWords[Core.Input.MouseButtonsWord];
+
+			ControllerButtonBits = new UInt32[Core.Input.ControllersMax];
+			for(int c = 0; c < Core.Input.ControllersMax; c++)
+			{ ControllerButtonBits[c] = stateWords[Core.Input.ControllersWord + c * Core.Input.ControllerWords]; }
+
+			Core.Input.Edges* edges = Core.Input.GetFrameEdges();
+
+			keysPressed = new UInt64[Core.Input.KeyWords];
+			keysReleased = new UInt64[Core.Input.KeyWords];
+			for(int w = 0; w < Core.Input.KeyWords; w++)
+			{
+				keysPressed[w] = edges->KeysPressed[w];
+				keysReleased[w] = edges->KeysReleased[w];
+			}
+
+			mousePressed = edges->MousePressed;
+			mouseReleased = edges->MouseReleased;
+
+			controllersPressed = new UInt32[Core.Input.ControllersMax];
+			controllersReleased = new UInt32[Core.Input.ControllersMax];
+			for(int c = 0; c < Core.Input.ControllersMax; c++)
+			{
+				controllersPressed[c] = edges->ControllersPressed[c];
+				controllersReleased[c] = edges->ControllersReleased[c];
+			}
+
+			// copied out, since the core's timeline is reused next frame
+			Core.Input.Events* coreEvents = Core.Input.GetEvents();
+			InputEvent* eventList = Core.Input.GetEventList(coreEvents);
+
+			InputEvent[] events = new InputEvent[coreEvents->Count];
+			for(int i = 0; i < events.Length; i++)
+			{ events[i] = eventList[i]; }
+
+			Events = events;
+			DroppedEventCount = coreEvents->OverflowCount;
 		}
+
+		static bool TestBit(UInt64[] bits, int i) => i >= 0 && i < bits.Length * 64 && (bits[i >> 6] & (1ul << (i & 63))) != 0;
+
+		static bool TestBit(UInt32 bits, int i) => i >= 0 && i < 32 && (bits & (1u << i)) != 0;
 	};
 }
\ No newline at end of file
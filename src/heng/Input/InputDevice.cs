@@ -1,23 +1,33 @@
-﻿using System.Collections.Generic;
+﻿using System;
+using System.Collections.Generic;
 
 namespace heng.Input
 {
-	// TODO: InputDevice should be immutable, but, a dictionary reinstantiation for every reamp?
-	// consider trying System.Collections.Immutable again, i guess
-
 	/// <summary>
 	/// A "virtual device" that can be used with the <see cref="InputState"/> to interpret <see cref="InputData"/>.
 	/// <para>An <see cref="InputDevice"/> consists of string-keyed sets of virtual buttons and axes.</para>
 	/// The <see cref="IButton"/> and <see cref="IAxis"/> interfaces can be used to construct new button/axis
 	/// representations, if existing implementations like <see cref="Key"/> and <see cref="ButtonAxis"/> aren't enough.
+	/// Mappings are immutable: <see cref="WithButton(string, IButton)"/> and <see cref="WithAxis(string, IAxis)"/> return a new
+	/// <see cref="InputDevice"/>, which shares all other mappings with this one.
 	/// </summary>
 	public class InputDevice
 	{
-		readonly Dictionary<string, IButton> buttons;
-		readonly Dictionary<string, IAxis> axes;
+		// action IDs are indices into the lists, and stay the same across remaps
+		readonly PersistentDictionary<string, int> buttonIDs;
+		readonly PersistentDictionary<string, int> axisIDs;
+		readonly PersistentList<IButton> buttons;
+		readonly PersistentList<IAxis> axes;
+
+		readonly InputBindings bindings;
 
 		InputData lastData;
 		InputData newData;
+
+		bool[] lastButtons;
+		bool[] newButtons;
+		short[] lastAxes;
+		short[] newAxes;
 		
 		/// <summary>
 		/// Constructs a new <see cref="InputDevice"/>, which will read the provided state objects.
@@ -25,70 +35,206 @@ namespace heng.Input
 		/// </summary>
 		public InputDevice()
 		{
-			buttons = new Dictionary<string, IButton>();
-			axes = new Dictionary<string, IAxis>();
+			buttonIDs = PersistentDictionary<string, int>.Empty;
+			axisIDs = PersistentDictionary<string, int>.Empty;
+			buttons = PersistentList<IButton>.Empty;
+			axes = PersistentList<IAxis>.Empty;
+
+			bindings = Compile();
+		}
+
+		InputDevice(InputDevice old, PersistentDictionary<string, int> buttonIDs = null, PersistentList<IButton> buttons = null,
+			PersistentDictionary<string, int> axisIDs = null, PersistentList<IAxis> axes = null)
+		{
+			this.buttonIDs = buttonIDs ?? old.buttonIDs;
+			this.axisIDs = axisIDs ?? old.axisIDs;
+			this.buttons = buttons ?? old.buttons;
+			this.axes = axes ?? old.axes;
+
+			bindings = Compile();
+
+			if(old.newData != null)
+			{
+				lastData = old.lastData;
+				newData = old.newData;
+
+				bindings.Evaluate(lastData, lastButtons, lastAxes);
+				bindings.Evaluate(newData, newButtons, newAxes);
+			}
+		}
+
+		// bindings are compiled once per remap, rather than resolved on every read
+		InputBindings Compile()
+		{
+			InputBindings compiled = new InputBindings(new List<IButton>(buttons), new List<IAxis>(axes));
+
+			lastButtons = new bool[compiled.ButtonValueCount];
+			newButtons = new bool[compiled.ButtonValueCount];
+			lastAxes = new short[compiled.AxisValueCount];
+			newAxes = new short[compiled.AxisValueCount];
+
+			return compiled;
 		}
 
 		/// <summary>
 		/// Updates the <see cref="InputData"/> read by the <see cref="InputDevice"/>, allowing methods like
 		/// <see cref="GetButtonPressed(string)"/> to interpolate between the previous and current <see cref="InputData"/>.
+		/// <para>Every mapped button and axis is evaluated here, once.</para>
 		/// </summary>
 		/// <param name="newData"></param>
 		public void UpdateData(InputData newData)
 		{
 			Assert.Ref(newData);
 
+			if(this.newData == null)
+			{
+				bindings.Evaluate(newData, newButtons, newAxes);
+				Array.Copy(newButtons, lastButtons, newButtons.Length);
+				Array.Copy(newAxes, lastAxes, newAxes.Length);
+			}
+			else
+			{
+				bool[] buttonValues = lastButtons;
+				lastButtons = newButtons;
+				newButtons = buttonValues;
+
+				short[] axisValues = lastAxes;
+				lastAxes = newAxes;
+				newAxes = axisValues;
+
+				bindings.Evaluate(newData, newButtons, newAxes);
+			}
+
 			this.lastData = this.newData ?? newData;
 			this.newData = newData;
 		}
 
 		/// <summary>
-		/// Remaps the given string to the given virtual button.
-		/// <para>If the string is not yet mapped, a new mapping will be created.</para>
+		/// Resolves a button name to its action ID, for reading it without a string lookup.
+		/// <para>IDs stay valid on devices remapped from this one.</para>
+		/// </summary>
+		/// <param name="name">The string to which the button was mapped.</param>
+		/// <returns>The button's action ID, or -1 if no button with that name is mapped.</returns>
+		public int GetButtonID(string name)
+		{
+			if(name != null)
+			{
+				if(buttonIDs.TryGetValue(name, out int id))
+				{ return id; }
+				else
+				{ Log.Error($"couldn't find button \"{name}\" - no button with that name is mapped"); }
+			}
+			else
+			{ Log.Error("couldn't find button: name is null"); }
+
+			return -1;
+		}
+
+		/// <summary>
+		/// Resolves an axis name to its action ID, for reading it without a string lookup.
+		/// <para>IDs stay valid on devices remapped from this one.</para>
+		/// </summary>
+		/// <param name="name">The string to which the axis was mapped.</param>
+		/// <returns>The axis' action ID, or -1 if no axis with that name is mapped.</returns>
+		public int GetAxisID(string name)
+		{
+			if(name != null)
+			{
+				if(axisIDs.TryGetValue(name, out int id))
+				{ return id; }
+				else
+				{ Log.Error($"couldn't find axis \"{name}\" - no axis with that name is mapped"); }
+			}
+			else
+			{ Log.Error("couldn't find axis: name is null"); }
+
+			return -1;
+		}
+
+		/// <summary>
+		/// Creates a copy of this <see cref="InputDevice"/>, with the given string mapped to the given virtual button.
+		/// <para>If the string is not yet mapped, a new mapping will be created. This device is left as it is.</para>
 		/// </summary>
 		/// <param name="name">The string key that will be used to read this button.</param>
 		/// <param name="button">The virtual button to map.</param>
-		public void RemapButton(string name, IButton button)
+		/// <returns>A new <see cref="InputDevice"/> with the button remapped, or this device if remapping failed.</returns>
+		public InputDevice WithButton(string name, IButton button)
 		{
 			if(name != null)
 			{
 				if(button != null)
-				{ buttons[name] = button; }
+				{
+					if(buttonIDs.TryGetValue(name, out int id))
+					{ return new InputDevice(this, buttons: buttons.SetItem(id, button)); }
+
+					return new InputDevice(this, buttonIDs: buttonIDs.SetItem(name, buttons.Count), buttons: buttons.Add(button));
+				}
 				else
 				{ Log.Error("couldn't remap button: new button is null"); }
 			}
 			else
 			{ Log.Error("couldn't remap button: new button name is null"); }
+
+			return this;
 		}
 		
 		/// <summary>
-		/// Remaps the given string to the given virtual axis.
-		/// <para>If the string is not yet mapped, a new mapping will be created.</para>
+		/// Creates a copy of this <see cref="InputDevice"/>, with the given string mapped to the given virtual axis.
+		/// <para>If the string is not yet mapped, a new mapping will be created. This device is left as it is.</para>
 		/// </summary>
 		/// <param name="name">The string key that will be used to read this axis.</param>
 		/// <param name="axis">The virtual axis to map.</param>
-		public void RemapAxis(string name, IAxis axis)
+		/// <returns>A new <see cref="InputDevice"/> with the axis remapped, or this device if remapping failed.</returns>
+		public InputDevice WithAxis(string name, IAxis axis)
 		{
 			if(name != null)
 			{
 				if(axis != null)
-				{ axes[name] = axis; }
+				{
+					if(axisIDs.TryGetValue(name, out int id))
+					{ return new InputDevice(this, axes: axes.SetItem(id, axis)); }
+
+					return new InputDevice(this, axisIDs: axisIDs.SetItem(name, axes.Count), axes: axes.Add(axis));
+				}
 				else
 				{ Log.Error("couldn't remap axis: new axis is null"); }
 			}
 			else
 			{ Log.Error("couldn't remap axis: new axis name is null"); }
+
+			return this;
 		}
 
+		/// <summary>
+		/// Remapping used to change this <see cref="InputDevice"/> in place, but devices are immutable now.
+		/// </summary>
+		[Obsolete("InputDevice is immutable: use WithButton, and keep the device it returns", true)]
+		public void RemapButton(string name, IButton button)
+		{ Log.Error("couldn't remap button: InputDevice is immutable, use WithButton instead"); }
+
+		/// <summary>
+		/// Remapping used to change this <see cref="InputDevice"/> in place, but devices are immutable now.
+		/// </summary>
+		[Obsolete("InputDevice is immutable: use WithAxis, and keep the device it returns", true)]
+		public void RemapAxis(string name, IAxis axis)
+		{ Log.Error("couldn't remap axis: InputDevice is immutable, use WithAxis instead"); }
+
 		/// <summary>
 		/// Checks if the button mapped to the given string is currently down.
 		/// </summary>
 		/// <param name="name">The string to which the desired button was mapped.</param>
 		/// <returns>Whether or not the button is currently down.</returns>
-		public bool GetButtonDown(string name)
+		public bool GetButtonDown(string name) => GetButtonDown(FindButton(name));
+
+		/// <summary>
+		/// Checks if the button with the given action ID is currently down.
+		/// </summary>
+		/// <param name="id">The ID returned by <see cref="GetButtonID(string)"/>.</param>
+		/// <returns>Whether or not the button is currently down.</returns>
+		public bool GetButtonDown(int id)
 		{
-			if(TryGetButton(name, out IButton button))
-			{ return button.GetValue(newData); }
+			if(CheckButton(id))
+			{ return newButtons[id]; }
 		
 			return false;
 		}
@@ -98,12 +244,17 @@ namespace heng.Input
 		/// </summary>
 		/// <param name="name">The string to which the desired button was mapped.</param>
 		/// <returns>Whether or not the button entered down state this frame.</returns>
-		public bool GetButtonPressed(string name)
-		{
-			Assert.Ref(name);
+		public bool GetButtonPressed(string name) => GetButtonPressed(FindButton(name));
 
-			if(TryGetButton(name, out IButton button))
-			{ return (!button.GetValue(lastData) && button.GetValue(newData)); }
+		/// <summary>
+		/// Checks if the button with the given action ID entered down state on this frame.
+		/// </summary>
+		/// <param name="id">The ID returned by <see cref="GetButtonID(string)"/>.</param>
+		/// <returns>Whether or not the button entered down state this frame.</returns>
+		public bool GetButtonPressed(int id)
+		{
+			if(CheckButton(id))
+			{ return (!lastButtons[id] && newButtons[id]); }
 		
 			return false;
 		}
@@ -113,10 +264,17 @@ namespace heng.Input
 		/// </summary>
 		/// <param name="name">The string to which the desired button was mapped.</param>
 		/// <returns>Whether or not the button left down state this frame.</returns>
-		public bool GetButtonReleased(string name)
+		public bool GetButtonReleased(string name) => GetButtonReleased(FindButton(name));
+
+		/// <summary>
+		/// Checks if the button with the given action ID left down state on this frame.
+		/// </summary>
+		/// <param name="id">The ID returned by <see cref="GetButtonID(string)"/>.</param>
+		/// <returns>Whether or not the button left down state this frame.</returns>
+		public bool GetButtonReleased(int id)
 		{
-			if(TryGetButton(name, out IButton button))
-			{ return (button.GetValue(lastData) && !button.GetValue(newData)); }
+			if(CheckButton(id))
+			{ return (lastButtons[id] && !newButtons[id]); }
 		
 			return false;
 		}
@@ -126,10 +284,17 @@ namespace heng.Input
 		/// </summary>
 		/// <param name="name">The string to which the desired axis was mapped.</param>
 		/// <returns>The value of the axis.</returns>
-		public short GetAxisValue(string name)
+		public short GetAxisValue(string name) => GetAxisValue(FindAxis(name));
+
+		/// <summary>
+		/// Checks the value of the axis with the given action ID, as a 16-bit signed integer.
+		/// </summary>
+		/// <param name="id">The ID returned by <see cref="GetAxisID(string)"/>.</param>
+		/// <returns>The value of the axis.</returns>
+		public short GetAxisValue(int id)
 		{
-			if(TryGetAxis(name, out IAxis axis))
-			{ return axis.GetValue(newData); }
+			if(CheckAxis(id))
+			{ return newAxes[id]; }
 		
 			return 0;
 		}
@@ -140,10 +305,18 @@ namespace heng.Input
 		/// </summary>
 		/// <param name="name">The string to which the desired axis was mapped.</param>
 		/// <returns>The difference in value of the axis between this frame and the last.</returns>
-		public short GetAxisDelta(string name)
+		public short GetAxisDelta(string name) => GetAxisDelta(FindAxis(name));
+
+		/// <summary>
+		/// Checks the difference in value of the axis with the given action ID between this frame and the last,
+		/// as a 16-bit signed integer.
+		/// </summary>
+		/// <param name="id">The ID returned by <see cref="GetAxisID(string)"/>.</param>
+		/// <returns>The difference in value of the axis between this frame and the last.</returns>
+		public short GetAxisDelta(int id)
 		{
-			if(TryGetAxis(name, out IAxis axis))
-			{ return (short)(axis.GetValue(newData) - axis.GetValue(lastData)); }
+			if(CheckAxis(id))
+			{ return (short)(newAxes[id] - lastAxes[id]); }
 		
 			return 0;
 		}
@@ -153,11 +326,14 @@ namespace heng.Input
 		/// </summary>
 		/// <param name="name">The string to which the desired axis was mapped.</param>
 		/// <returns>The value of the axis.</returns>
-		public float GetAxisFrac(string name)
-		{
-			short val = GetAxisValue(name);
-			return GetFrac(val);
-		}
+		public float GetAxisFrac(string name) => GetFrac(GetAxisValue(name));
+
+		/// <summary>
+		/// Checks the value of the axis with the given action ID, as a 0-1 floating point fraction.
+		/// </summary>
+		/// <param name="id">The ID returned by <see cref="GetAxisID(string)"/>.</param>
+		/// <returns>The value of the axis.</returns>
+		public float GetAxisFrac(int id) => GetFrac(GetAxisValue(id));
 		
 		/// <summary>
 		/// Checks the difference in value of the given axis between this frame and the last,
@@ -165,41 +341,46 @@ namespace heng.Input
 		/// </summary>
 		/// <param name="name">The string to which the desired axis was mapped.</param>
 		/// <returns>The difference in value of the axis between this frame and the last.</returns>
-		public float GetAxisDeltaFrac(string name)
+		public float GetAxisDeltaFrac(string name) => GetFrac(GetAxisDelta(name));
+
+		/// <summary>
+		/// Checks the difference in value of the axis with the given action ID between this frame and the last,
+		/// as a 0-1 floating point fraction.
+		/// </summary>
+		/// <param name="id">The ID returned by <see cref="GetAxisID(string)"/>.</param>
+		/// <returns>The difference in value of the axis between this frame and the last.</returns>
+		public float GetAxisDeltaFrac(int id) => GetFrac(GetAxisDelta(id));
+
+		// the string API logs its own lookup errors, so a missing name isn't reported twice
+		int FindButton(string name)
 		{
-			short val = GetAxisDelta(name);
-			return GetFrac(val);
+			int id = GetButtonID(name);
+			return (id > -1) ? id : int.MinValue;
 		}
-	
-		bool TryGetButton(string name, out IButton button)
+
+		int FindAxis(string name)
 		{
-			if(name != null)
-			{
-				if(buttons.TryGetValue(name, out button))
-				{ return true; }
-				else
-				{ Log.Error($"couldn't read button \"{name}\" - no button with that name is mapped"); }
-			}
-			else
-			{ Log.Error("couldn't read button: name is null"); }
+			int id = GetAxisID(name);
+			return (id > -1) ? id : int.MinValue;
+		}
+
+		bool CheckButton(int id)
+		{
+			if(id >= 0 && id < buttons.Count)
+			{ return true; }
+			else if(id != int.MinValue)
+			{ Log.Error($"couldn't read button: ID {id} is invalid"); }
 
-			button = null;
 			return false;
 		}
-	
-		bool TryGetAxis(string name, out IAxis axis)
+
+		bool CheckAxis(int id)
 		{
-			if(name != null)
-			{
-				if(axes.TryGetValue(name, out axis))
-				{ return true; }
-				else
-				{ Log.Error($"couldn't read axis \"{name}\" - no axis with that name is mapped"); }
-			}
-			else
-			{ Log.Error("couldn't read axis: name is null"); }
+			if(id >= 0 && id < axes.Count)
+			{ return true; }
+			else if(id != int.MinValue)
+			{ Log.Error($"couldn't read axis: ID {id} is invalid"); }
 
-			axis = null;
 			return false;
 		}
 	
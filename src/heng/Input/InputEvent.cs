@@ -0,0 +1,45 @@
+﻿using System;
+using System.Runtime.InteropServices;
+
+namespace heng.Input
+{
+	/// <summary>
+	/// A single timestamped input transition, as recorded by the engine.
+	/// </summary>
+	[StructLayout(LayoutKind.Sequential)]
+	public struct InputEvent
+	{
+		/// <summary>
+		/// When the event was queued, in milliseconds since the engine started.
+		/// </summary>
+		public readonly UInt32 Timestamp;
+
+		/// <summary>
+		/// What kind of input changed; determines how <see cref="Code"/> and <see cref="Value"/> are read.
+		/// </summary>
+		public readonly InputEventType Type;
+
+		/// <summary>
+		/// The device ID of the controller; always 0 for the keyboard and mouse.
+		/// </summary>
+		public readonly Byte Device;
+
+		/// <summary>
+		/// The <see cref="KeyCode"/>, <see cref="MouseButtonCode"/>, <see cref="ControllerButtonCode"/>, or
+		/// <see cref="AxisCode"/> that changed, depending on <see cref="Type"/>.
+		/// </summary>
+		public readonly UInt16 Code;
+
+		/// <summary>
+		/// 1 if a button went down, 0 if it went up; for axes, the new position value.
+		/// </summary>
+		public readonly int Value;
+
+		/// <summary>
+		/// Whether the event is a button going down.
+		/// </summary>
+		public bool IsDown => Type != InputEventType.Axis && Value != 0;
+
+		public override string ToString() => $"{Type} {Code} = {Value} (device {Device}, {Timestamp}ms)";
+	};
+}
\ No newline at end of file
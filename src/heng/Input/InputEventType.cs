@@ -0,0 +1,13 @@
+﻿namespace heng.Input
+{
+	/// <summary>
+	/// The kinds of physical input transitions recorded in <see cref="InputData.Events"/>.
+	/// </summary>
+	public enum InputEventType : byte
+	{
+		Key,
+		MouseButton,
+		ControllerButton,
+		Axis
+	};
+}
\ No newline at end of file
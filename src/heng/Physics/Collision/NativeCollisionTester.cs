@@ -0,0 +1,158 @@
+﻿using System;
+using System.Collections.Generic;
+
+namespace heng.Physics
+{
+	/// <summary>
+	/// Flattens bodies into arrays and runs their collision tests in the core.
+	/// <para>Every buffer is kept and reused between calls, so a step that's no bigger than those before it doesn't allocate.
+	/// The returned collisions are reused too - they're only valid until the next call.</para>
+	/// </summary>
+	internal class NativeCollisionTester
+	{
+		const int minCapacity = 16;
+
+		// bodies are counting-sorted into contiguous group runs, in the order each sector first appears
+		readonly Dictionary<long, int> groupIndices = new Dictionary<long, int>();
+		int[] groupStarts = new int[minCapacity];
+		int[] bodyGroups = new int[minCapacity];
+
+		IPhysicsBody[] bodies = new IPhysicsBody[minCapacity];
+		Vector2[] points = new Vector2[minCapacity];
+		Core.Physics.Collision.Collider[] colliders = new Core.Physics.Collision.Collider[minCapacity];
+		Core.Physics.Collision.Contact[] contacts = new Core.Physics.Collision.Contact[minCapacity];
+
+		readonly Dictionary<IPhysicsBody, IReadOnlyList<CollisionData>> collisions = new Dictionary<IPhysicsBody, IReadOnlyList<CollisionData>>();
+		readonly List<List<CollisionData>> collisionLists = new List<List<CollisionData>>();
+		int collisionListsUsed;
+
+		public IReadOnlyDictionary<IPhysicsBody, IReadOnlyList<CollisionData>> GetCollisions(IReadOnlyList<IPhysicsBody> objects)
+		{
+			Assert.Ref(objects);
+
+			Reserve(ref bodyGroups, objects.Count);
+			groupIndices.Clear();
+
+			int bodyCount = 0;
+			int pointCount = 0;
+
+			for(int i = 0; i < objects.Count; i++)
+			{
+				ICollider collider = objects[i].Collider;
+				bodyGroups[i] = -1;
+
+				if(collider == null)
+				{ continue; }
+
+				// custom colliders can't be flattened - let the reference implementation handle them
+				if(!(collider is ConvexCollider convex))
+				{ return new CollisionTester().GetCollisions(objects); }
+
+				WorldPoint position = objects[i].Position;
+				long key = ((long)(position.X.Sector) << 32) | (uint)(position.Y.Sector);
+
+				if(!groupIndices.TryGetValue(key, out int group))
+				{
+					group = groupIndices.Count;
+					groupIndices.Add(key, group);
+
+					Reserve(ref groupStarts, group + 1);
+					groupStarts[group] = 0;
+				}
+
+				bodyGroups[i] = group;
+				groupStarts[group]++;
+
+				bodyCount++;
+				pointCount += convex.Shape.Points.Count;
+			}
+
+			// group sizes become the index each group's run starts at
+			int start = 0;
+			for(int g = 0; g < groupIndices.Count; g++)
+			{
+				int size = groupStarts[g];
+				groupStarts[g] = start;
+				start += size;
+			}
+
+			Reserve(ref bodies, bodyCount);
+			Reserve(ref colliders, bodyCount);
+			Reserve(ref points, pointCount);
+
+			// each group is positioned relative to its sector's origin; points are only referenced by offset, so they stay in list order
+			int point = 0;
+			for(int i = 0; i < objects.Count; i++)
+			{
+				int group = bodyGroups[i];
+				if(group < 0)
+				{ continue; }
+
+				IPhysicsBody body = objects[i];
+				IReadOnlyList<Vector2> shape = ((ConvexCollider)(body.Collider)).Shape.Points;
+
+				// the same as the distance from the sector's origin, without constructing (and clamping) the origin
+				WorldPoint worldPosition = body.Position;
+				Vector2 position = new Vector2(worldPosition.X.Subposition * WorldCoordinate.PixelsPerSector,
+					worldPosition.Y.Subposition * WorldCoordinate.PixelsPerSector);
+
+				int slot = groupStarts[group]++;
+				bodies[slot] = body;
+				colliders[slot] = new Core.Physics.Collision.Collider(position, body.Velocity, group, point, shape.Count);
+
+				for(int p = 0; p < shape.Count; p++)
+				{ points[point++] = shape[p]; }
+			}
+
+			Reserve(ref contacts, bodyCount * 2);
+
+			int found = Core.Physics.Collision.TestColliders(points, colliders, bodyCount, contacts, contacts.Length);
+			if(found > contacts.Length)
+			{
+				// not enough room for every contact - try again with enough
+				Reserve(ref contacts, found);
+				found = Core.Physics.Collision.TestColliders(points, colliders, bodyCount, contacts, contacts.Length);
+			}
+
+			collisions.Clear();
+			collisionListsUsed = 0;
+
+			for(int i = 0; i < found; i++)
+			{
+				IPhysicsBody a = bodies[contacts[i].A];
+				IPhysicsBody b = bodies[contacts[i].B];
+
+				AddCollision(a, new CollisionData(b, contacts[i].MTV));
+				AddCollision(b, new CollisionData(a, -contacts[i].MTV));
+			}
+
+			// don't keep the last step's bodies alive through the buffer
+			Array.Clear(bodies, 0, bodyCount);
+
+			return collisions;
+		}
+
+		void AddCollision(IPhysicsBody body, CollisionData collision)
+		{
+			if(!collisions.TryGetValue(body, out IReadOnlyList<CollisionData> bodyCollisions))
+			{
+				if(collisionListsUsed == collisionLists.Count)
+				{ collisionLists.Add(new List<CollisionData>()); }
+
+				List<CollisionData> list = collisionLists[collisionListsUsed++];
+				list.Clear();
+
+				bodyCollisions = list;
+				collisions[body] = bodyCollisions;
+			}
+
+			((List<CollisionData>)(bodyCollisions)).Add(collision);
+		}
+
+		static void Reserve<T>(ref T[] buffer, int count)
+		{
+			if(buffer.Length < count)
+			{ Array.Resize(ref buffer, Math.Max(count, buffer.Length * 2)); }
+		}
+	};
+}
\ No newline at end of file
@@ -11,6 +11,13 @@ namespace heng.Physics
 	/// </summary>
 	public interface IPhysicsBody
 	{
+		/// <summary>
+		/// The stable ID by which the <see cref="IPhysicsBody"/> is matched up between <see cref="PhysicsState"/>s.
+		/// <para>New bodies should take one from <see cref="EntityIDs.Next"/>; bodies returned by
+		/// <see cref="ImpulsePass(Vector2, float)"/> and <see cref="CollisionPass(IEnumerable{CollisionData})"/> keep theirs.</para>
+		/// </summary>
+		int ID { get; }
+
 		/// <summary>
 		/// The world-space position of the <see cref="IPhysicsBody"/>.
 		/// </summary>
@@ -0,0 +1,21 @@
+﻿namespace heng.Physics
+{
+	/// <summary>
+	/// Selects which implementation the <see cref="PhysicsState"/> uses to simulate each step.
+	/// </summary>
+	public enum PhysicsKernel
+	{
+		/// <summary>
+		/// Collision tests and integration are run in managed code.
+		/// <para>This is the reference implementation, and supports any <see cref="ICollider"/> or <see cref="IPhysicsBody"/>.</para>
+		/// </summary>
+		Managed,
+
+		/// <summary>
+		/// Collision tests and integration are batched into flat arrays, and run by the core in one call each per step.
+		/// <para>Only <see cref="ConvexCollider"/>s and <see cref="RigidBody"/> integration are handled natively;
+		/// steps containing other collider types fall back to the managed implementation.</para>
+		/// </summary>
+		Native
+	};
+}
\ No newline at end of file
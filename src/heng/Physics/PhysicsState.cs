@@ -9,6 +9,26 @@ namespace heng.Physics
 	/// </summary>
 	public class PhysicsState
 	{
+		// bodies are rebuilt by every step, so they're compared by what the simulation sees of them
+		sealed class StateComparer : IEqualityComparer<IPhysicsBody>
+		{
+			public static readonly StateComparer Instance = new StateComparer();
+
+			public bool Equals(IPhysicsBody a, IPhysicsBody b)
+			{
+				if(ReferenceEquals(a, b))
+				{ return true; }
+
+				if(a == null || b == null)
+				{ return false; }
+
+				return a.Position == b.Position && a.Velocity == b.Velocity && a.Mass == b.Mass &&
+					a.Material == b.Material && a.Collider == b.Collider;
+			}
+
+			public int GetHashCode(IPhysicsBody body) => body?.ID ?? 0;
+		};
+
 		/// <summary>
 		/// All <see cref="IPhysicsBody"/> instances being simulated.
 		/// </summary>
@@ -19,6 +39,15 @@ namespace heng.Physics
 		/// </summary>
 		public readonly Vector2 Gravity;
 
+		/// <summary>
+		/// The implementation used to simulate this state.
+		/// </summary>
+		public readonly PhysicsKernel Kernel;
+
+		// reused from step to step, so the native kernel's buffers are only allocated as the simulation grows
+		[System.ThreadStatic]
+		static NativeCollisionTester nativeTester;
+
 		/// <summary>
 		/// Constructs a new snapshot of the physics system's state.
 		/// </summary>
@@ -26,17 +55,42 @@ namespace heng.Physics
 		/// <param name="gravity">The total force of gravity applied to the simulation.</param>
 		/// <param name="deltaT">Seconds since the previous <see cref="PhysicsState"/> was constructed.</param>
 		public PhysicsState(IEnumerable<IPhysicsBody> physicsBodies, Vector2 gravity, float deltaT)
+			: this(physicsBodies, gravity, deltaT, PhysicsKernel.Managed) { }
+
+		/// <summary>
+		/// Constructs a new snapshot of the physics system's state, simulated by the given <see cref="PhysicsKernel"/>.
+		/// </summary>
+		/// <param name="physicsBodies">All <see cref="IPhysicsBody"/> instances to be simulated.</param>
+		/// <param name="gravity">The total force of gravity applied to the simulation.</param>
+		/// <param name="deltaT">Seconds since the previous <see cref="PhysicsState"/> was constructed.</param>
+		/// <param name="kernel">The implementation used to simulate the new state.</param>
+		public PhysicsState(IEnumerable<IPhysicsBody> physicsBodies, Vector2 gravity, float deltaT, PhysicsKernel kernel)
 		{
 			Gravity = gravity;
+			Kernel = kernel;
 			PhysicsBodies = AddBodies(physicsBodies, deltaT);
 		}
 
+		/// <summary>
+		/// Computes which <see cref="IPhysicsBody"/> instances changed since a previous <see cref="PhysicsState"/>.
+		/// <para>Bodies are identified by their <see cref="IPhysicsBody.ID"/>, and only count as changed when they moved,
+		/// or their velocity, mass, material or collider changed -- not just because a step rebuilt them.</para>
+		/// </summary>
+		/// <param name="previous">The preceding <see cref="PhysicsState"/>. If null, every body is reported as added.</param>
+		/// <returns>The delta between the two states' bodies.</returns>
+		public StateDelta<IPhysicsBody> GetDelta(PhysicsState previous)
+		{
+			return new StateDelta<IPhysicsBody>(previous?.PhysicsBodies, PhysicsBodies, body => body.ID, StateComparer.Instance);
+		}
+
+		// unlike other states, bodies are kept in a plain list rather than a PersistentList: every step replaces
+		// every RigidBody, so there's no structure left to share with the previous step, only path copies to pay for
 		IReadOnlyList<IPhysicsBody> AddBodies(IEnumerable<IPhysicsBody> bodies, float deltaT)
 		{
 			if(bodies != null)
 			{
-				IReadOnlyList<IPhysicsBody> newBodies = ImpulsePass(bodies, deltaT);
-				newBodies = CollisionPass(newBodies);
+				List<IPhysicsBody> newBodies = ImpulsePass(bodies, deltaT);
+				CollisionPass(newBodies);
 
 				return newBodies;
 			}
@@ -44,8 +98,11 @@ namespace heng.Physics
 			return new IPhysicsBody[0];
 		}
 
-		IReadOnlyList<IPhysicsBody> ImpulsePass(IEnumerable<IPhysicsBody> bodies, float deltaT)
+		List<IPhysicsBody> ImpulsePass(IEnumerable<IPhysicsBody> bodies, float deltaT)
 		{
+			if(Kernel == PhysicsKernel.Native)
+			{ return NativeImpulsePass(bodies, deltaT); }
+
 			List<IPhysicsBody> newBodies = new List<IPhysicsBody>();
 
 			foreach(IPhysicsBody body in bodies)
@@ -57,23 +114,60 @@ namespace heng.Physics
 			return newBodies;
 		}
 
-		IReadOnlyList<IPhysicsBody> CollisionPass(IReadOnlyList<IPhysicsBody> bodies)
+		List<IPhysicsBody> NativeImpulsePass(IEnumerable<IPhysicsBody> bodies, float deltaT)
 		{
-			List<IPhysicsBody> newBodies = new List<IPhysicsBody>();
-
-			CollisionTester tester = new CollisionTester();
-			var collisions = tester.GetCollisions(bodies);
+			List<IPhysicsBody> oldBodies = new List<IPhysicsBody>();
+			List<Core.Physics.Integration.Body> rigidBodies = new List<Core.Physics.Integration.Body>();
 
 			foreach(IPhysicsBody body in bodies)
 			{
-				IPhysicsBody newBody = body;
-				if(collisions.TryGetValue(body, out IReadOnlyList<CollisionData> bodyCollisions))
-				{ newBody = body.CollisionPass(bodyCollisions); }
+				if(body != null)
+				{
+					oldBodies.Add(body);
 
-				newBodies.Add(newBody);
+					if(body is RigidBody rb)
+					{ rigidBodies.Add(rb.GetIntegrationBody()); }
+				}
+			}
+
+			// every RigidBody is integrated in a single call; other body types run their own impulse pass
+			Core.Physics.Integration.Body[] integrated = rigidBodies.ToArray();
+			Core.Physics.Integration.IntegrateBodies(integrated, integrated.Length, Gravity, deltaT);
+
+			List<IPhysicsBody> newBodies = new List<IPhysicsBody>(oldBodies.Count);
+
+			int r = 0;
+			foreach(IPhysicsBody body in oldBodies)
+			{
+				if(body is RigidBody rb)
+				{ newBodies.Add(rb.ApplyIntegration(integrated[r++])); }
+				else
+				{ newBodies.Add(body.ImpulsePass(Gravity, deltaT)); }
 			}
 
 			return newBodies;
 		}
+
+		// the list isn't part of any state yet, so colliding bodies are replaced in place
+		void CollisionPass(List<IPhysicsBody> bodies)
+		{
+			IReadOnlyDictionary<IPhysicsBody, IReadOnlyList<CollisionData>> collisions;
+			if(Kernel == PhysicsKernel.Native)
+			{
+				if(nativeTester == null)
+				{ nativeTester = new NativeCollisionTester(); }
+
+				collisions = nativeTester.GetCollisions(bodies);
+			}
+			else
+			{ collisions = new CollisionTester().GetCollisions(bodies); }
+
+			for(int i = 0; i < bodies.Count; i++)
+			{
+				IPhysicsBody body = bodies[i];
+				if(collisions.TryGetValue(body, out IReadOnlyList<CollisionData> bodyCollisions))
+				{ bodies[i] = body.CollisionPass(bodyCollisions); }
+			}
+		}
 	};
 }
\ No newline at end of file
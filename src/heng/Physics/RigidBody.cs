@@ -11,6 +11,11 @@ namespace heng.Physics
 	/// </summary>
 	public class RigidBody : IPhysicsBody
 	{
+		/// <summary>
+		/// The <see cref="RigidBody"/>'s ID, which is carried over by every <see cref="RigidBody"/> derived from it.
+		/// </summary>
+		public readonly int ID;
+
 		/// <summary>
 		/// The world-space position of the <see cref="RigidBody"/>.
 		/// </summary>
@@ -46,6 +51,7 @@ namespace heng.Physics
 		/// </summary>
 		public readonly Vector2 Forces;
 
+		int IPhysicsBody.ID => ID;
 		WorldPoint IPhysicsBody.Position => Position;
 		ICollider IPhysicsBody.Collider => Collider;
 		float IPhysicsBody.Mass => Mass;
@@ -71,6 +77,7 @@ namespace heng.Physics
 				mass = float.Epsilon;
 			}
 
+			ID = old?.ID ?? EntityIDs.Next();
 			Position = position ?? old?.Position ?? WorldPoint.Zero;
 			Collider = collider ?? old?.Collider;
 
@@ -120,6 +127,20 @@ namespace heng.Physics
 			return new RigidBody(this, position: newPosition, velocity: newVelocity, forces: Vector2.Zero);
 		}
 
+		internal Core.Physics.Integration.Body GetIntegrationBody()
+		{
+			WorldPoint secOrigin = new WorldPoint(Position.Sector, Vector2.Zero);
+			return new Core.Physics.Integration.Body(Position.PixelDistance(secOrigin), Velocity, Forces, Mass);
+		}
+
+		internal RigidBody ApplyIntegration(Core.Physics.Integration.Body integrated)
+		{
+			WorldPoint secOrigin = new WorldPoint(Position.Sector, Vector2.Zero);
+			WorldPoint newPosition = secOrigin.PixelTranslate(integrated.Position);
+
+			return new RigidBody(this, position: newPosition, velocity: integrated.Velocity, forces: Vector2.Zero);
+		}
+
 		IPhysicsBody IPhysicsBody.CollisionPass(IEnumerable<CollisionData> collisions)
 		{
 			WorldPoint newPosition = Position;
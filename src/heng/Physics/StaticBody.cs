@@ -10,6 +10,11 @@ namespace heng.Physics
 	/// </summary>
 	public class StaticBody : IPhysicsBody
 	{
+		/// <summary>
+		/// The <see cref="StaticBody"/>'s ID.
+		/// </summary>
+		public readonly int ID;
+
 		/// <summary>
 		/// The world-space position of the <see cref="StaticBody"/>.
 		/// </summary>
@@ -26,6 +31,7 @@ namespace heng.Physics
 		/// </summary>
 		public readonly PhysicsMaterial Material;
 
+		int IPhysicsBody.ID => ID;
 		WorldPoint IPhysicsBody.Position => Position;
 		ICollider IPhysicsBody.Collider => Collider;
 		float IPhysicsBody.Mass => float.PositiveInfinity;
@@ -43,6 +49,7 @@ namespace heng.Physics
 			if(collider == null)
 			{ Log.Warning("constructed a StaticBody with no collider"); }
 
+			ID = EntityIDs.Next();
 			Position = position;
 			Collider = collider;
 
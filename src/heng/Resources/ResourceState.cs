@@ -0,0 +1,242 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Linq;
+using heng.Audio;
+using heng.Video;
+
+namespace heng.Resources
+{
+	/// <summary>
+	/// Represents an immutable snapshot of which streamed assets are loaded around a world-space focus.
+	/// <para>Each frame, build a new <see cref="ResourceState"/> from the previous one: assets used by sectors
+	/// within <see cref="StreamingConfig.PrefetchRadius"/> of the focus are requested from the background loader,
+	/// and assets already loaded are carried over.</para>
+	/// When the resident bytes go over budget, loaded assets no longer in range are evicted -- farthest first,
+	/// then least recently used. Evicted <see cref="Texture"/>s and <see cref="Sound"/>s are disposed, so only use
+	/// handles from the newest state, and call <see cref="Unload"/> on it when streaming is no longer needed.
+	/// </summary>
+	public class ResourceState
+	{
+		readonly PersistentDictionary<string, Texture> textures;
+		readonly PersistentDictionary<string, Sound> sounds;
+		readonly PersistentDictionary<string, long> lastUsed;
+		readonly long generation;
+
+		readonly StreamingManifest manifest;
+
+		/// <summary>
+		/// The world-space position assets are streamed around.
+		/// </summary>
+		public readonly WorldPoint Focus;
+
+		/// <summary>
+		/// The streaming settings this state was built with.
+		/// </summary>
+		public readonly StreamingConfig Config;
+
+		/// <summary>
+		/// How many streamed textures are held by this state, loaded or not.
+		/// </summary>
+		public int TextureCount => textures.Count;
+
+		/// <summary>
+		/// How many streamed sounds are held by this state, loaded or not.
+		/// </summary>
+		public int SoundCount => sounds.Count;
+
+		/// <summary>
+		/// Bytes of texture pixels resident in core, streamed or not, once this state was built.
+		/// </summary>
+		public readonly UInt64 TextureResidentBytes;
+
+		/// <summary>
+		/// Textures still waiting on the background loader, once this state was built.
+		/// </summary>
+		public readonly int TexturePendingCount;
+
+		/// <summary>
+		/// Bytes of sound samples resident in core, streamed or not, once this state was built.
+		/// </summary>
+		public readonly UInt64 SoundResidentBytes;
+
+		/// <summary>
+		/// Sounds still waiting on the background loader, once this state was built.
+		/// </summary>
+		public readonly int SoundPendingCount;
+
+		/// <summary>
+		/// Constructs a new <see cref="ResourceState"/>, streaming assets in and out around the given focus.
+		/// </summary>
+		/// <param name="previous">The preceding <see cref="ResourceState"/>, whose loaded assets are carried over. May be null.</param>
+		/// <param name="manifest">The map of sectors to the assets they use.</param>
+		/// <param name="focus">The world-space position to stream around; usually the camera's center.</param>
+		/// <param name="config">The prefetch radius and budgets to stream with.</param>
+		public ResourceState(ResourceState previous, StreamingManifest manifest, WorldPoint focus, StreamingConfig config)
+		{
+			if(manifest == null)
+			{
+				Log.Warning("ResourceState constructed with null manifest");
+				manifest = StreamingManifest.Empty;
+			}
+
+			if(config == null)
+			{
+				Log.Warning("ResourceState constructed with null StreamingConfig");
+				config = new StreamingConfig(0, UInt64.MaxValue, UInt64.MaxValue);
+			}
+
+			this.manifest = manifest;
+			Focus = focus;
+			Config = config;
+
+			generation = (previous?.generation ?? 0) + 1;
+			textures = previous?.textures ?? PersistentDictionary<string, Texture>.Empty;
+			sounds = previous?.sounds ?? PersistentDictionary<string, Sound>.Empty;
+			lastUsed = previous?.lastUsed ?? PersistentDictionary<string, long>.Empty;
+
+			// core only reports budgets; enforcing them is up to whoever knows what's in range
+			Core.Video.Textures.SetBudget(config.TextureBudget);
+			Core.Audio.Sounds.SetBudget(config.SoundBudget);
+
+			HashSet<string> wantedTextures = new HashSet<string>();
+			HashSet<string> wantedSounds = new HashSet<string>();
+			GatherWanted(wantedTextures, wantedSounds);
+
+			foreach(string path in wantedTextures)
+			{
+				if(!textures.ContainsKey(path))
+				{ textures = textures.SetItem(path, new Texture(path, true)); }
+
+				lastUsed = lastUsed.SetItem(TextureKey(path), generation);
+			}
+
+			foreach(string path in wantedSounds)
+			{
+				if(!sounds.ContainsKey(path))
+				{ sounds = sounds.SetItem(path, new Sound(path, true)); }
+
+				lastUsed = lastUsed.SetItem(SoundKey(path), generation);
+			}
+
+			unsafe
+			{
+				textures = Evict(textures, wantedTextures, Core.Video.Textures.GetSnapshot()->ResidentBytes, config.TextureBudget, TextureKey,
+					manifest.GetTextureDistance, t => t.ResidentBytes, t => { if(!t.IsDisposed) { t.Dispose(); } }, "texture");
+
+				sounds = Evict(sounds, wantedSounds, Core.Audio.Sounds.GetSnapshot()->ResidentBytes, config.SoundBudget, SoundKey,
+					manifest.GetSoundDistance, s => s.ResidentBytes, s => { if(!s.IsDisposed) { s.Dispose(); } }, "sound");
+
+				// refreshed again, to count what eviction freed
+				Core.Video.Textures.State* videoState = Core.Video.Textures.GetSnapshot();
+				Core.Audio.Sounds.State* audioState = Core.Audio.Sounds.GetSnapshot();
+
+				TextureResidentBytes = videoState->ResidentBytes;
+				TexturePendingCount = videoState->PendingCount;
+				SoundResidentBytes = audioState->ResidentBytes;
+				SoundPendingCount = audioState->PendingCount;
+			}
+		}
+
+		/// <summary>
+		/// Gets the streamed <see cref="Texture"/> for the given file.
+		/// <para>The texture may still be loading; it won't be drawn until it's ready.</para>
+		/// </summary>
+		/// <param name="filePath">The texture file, as listed in the manifest.</param>
+		/// <returns>The texture, or null if it isn't held by this state.</returns>
+		public Texture GetTexture(string filePath)
+		{
+			if(filePath != null && textures.TryGetValue(filePath, out Texture t))
+			{ return t; }
+
+			return null;
+		}
+
+		/// <summary>
+		/// Gets the streamed <see cref="Sound"/> for the given file.
+		/// <para>The sound may still be loading; it stays silent until it's ready.</para>
+		/// </summary>
+		/// <param name="filePath">The sound file, as listed in the manifest.</param>
+		/// <returns>The sound, or null if it isn't held by this state.</returns>
+		public Sound GetSound(string filePath)
+		{
+			if(filePath != null && sounds.TryGetValue(filePath, out Sound s))
+			{ return s; }
+
+			return null;
+		}
+
+		/// <summary>
+		/// Disposes of every streamed asset held by this state.
+		/// <para>Only call this on the newest state; older states share its handles.</para>
+		/// </summary>
+		public void Unload()
+		{
+			foreach(Texture t in textures.Values)
+			{
+				if(!t.IsDisposed)
+				{ t.Dispose(); }
+			}
+
+			foreach(Sound s in sounds.Values)
+			{
+				if(!s.IsDisposed)
+				{ s.Dispose(); }
+			}
+		}
+
+		void GatherWanted(HashSet<string> wantedTextures, HashSet<string> wantedSounds)
+		{
+			int r = Config.PrefetchRadius;
+			for(int y = Focus.Y.Sector - r; y <= Focus.Y.Sector + r; y++)
+			{
+				for(int x = Focus.X.Sector - r; x <= Focus.X.Sector + r; x++)
+				{
+					SectorAssets s = manifest.GetSector(x, y);
+					if(s != null)
+					{
+						wantedTextures.UnionWith(s.TexturePaths);
+						wantedSounds.UnionWith(s.SoundPaths);
+					}
+				}
+			}
+		}
+
+		// textures and sounds share the last-used map, so their keys are kept apart
+		static string TextureKey(string path) => "t:" + path;
+		static string SoundKey(string path) => "s:" + path;
+
+		PersistentDictionary<string, T> Evict<T>(PersistentDictionary<string, T> held, HashSet<string> wanted, UInt64 residentBytes, UInt64 budget,
+			Func<string, string> key, Func<string, int, int, int> distance, Func<T, UInt64> size, Action<T> dispose, string kind)
+		{
+			if(residentBytes <= budget)
+			{ return held; }
+
+			int fx = Focus.X.Sector;
+			int fy = Focus.Y.Sector;
+
+			// farthest from the focus first; among equally-far assets, least recently used first
+			var candidates = held
+				.Where(h => !wanted.Contains(h.Key))
+				.OrderByDescending(h => distance(h.Key, fx, fy))
+				.ThenBy(h => lastUsed.TryGetValue(key(h.Key), out long used) ? used : 0)
+				.ToList();
+
+			foreach(var c in candidates)
+			{
+				if(residentBytes <= budget)
+				{ break; }
+
+				// a resource still held elsewhere stays resident; this is an estimate until the next snapshot
+				residentBytes -= Math.Min(residentBytes, size(c.Value));
+
+				dispose(c.Value);
+				held = held.Remove(c.Key);
+			}
+
+			if(residentBytes > budget)
+			{ Log.Warning($"streamed {kind}s are over budget ({residentBytes} of {budget} bytes) with only in-range {kind}s left loaded"); }
+
+			return held;
+		}
+	};
+}
\ No newline at end of file
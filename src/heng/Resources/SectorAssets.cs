@@ -0,0 +1,47 @@
+﻿using System.Collections.Generic;
+using System.Linq;
+
+namespace heng.Resources
+{
+	/// <summary>
+	/// The set of assets a single world sector needs loaded.
+	/// <para>Sectors are the same integer sectors <see cref="WorldCoordinate"/>s are built from.</para>
+	/// </summary>
+	public class SectorAssets
+	{
+		/// <summary>
+		/// The sector's X position.
+		/// </summary>
+		public readonly int SectorX;
+
+		/// <summary>
+		/// The sector's Y position.
+		/// </summary>
+		public readonly int SectorY;
+
+		/// <summary>
+		/// The texture files the sector uses.
+		/// </summary>
+		public readonly IReadOnlyList<string> TexturePaths;
+
+		/// <summary>
+		/// The sound files the sector uses.
+		/// </summary>
+		public readonly IReadOnlyList<string> SoundPaths;
+
+		/// <summary>
+		/// Constructs a new <see cref="SectorAssets"/> for the sector at the given position.
+		/// </summary>
+		/// <param name="sectorX">The sector's X position.</param>
+		/// <param name="sectorY">The sector's Y position.</param>
+		/// <param name="texturePaths">The texture files the sector uses. May be null.</param>
+		/// <param name="soundPaths">The sound files the sector uses. May be null.</param>
+		public SectorAssets(int sectorX, int sectorY, IEnumerable<string> texturePaths, IEnumerable<string> soundPaths)
+		{
+			SectorX = sectorX;
+			SectorY = sectorY;
+			TexturePaths = (texturePaths ?? new string[0]).Where(p => p != null).Distinct().ToArray();
+			SoundPaths = (soundPaths ?? new string[0]).Where(p => p != null).Distinct().ToArray();
+		}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,45 @@
+﻿using System;
+
+namespace heng.Resources
+{
+	/// <summary>
+	/// Settings for how a <see cref="ResourceState"/> streams assets in and out around its focus.
+	/// </summary>
+	public class StreamingConfig
+	{
+		/// <summary>
+		/// How many sectors away from the focus sector assets are kept loaded, in every direction.
+		/// <para>A radius of 0 only loads the focus sector's assets; 1 loads the surrounding 3x3 sectors, and so on.</para>
+		/// </summary>
+		public readonly int PrefetchRadius;
+
+		/// <summary>
+		/// How many bytes of texture pixels may stay resident before out-of-range textures are evicted.
+		/// </summary>
+		public readonly UInt64 TextureBudget;
+
+		/// <summary>
+		/// How many bytes of sound samples may stay resident before out-of-range sounds are evicted.
+		/// </summary>
+		public readonly UInt64 SoundBudget;
+
+		/// <summary>
+		/// Constructs a new <see cref="StreamingConfig"/>.
+		/// </summary>
+		/// <param name="prefetchRadius">How many sectors around the focus sector to keep loaded.</param>
+		/// <param name="textureBudget">The resident texture budget, in bytes.</param>
+		/// <param name="soundBudget">The resident sound budget, in bytes.</param>
+		public StreamingConfig(int prefetchRadius, UInt64 textureBudget, UInt64 soundBudget)
+		{
+			if(prefetchRadius < 0)
+			{
+				Log.Warning($"StreamingConfig constructed with negative prefetch radius {prefetchRadius}; using 0");
+				prefetchRadius = 0;
+			}
+
+			PrefetchRadius = prefetchRadius;
+			TextureBudget = textureBudget;
+			SoundBudget = soundBudget;
+		}
+	};
+}
\ No newline at end of file
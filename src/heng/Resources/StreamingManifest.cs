@@ -0,0 +1,102 @@
+﻿using System;
+using System.Collections.Generic;
+
+namespace heng.Resources
+{
+	/// <summary>
+	/// An immutable map of world sectors to the assets they use.
+	/// <para>A <see cref="ResourceState"/> uses the manifest to decide which assets to load around
+	/// its focus, and which loaded assets are farthest away when something has to be evicted.</para>
+	/// </summary>
+	public class StreamingManifest
+	{
+		readonly Dictionary<long, SectorAssets> sectors = new Dictionary<long, SectorAssets>();
+
+		// every sector each asset is used in, to find how far a loaded asset is from the focus
+		readonly Dictionary<string, List<long>> textureSectors = new Dictionary<string, List<long>>();
+		readonly Dictionary<string, List<long>> soundSectors = new Dictionary<string, List<long>>();
+
+		/// <summary>
+		/// A manifest with no sectors.
+		/// </summary>
+		public static readonly StreamingManifest Empty = new StreamingManifest(null);
+
+		/// <summary>
+		/// How many sectors have assets in this manifest.
+		/// </summary>
+		public int SectorCount => sectors.Count;
+
+		/// <summary>
+		/// Constructs a new <see cref="StreamingManifest"/> from the given sectors.
+		/// <para>If a sector appears more than once, its last entry is used.</para>
+		/// </summary>
+		/// <param name="sectors">The sectors, and the assets each one uses.</param>
+		public StreamingManifest(IEnumerable<SectorAssets> sectors)
+		{
+			if(sectors != null)
+			{
+				foreach(SectorAssets s in sectors)
+				{
+					if(s != null)
+					{ this.sectors[MakeKey(s.SectorX, s.SectorY)] = s; }
+					else
+					{ Log.Warning("ignored null SectorAssets in StreamingManifest"); }
+				}
+			}
+
+			foreach(KeyValuePair<long, SectorAssets> s in this.sectors)
+			{
+				AddIndex(textureSectors, s.Value.TexturePaths, s.Key);
+				AddIndex(soundSectors, s.Value.SoundPaths, s.Key);
+			}
+		}
+
+		/// <summary>
+		/// Gets the assets used by the sector at the given position.
+		/// </summary>
+		/// <param name="sectorX">The sector's X position.</param>
+		/// <param name="sectorY">The sector's Y position.</param>
+		/// <returns>The sector's assets, or null if the manifest doesn't have the sector.</returns>
+		public SectorAssets GetSector(int sectorX, int sectorY)
+		{
+			sectors.TryGetValue(MakeKey(sectorX, sectorY), out SectorAssets s);
+			return s;
+		}
+
+		internal int GetTextureDistance(string path, int sectorX, int sectorY) => GetDistance(textureSectors, path, sectorX, sectorY);
+		internal int GetSoundDistance(string path, int sectorX, int sectorY) => GetDistance(soundSectors, path, sectorX, sectorY);
+
+		static long MakeKey(int x, int y) => ((long)(x) << 32) | (uint)(y);
+
+		static void AddIndex(Dictionary<string, List<long>> index, IEnumerable<string> paths, long key)
+		{
+			foreach(string p in paths)
+			{
+				if(!index.TryGetValue(p, out List<long> keys))
+				{
+					keys = new List<long>();
+					index.Add(p, keys);
+				}
+
+				keys.Add(key);
+			}
+		}
+
+		// chebyshev distance, in sectors, to the nearest sector using the asset
+		static int GetDistance(Dictionary<string, List<long>> index, string path, int sectorX, int sectorY)
+		{
+			int distance = int.MaxValue;
+			if(index.TryGetValue(path, out List<long> keys))
+			{
+				foreach(long k in keys)
+				{
+					long dx = Math.Abs((long)(int)(k >> 32) - sectorX);
+					long dy = Math.Abs((long)(int)(k) - sectorY);
+					distance = (int)(Math.Min(distance, Math.Max(dx, dy)));
+				}
+			}
+
+			return distance;
+		}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,28 @@
+﻿namespace heng.Time
+{
+	/// <summary>
+	/// The times tracked by <see cref="FrameStats"/>.
+	/// </summary>
+	public enum FrameStatType
+	{
+		/// <summary>
+		/// Whole frames, from one <see cref="TimeState.Update(System.UInt32)"/> to the next.
+		/// </summary>
+		Frame,
+
+		/// <summary>
+		/// Event pumping, each frame.
+		/// </summary>
+		Events,
+
+		/// <summary>
+		/// Render queue pumping, over every window, each frame.
+		/// </summary>
+		Video,
+
+		/// <summary>
+		/// Audio mixing and queueing, each frame.
+		/// </summary>
+		Audio
+	};
+}
\ No newline at end of file
@@ -0,0 +1,101 @@
+﻿using System;
+
+namespace heng.Time
+{
+	/// <summary>
+	/// Represents an immutable snapshot of frame time statistics, over a rolling window of recent frames.
+	/// <para>Percentiles come from a log-linear histogram, so they're accurate to about 1%. All times are in microseconds.</para>
+	/// </summary>
+	public class FrameStats
+	{
+		/// <summary>
+		/// Statistics for a single <see cref="FrameStatType"/>.
+		/// </summary>
+		public struct Info
+		{
+			/// <summary>
+			/// How many frames the statistics were taken over.
+			/// </summary>
+			public readonly UInt32 SampleCount;
+
+			/// <summary>
+			/// The median time.
+			/// </summary>
+			public readonly UInt32 P50;
+
+			/// <summary>
+			/// The 95th percentile time.
+			/// </summary>
+			public readonly UInt32 P95;
+
+			/// <summary>
+			/// The 99th percentile time.
+			/// </summary>
+			public readonly UInt32 P99;
+
+			/// <summary>
+			/// The longest time.
+			/// </summary>
+			public readonly UInt32 Max;
+
+			/// <summary>
+			/// How many times were over <see cref="HitchThreshold"/>.
+			/// </summary>
+			public readonly UInt32 HitchCount;
+
+			internal Info(Core.Time.FrameStatInfo info)
+			{
+				SampleCount = info.SampleCount;
+				P50 = info.P50;
+				P95 = info.P95;
+				P99 = info.P99;
+				Max = info.Max;
+				HitchCount = info.HitchCount;
+			}
+		};
+
+		readonly Info[] stats;
+
+		/// <summary>
+		/// Frames recorded since the statistics were last reset.
+		/// </summary>
+		public readonly UInt64 FrameCount;
+
+		/// <summary>
+		/// Frames over <see cref="HitchThreshold"/> since the statistics were last reset, including ones no longer in the window.
+		/// </summary>
+		public readonly UInt64 TotalHitchCount;
+
+		/// <summary>
+		/// The time, in microseconds, over which a frame counts as a hitch.
+		/// </summary>
+		public readonly UInt32 HitchThreshold;
+
+		internal FrameStats()
+		{
+			Core.Time.GetFrameStats(out Core.Time.FrameStats coreStats);
+
+			stats = new Info[Core.Time.FrameStatMax];
+			for(int i = 0; i < stats.Length; i++)
+			{ stats[i] = new Info(coreStats.Stats[i]); }
+
+			FrameCount = coreStats.FrameCount;
+			TotalHitchCount = coreStats.TotalHitchCount;
+			HitchThreshold = coreStats.HitchThreshold;
+		}
+
+		/// <summary>
+		/// Gets the statistics for the given <see cref="FrameStatType"/>.
+		/// </summary>
+		/// <param name="type">The time to get statistics for.</param>
+		/// <returns>The statistics.</returns>
+		public Info this[FrameStatType type]
+		{
+			get
+			{
+				Assert.Index((int)(type), stats.Length);
+				return stats[(int)(type)];
+			}
+		}
+	};
+}
\ No newline at end of file
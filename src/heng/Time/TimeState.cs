@@ -38,6 +38,8 @@ namespace heng.Time
 		{
 			TotalTicks = Core.Time.GetTicks();
 			DeltaTicks = 0;
+
+			Core.Time.MarkFrame();
 		}
 
 		TimeState(UInt32 totalTicks, UInt32 deltaTicks)
@@ -65,7 +67,29 @@ namespace heng.Time
 			UInt32 newTotal = Core.Time.GetTicks();
 			UInt32 newDelta = newTotal - TotalTicks;
 
+			// frame stats measure from one update to the next, including any delay
+			Core.Time.MarkFrame();
+
 			return new TimeState(newTotal, newDelta);
 		}
+
+		/// <summary>
+		/// Gets microsecond-resolution statistics for recent frames -- percentiles, maximums and hitch counts,
+		/// for whole frames and for each engine subsystem.
+		/// <para>Frames are recorded each time a <see cref="TimeState"/> is created or updated.</para>
+		/// </summary>
+		/// <returns>A new <see cref="FrameStats"/> snapshot.</returns>
+		public FrameStats GetFrameStats() => new FrameStats();
+
+		/// <summary>
+		/// Sets the frame time over which a frame counts as a hitch. The default is 33,333 microseconds.
+		/// </summary>
+		/// <param name="microseconds">The new hitch threshold, in microseconds.</param>
+		public static void SetHitchThreshold(UInt32 microseconds) => Core.Time.SetHitchThreshold(microseconds);
+
+		/// <summary>
+		/// Clears all recorded frame statistics.
+		/// </summary>
+		public static void ResetFrameStats() => Core.Time.ResetFrameStats();
 	};
 }
\ No newline at end of file
@@ -7,6 +7,13 @@
 	/// </summary>
 	public interface IDrawable
 	{
+		/// <summary>
+		/// The stable ID by which the <see cref="IDrawable"/> is matched up between <see cref="VideoState"/>s.
+		/// <para>New drawables should take one from <see cref="EntityIDs.Next"/>; drawables derived from them
+		/// (e.g. by <see cref="Sprite.Reposition(WorldPoint)"/>) keep theirs.</para>
+		/// </summary>
+		int ID { get; }
+
 		/// <summary>
 		/// Draws this <see cref="IDrawable"/> to the given <see cref="Window"/>.
 		/// </summary>
@@ -5,6 +5,13 @@
 	/// </summary>
 	public class LineDrawable : IDrawable
 	{
+		/// <summary>
+		/// The <see cref="LineDrawable"/>'s ID, by which it's matched up between <see cref="VideoState"/>s.
+		/// </summary>
+		public readonly int ID;
+
+		int IDrawable.ID => ID;
+
 		/// <summary>
 		/// The line's world-space start point.
 		/// </summary>
@@ -28,6 +35,7 @@
 		/// <param name="color">The new line's color.</param>
 		public LineDrawable(WorldPoint start, WorldPoint end, Color color)
 		{
+			ID = EntityIDs.Next();
 			Start = start;
 			End = end;
 			Color = color;
@@ -5,6 +5,13 @@
 	/// </summary>
 	public class PointDrawable : IDrawable
 	{
+		/// <summary>
+		/// The <see cref="PointDrawable"/>'s ID, by which it's matched up between <see cref="VideoState"/>s.
+		/// </summary>
+		public readonly int ID;
+
+		int IDrawable.ID => ID;
+
 		/// <summary>
 		/// The point's world-space position.
 		/// </summary>
@@ -22,6 +29,7 @@
 		/// <param name="color">The new line's color.</param>
 		public PointDrawable(WorldPoint position, Color color)
 		{
+			ID = EntityIDs.Next();
 			Position = position;
 			Color = color;
 		}
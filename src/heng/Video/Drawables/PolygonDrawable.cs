@@ -5,6 +5,13 @@
 	/// </summary>
 	public class PolygonDrawable : IDrawable
 	{
+		/// <summary>
+		/// The <see cref="PolygonDrawable"/>'s ID, by which it's matched up between <see cref="VideoState"/>s.
+		/// </summary>
+		public readonly int ID;
+
+		int IDrawable.ID => ID;
+
 		/// <summary>
 		/// The <see cref="heng.Polygon"/> to draw.
 		/// </summary>
@@ -15,6 +22,11 @@
 		/// </summary>
 		public readonly WorldPoint Position;
 
+		/// <summary>
+		/// Whether to fill the polygon.
+		/// </summary>
+		public readonly bool Fill;
+
 		/// <summary>
 		/// The color of the polygon.
 		/// </summary>
@@ -27,9 +39,21 @@
 		/// <param name="position">The world-space origin of the polygon.</param>
 		/// <param name="color">The color of the polygon.</param>
 		public PolygonDrawable(Polygon polygon, WorldPoint position, Color color)
+			: this(polygon, position, false, color) { }
+
+		/// <summary>
+		/// Contructs a new <see cref="PolygonDrawable"/>.
+		/// </summary>
+		/// <param name="polygon">The <see cref="heng.Polygon"/> to draw.</param>
+		/// <param name="position">The world-space origin of the polygon.</param>
+		/// <param name="fill">Whether to fill the polygon.</param>
+		/// <param name="color">The color of the polygon.</param>
+		public PolygonDrawable(Polygon polygon, WorldPoint position, bool fill, Color color)
 		{
+			ID = EntityIDs.Next();
 			Polygon = polygon;
 			Position = position;
+			Fill = fill;
 			Color = color;
 		}
 
@@ -43,7 +67,10 @@
 				points[i] = camera.WorldToViewportPosition(pointPos);
 			}
 
-			window.DrawPolygon(points, Color);
+			if(Fill)
+			{ window.FillPolygon(points, Color); }
+			else
+			{ window.DrawPolygon(points, Color); }
 		}
 	};
 }
\ No newline at end of file
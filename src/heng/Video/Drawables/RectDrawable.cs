@@ -5,6 +5,13 @@
 	/// </summary>
 	public class RectDrawable : IDrawable
 	{
+		/// <summary>
+		/// The <see cref="RectDrawable"/>'s ID, by which it's matched up between <see cref="VideoState"/>s.
+		/// </summary>
+		public readonly int ID;
+
+		int IDrawable.ID => ID;
+
 		/// <summary>
 		/// The <see cref="heng.Rect"/> to draw.
 		/// </summary>
@@ -36,6 +43,7 @@
 		/// <param name="color">The color of the rect.</param>
 		public RectDrawable(Rect rect, WorldPoint position, bool fill, Color color)
 		{
+			ID = EntityIDs.Next();
 			Rect = rect;
 			Position = position;
 			Fill = fill;
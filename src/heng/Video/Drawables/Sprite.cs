@@ -5,6 +5,14 @@
 	/// </summary>
 	public class Sprite : IDrawable
 	{
+		/// <summary>
+		/// The <see cref="Sprite"/>'s ID, by which it's matched up between <see cref="VideoState"/>s.
+		/// <para>Repositioned sprites keep their ID.</para>
+		/// </summary>
+		public readonly int ID;
+
+		int IDrawable.ID => ID;
+
 		/// <summary>
 		/// The <see cref="Video.Texture"/> to draw.
 		/// </summary>
@@ -27,13 +35,18 @@
 		/// <param name="position">The new <see cref="Sprite"/>'s world-space position.</param>
 		/// <param name="rotation">The new <see cref="Sprite"/>'s rotation, in degrees.</param>
 		public Sprite(Texture texture, WorldPoint position, float rotation)
+			: this(EntityIDs.Next(), texture, position, rotation)
 		{
+			if(texture == null)
+			{ Log.Warning("constructed Sprite with null texture"); }
+		}
+
+		Sprite(int id, Texture texture, WorldPoint position, float rotation)
+		{
+			ID = id;
 			Texture = texture;
 			Position = position;
 			Rotation = rotation;
-			
-			if(texture == null)
-			{ Log.Warning("constructed Sprite with null texture"); }
 		}
 		
 		/// <summary>
@@ -43,7 +56,7 @@
 		/// <returns>A new repositioned <see cref="Sprite"/>.</returns>
 		public Sprite Reposition(WorldPoint position)
 		{
-			return new Sprite(Texture, position, Rotation);
+			return new Sprite(ID, Texture, position, Rotation);
 		}
 		
 		/// <inheritdoc />
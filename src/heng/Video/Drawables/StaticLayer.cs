@@ -0,0 +1,153 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Linq;
+
+namespace heng.Video
+{
+	/// <summary>
+	/// A group of <see cref="IDrawable"/>s that rarely change, cached in an offscreen texture.
+	/// <para>The layer's drawables are only drawn into the texture the first time the layer is drawn to a
+	/// <see cref="Window"/>, and again after <see cref="Invalidate"/>. Every other frame, the whole layer
+	/// is drawn as a single textured quad.</para>
+	/// Anything drawn outside the layer's bounds is clipped. Layers can't be drawn inside other layers.
+	/// Be sure to <see cref="Dispose"/> of the <see cref="StaticLayer"/> when it's no longer needed.
+	/// </summary>
+	public class StaticLayer : IDrawable, IDisposable
+	{
+		/// <summary>
+		/// The <see cref="StaticLayer"/>'s ID, by which it's matched up between <see cref="VideoState"/>s.
+		/// </summary>
+		public readonly int ID;
+
+		int IDrawable.ID => ID;
+
+		/// <summary>
+		/// The <see cref="IDrawable"/>s cached by this layer.
+		/// </summary>
+		public readonly IReadOnlyList<IDrawable> Drawables;
+
+		/// <summary>
+		/// The world-space position of the layer's bottom-left corner.
+		/// </summary>
+		public readonly WorldPoint Origin;
+
+		/// <summary>
+		/// The layer's width, in pixels.
+		/// </summary>
+		public readonly int Width;
+
+		/// <summary>
+		/// The layer's height, in pixels.
+		/// </summary>
+		public readonly int Height;
+
+		// render targets belong to a single window, so each window gets its own
+		readonly int[] targetIDs;
+		readonly bool[] isDrawn;
+		bool isDisposed;
+
+		/// <summary>
+		/// Constructs a new <see cref="StaticLayer"/>.
+		/// </summary>
+		/// <param name="drawables">The <see cref="IDrawable"/>s to cache.</param>
+		/// <param name="origin">The world-space position of the layer's bottom-left corner.</param>
+		/// <param name="width">The layer's width, in pixels.</param>
+		/// <param name="height">The layer's height, in pixels.</param>
+		public StaticLayer(IEnumerable<IDrawable> drawables, WorldPoint origin, int width, int height)
+		{
+			ID = EntityIDs.Next();
+			if(drawables == null)
+			{
+				Log.Warning("constructed StaticLayer with null drawables collection");
+				drawables = new IDrawable[0];
+			}
+
+			Drawables = drawables.Where(d => d != null).ToArray();
+			Origin = origin;
+			Width = width;
+			Height = height;
+
+			targetIDs = Enumerable.Repeat(-1, Core.Video.Windows.Max).ToArray();
+			isDrawn = new bool[Core.Video.Windows.Max];
+		}
+
+		/// <summary>
+		/// Marks the cached texture as out-of-date, so <see cref="Drawables"/> are drawn into it again
+		/// the next time the layer is drawn.
+		/// <para>Only needed if a drawable's appearance changes after the layer is constructed.</para>
+		/// </summary>
+		public void Invalidate()
+		{
+			for(int i = 0; i < isDrawn.Length; i++)
+			{ isDrawn[i] = false; }
+		}
+
+		/// <inheritdoc />
+		public void Dispose()
+		{
+			if(!isDisposed)
+			{
+				for(int i = 0; i < targetIDs.Length; i++)
+				{
+					if(targetIDs[i] > -1)
+					{ Core.Video.Targets.FreeTarget(targetIDs[i]); }
+
+					targetIDs[i] = -1;
+				}
+
+				isDisposed = true;
+			}
+			else
+			{ Log.Warning("tried to Dispose of an already-disposed StaticLayer"); }
+		}
+
+		/// <inheritdoc />
+		public void Draw(Window window, Camera camera)
+		{
+			Assert.Ref(window, camera);
+			Assert.Index(window.ID, Core.Video.Windows.Max);
+
+			if(isDisposed)
+			{
+				Log.Warning($"couldn't draw StaticLayer to window {window.ID}: layer was disposed");
+				return;
+			}
+
+			int id = window.ID;
+			if(targetIDs[id] < 0)
+			{ targetIDs[id] = Core.Video.Targets.CreateTarget(id, Width, Height); }
+
+			// core will take care of error logging; the layer still gets drawn, just not cached
+			if(targetIDs[id] < 0)
+			{
+				foreach(IDrawable d in Drawables)
+				{ d.Draw(window, camera); }
+
+				return;
+			}
+
+			// the renderer can throw the texture's contents away on its own
+			if(!isDrawn[id] || Core.Video.Targets.IsLost(targetIDs[id]))
+			{
+				DrawToTarget(window, targetIDs[id]);
+				isDrawn[id] = true;
+			}
+
+			Core.Video.Queue.DrawTarget(id, targetIDs[id], camera.WorldToViewportPosition(Origin));
+		}
+
+		void DrawToTarget(Window window, int targetID)
+		{
+			// drawables land in the texture relative to the layer's origin
+			Camera layerCamera = new Camera(Origin);
+
+			Core.Video.Queue.SetTarget(window.ID, targetID);
+			window.Clear(Color.Clear);
+
+			foreach(IDrawable d in Drawables)
+			{ d.Draw(window, layerCamera); }
+
+			Core.Video.Queue.SetTarget(window.ID, -1);
+		}
+	};
+}
\ No newline at end of file
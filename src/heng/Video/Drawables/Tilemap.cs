@@ -0,0 +1,159 @@
+﻿using System;
+
+namespace heng.Video
+{
+	/// <summary>
+	/// A world-space grid of tiles from a <see cref="Video.Tileset"/>, drawable to a <see cref="Window"/>.
+	/// <para>Tiles are stored in chunks, one per sector, and only sectors holding tiles take up memory.
+	/// Each chunk's geometry is built once and reused, until a tile in it changes; only the chunks
+	/// visible through the <see cref="Camera"/> are drawn.</para>
+	/// Tilesets used by a tilemap need square tiles that evenly divide <see cref="WorldCoordinate.PixelsPerSector"/>.
+	/// Be sure to <see cref="Dispose"/> of the <see cref="Tilemap"/> when it's no longer needed.
+	/// </summary>
+	public class Tilemap : IDrawable, IDisposable
+	{
+		/// <summary>
+		/// The tile value of an empty tile.
+		/// </summary>
+		public const UInt16 Empty = Core.Video.Tilemaps.TileEmpty;
+
+		/// <summary>
+		/// The <see cref="Tilemap"/>'s ID, by which it's matched up between <see cref="VideoState"/>s.
+		/// </summary>
+		public readonly int ID;
+
+		int IDrawable.ID => ID;
+
+		readonly int tilemapID;
+		bool isDisposed;
+
+		/// <summary>
+		/// The <see cref="Video.Tileset"/> the tiles are drawn from.
+		/// </summary>
+		public readonly Tileset Tileset;
+
+		/// <summary>
+		/// How many tiles span a sector, on each axis.
+		/// </summary>
+		public readonly int SectorTiles;
+
+		/// <summary>
+		/// Creates a new, empty <see cref="Tilemap"/>.
+		/// </summary>
+		/// <param name="tileset">The <see cref="Video.Tileset"/> to draw tiles from.</param>
+		public Tilemap(Tileset tileset)
+		{
+			ID = EntityIDs.Next();
+			Tileset = tileset;
+			tilemapID = -1;
+
+			if(tileset == null || tileset.IsDisposed)
+			{ Log.Error("couldn't construct Tilemap: tileset is null or disposed"); }
+			else if(tileset.TileWidth != tileset.TileHeight || WorldCoordinate.PixelsPerSector % tileset.TileWidth != 0)
+			{ Log.Error($"couldn't construct Tilemap: {tileset.TileWidth}x{tileset.TileHeight} tiles don't evenly divide a sector"); }
+			else
+			{
+				SectorTiles = WorldCoordinate.PixelsPerSector / tileset.TileWidth;
+				tilemapID = Core.Video.Tilemaps.CreateTilemap(tileset.ID, SectorTiles);
+			}
+
+			if(tilemapID < 0)
+			{ isDisposed = true; }
+		}
+
+		/// <summary>
+		/// Sets the tile covering the given world-space position.
+		/// </summary>
+		/// <param name="position">A world-space position inside the tile.</param>
+		/// <param name="tile">The new tile, or <see cref="Empty"/> to clear it.</param>
+		public void SetTile(WorldPoint position, UInt16 tile)
+		{
+			if(CheckUsable("set tile"))
+			{ Core.Video.Tilemaps.SetTile(tilemapID, position.X.Sector, position.Y.Sector, GetTileIndex(position.X), GetTileIndex(position.Y), tile); }
+		}
+
+		/// <summary>
+		/// Reads the tile covering the given world-space position.
+		/// </summary>
+		/// <param name="position">A world-space position inside the tile.</param>
+		/// <returns>The tile at the position, or <see cref="Empty"/>.</returns>
+		public UInt16 GetTile(WorldPoint position)
+		{
+			if(CheckUsable("get tile"))
+			{ return Core.Video.Tilemaps.GetTile(tilemapID, position.X.Sector, position.Y.Sector, GetTileIndex(position.X), GetTileIndex(position.Y)); }
+
+			return Empty;
+		}
+
+		/// <summary>
+		/// Replaces every tile in a sector at once.
+		/// <para>Much faster than setting each tile separately, when loading large maps.</para>
+		/// </summary>
+		/// <param name="sectorX">The sector's X position.</param>
+		/// <param name="sectorY">The sector's Y position.</param>
+		/// <param name="tiles"><see cref="SectorTiles"/> squared tiles, in rows from the bottom of the sector up.</param>
+		public void SetSector(int sectorX, int sectorY, UInt16[] tiles)
+		{
+			if(tiles == null || tiles.Length != SectorTiles * SectorTiles)
+			{
+				Log.Error($"couldn't set tilemap sector ({sectorX}, {sectorY}): needs exactly {SectorTiles * SectorTiles} tiles");
+				return;
+			}
+
+			if(CheckUsable("set sector"))
+			{ Core.Video.Tilemaps.SetChunk(tilemapID, sectorX, sectorY, tiles); }
+		}
+
+		/// <summary>
+		/// Empties every tile in a sector.
+		/// </summary>
+		/// <param name="sectorX">The sector's X position.</param>
+		/// <param name="sectorY">The sector's Y position.</param>
+		public void ClearSector(int sectorX, int sectorY)
+		{
+			if(CheckUsable("clear sector"))
+			{ Core.Video.Tilemaps.SetChunk(tilemapID, sectorX, sectorY, null); }
+		}
+
+		/// <inheritdoc />
+		public void Dispose()
+		{
+			if(!isDisposed)
+			{
+				Core.Video.Tilemaps.FreeTilemap(tilemapID);
+				isDisposed = true;
+			}
+			else
+			{ Log.Warning("tried to Dispose of an already-disposed Tilemap"); }
+		}
+
+		/// <inheritdoc />
+		public void Draw(Window window, Camera camera)
+		{
+			Assert.Ref(window, camera);
+
+			if(CheckUsable("draw"))
+			{
+				// measured from the camera's own sector, so it stays precise far from the world's origin
+				WorldCoordinate x = camera.Position.X;
+				WorldCoordinate y = camera.Position.Y;
+				ScreenPoint origin = camera.WorldToViewportPosition(new WorldPoint(x.Sector, y.Sector, Vector2.Zero));
+
+				Core.Video.Queue.DrawTilemap(window.ID, tilemapID, x.Sector, y.Sector, origin);
+			}
+		}
+
+		int GetTileIndex(WorldCoordinate coord)
+		{
+			return HMath.Clamp(HMath.FloorToInt(coord.Subposition * SectorTiles), 0, SectorTiles - 1);
+		}
+
+		bool CheckUsable(string action)
+		{
+			if(isDisposed)
+			{ Log.Warning($"couldn't {action}: Tilemap was disposed, or erroneously constructed"); }
+
+			return !isDisposed;
+		}
+	};
+}
\ No newline at end of file
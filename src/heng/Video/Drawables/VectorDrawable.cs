@@ -5,6 +5,13 @@
 	/// </summary>
 	public class VectorDrawable : IDrawable
 	{
+		/// <summary>
+		/// The <see cref="VectorDrawable"/>'s ID, by which it's matched up between <see cref="VideoState"/>s.
+		/// </summary>
+		public readonly int ID;
+
+		int IDrawable.ID => ID;
+
 		/// <summary>
 		/// The <see cref="Vector2"/> to draw.
 		/// </summary>
@@ -28,6 +35,7 @@
 		/// <param name="color">The color of the vector.</param>
 		public VectorDrawable(Vector2 vector, WorldPoint position, Color color)
 		{
+			ID = EntityIDs.Next();
 			Vector = vector;
 			Position = position;
 			Color = color;
@@ -26,6 +26,22 @@ namespace heng.Video
 			{ isDisposed = true; }
 		}
 
+		// streamed textures load on core's loader thread, and aren't drawn until they're ready
+		internal Texture(string filePath, bool streamed)
+		{
+			textureID = streamed ? Core.Video.Textures.RequestTexture(filePath) : Core.Video.Textures.LoadTexture(filePath);
+			if(textureID < 0)
+			{ isDisposed = true; }
+		}
+
+		internal bool IsDisposed => isDisposed;
+
+		// the core's texture ID, for core resources built on top of it
+		internal int ID => textureID;
+
+		// bytes held by the loaded pixels; zero while the texture is still loading
+		internal UInt64 ResidentBytes => isDisposed ? 0 : Core.Video.Textures.GetTextureSize(textureID);
+
 		/// <inheritdoc />
 		public void Dispose()
 		{
@@ -0,0 +1,73 @@
+﻿using System;
+
+namespace heng.Video
+{
+	/// <summary>
+	/// A grid of equally-sized tiles, cut from a single atlas <see cref="Video.Texture"/>.
+	/// <para>Tiles are numbered from 1, left-to-right and then top-to-bottom across the atlas;
+	/// <see cref="Tilemap.Empty"/> (0) is reserved for empty tiles.</para>
+	/// Be sure to <see cref="Dispose"/> of the <see cref="Tileset"/> when it's no longer needed, after any
+	/// <see cref="Tilemap"/>s using it.
+	/// </summary>
+	public class Tileset : IDisposable
+	{
+		readonly int tilesetID;
+		bool isDisposed;
+
+		/// <summary>
+		/// The atlas <see cref="Video.Texture"/> the tiles are cut from.
+		/// </summary>
+		public readonly Texture Texture;
+
+		/// <summary>
+		/// The width of each tile, in pixels.
+		/// </summary>
+		public readonly int TileWidth;
+
+		/// <summary>
+		/// The height of each tile, in pixels.
+		/// </summary>
+		public readonly int TileHeight;
+
+		/// <summary>
+		/// Creates a new <see cref="Tileset"/> from the given atlas.
+		/// </summary>
+		/// <param name="atlas">The <see cref="Video.Texture"/> to cut tiles from.</param>
+		/// <param name="tileWidth">The width of each tile, in pixels.</param>
+		/// <param name="tileHeight">The height of each tile, in pixels.</param>
+		public Tileset(Texture atlas, int tileWidth, int tileHeight)
+		{
+			Texture = atlas;
+			TileWidth = tileWidth;
+			TileHeight = tileHeight;
+
+			if(atlas != null && !atlas.IsDisposed)
+			{ tilesetID = Core.Video.Tilemaps.CreateTileset(atlas.ID, tileWidth, tileHeight); }
+			else
+			{
+				Log.Warning("constructed Tileset with null or disposed texture");
+				tilesetID = -1;
+			}
+
+			// core will take care of error logging
+			if(tilesetID < 0)
+			{ isDisposed = true; }
+		}
+
+		internal int ID => tilesetID;
+
+		internal bool IsDisposed => isDisposed;
+
+		/// <inheritdoc />
+		public void Dispose()
+		{
+			if(!isDisposed)
+			{
+				Core.Video.Tilemaps.FreeTileset(tilesetID);
+				isDisposed = true;
+			}
+			else
+			{ Log.Warning("tried to Dispose of an already-disposed Tileset"); }
+		}
+	};
+}
\ No newline at end of file
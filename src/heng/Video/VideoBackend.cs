@@ -0,0 +1,25 @@
+﻿namespace heng.Video
+{
+	/// <summary>
+	/// How the engine's video system draws.
+	/// <para>The offscreen backends open no OS windows and need no display, for running the engine
+	/// headless, e.g. in benchmarks or tests.</para>
+	/// </summary>
+	public enum VideoBackend
+	{
+		/// <summary>
+		/// Each <see cref="Window"/> is a real OS window, drawn by its own renderer.
+		/// </summary>
+		Windowed,
+
+		/// <summary>
+		/// Each <see cref="Window"/> is an offscreen image, drawn by the CPU; frames can be saved with <see cref="Window.SaveImage"/>.
+		/// </summary>
+		Software,
+
+		/// <summary>
+		/// Nothing is drawn at all; draws are only counted, which <see cref="Window.GetDrawStats"/> reports.
+		/// </summary>
+		Null
+	};
+}
\ No newline at end of file
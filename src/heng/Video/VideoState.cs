@@ -1,5 +1,6 @@
 ﻿using System;
 using System.Collections.Generic;
+using System.Linq;
 
 namespace heng.Video
 {
@@ -12,6 +13,67 @@ namespace heng.Video
 	/// </summary>
 	public class VideoState
 	{
+		// games rebuild built-in drawables every frame, so those are compared by what they draw; anything else (layers,
+		// tilemaps, custom drawables) by reference
+		sealed class StateComparer : IEqualityComparer<IDrawable>
+		{
+			public static readonly StateComparer Instance = new StateComparer();
+
+			public bool Equals(IDrawable a, IDrawable b)
+			{
+				if(ReferenceEquals(a, b))
+				{ return true; }
+
+				if(a == null || b == null || a.GetType() != b.GetType())
+				{ return false; }
+
+				switch(a)
+				{
+					case Sprite s:
+						Sprite otherSprite = (Sprite)(b);
+						return s.Texture == otherSprite.Texture && s.Position == otherSprite.Position && s.Rotation == otherSprite.Rotation;
+					case RectDrawable r:
+						RectDrawable otherRect = (RectDrawable)(b);
+						return r.Rect.Center == otherRect.Rect.Center && r.Rect.Extents == otherRect.Rect.Extents &&
+							r.Position == otherRect.Position && r.Fill == otherRect.Fill && r.Color == otherRect.Color;
+					case LineDrawable l:
+						LineDrawable otherLine = (LineDrawable)(b);
+						return l.Start == otherLine.Start && l.End == otherLine.End && l.Color == otherLine.Color;
+					case PointDrawable p:
+						PointDrawable otherPoint = (PointDrawable)(b);
+						return p.Position == otherPoint.Position && p.Color == otherPoint.Color;
+					case VectorDrawable v:
+						VectorDrawable otherVector = (VectorDrawable)(b);
+						return v.Vector == otherVector.Vector && v.Position == otherVector.Position && v.Color == otherVector.Color;
+					case PolygonDrawable pg:
+						PolygonDrawable otherPolygon = (PolygonDrawable)(b);
+						return SamePoints(pg.Polygon.Points, otherPolygon.Polygon.Points) && pg.Position == otherPolygon.Position &&
+							pg.Fill == otherPolygon.Fill && pg.Color == otherPolygon.Color;
+					default:
+						return false;
+				}
+			}
+
+			public int GetHashCode(IDrawable drawable) => drawable?.ID ?? 0;
+
+			static bool SamePoints(IReadOnlyList<Vector2> a, IReadOnlyList<Vector2> b)
+			{
+				if(ReferenceEquals(a, b))
+				{ return true; }
+
+				if(a == null || b == null || a.Count != b.Count)
+				{ return false; }
+
+				for(int i = 0; i < a.Count; i++)
+				{
+					if(a[i] != b[i])
+					{ return false; }
+				}
+
+				return true;
+			}
+		};
+
 		/// <summary>
 		/// All <see cref="Window"/>s currently open.
 		/// <para>A <see cref="Window"/>'s <see cref="Window.ID"/> is an index into this collection.</para>
@@ -41,12 +103,24 @@ namespace heng.Video
 			Drawables = AddDrawables(drawables);
 		}
 
-		IReadOnlyList<Window> AddWindows(IEnumerable<Window> windows)
+		/// <summary>
+		/// Computes which <see cref="IDrawable"/> objects changed since a previous <see cref="VideoState"/>.
+		/// <para>Drawables are identified by their <see cref="IDrawable.ID"/>, so adding or removing one doesn't shift the rest.
+		/// Built-in drawables only count as changed when they'd draw differently; other drawables whenever they're replaced.</para>
+		/// </summary>
+		/// <param name="previous">The preceding <see cref="VideoState"/>. If null, every drawable is reported as added.</param>
+		/// <returns>The delta between the two states' drawables.</returns>
+		public StateDelta<IDrawable> GetDelta(VideoState previous)
+		{
+			return new StateDelta<IDrawable>(previous?.Drawables, Drawables, drawable => drawable.ID, StateComparer.Instance);
+		}
+
+		unsafe IReadOnlyList<Window> AddWindows(IEnumerable<Window> windows)
 		{
 			if(windows != null)
 			{
 				List<Window> wnd = new List<Window>();
-				Core.Video.GetSnapshot(out Core.Video.State coreState);
+				Core.Video.Windows.WindowInfo* windowInfo = Core.Video.Windows.GetWindowInfo(Core.Video.Windows.GetSnapshot());
 
 				foreach(Window w in windows)
 				{
@@ -57,7 +131,7 @@ namespace heng.Video
 							wnd.Add(w);
 
 							// open the window if it's not yet open
-							if(coreState.Windows.WindowInfo[w.ID].ID < 0)
+							if(windowInfo[w.ID].ID < 0)
 							{ Core.Video.Windows.OpenWindow(w.ID, w.Title, w.Rect, (UInt32)(w.WindowFlags), (UInt32)(w.RendererFlags)); }
 						}
 						else
@@ -79,17 +153,27 @@ namespace heng.Video
 		{
 			if(drawables != null)
 			{
-				List<IDrawable> drw = new List<IDrawable>(drawables);
-				int rm = drw.RemoveAll(d => d == null);
+				// a PersistentList passed in by the game is kept as-is, rather than copied
+				PersistentList<IDrawable> drw = PersistentList<IDrawable>.Create(drawables);
+
+				int rm = 0;
+				foreach(IDrawable d in drw)
+				{
+					if(d == null)
+					{ rm++; }
+				}
 
 				if(rm > 0)
-				{ Log.Warning($"removed {rm} null IDrawable objects from VideoState"); }
+				{
+					drw = PersistentList<IDrawable>.Create(drw.Where(d => d != null));
+					Log.Warning($"removed {rm} null IDrawable objects from VideoState");
+				}
 
 				foreach(Window w in Windows)
 				{
 					w.Clear(Color.White);
 
-					foreach(IDrawable d in drawables)
+					foreach(IDrawable d in drw)
 					{ d.Draw(w, Camera); }
 
 					// no-op if DEBUG is not defined
@@ -104,7 +188,7 @@ namespace heng.Video
 			else
 			{ Log.Warning("VideoState constructed with null drawables collection"); }
 
-			return new IDrawable[0];
+			return PersistentList<IDrawable>.Empty;
 		}
 
 		Camera AddCamera(Camera camera)
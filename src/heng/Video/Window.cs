@@ -107,6 +107,51 @@
 			Core.Video.Queue.ClearWindow(ID, color);
 		}
 
+		/// <summary>
+		/// Caps how much can be drawn to the window each frame; anything past the budget is dropped.
+		/// <para>The budget belongs to the window's <see cref="ID"/>, and stays until it's set again.</para>
+		/// </summary>
+		/// <param name="maxCommands">The most draw calls per frame, or 0 for no limit.</param>
+		/// <param name="maxPoints">The most points per frame, across all point and polygon draws, or 0 for no limit.</param>
+		public void SetDrawBudget(int maxCommands, int maxPoints)
+		{
+			Core.Video.Queue.SetBudget(ID, maxCommands, maxPoints);
+		}
+
+		/// <summary>
+		/// Saves what's currently been drawn to the window as a BMP image.
+		/// <para>Only the <see cref="VideoBackend.Software"/> backend reliably keeps a frame after it's presented,
+		/// so it's the one to use for comparing against golden images.</para>
+		/// </summary>
+		/// <param name="filePath">The path of the image to write.</param>
+		/// <returns>Whether the image was saved.</returns>
+		public bool SaveImage(string filePath)
+		{
+			if(filePath == null)
+			{
+				Log.Warning("tried to save image of window " + ID + " to null path");
+				return false;
+			}
+
+			return Core.Video.Windows.SaveImage(ID, filePath);
+		}
+
+		/// <summary>
+		/// Gets how much has been drawn to the window since it was opened.
+		/// <para>Every backend counts draws, including <see cref="VideoBackend.Null"/>, which draws nothing.</para>
+		/// </summary>
+		/// <param name="drawCalls">The number of draw calls.</param>
+		/// <param name="points">The number of points drawn by point, line and polygon draws.</param>
+		/// <param name="presents">The number of frames presented.</param>
+		public void GetDrawStats(out ulong drawCalls, out ulong points, out ulong presents)
+		{
+			Core.Video.Windows.GetDrawStats(ID, out Core.Video.Windows.DrawStats stats);
+
+			drawCalls = stats.DrawCalls;
+			points = stats.Points;
+			presents = stats.Presents;
+		}
+
 		/// <summary>
 		/// Draws a one-pixel point to the window.
 		/// </summary>
@@ -161,6 +206,23 @@
 			Core.Video.Queue.DrawPolygon(ID, color, points, points.Length);
 		}
 
+		/// <summary>
+		/// Draws a filled polygon to the window, whose vertices consist of the given points.
+		/// <para>The polygon must be convex.</para>
+		/// </summary>
+		/// <param name="points">The vertices of the polygon.</param>
+		/// <param name="color">The color of the polygon.</param>
+		public void FillPolygon(ScreenPoint[] points, Color color)
+		{
+			if(points == null)
+			{
+				Log.Warning("tried to fill null array of ScreenPoints to window " + ID);
+				points = new ScreenPoint[0];
+			}
+
+			Core.Video.Queue.FillPolygon(ID, color, points, points.Length);
+		}
+
 		/// <summary>
 		/// Draws a rect to the window, optionally filling it.
 		/// </summary>
@@ -17,6 +17,16 @@ namespace heng
 			Debug.Assert(condition, msg);
 		}
 		
+		/// <summary>
+		/// Asserts that the given object reference is not null.
+		/// <para>Unlike <see cref="Ref(object[])"/>, this doesn't allocate an array, so it's safe in per-frame paths.</para>
+		/// </summary>
+		/// <param name="reference">The reference that shouldn't be null.</param>
+		public static void Ref(object reference)
+		{
+			Debug.Assert(reference != null, "reference is null");
+		}
+
 		/// <summary>
 		/// Asserts that the given object references are not null.
 		/// </summary>
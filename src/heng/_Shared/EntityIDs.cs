@@ -0,0 +1,23 @@
+﻿using System.Threading;
+
+namespace heng
+{
+	/// <summary>
+	/// Hands out the stable IDs state entities (<see cref="Audio.SoundSource"/>s, <see cref="Physics.IPhysicsBody"/>s,
+	/// <see cref="Video.IDrawable"/>s) are matched up by, between snapshots.
+	/// <para>An entity takes a new ID when it's constructed, and passes it on to every entity derived from it.</para>
+	/// </summary>
+	public static class EntityIDs
+	{
+		static int lastID;
+
+		/// <summary>
+		/// Gets a new ID, unique for the process' lifetime.
+		/// </summary>
+		/// <returns>The new ID.</returns>
+		public static int Next()
+		{
+			return Interlocked.Increment(ref lastID);
+		}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,49 @@
+﻿using System;
+
+namespace heng
+{
+	/// <summary>
+	/// Represents a mounted pack file, built by the heng-pack tool.
+	/// <para>While a <see cref="PackFile"/> is mounted, resources loaded by path -- <see cref="Audio.Sound"/>s
+	/// and <see cref="Video.Texture"/>s -- are served from it instead of from their own files, if it contains them.
+	/// Assets pre-converted to the running audio and pixel formats are used in place, without being parsed or copied.</para>
+	/// Packs mounted later take precedence over earlier ones. Be sure to <see cref="Dispose"/> of the
+	/// <see cref="PackFile"/> only after the resources loaded from it have been disposed.
+	/// </summary>
+	public class PackFile : IDisposable
+	{
+		readonly int packID;
+		bool isDisposed;
+
+		/// <summary>
+		/// Maps the pack file at the given path, and mounts it.
+		/// </summary>
+		/// <param name="filePath">The pack file to mount.</param>
+		public PackFile(string filePath)
+		{
+			packID = Core.Pack.Mount(filePath);
+
+			// core will take care of error logging
+			if(packID < 0)
+			{ isDisposed = true; }
+		}
+
+		/// <summary>
+		/// Whether the pack was successfully mounted, and is still mounted.
+		/// </summary>
+		public bool IsMounted => !isDisposed;
+
+		/// <inheritdoc />
+		public void Dispose()
+		{
+			if(!isDisposed)
+			{
+				// core refuses to unmount a pack with resources still loaded from it
+				if(Core.Pack.Unmount(packID))
+				{ isDisposed = true; }
+			}
+			else
+			{ Log.Warning("tried to Dispose of an already-disposed PackFile"); }
+		}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,423 @@
+﻿using System;
+using System.Collections;
+using System.Collections.Generic;
+
+namespace heng
+{
+	/// <summary>
+	/// An immutable dictionary which shares structure between versions.
+	/// <para>Entries are stored in a hash array mapped trie, consuming 5 bits of each key's hash code per level.
+	/// Setting or removing an entry only copies the path from the root to the affected node -- O(log32 n) --
+	/// while every other node is shared with the previous version.</para>
+	/// </summary>
+	/// <typeparam name="TKey">The type of key used to look up values. Null keys are not allowed.</typeparam>
+	/// <typeparam name="TValue">The type of value stored in the dictionary.</typeparam>
+	public sealed class PersistentDictionary<TKey, TValue> : IReadOnlyDictionary<TKey, TValue>
+	{
+		const int bits = 5;
+		const int mask = (1 << bits) - 1;
+		const int hashBits = 32;
+
+		sealed class Node
+		{
+			// bitmap-indexed node: bits set in dataMap/nodeMap mark which hash fragments are occupied
+			public readonly uint DataMap;
+			public readonly uint NodeMap;
+			public readonly KeyValuePair<TKey, TValue>[] Data;
+			public readonly Node[] Nodes;
+
+			// collision node: all entries share the same full hash code
+			public readonly bool IsCollision;
+
+			public int EntryCount => Data.Length + Nodes.Length;
+
+			public Node(uint dataMap, uint nodeMap, KeyValuePair<TKey, TValue>[] data, Node[] nodes)
+			{
+				DataMap = dataMap;
+				NodeMap = nodeMap;
+				Data = data;
+				Nodes = nodes;
+			}
+
+			public Node(KeyValuePair<TKey, TValue>[] collisions)
+			{
+				IsCollision = true;
+				Data = collisions;
+				Nodes = new Node[0];
+			}
+		};
+
+		static readonly Node emptyRoot = new Node(0, 0, new KeyValuePair<TKey, TValue>[0], new Node[0]);
+		static readonly IEqualityComparer<TKey> keyComparer = EqualityComparer<TKey>.Default;
+		static readonly IEqualityComparer<TValue> valueComparer = EqualityComparer<TValue>.Default;
+
+		/// <summary>
+		/// An empty <see cref="PersistentDictionary{TKey, TValue}"/>.
+		/// </summary>
+		public static readonly PersistentDictionary<TKey, TValue> Empty = new PersistentDictionary<TKey, TValue>(emptyRoot, 0);
+
+		readonly Node root;
+		readonly int count;
+
+		/// <summary>
+		/// The number of entries in the dictionary.
+		/// </summary>
+		public int Count => count;
+
+		/// <summary>
+		/// Gets the value associated with the given key.
+		/// </summary>
+		/// <param name="key">The key of the value to get.</param>
+		public TValue this[TKey key]
+		{
+			get
+			{
+				if(!TryGetValue(key, out TValue value))
+				{ throw new KeyNotFoundException(); }
+
+				return value;
+			}
+		}
+
+		/// <summary>
+		/// All keys in the dictionary.
+		/// </summary>
+		public IEnumerable<TKey> Keys
+		{
+			get
+			{
+				foreach(KeyValuePair<TKey, TValue> entry in this)
+				{ yield return entry.Key; }
+			}
+		}
+
+		/// <summary>
+		/// All values in the dictionary.
+		/// </summary>
+		public IEnumerable<TValue> Values
+		{
+			get
+			{
+				foreach(KeyValuePair<TKey, TValue> entry in this)
+				{ yield return entry.Value; }
+			}
+		}
+
+		PersistentDictionary(Node root, int count)
+		{
+			this.root = root;
+			this.count = count;
+		}
+
+		/// <summary>
+		/// Checks if the dictionary contains the given key.
+		/// </summary>
+		/// <param name="key">The key to check for.</param>
+		/// <returns>Whether or not the key is present.</returns>
+		public bool ContainsKey(TKey key)
+		{
+			return TryGetValue(key, out _);
+		}
+
+		/// <summary>
+		/// Attempts to get the value associated with the given key.
+		/// </summary>
+		/// <param name="key">The key of the value to get.</param>
+		/// <param name="value">The value associated with the key, or the default value if it's not present.</param>
+		/// <returns>Whether or not the key was present.</returns>
+		public bool TryGetValue(TKey key, out TValue value)
+		{
+			if(key != null)
+			{
+				uint hash = (uint)(keyComparer.GetHashCode(key));
+				Node node = root;
+
+				for(int shift = 0; ; shift += bits)
+				{
+					if(node.IsCollision)
+					{ return TryFindCollision(node, key, out value); }
+
+					uint bit = Bit(hash, shift);
+					if((node.DataMap & bit) != 0)
+					{
+						KeyValuePair<TKey, TValue> entry = node.Data[Index(node.DataMap, bit)];
+						if(keyComparer.Equals(entry.Key, key))
+						{
+							value = entry.Value;
+							return true;
+						}
+
+						break;
+					}
+					else if((node.NodeMap & bit) != 0)
+					{ node = node.Nodes[Index(node.NodeMap, bit)]; }
+					else
+					{ break; }
+				}
+			}
+
+			value = default(TValue);
+			return false;
+		}
+
+		/// <summary>
+		/// Associates the given value with the given key, adding a new entry if the key isn't present.
+		/// </summary>
+		/// <param name="key">The key to set.</param>
+		/// <param name="value">The value to associate with the key.</param>
+		/// <returns>A new dictionary with the entry set, or this dictionary if nothing changed.</returns>
+		public PersistentDictionary<TKey, TValue> SetItem(TKey key, TValue value)
+		{
+			if(key != null)
+			{
+				bool added = false;
+				uint hash = (uint)(keyComparer.GetHashCode(key));
+				Node newRoot = Set(root, new KeyValuePair<TKey, TValue>(key, value), hash, 0, ref added);
+
+				if(newRoot != root)
+				{ return new PersistentDictionary<TKey, TValue>(newRoot, added ? count + 1 : count); }
+			}
+			else
+			{ Log.Error("couldn't set PersistentDictionary entry: key is null"); }
+
+			return this;
+		}
+
+		/// <summary>
+		/// Removes the entry with the given key.
+		/// </summary>
+		/// <param name="key">The key of the entry to remove.</param>
+		/// <returns>A new dictionary with the entry removed, or this dictionary if the key wasn't present.</returns>
+		public PersistentDictionary<TKey, TValue> Remove(TKey key)
+		{
+			if(key != null)
+			{
+				uint hash = (uint)(keyComparer.GetHashCode(key));
+				Node newRoot = Remove(root, key, hash, 0);
+
+				if(newRoot != root)
+				{ return new PersistentDictionary<TKey, TValue>(newRoot, count - 1); }
+			}
+
+			return this;
+		}
+
+		/// <summary>
+		/// Gets an enumerator which iterates all entries in the dictionary, in no particular order.
+		/// </summary>
+		/// <returns>The enumerator.</returns>
+		public IEnumerator<KeyValuePair<TKey, TValue>> GetEnumerator()
+		{
+			Stack<Node> nodes = new Stack<Node>();
+			nodes.Push(root);
+
+			while(nodes.Count > 0)
+			{
+				Node node = nodes.Pop();
+
+				foreach(KeyValuePair<TKey, TValue> entry in node.Data)
+				{ yield return entry; }
+
+				foreach(Node child in node.Nodes)
+				{ nodes.Push(child); }
+			}
+		}
+
+		IEnumerator IEnumerable.GetEnumerator()
+		{
+			return GetEnumerator();
+		}
+
+		static Node Set(Node node, KeyValuePair<TKey, TValue> entry, uint hash, int shift, ref bool added)
+		{
+			if(node.IsCollision)
+			{ return SetCollision(node, entry, ref added); }
+
+			uint bit = Bit(hash, shift);
+			if((node.DataMap & bit) != 0)
+			{
+				int i = Index(node.DataMap, bit);
+				KeyValuePair<TKey, TValue> existing = node.Data[i];
+
+				if(keyComparer.Equals(existing.Key, entry.Key))
+				{
+					if(valueComparer.Equals(existing.Value, entry.Value))
+					{ return node; }
+
+					KeyValuePair<TKey, TValue>[] data = (KeyValuePair<TKey, TValue>[])(node.Data.Clone());
+					data[i] = entry;
+
+					return new Node(node.DataMap, node.NodeMap, data, node.Nodes);
+				}
+				else
+				{
+					// two different keys in the same slot - push both down into a new sub-node
+					uint existingHash = (uint)(keyComparer.GetHashCode(existing.Key));
+					Node sub = Merge(existing, existingHash, entry, hash, shift + bits);
+					added = true;
+
+					return new Node(node.DataMap ^ bit, node.NodeMap | bit,
+						RemoveAt(node.Data, i), InsertAt(node.Nodes, Index(node.NodeMap, bit), sub));
+				}
+			}
+			else if((node.NodeMap & bit) != 0)
+			{
+				int i = Index(node.NodeMap, bit);
+				Node child = node.Nodes[i];
+				Node newChild = Set(child, entry, hash, shift + bits, ref added);
+
+				if(newChild == child)
+				{ return node; }
+
+				Node[] nodes = (Node[])(node.Nodes.Clone());
+				nodes[i] = newChild;
+
+				return new Node(node.DataMap, node.NodeMap, node.Data, nodes);
+			}
+			else
+			{
+				added = true;
+				return new Node(node.DataMap | bit, node.NodeMap, InsertAt(node.Data, Index(node.DataMap, bit), entry), node.Nodes);
+			}
+		}
+
+		static Node SetCollision(Node node, KeyValuePair<TKey, TValue> entry, ref bool added)
+		{
+			for(int i = 0; i < node.Data.Length; i++)
+			{
+				if(keyComparer.Equals(node.Data[i].Key, entry.Key))
+				{
+					if(valueComparer.Equals(node.Data[i].Value, entry.Value))
+					{ return node; }
+
+					KeyValuePair<TKey, TValue>[] data = (KeyValuePair<TKey, TValue>[])(node.Data.Clone());
+					data[i] = entry;
+
+					return new Node(data);
+				}
+			}
+
+			added = true;
+			return new Node(InsertAt(node.Data, node.Data.Length, entry));
+		}
+
+		static Node Merge(KeyValuePair<TKey, TValue> a, uint hashA, KeyValuePair<TKey, TValue> b, uint hashB, int shift)
+		{
+			// out of hash bits - the full hash codes are equal
+			if(shift >= hashBits)
+			{ return new Node(new KeyValuePair<TKey, TValue>[] { a, b }); }
+
+			uint bitA = Bit(hashA, shift);
+			uint bitB = Bit(hashB, shift);
+
+			if(bitA != bitB)
+			{
+				KeyValuePair<TKey, TValue>[] data = (bitA < bitB) ?
+					new KeyValuePair<TKey, TValue>[] { a, b } : new KeyValuePair<TKey, TValue>[] { b, a };
+
+				return new Node(bitA | bitB, 0, data, new Node[0]);
+			}
+
+			Node sub = Merge(a, hashA, b, hashB, shift + bits);
+			return new Node(0, bitA, new KeyValuePair<TKey, TValue>[0], new Node[] { sub });
+		}
+
+		static Node Remove(Node node, TKey key, uint hash, int shift)
+		{
+			if(node.IsCollision)
+			{
+				for(int i = 0; i < node.Data.Length; i++)
+				{
+					if(keyComparer.Equals(node.Data[i].Key, key))
+					{ return new Node(RemoveAt(node.Data, i)); }
+				}
+
+				return node;
+			}
+
+			uint bit = Bit(hash, shift);
+			if((node.DataMap & bit) != 0)
+			{
+				int i = Index(node.DataMap, bit);
+				if(keyComparer.Equals(node.Data[i].Key, key))
+				{ return new Node(node.DataMap ^ bit, node.NodeMap, RemoveAt(node.Data, i), node.Nodes); }
+			}
+			else if((node.NodeMap & bit) != 0)
+			{
+				int i = Index(node.NodeMap, bit);
+				Node child = node.Nodes[i];
+				Node newChild = Remove(child, key, hash, shift + bits);
+
+				if(newChild == child)
+				{ return node; }
+
+				// a sub-node left holding a single entry is pulled back up into this node
+				if(newChild.EntryCount == 1 && newChild.Nodes.Length == 0)
+				{
+					return new Node(node.DataMap | bit, node.NodeMap ^ bit,
+						InsertAt(node.Data, Index(node.DataMap, bit), newChild.Data[0]), RemoveAt(node.Nodes, i));
+				}
+
+				Node[] nodes = (Node[])(node.Nodes.Clone());
+				nodes[i] = newChild;
+
+				return new Node(node.DataMap, node.NodeMap, node.Data, nodes);
+			}
+
+			return node;
+		}
+
+		static bool TryFindCollision(Node node, TKey key, out TValue value)
+		{
+			foreach(KeyValuePair<TKey, TValue> entry in node.Data)
+			{
+				if(keyComparer.Equals(entry.Key, key))
+				{
+					value = entry.Value;
+					return true;
+				}
+			}
+
+			value = default(TValue);
+			return false;
+		}
+
+		static uint Bit(uint hash, int shift)
+		{
+			return 1u << (int)((hash >> shift) & mask);
+		}
+
+		static int Index(uint bitmap, uint bit)
+		{
+			return PopCount(bitmap & (bit - 1));
+		}
+
+		static int PopCount(uint x)
+		{
+			x = x - ((x >> 1) & 0x55555555);
+			x = (x & 0x33333333) + ((x >> 2) & 0x33333333);
+			x = (x + (x >> 4)) & 0x0F0F0F0F;
+
+			return (int)((x * 0x01010101) >> 24);
+		}
+
+		static TElem[] InsertAt<TElem>(TElem[] array, int i, TElem item)
+		{
+			TElem[] newArray = new TElem[array.Length + 1];
+			Array.Copy(array, 0, newArray, 0, i);
+			newArray[i] = item;
+			Array.Copy(array, i, newArray, i + 1, array.Length - i);
+
+			return newArray;
+		}
+
+		static TElem[] RemoveAt<TElem>(TElem[] array, int i)
+		{
+			TElem[] newArray = new TElem[array.Length - 1];
+			Array.Copy(array, 0, newArray, 0, i);
+			Array.Copy(array, i + 1, newArray, i, array.Length - i - 1);
+
+			return newArray;
+		}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,306 @@
+﻿using System;
+using System.Collections;
+using System.Collections.Generic;
+
+namespace heng
+{
+	/// <summary>
+	/// An immutable list which shares structure between versions.
+	/// <para>Items are stored in a 32-way trie of fixed-size leaves, plus a separate tail leaf for the last items.
+	/// Updating or appending an item only copies the path from the root to the affected leaf -- O(log32 n) --
+	/// while every other leaf is shared with the previous version.</para>
+	/// Use <see cref="Builder"/> to efficiently construct a list from scratch.
+	/// </summary>
+	/// <typeparam name="T">The type of item stored in the list.</typeparam>
+	public sealed class PersistentList<T> : IReadOnlyList<T>
+	{
+		const int bits = 5;
+		const int width = 1 << bits;
+		const int mask = width - 1;
+
+		sealed class Node
+		{
+			public readonly Node[] Children;
+			public readonly T[] Values;
+
+			public Node(Node[] children)
+			{ Children = children; }
+
+			public Node(T[] values)
+			{ Values = values; }
+		};
+
+		static readonly Node emptyRoot = new Node(new Node[0]);
+
+		/// <summary>
+		/// An empty <see cref="PersistentList{T}"/>.
+		/// </summary>
+		public static readonly PersistentList<T> Empty = new PersistentList<T>(0, bits, emptyRoot, new T[0]);
+
+		readonly int count;
+		readonly int shift;
+		readonly Node root;
+		readonly T[] tail;
+
+		/// <summary>
+		/// The number of items in the list.
+		/// </summary>
+		public int Count => count;
+
+		/// <summary>
+		/// Gets the item at the given index.
+		/// </summary>
+		/// <param name="i">The index of the item to get.</param>
+		public T this[int i]
+		{
+			get
+			{
+				Assert.Index(i, count);
+				return LeafFor(i)[i & mask];
+			}
+		}
+
+		PersistentList(int count, int shift, Node root, T[] tail)
+		{
+			this.count = count;
+			this.shift = shift;
+			this.root = root;
+			this.tail = tail;
+		}
+
+		/// <summary>
+		/// Creates a new <see cref="PersistentList{T}"/> containing the given items.
+		/// <para>If the given collection is already a <see cref="PersistentList{T}"/>, it's returned as-is.</para>
+		/// </summary>
+		/// <param name="items">The items to store in the new list.</param>
+		/// <returns>A list containing the given items, or <see cref="Empty"/> if the collection is null.</returns>
+		public static PersistentList<T> Create(IEnumerable<T> items)
+		{
+			if(items is PersistentList<T> list)
+			{ return list; }
+
+			Builder builder = new Builder();
+			if(items != null)
+			{
+				foreach(T item in items)
+				{ builder.Add(item); }
+			}
+
+			return builder.ToList();
+		}
+
+		/// <summary>
+		/// Appends an item to the end of the list.
+		/// </summary>
+		/// <param name="item">The item to append.</param>
+		/// <returns>A new list, with the item appended.</returns>
+		public PersistentList<T> Add(T item)
+		{
+			// room in the tail - just copy it
+			if(count - TailOffset(count) < width)
+			{
+				T[] newTail = new T[tail.Length + 1];
+				tail.CopyTo(newTail, 0);
+				newTail[tail.Length] = item;
+
+				return new PersistentList<T>(count + 1, shift, root, newTail);
+			}
+
+			PushTail(count, shift, root, new Node(tail), out Node newRoot, out int newShift);
+			return new PersistentList<T>(count + 1, newShift, newRoot, new T[] { item });
+		}
+
+		/// <summary>
+		/// Replaces the item at the given index.
+		/// </summary>
+		/// <param name="i">The index of the item to replace.</param>
+		/// <param name="item">The new item.</param>
+		/// <returns>A new list, with the item replaced.</returns>
+		public PersistentList<T> SetItem(int i, T item)
+		{
+			Assert.Index(i, count);
+
+			if(i >= TailOffset(count))
+			{
+				T[] newTail = (T[])(tail.Clone());
+				newTail[i & mask] = item;
+
+				return new PersistentList<T>(count, shift, root, newTail);
+			}
+
+			return new PersistentList<T>(count, shift, SetInNode(shift, root, i, item), tail);
+		}
+
+		/// <summary>
+		/// Creates a <see cref="Builder"/> initially containing this list's items.
+		/// </summary>
+		/// <returns>A new <see cref="Builder"/>.</returns>
+		public Builder ToBuilder()
+		{
+			return new Builder(this);
+		}
+
+		/// <summary>
+		/// Gets an enumerator which iterates the list's items in order.
+		/// </summary>
+		/// <returns>The enumerator.</returns>
+		public IEnumerator<T> GetEnumerator()
+		{
+			for(int i = 0; i < count; i += width)
+			{
+				T[] leaf = LeafFor(i);
+				for(int j = 0; j < leaf.Length && (i + j) < count; j++)
+				{ yield return leaf[j]; }
+			}
+		}
+
+		IEnumerator IEnumerable.GetEnumerator()
+		{
+			return GetEnumerator();
+		}
+
+		T[] LeafFor(int i)
+		{
+			if(i >= TailOffset(count))
+			{ return tail; }
+
+			Node node = root;
+			for(int level = shift; level > 0; level -= bits)
+			{ node = node.Children[(i >> level) & mask]; }
+
+			return node.Values;
+		}
+
+		static int TailOffset(int count)
+		{
+			return (count < width) ? 0 : (((count - 1) >> bits) << bits);
+		}
+
+		static void PushTail(int count, int shift, Node root, Node tailNode, out Node newRoot, out int newShift)
+		{
+			// root is full - grow the tree by one level
+			if((count >> bits) > (1 << shift))
+			{
+				newRoot = new Node(new Node[] { root, NewPath(shift, tailNode) });
+				newShift = shift + bits;
+			}
+			else
+			{
+				newRoot = PushTailInto(count, shift, root, tailNode);
+				newShift = shift;
+			}
+		}
+
+		static Node PushTailInto(int count, int level, Node parent, Node tailNode)
+		{
+			int sub = ((count - 1) >> level) & mask;
+
+			Node[] children = new Node[Math.Max(parent.Children.Length, sub + 1)];
+			parent.Children.CopyTo(children, 0);
+
+			if(level == bits)
+			{ children[sub] = tailNode; }
+			else
+			{
+				Node child = (sub < parent.Children.Length) ? parent.Children[sub] : null;
+				children[sub] = (child != null) ? PushTailInto(count, level - bits, child, tailNode) : NewPath(level - bits, tailNode);
+			}
+
+			return new Node(children);
+		}
+
+		static Node NewPath(int level, Node node)
+		{
+			if(level == 0)
+			{ return node; }
+
+			return new Node(new Node[] { NewPath(level - bits, node) });
+		}
+
+		static Node SetInNode(int level, Node node, int i, T item)
+		{
+			if(level == 0)
+			{
+				T[] values = (T[])(node.Values.Clone());
+				values[i & mask] = item;
+
+				return new Node(values);
+			}
+
+			Node[] children = (Node[])(node.Children.Clone());
+			int sub = (i >> level) & mask;
+			children[sub] = SetInNode(level - bits, children[sub], i, item);
+
+			return new Node(children);
+		}
+
+		/// <summary>
+		/// A mutable builder, used to efficiently construct a <see cref="PersistentList{T}"/>.
+		/// <para>Appending to a builder only allocates once per 32 items.</para>
+		/// </summary>
+		public sealed class Builder
+		{
+			int count;
+			int shift;
+			Node root;
+			T[] tail;
+
+			/// <summary>
+			/// The number of items added to the builder so far.
+			/// </summary>
+			public int Count => count;
+
+			/// <summary>
+			/// Creates a new, empty <see cref="Builder"/>.
+			/// </summary>
+			public Builder()
+			{
+				shift = bits;
+				root = emptyRoot;
+				tail = new T[width];
+			}
+
+			internal Builder(PersistentList<T> list)
+			{
+				count = list.count;
+				shift = list.shift;
+				root = list.root;
+				tail = new T[width];
+				list.tail.CopyTo(tail, 0);
+			}
+
+			/// <summary>
+			/// Appends an item to the builder.
+			/// </summary>
+			/// <param name="item">The item to append.</param>
+			public void Add(T item)
+			{
+				if(count - TailOffset(count) == width)
+				{
+					PushTail(count, shift, root, new Node(tail), out root, out shift);
+					tail = new T[width];
+				}
+
+				tail[count & mask] = item;
+				count++;
+			}
+
+			/// <summary>
+			/// Creates a <see cref="PersistentList{T}"/> from the builder's current items.
+			/// <para>The builder can continue to be used afterward.</para>
+			/// </summary>
+			/// <returns>The new <see cref="PersistentList{T}"/>.</returns>
+			public PersistentList<T> ToList()
+			{
+				if(count == 0)
+				{ return Empty; }
+
+				int tailCount = count - TailOffset(count);
+				T[] listTail = new T[tailCount];
+				Array.Copy(tail, listTail, tailCount);
+
+				return new PersistentList<T>(count, shift, root, listTail);
+			}
+		};
+	};
+}
\ No newline at end of file
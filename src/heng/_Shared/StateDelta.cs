@@ -0,0 +1,280 @@
+﻿using System;
+using System.Collections.Generic;
+
+namespace heng
+{
+	/// <summary>
+	/// Describes the differences between two consecutive snapshots of an immutable state collection,
+	/// such as <see cref="Physics.PhysicsState.PhysicsBodies"/> or <see cref="Video.VideoState.Drawables"/>.
+	/// <para>Entities are keyed by a stable ID, where they have one (see <see cref="StateDelta(IReadOnlyList{T}, IReadOnlyList{T}, Func{T, int}, IEqualityComparer{T})"/>),
+	/// so they're matched up even when they're reordered, added or removed from the middle of the collection. Otherwise, they're
+	/// keyed by their index within the collection, which only stays stable for as long as their owner keeps re-adding them in order.</para>
+	/// By default, entities are compared by reference: immutable objects that didn't change are simply carried over
+	/// into the next state, so only replaced objects are recorded. Entities that are rebuilt every frame need a comparer
+	/// that compares them by value instead. <see cref="Apply(IReadOnlyList{T})"/> reverses the diff, reconstructing the newer
+	/// collection from the older one.
+	/// </summary>
+	/// <typeparam name="T">The type of entity stored by the state collection.</typeparam>
+	public class StateDelta<T> where T : class
+	{
+		/// <summary>
+		/// A single entity that was changed or added between two snapshots.
+		/// </summary>
+		public struct Change
+		{
+			/// <summary>
+			/// The stable ID (or collection index) of the changed entity.
+			/// </summary>
+			public readonly int ID;
+
+			/// <summary>
+			/// The entity's value in the newer snapshot.
+			/// </summary>
+			public readonly T Value;
+
+			internal Change(int id, T value)
+			{
+				ID = id;
+				Value = value;
+			}
+		};
+
+		/// <summary>
+		/// The number of entities in the older snapshot.
+		/// </summary>
+		public readonly int OldCount;
+
+		/// <summary>
+		/// The number of entities in the newer snapshot.
+		/// </summary>
+		public readonly int NewCount;
+
+		/// <summary>
+		/// All entities that were changed or added, ordered by ID.
+		/// <para>When entities are keyed by index, added entities are those whose IDs are greater than or equal to <see cref="OldCount"/>.</para>
+		/// </summary>
+		public readonly IReadOnlyList<Change> Changes;
+
+		/// <summary>
+		/// The IDs of all entities in the older snapshot that aren't in the newer one, ordered by ID.
+		/// </summary>
+		public readonly IReadOnlyList<int> RemovedIDs;
+
+		/// <summary>
+		/// The number of entities added to the collection.
+		/// </summary>
+		public readonly int AddedCount;
+
+		/// <summary>
+		/// The number of entities removed from the collection.
+		/// </summary>
+		public int RemovedCount => RemovedIDs.Count;
+
+		/// <summary>
+		/// Whether or not the two snapshots were identical.
+		/// </summary>
+		public bool IsEmpty => (Changes.Count == 0) && (RemovedIDs.Count == 0) && (OldCount == NewCount);
+
+		// null when entities are keyed by index; otherwise, the newer snapshot's IDs, in order, so it can be rebuilt
+		readonly Func<T, int> getID;
+		readonly int[] newIDs;
+		readonly bool hasDuplicates;
+
+		/// <summary>
+		/// Computes the delta between two consecutive snapshots of a state collection, comparing entities by reference.
+		/// </summary>
+		/// <param name="oldItems">The older snapshot. A null collection is treated as empty.</param>
+		/// <param name="newItems">The newer snapshot. A null collection is treated as empty.</param>
+		public StateDelta(IReadOnlyList<T> oldItems, IReadOnlyList<T> newItems)
+			: this(oldItems, newItems, null) { }
+
+		/// <summary>
+		/// Computes the delta between two consecutive snapshots of a state collection, comparing entities
+		/// with the given <see cref="IEqualityComparer{T}"/>.
+		/// </summary>
+		/// <param name="oldItems">The older snapshot. A null collection is treated as empty.</param>
+		/// <param name="newItems">The newer snapshot. A null collection is treated as empty.</param>
+		/// <param name="comparer">Used to decide if an entity changed. If null, entities are compared by reference.</param>
+		public StateDelta(IReadOnlyList<T> oldItems, IReadOnlyList<T> newItems, IEqualityComparer<T> comparer)
+			: this(oldItems, newItems, null, comparer) { }
+
+		/// <summary>
+		/// Computes the delta between two consecutive snapshots of a state collection, keying entities by a stable ID,
+		/// and comparing them with the given <see cref="IEqualityComparer{T}"/>.
+		/// </summary>
+		/// <param name="oldItems">The older snapshot. A null collection is treated as empty.</param>
+		/// <param name="newItems">The newer snapshot. A null collection is treated as empty.</param>
+		/// <param name="getID">Gets an entity's stable ID, which has to be unique within a snapshot. If null, entities are keyed by index.
+		/// Duplicate IDs are logged, and every entity sharing an ID after the first is reported as changed.</param>
+		/// <param name="comparer">Used to decide if an entity changed. If null, entities are compared by reference.</param>
+		public StateDelta(IReadOnlyList<T> oldItems, IReadOnlyList<T> newItems, Func<T, int> getID, IEqualityComparer<T> comparer)
+		{
+			OldCount = oldItems?.Count ?? 0;
+			NewCount = newItems?.Count ?? 0;
+
+			List<Change> changes = new List<Change>();
+			List<int> removedIDs = new List<int>();
+
+			if(getID == null)
+			{
+				for(int i = 0; i < NewCount; i++)
+				{
+					T newItem = newItems[i];
+
+					if(i >= OldCount || !AreEqual(oldItems[i], newItem, comparer))
+					{ changes.Add(new Change(i, newItem)); }
+				}
+
+				for(int i = NewCount; i < OldCount; i++)
+				{ removedIDs.Add(i); }
+
+				AddedCount = Math.Max(NewCount - OldCount, 0);
+			}
+			else
+			{
+				Dictionary<int, T> oldByID = new Dictionary<int, T>(OldCount);
+				for(int i = 0; i < OldCount; i++)
+				{
+					int id = getID(oldItems[i]);
+
+					// the first entity keeps the ID; any others can't be matched up
+					if(oldByID.ContainsKey(id))
+					{
+						Log.Error($"StateDelta found entity ID {id} more than once in the older snapshot");
+						hasDuplicates = true;
+					}
+					else
+					{ oldByID.Add(id, oldItems[i]); }
+				}
+
+				HashSet<int> seenIDs = new HashSet<int>();
+				newIDs = new int[NewCount];
+				for(int i = 0; i < NewCount; i++)
+				{
+					T newItem = newItems[i];
+					int id = getID(newItem);
+					newIDs[i] = id;
+
+					if(!seenIDs.Add(id))
+					{
+						Log.Error($"StateDelta found entity ID {id} more than once in the newer snapshot");
+						hasDuplicates = true;
+						changes.Add(new Change(id, newItem));
+					}
+					else if(oldByID.TryGetValue(id, out T oldItem))
+					{
+						// whatever's left over once every new entity's been matched up was removed
+						oldByID.Remove(id);
+
+						if(!AreEqual(oldItem, newItem, comparer))
+						{ changes.Add(new Change(id, newItem)); }
+					}
+					else
+					{
+						changes.Add(new Change(id, newItem));
+						AddedCount++;
+					}
+				}
+
+				removedIDs.AddRange(oldByID.Keys);
+
+				changes.Sort((a, b) => a.ID.CompareTo(b.ID));
+				removedIDs.Sort();
+			}
+
+			this.getID = getID;
+			Changes = changes;
+			RemovedIDs = removedIDs;
+		}
+
+		/// <summary>
+		/// Checks if the entity with the given ID was changed or added.
+		/// <para>Downstream passes can use this to skip work on entities that didn't change.</para>
+		/// </summary>
+		/// <param name="id">The stable ID of the entity to check.</param>
+		/// <returns>True if the entity was changed or added; false if it's unchanged, or doesn't exist in the newer snapshot.</returns>
+		public bool IsChanged(int id)
+		{
+			if(getID == null && (id < 0 || id >= NewCount))
+			{ return false; }
+
+			int lower = 0;
+			int upper = Changes.Count - 1;
+
+			// changes are ordered by ID, so we can binary search
+			while(lower <= upper)
+			{
+				int mid = lower + ((upper - lower) / 2);
+				int midID = Changes[mid].ID;
+
+				if(midID == id)
+				{ return true; }
+
+				if(midID < id)
+				{ lower = mid + 1; }
+				else
+				{ upper = mid - 1; }
+			}
+
+			return false;
+		}
+
+		/// <summary>
+		/// Applies this delta to the older snapshot, reconstructing the newer snapshot.
+		/// </summary>
+		/// <param name="oldItems">The older snapshot this delta was computed from.</param>
+		/// <returns>A new collection equivalent to the newer snapshot.</returns>
+		public IReadOnlyList<T> Apply(IReadOnlyList<T> oldItems)
+		{
+			int oldCount = oldItems?.Count ?? 0;
+			if(hasDuplicates)
+			{ Log.Error("couldn't apply StateDelta: its snapshots had duplicate entity IDs"); }
+			else if(oldCount == OldCount)
+			{
+				T[] items = new T[NewCount];
+
+				if(getID == null)
+				{
+					int carried = Math.Min(OldCount, NewCount);
+					for(int i = 0; i < carried; i++)
+					{ items[i] = oldItems[i]; }
+
+					foreach(Change change in Changes)
+					{ items[change.ID] = change.Value; }
+
+					return items;
+				}
+
+				Dictionary<int, T> values = new Dictionary<int, T>(NewCount);
+				for(int i = 0; i < oldCount; i++)
+				{ values[getID(oldItems[i])] = oldItems[i]; }
+
+				foreach(Change change in Changes)
+				{ values[change.ID] = change.Value; }
+
+				for(int i = 0; i < NewCount; i++)
+				{
+					if(!values.TryGetValue(newIDs[i], out items[i]))
+					{
+						Log.Error($"couldn't apply StateDelta: entity {newIDs[i]} isn't in the older snapshot");
+						return new T[0];
+					}
+				}
+
+				return items;
+			}
+			else
+			{ Log.Error($"couldn't apply StateDelta: expected a snapshot with {OldCount} entities, but got {oldCount}"); }
+
+			return new T[0];
+		}
+
+		static bool AreEqual(T a, T b, IEqualityComparer<T> comparer)
+		{
+			if(comparer != null)
+			{ return comparer.Equals(a, b); }
+
+			return ReferenceEquals(a, b);
+		}
+	};
+}
\ No newline at end of file
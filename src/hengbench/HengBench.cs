@@ -0,0 +1,177 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.IO;
+
+namespace hengbench
+{
+	/// <summary>
+	/// heng-bench: times heng's managed hot paths, and writes the results as json, in the same shape as hcore_bench's.
+	/// <para>A benchmark's setup also checks its results against the reference implementation, where there's one,
+	/// so a run fails if the fast path stops agreeing with it.</para>
+	/// </summary>
+	static class HengBench
+	{
+		const int resultsVersion = 1;
+		const int samplesDefault = 15;
+		const int samplesMax = 1000;
+
+		class Benchmark
+		{
+			public readonly string Name;
+			public readonly int Iterations;	// operations per sample; results are per operation
+
+			public readonly Func<bool> Setup;	// optional
+			public readonly Action<int> Run;
+			public readonly Action Teardown;	// optional
+
+			public Benchmark(string name, int iterations, Func<bool> setup, Action<int> run, Action teardown)
+			{
+				Name = name;
+				Iterations = iterations;
+				Setup = setup;
+				Run = run;
+				Teardown = teardown;
+			}
+		};
+
+		static readonly Benchmark[] benchmarks =
+		{
+			new Benchmark("physics/collide_managed_1024", 5, PhysicsBench.Setup, PhysicsBench.RunManaged, null),
+			new Benchmark("physics/collide_native_1024", 20, PhysicsBench.Setup, PhysicsBench.RunNative, null),
+			new Benchmark("state/churn_100k_list_copied", 20, PersistentBench.Setup, PersistentBench.RunCopiedList, PersistentBench.Teardown),
+			new Benchmark("state/churn_100k_list_persistent", 20, PersistentBench.Setup, PersistentBench.RunPersistentList, PersistentBench.Teardown),
+			new Benchmark("state/churn_100k_dictionary_copied", 20, PersistentBench.Setup, PersistentBench.RunCopiedDictionary, PersistentBench.Teardown),
+			new Benchmark("state/churn_100k_dictionary_persistent", 20, PersistentBench.Setup, PersistentBench.RunPersistentDictionary, PersistentBench.Teardown)
+		};
+
+		static double TimeSample(Benchmark b)
+		{
+			Stopwatch watch = Stopwatch.StartNew();
+			b.Run(b.Iterations);
+			watch.Stop();
+
+			return watch.Elapsed.TotalMilliseconds * 1e6 / b.Iterations;
+		}
+
+		// one warm-up sample is thrown away, then the rest are summarized
+		static bool RunBenchmark(Benchmark b, int sampleCount, TextWriter output, bool first)
+		{
+			output.Write($"{(first ? "" : ",")}\n\t\t{{ \"name\": \"{b.Name}\"");
+
+			if(b.Setup != null && !b.Setup())
+			{
+				Console.Error.WriteLine($"couldn't set up benchmark '{b.Name}'");
+				output.Write(", \"error\": \"setup failed\" }");
+				return false;
+			}
+
+			double[] samples = new double[sampleCount];
+
+			TimeSample(b);
+			for(int i = 0; i < sampleCount; i++)
+			{ samples[i] = TimeSample(b); }
+
+			b.Teardown?.Invoke();
+
+			Array.Sort(samples);
+
+			double mean = 0;
+			for(int i = 0; i < sampleCount; i++)
+			{ mean += samples[i] / sampleCount; }
+
+			output.Write(FormattableString.Invariant(
+				$", \"iterations\": {b.Iterations}, \"min_ns\": {samples[0]:F1}, \"median_ns\": {samples[sampleCount / 2]:F1}, \"mean_ns\": {mean:F1}, \"max_ns\": {samples[sampleCount - 1]:F1} }}"));
+
+			return true;
+		}
+
+		static void PrintUsage()
+		{
+			Console.Error.Write(
+				"usage: heng_bench [options]\n" +
+				"\tresults are written as json, one entry per benchmark; times are per operation\n" +
+				"options:\n" +
+				$"\t--samples <count>\ttimed samples per benchmark (default: {samplesDefault})\n" +
+				"\t--filter <text>\tonly run benchmarks whose names contain the text\n" +
+				"\t--commit <id>\trecorded in the results, to track them per commit\n" +
+				"\t--out <path>\twrite results to a file, instead of stdout\n" +
+				"\t--list\tprint benchmark names and exit\n");
+		}
+
+		static int Main(string[] args)
+		{
+			int sampleCount = samplesDefault;
+			string filter = null;
+			string commit = "unknown";
+			string outPath = null;
+
+			for(int i = 0; i < args.Length; i++)
+			{
+				string arg = args[i];
+
+				if(arg == "--samples" && i + 1 < args.Length)
+				{
+					if(!int.TryParse(args[++i], out sampleCount) || sampleCount < 1 || sampleCount > samplesMax)
+					{
+						Console.Error.WriteLine($"sample count must be between 1 and {samplesMax}");
+						return 1;
+					}
+				}
+				else if(arg == "--filter" && i + 1 < args.Length)
+				{ filter = args[++i]; }
+				else if(arg == "--commit" && i + 1 < args.Length)
+				{ commit = args[++i]; }
+				else if(arg == "--out" && i + 1 < args.Length)
+				{ outPath = args[++i]; }
+				else if(arg == "--help")
+				{
+					PrintUsage();
+					return 0;
+				}
+				else if(arg == "--list")
+				{
+					foreach(Benchmark b in benchmarks)
+					{ Console.WriteLine(b.Name); }
+
+					return 0;
+				}
+				else
+				{
+					PrintUsage();
+					return 1;
+				}
+			}
+
+			TextWriter output;
+			try
+			{ output = (outPath != null) ? new StreamWriter(outPath) : Console.Out; }
+			catch(Exception e) when (e is IOException || e is UnauthorizedAccessException)
+			{
+				Console.Error.WriteLine($"couldn't open '{outPath}' for writing");
+				return 1;
+			}
+
+			output.Write($"{{\n\t\"version\": {resultsVersion},\n\t\"commit\": \"{commit}\",\n\t\"samples\": {sampleCount},\n\t\"benchmarks\": [");
+
+			bool success = true;
+			bool first = true;
+			foreach(Benchmark b in benchmarks)
+			{
+				if(filter != null && !b.Name.Contains(filter))
+				{ continue; }
+
+				success = RunBenchmark(b, sampleCount, output, first) && success;
+				first = false;
+			}
+
+			output.Write("\n\t]\n}\n");
+			output.Flush();
+
+			if(outPath != null)
+			{ output.Dispose(); }
+
+			return success ? 0 : 1;
+		}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,213 @@
+﻿using System;
+using System.Collections.Generic;
+using heng;
+
+namespace hengbench
+{
+	/// <summary>
+	/// A state of 100k entities, of which 1% are replaced every frame, kept in a persistent list and dictionary
+	/// and, for comparison, in a list and dictionary that are copied every frame, as states used to be.
+	/// </summary>
+	static class PersistentBench
+	{
+		const int entityCount = 100000;
+		const int churnCount = entityCount / 100;
+		const int checkFrames = 8;
+
+		class Entity
+		{
+			public readonly int ID;
+			public readonly int Frame;
+
+			public Entity(int id, int frame)
+			{
+				ID = id;
+				Frame = frame;
+			}
+		};
+
+		static PersistentList<Entity> persistentList;
+		static PersistentDictionary<int, Entity> persistentDictionary;
+		static List<Entity> copiedList;
+		static Dictionary<int, Entity> copiedDictionary;
+
+		static bool checkedEquivalent;
+		static bool equivalent;
+		static int frame;
+
+		// deterministic, so every run churns the same entities
+		static uint randState;
+
+		static int RandomEntity()
+		{
+			randState = randState * 1664525u + 1013904223u;
+			return (int)((randState >> 8) % entityCount);
+		}
+
+		static void Reset()
+		{
+			randState = 1;
+			frame = 0;
+
+			PersistentList<Entity>.Builder listBuilder = new PersistentList<Entity>.Builder();
+			PersistentDictionary<int, Entity> dictionary = PersistentDictionary<int, Entity>.Empty;
+			copiedList = new List<Entity>(entityCount);
+			copiedDictionary = new Dictionary<int, Entity>(entityCount);
+
+			for(int i = 0; i < entityCount; i++)
+			{
+				Entity entity = new Entity(i, 0);
+
+				listBuilder.Add(entity);
+				dictionary = dictionary.SetItem(i, entity);
+				copiedList.Add(entity);
+				copiedDictionary.Add(i, entity);
+			}
+
+			persistentList = listBuilder.ToList();
+			persistentDictionary = dictionary;
+		}
+
+		// each collection type churns the same entities, in the same order
+		static void ChurnPersistentList()
+		{
+			frame++;
+			for(int i = 0; i < churnCount; i++)
+			{
+				int id = RandomEntity();
+				persistentList = persistentList.SetItem(id, new Entity(id, frame));
+			}
+		}
+
+		static void ChurnPersistentDictionary()
+		{
+			frame++;
+			for(int i = 0; i < churnCount; i++)
+			{
+				int id = RandomEntity();
+				persistentDictionary = persistentDictionary.SetItem(id, new Entity(id, frame));
+			}
+		}
+
+		static void ChurnCopiedList()
+		{
+			frame++;
+			copiedList = new List<Entity>(copiedList);
+			for(int i = 0; i < churnCount; i++)
+			{
+				int id = RandomEntity();
+				copiedList[id] = new Entity(id, frame);
+			}
+		}
+
+		static void ChurnCopiedDictionary()
+		{
+			frame++;
+			copiedDictionary = new Dictionary<int, Entity>(copiedDictionary);
+			for(int i = 0; i < churnCount; i++)
+			{
+				int id = RandomEntity();
+				copiedDictionary[id] = new Entity(id, frame);
+			}
+		}
+
+		// every collection makes its own entities, so they're compared by value
+		static bool SameEntity(Entity a, Entity b) => (a.ID == b.ID && a.Frame == b.Frame);
+
+		// every persistent frame has to match the copied one, and leave the frames before it as they were
+		static bool CheckEquivalent()
+		{
+			Reset();
+
+			PersistentList<Entity> firstList = persistentList;
+			PersistentDictionary<int, Entity> firstDictionary = persistentDictionary;
+
+			for(int f = 0; f < checkFrames; f++)
+			{
+				uint frameRandState = randState;
+				int frameStart = frame;
+
+				ChurnCopiedList();
+				randState = frameRandState;
+				frame = frameStart;
+				ChurnCopiedDictionary();
+				randState = frameRandState;
+				frame = frameStart;
+				ChurnPersistentList();
+				randState = frameRandState;
+				frame = frameStart;
+				ChurnPersistentDictionary();
+			}
+
+			if(persistentList.Count != entityCount || persistentDictionary.Count != entityCount)
+			{
+				Console.Error.WriteLine($"persistent collections hold {persistentList.Count} and {persistentDictionary.Count} entities, instead of {entityCount}");
+				return false;
+			}
+
+			int i = 0;
+			foreach(Entity entity in persistentList)
+			{
+				if(!SameEntity(entity, copiedList[i]) || !SameEntity(persistentDictionary[i], copiedDictionary[i]))
+				{
+					Console.Error.WriteLine($"persistent collections disagree with copied ones on entity {i}");
+					return false;
+				}
+
+				if(firstList[i].Frame != 0 || firstDictionary[i].Frame != 0)
+				{
+					Console.Error.WriteLine($"churning persistent collections changed entity {i} in an earlier frame");
+					return false;
+				}
+
+				i++;
+			}
+
+			return true;
+		}
+
+		public static bool Setup()
+		{
+			if(!checkedEquivalent)
+			{
+				equivalent = CheckEquivalent();
+				checkedEquivalent = true;
+			}
+
+			Reset();
+			return equivalent;
+		}
+
+		public static void RunPersistentList(int iterations)
+		{
+			for(int i = 0; i < iterations; i++)
+			{ ChurnPersistentList(); }
+		}
+
+		public static void RunPersistentDictionary(int iterations)
+		{
+			for(int i = 0; i < iterations; i++)
+			{ ChurnPersistentDictionary(); }
+		}
+
+		public static void RunCopiedList(int iterations)
+		{
+			for(int i = 0; i < iterations; i++)
+			{ ChurnCopiedList(); }
+		}
+
+		public static void RunCopiedDictionary(int iterations)
+		{
+			for(int i = 0; i < iterations; i++)
+			{ ChurnCopiedDictionary(); }
+		}
+
+		public static void Teardown()
+		{
+			persistentList = null;
+			persistentDictionary = null;
+			copiedList = null;
+			copiedDictionary = null;
+		}
+	};
+}
\ No newline at end of file
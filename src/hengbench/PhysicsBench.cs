@@ -0,0 +1,143 @@
+﻿using System;
+using System.Collections.Generic;
+using heng;
+using heng.Physics;
+
+namespace hengbench
+{
+	/// <summary>
+	/// Collision tests over a crowd of convex bodies, spread over a few sectors,
+	/// through both the managed reference tester and the native one.
+	/// </summary>
+	static class PhysicsBench
+	{
+		const int bodyCount = 1024;
+		const int sectorSpan = 2;
+		const float mtvTolerance = 1e-3f;
+
+		// a body that never changes, so every step collides the same crowd
+		class BenchBody : IPhysicsBody
+		{
+			public int ID { get; } = EntityIDs.Next();
+			public WorldPoint Position { get; }
+			public ICollider Collider { get; }
+			public float Mass => 1;
+			public PhysicsMaterial Material { get; } = new PhysicsMaterial(0, 0, 1);
+			public Vector2 Velocity { get; }
+
+			public BenchBody(WorldPoint position, ICollider collider, Vector2 velocity)
+			{
+				Position = position;
+				Collider = collider;
+				Velocity = velocity;
+			}
+
+			public IPhysicsBody ImpulsePass(Vector2 gravity, float deltaT) => this;
+			public IPhysicsBody CollisionPass(IEnumerable<CollisionData> collisions) => this;
+		};
+
+		static IReadOnlyList<IPhysicsBody> bodies;
+		static bool equivalent;
+		static readonly CollisionTester managed = new CollisionTester();
+		static readonly NativeCollisionTester native = new NativeCollisionTester();
+
+		// deterministic, so every run collides the same things
+		static uint randState;
+
+		static float Random()
+		{
+			randState = randState * 1664525u + 1013904223u;
+			return (randState >> 8) / (float)(1 << 24);
+		}
+
+		// regular polygons of 3 to 8 sides; a quarter stand still, and a few have no collider at all
+		static IReadOnlyList<IPhysicsBody> CreateBodies()
+		{
+			randState = 1;
+			List<IPhysicsBody> crowd = new List<IPhysicsBody>(bodyCount);
+
+			for(int i = 0; i < bodyCount; i++)
+			{
+				int sides = 3 + (int)(Random() * 6);
+				float radius = 8 + Random() * 16;
+
+				Vector2[] points = new Vector2[sides];
+				for(int p = 0; p < sides; p++)
+				{
+					double a = p * 2 * Math.PI / sides;
+					points[p] = new Vector2((float)(Math.Cos(a)) * radius, (float)(Math.Sin(a)) * radius);
+				}
+
+				WorldPoint position = new WorldPoint(
+					new WorldCoordinate((int)(Random() * sectorSpan), Random()),
+					new WorldCoordinate((int)(Random() * sectorSpan), Random()));
+
+				Vector2 velocity = (i % 4 == 0) ? Vector2.Zero : new Vector2(Random() * 2 - 1, Random() * 2 - 1);
+				ICollider collider = (i % 61 == 0) ? null : new ConvexCollider(new Polygon(points));
+
+				crowd.Add(new BenchBody(position, collider, velocity));
+			}
+
+			return crowd;
+		}
+
+		// every body has to see the same contacts, in the same order, with the same mtvs
+		static bool CheckEquivalent(IReadOnlyDictionary<IPhysicsBody, IReadOnlyList<CollisionData>> expected,
+			IReadOnlyDictionary<IPhysicsBody, IReadOnlyList<CollisionData>> actual)
+		{
+			if(expected.Count != actual.Count)
+			{
+				Console.Error.WriteLine($"managed tester found {expected.Count} colliding bodies, but native found {actual.Count}");
+				return false;
+			}
+
+			foreach(var pair in expected)
+			{
+				if(!actual.TryGetValue(pair.Key, out IReadOnlyList<CollisionData> collisions) || collisions.Count != pair.Value.Count)
+				{
+					Console.Error.WriteLine($"native tester disagrees on how many collisions a body at {pair.Key.Position.PixelPosition} has");
+					return false;
+				}
+
+				for(int i = 0; i < collisions.Count; i++)
+				{
+					if(collisions[i].Other != pair.Value[i].Other || !collisions[i].MTV.IsApproximately(pair.Value[i].MTV, mtvTolerance))
+					{
+						Console.Error.WriteLine($"native tester disagrees on collision {i} of a body at {pair.Key.Position.PixelPosition}");
+						return false;
+					}
+				}
+			}
+
+			return true;
+		}
+
+		public static bool Setup()
+		{
+			if(bodies == null)
+			{
+				bodies = CreateBodies();
+
+				var expected = managed.GetCollisions(bodies);
+				if(expected.Count == 0)
+				{ Console.Error.WriteLine("physics bench crowd doesn't collide at all"); }
+				else
+				{ equivalent = CheckEquivalent(expected, native.GetCollisions(bodies)); }
+			}
+
+			return equivalent;
+		}
+
+		public static void RunManaged(int iterations)
+		{
+			for(int i = 0; i < iterations; i++)
+			{ managed.GetCollisions(bodies); }
+		}
+
+		public static void RunNative(int iterations)
+		{
+			for(int i = 0; i < iterations; i++)
+			{ native.GetCollisions(bodies); }
+		}
+	};
+}
\ No newline at end of file
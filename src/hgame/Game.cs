@@ -34,9 +34,13 @@ namespace hgame
 			config.Audio.SampleRate = 44100;
 			config.Audio.Channels = 2;
 			config.Audio.Sounds.MaxSounds = 1024;
-			config.Audio.Mixer.ChannelCount = 32;
+			config.Audio.Sounds.CompressSounds = true;
+			config.Audio.Mixer.ChannelCount = 128;
 			config.Audio.Mixer.AttenuationThreshold = 32;
 			config.Audio.Mixer.StereoFalloffExponent = 0.15f;
+			config.Audio.Mixer.RealVoiceCount = 32;
+
+			config.Video.Backend = heng.Video.VideoBackend.Windowed;
 
 			if(Engine.Init(config))
 			{
@@ -10,11 +10,13 @@ namespace hgame
 		{
 			readonly List<IPhysicsBody> physicsBodies;
 			Vector2 gravity;
+			PhysicsKernel kernel;
 
 			public PhysicsStateBuilder()
 			{
 				physicsBodies = new List<IPhysicsBody>();
 				gravity = new Vector2(0, -550);
+				kernel = PhysicsKernel.Managed;
 			}
 
 			public int AddPhysicsObject(IPhysicsBody obj)
@@ -30,9 +32,14 @@ namespace hgame
 				this.gravity = gravity;
 			}
 
+			public void SetKernel(PhysicsKernel kernel)
+			{
+				this.kernel = kernel;
+			}
+
 			public PhysicsState Build(float deltaT)
 			{
-				return new PhysicsState(physicsBodies, gravity, deltaT);
+				return new PhysicsState(physicsBodies, gravity, deltaT, kernel);
 			}
 
 			public void Clear()
@@ -1,4 +1,5 @@
 ﻿using System.Collections.Generic;
+using System.Linq;
 using heng;
 using heng.Video;
 
@@ -13,9 +14,13 @@ namespace hgame
 			readonly List<IDrawable> drawables;
 			Camera camera;
 
+			// built once, so they keep their IDs from frame to frame
+			readonly IDrawable[] sectorLines;
+
 			public VideoStateBuilder()
 			{
 				drawables = new List<IDrawable>();
+				sectorLines = DebugDrawSectors(5).ToArray();
 			}
 
 			public int AddDrawable(IDrawable drw)
@@ -39,7 +44,7 @@ namespace hgame
 			public VideoState Build(VideoState old)
 			{
 				Window w = old?.Windows[windowID] ?? BuildWindow();
-				drawables.AddRange(DebugDrawSectors(5));
+				drawables.AddRange(sectorLines);
 
 				if(camera == null)
 				{
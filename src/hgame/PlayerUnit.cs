@@ -23,8 +23,8 @@ namespace hgame
 			texture = new Texture("../../data/textest.bmp");
 
 			InputDevice device = new InputDevice();
-			device.RemapAxis("Horizontal", new ButtonAxis(new Key(KeyCode.Left), new Key(KeyCode.Right)));
-			device.RemapAxis("Vertical", new ButtonAxis(new Key(KeyCode.Down), new Key(KeyCode.Up)));
+			device = device.WithAxis("Horizontal", new ButtonAxis(new Key(KeyCode.Left), new Key(KeyCode.Right)));
+			device = device.WithAxis("Vertical", new ButtonAxis(new Key(KeyCode.Down), new Key(KeyCode.Up)));
 			
 			WorldPoint pos = new WorldPoint(new Vector2(280 - 16, 200 - 16));
 
@@ -12,7 +12,7 @@ namespace hgame
 
 		readonly int inputDevice;
 		readonly int staticBody;
-		readonly int rectDrawable;
+		readonly int layerDrawable;
 		readonly int soundSource;
 
 		public Scenery(GamestateBuilder newState)
@@ -22,7 +22,7 @@ namespace hgame
 			sound = new Sound("../../data/sto.ogg");
 
 			InputDevice device = new InputDevice();
-			device.RemapButton("SoundTest", new Key(KeyCode.Space));
+			device = device.WithButton("SoundTest", new Key(KeyCode.Space));
 
 			WorldPoint pos = new WorldPoint(new Vector2(276, 140));
 			Rect rect = new Rect(Vector2.Zero, new Vector2(256, 16));
@@ -30,11 +30,16 @@ namespace hgame
 			Polygon collider = new Polygon(new Vector2(-256, -16), new Vector2(256, -16), new Vector2(256, 16), new Vector2(-256, 16));
 			StaticBody body = new StaticBody(pos, new ConvexCollider(collider), PhysicsMaterialLibrary.Concrete);
 			RectDrawable drw = new RectDrawable(rect, pos, true, Color.Black);
+
+			// scenery never changes, so it's drawn once and cached
+			int w = HMath.RoundToInt(rect.Extents.X * 2);
+			int h = HMath.RoundToInt(rect.Extents.Y * 2);
+			StaticLayer layer = new StaticLayer(new IDrawable[] { drw }, pos.PixelTranslate(rect.BottomLeft), w, h);
 			SoundSource src = new SoundSource(body.Position);
 
 			inputDevice = newState.Input.AddDevice(device);
 			staticBody = newState.Physics.AddPhysicsObject(body);
-			rectDrawable = newState.Video.AddDrawable(drw);
+			layerDrawable = newState.Video.AddDrawable(layer);
 			soundSource = newState.Audio.AddSoundSource(src);
 		}
 
@@ -47,7 +52,7 @@ namespace hgame
 
 			InputDevice device = oldState.Input.Devices[oldScenery.inputDevice];
 			StaticBody body = (StaticBody)(oldState.Physics.PhysicsBodies[oldScenery.staticBody]);
-			RectDrawable drw = (RectDrawable)(oldState.Video.Drawables[oldScenery.rectDrawable]);
+			StaticLayer layer = (StaticLayer)(oldState.Video.Drawables[oldScenery.layerDrawable]);
 			SoundSource src = oldState.Audio.SoundSources[oldScenery.soundSource];
 
 			if(device.GetButtonPressed("SoundTest"))
@@ -55,7 +60,7 @@ namespace hgame
 
 			inputDevice = newState.Input.AddDevice(device);
 			staticBody = newState.Physics.AddPhysicsObject(body);
-			rectDrawable = newState.Video.AddDrawable(drw);
+			layerDrawable = newState.Video.AddDrawable(layer);
 			soundSource = newState.Audio.AddSoundSource(src);
 		}
 
@@ -0,0 +1,510 @@
+// heng-pack: builds pack files for hcore to mount
+// sounds are converted by the same hcore code that loads them at runtime, so packed samples
+// are exactly what the game would have made for itself
+
+#define SDL_MAIN_HANDLED
+
+#include <stdarg.h>
+#include "audio.h"
+#include "pack.h"
+
+extern bool Audio_Sounds_Init(struct audio_sounds_config config);
+extern void Audio_Sounds_Quit();
+extern sound *Audio_Sounds_GetSound(int soundID);
+
+typedef struct
+{
+	char *path;
+	uint64 hash;
+
+	pack_entry_type type;
+	uint8 *data;
+	uint64 dataLen;
+
+	pack_entry info;	// only the type-specific info is used
+} tool_entry;
+
+intern bool verbose;
+
+intern bool convertSounds;
+intern SDL_AudioSpec audioSpec;
+
+intern bool convertSurfaces;
+intern uint32 pixelFormat;
+
+// - - - - - -
+// hcore hooks
+// - - - - - -
+
+void Log_FormatToAll(log_level level, char *msg, ...)
+{
+	if(level == LOG_DEBUG && !verbose)
+	{ return; }
+
+	static char *prefixes[] = { "debug", "note", "warning", "error", "failure" };
+	fprintf(stderr, "%s: ", prefixes[level]);
+
+	va_list args;
+	va_start(args, msg);
+	vfprintf(stderr, msg, args);
+	va_end(args);
+
+	fprintf(stderr, "\n");
+}
+
+void Log_Quit()
+{
+	fflush(stderr);
+}
+
+// sounds get converted to this instead of a device's format
+SDL_AudioSpec Audio_GetSpec()
+{
+	return audioSpec;
+}
+
+// - - - - - -
+// helpers
+// - - - - - -
+
+intern uint64 Align(uint64 offset, uint64 alignment)
+{
+	return (offset + alignment - 1) & ~(alignment - 1);
+}
+
+intern bool HasExtension(char *path, char *ext)
+{
+	char *dot = strrchr(path, '.');
+	if(dot)
+	{
+		dot++;
+		for(; *dot && *ext; dot++, ext++)
+		{
+			if(Pack_NormalizePathChar(*dot) != *ext)
+			{ return false; }
+		}
+
+		return !(*dot) && !(*ext);
+	}
+
+	return false;
+}
+
+intern bool PathsEqual(char *a, char *b)
+{
+	for(; *a && *b; a++, b++)
+	{
+		if(Pack_NormalizePathChar(*a) != Pack_NormalizePathChar(*b))
+		{ return false; }
+	}
+
+	return !(*a) && !(*b);
+}
+
+intern uint8 *LoadFile(char *path, uint64 *len)
+{
+	uint8 *data = NULL;
+
+	FILE *file = fopen(path, "rb");
+	if(file)
+	{
+		if(fseek(file, 0, SEEK_END) == 0)
+		{
+			long size = ftell(file);
+			rewind(file);
+
+			if(size >= 0)
+			{
+				data = malloc(max(size, 1));
+				if(data && fread(data, 1, size, file) == (size_t)(size))
+				{ *len = (uint64)(size); }
+				else
+				{
+					free(data);
+					data = NULL;
+				}
+			}
+		}
+
+		fclose(file);
+	}
+
+	if(!data)
+	{ LogError("couldn't read '%s'", path); }
+
+	return data;
+}
+
+intern bool ParseAudioFormat(char *name, SDL_AudioFormat *format)
+{
+	struct { char *name; SDL_AudioFormat format; } formats[] =
+	{
+		{ "u8", AUDIO_U8 }, { "s8", AUDIO_S8 }, { "u16", AUDIO_U16 },
+		{ "s16", AUDIO_S16 }, { "s32", AUDIO_S32 }, { "f32", AUDIO_F32 }
+	};
+
+	for(int i = 0; i < (int)(sizeof(formats) / sizeof(formats[0])); i++)
+	{
+		if(strcmp(name, formats[i].name) == 0)
+		{
+			*format = formats[i].format;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+intern bool ParsePixelFormat(char *name, uint32 *format)
+{
+	struct { char *name; uint32 format; } formats[] =
+	{
+		{ "argb8888", SDL_PIXELFORMAT_ARGB8888 }, { "rgba8888", SDL_PIXELFORMAT_RGBA8888 },
+		{ "abgr8888", SDL_PIXELFORMAT_ABGR8888 }, { "bgra8888", SDL_PIXELFORMAT_BGRA8888 }
+	};
+
+	for(int i = 0; i < (int)(sizeof(formats) / sizeof(formats[0])); i++)
+	{
+		if(strcmp(name, formats[i].name) == 0)
+		{
+			*format = formats[i].format;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+// - - - - - -
+// entries
+// - - - - - -
+
+intern bool PackSound(tool_entry *entry)
+{
+	int soundID = Audio_Sounds_LoadSound(entry->path);
+	if(soundID < 0)
+	{ return false; }
+
+	sound *s = Audio_Sounds_GetSound(soundID);
+
+	entry->data = malloc(max(s->encodedLen, 1));
+	if(entry->data)
+	{
+		memcpy(entry->data, s->data, s->encodedLen);
+
+		entry->type = PACK_ENTRY_SOUND;
+		entry->dataLen = s->encodedLen;
+		entry->info.info.sound.freq = audioSpec.freq;
+		entry->info.info.sound.format = audioSpec.format;
+		entry->info.info.sound.channels = audioSpec.channels;
+		entry->info.info.sound.encoding = (uint8)(s->encoding);
+		entry->info.info.sound.decodedLen = s->dataLen;
+	}
+
+	Audio_Sounds_FreeSound(soundID);
+	return entry->data != NULL;
+}
+
+intern bool PackSurface(tool_entry *entry)
+{
+	SDL_Surface *loaded = SDL_LoadBMP(entry->path);
+	if(!loaded)
+	{
+		LogError("couldn't load '%s'\n\tSDL error: %s", entry->path, SDL_GetError());
+		return false;
+	}
+
+	SDL_Surface *s = SDL_ConvertSurfaceFormat(loaded, pixelFormat, 0);
+	SDL_FreeSurface(loaded);
+
+	if(!s)
+	{
+		LogError("couldn't convert '%s'\n\tSDL error: %s", entry->path, SDL_GetError());
+		return false;
+	}
+
+	uint64 len = (uint64)(s->pitch) * (uint64)(s->h);
+	entry->data = malloc(max(len, 1));
+	if(entry->data)
+	{
+		memcpy(entry->data, s->pixels, len);
+
+		entry->type = PACK_ENTRY_SURFACE;
+		entry->dataLen = len;
+		entry->info.info.surface.w = s->w;
+		entry->info.info.surface.h = s->h;
+		entry->info.info.surface.pitch = s->pitch;
+		entry->info.info.surface.pixelFormat = pixelFormat;
+	}
+
+	SDL_FreeSurface(s);
+	return entry->data != NULL;
+}
+
+intern bool PackEntry(tool_entry *entry)
+{
+	bool isSound = HasExtension(entry->path, "wav") || HasExtension(entry->path, "ogg");
+	bool isSurface = HasExtension(entry->path, "bmp");
+
+	if(convertSounds && isSound)
+	{ return PackSound(entry); }
+	if(convertSurfaces && isSurface)
+	{ return PackSurface(entry); }
+
+	entry->type = PACK_ENTRY_RAW;
+	entry->data = LoadFile(entry->path, &entry->dataLen);
+	return entry->data != NULL;
+}
+
+// - - - - - -
+// writing
+// - - - - - -
+
+intern bool WritePadding(FILE *file, uint64 *offset, uint64 to)
+{
+	static uint8 zeros[PACK_BLOB_ALIGNMENT];
+
+	while(*offset < to)
+	{
+		uint64 len = min(to - *offset, sizeof(zeros));
+		if(fwrite(zeros, 1, len, file) != len)
+		{ return false; }
+
+		*offset += len;
+	}
+
+	return true;
+}
+
+intern bool WriteBytes(FILE *file, uint64 *offset, void *data, uint64 len)
+{
+	if(len > 0 && fwrite(data, 1, len, file) != len)
+	{ return false; }
+
+	*offset += len;
+	return true;
+}
+
+intern bool WritePack(char *outPath, tool_entry *entries, uint32 entryCount)
+{
+	// keep the table at most half full, so probes stay short
+	uint32 bucketCount = 2;
+	while(bucketCount < entryCount * 2)
+	{ bucketCount <<= 1; }
+
+	uint32 *buckets = malloc(bucketCount * sizeof(uint32));
+	pack_entry *packed = calloc(max(entryCount, 1), sizeof(pack_entry));
+	if(!buckets || !packed)
+	{
+		LogError("couldn't allocate the pack directory");
+
+		free(buckets);
+		free(packed);
+		return false;
+	}
+
+	pack_header header =
+	{
+		.magic = PACK_MAGIC,
+		.version = PACK_VERSION,
+		.entryCount = entryCount,
+		.bucketCount = bucketCount,
+		.bucketsOffset = sizeof(pack_header)
+	};
+
+	header.entriesOffset = Align(header.bucketsOffset + (bucketCount * sizeof(uint32)), sizeof(uint64));
+	header.stringsOffset = header.entriesOffset + (entryCount * sizeof(pack_entry));
+
+	uint64 stringsLen = 0;
+	for(uint32 i = 0; i < entryCount; i++)
+	{ stringsLen += strlen(entries[i].path); }
+
+	uint64 offset = Align(header.stringsOffset + stringsLen, PACK_BLOB_ALIGNMENT);
+	uint32 pathOffset = 0;
+
+	for(uint32 i = 0; i < bucketCount; i++)
+	{ buckets[i] = PACK_BUCKET_EMPTY; }
+
+	for(uint32 i = 0; i < entryCount; i++)
+	{
+		tool_entry *t = &entries[i];
+		pack_entry *e = &packed[i];
+
+		*e = t->info;
+		e->hash = t->hash;
+		e->type = t->type;
+		e->pathOffset = pathOffset;
+		e->pathLen = (uint32)(strlen(t->path));
+		e->dataOffset = offset;
+		e->dataLen = t->dataLen;
+
+		pathOffset += e->pathLen;
+		offset = Align(offset + t->dataLen, PACK_BLOB_ALIGNMENT);
+
+		uint32 bucket = (uint32)(t->hash & (bucketCount - 1));
+		while(buckets[bucket] != PACK_BUCKET_EMPTY)
+		{ bucket = (bucket + 1) & (bucketCount - 1); }
+
+		buckets[bucket] = i;
+	}
+
+	header.fileSize = offset;
+
+	bool success = false;
+
+	FILE *file = fopen(outPath, "wb");
+	if(file)
+	{
+		uint64 written = 0;
+		success = WriteBytes(file, &written, &header, sizeof(header)) &&
+			WriteBytes(file, &written, buckets, bucketCount * sizeof(uint32)) &&
+			WritePadding(file, &written, header.entriesOffset) &&
+			WriteBytes(file, &written, packed, entryCount * sizeof(pack_entry));
+
+		for(uint32 i = 0; success && i < entryCount; i++)
+		{
+			char *path = entries[i].path;
+			for(char *c = path; *c; c++)
+			{ *c = Pack_NormalizePathChar(*c); }
+
+			success = WriteBytes(file, &written, path, strlen(path));
+		}
+
+		for(uint32 i = 0; success && i < entryCount; i++)
+		{
+			success = WritePadding(file, &written, packed[i].dataOffset) &&
+				WriteBytes(file, &written, entries[i].data, entries[i].dataLen);
+		}
+
+		success = success && WritePadding(file, &written, header.fileSize);
+		success = (fclose(file) == 0) && success;
+	}
+
+	if(success)
+	{ LogNote("wrote %u assets to '%s' (%llu bytes)", entryCount, outPath, (unsigned long long)(header.fileSize)); }
+	else
+	{ LogError("couldn't write pack to '%s'", outPath); }
+
+	free(buckets);
+	free(packed);
+	return success;
+}
+
+// - - - - - -
+// main
+// - - - - - -
+
+intern void PrintUsage()
+{
+	fprintf(stderr,
+		"usage: heng-pack <output> [options] <files...>\n"
+		"\tfiles are stored under their paths as given, so run this from where the game loads them\n"
+		"options:\n"
+		"\t--audio <rate> <channels> <u8|s8|u16|s16|s32|f32>\tpre-convert sounds to a device format\n"
+		"\t--adpcm\tstore pre-converted sounds as IMA-ADPCM (s16 only)\n"
+		"\t--pixels <argb8888|rgba8888|abgr8888|bgra8888>\tpre-convert bitmaps to a pixel format\n"
+		"\t--verbose\tprint debug output\n");
+}
+
+int main(int argc, char **argv)
+{
+	if(argc < 3)
+	{
+		PrintUsage();
+		return 1;
+	}
+
+	char *outPath = argv[1];
+	bool compressSounds = false;
+
+	tool_entry *entries = calloc(argc, sizeof(tool_entry));
+	uint32 entryCount = 0;
+	if(!entries)
+	{ return 1; }
+
+	for(int i = 2; i < argc; i++)
+	{
+		char *arg = argv[i];
+
+		if(strcmp(arg, "--audio") == 0 && i + 3 < argc)
+		{
+			audioSpec.freq = atoi(argv[i + 1]);
+			audioSpec.channels = (uint8)(atoi(argv[i + 2]));
+			convertSounds = ParseAudioFormat(argv[i + 3], &audioSpec.format) && audioSpec.freq > 0 && audioSpec.channels > 0;
+
+			if(!convertSounds)
+			{
+				LogError("invalid audio format: %s %s %s", argv[i + 1], argv[i + 2], argv[i + 3]);
+				return 1;
+			}
+
+			i += 3;
+		}
+		else if(strcmp(arg, "--adpcm") == 0)
+		{ compressSounds = true; }
+		else if(strcmp(arg, "--pixels") == 0 && i + 1 < argc)
+		{
+			convertSurfaces = ParsePixelFormat(argv[++i], &pixelFormat);
+			if(!convertSurfaces)
+			{
+				LogError("invalid pixel format: %s", argv[i]);
+				return 1;
+			}
+		}
+		else if(strcmp(arg, "--verbose") == 0)
+		{ verbose = true; }
+		else if(strncmp(arg, "--", 2) == 0)
+		{
+			PrintUsage();
+			return 1;
+		}
+		else
+		{
+			uint64 hash = Pack_HashPath(arg);
+
+			bool duplicate = false;
+			for(uint32 e = 0; e < entryCount; e++)
+			{ duplicate = duplicate || (entries[e].hash == hash && PathsEqual(entries[e].path, arg)); }
+
+			if(duplicate)
+			{ LogWarning("'%s' is listed more than once; packing it once", arg); }
+			else
+			{
+				entries[entryCount].path = arg;
+				entries[entryCount].hash = hash;
+				entryCount++;
+			}
+		}
+	}
+
+	if(compressSounds && !convertSounds)
+	{ LogWarning("--adpcm only applies to sounds pre-converted with --audio"); }
+
+	struct audio_sounds_config soundsConfig =
+	{
+		.maxSounds = 1,
+		.compressSounds = compressSounds,
+		.convertOnLoad = true
+	};
+
+	if(convertSounds && !Audio_Sounds_Init(soundsConfig))
+	{ return 1; }
+
+	bool success = true;
+	for(uint32 i = 0; success && i < entryCount; i++)
+	{
+		LogDebug("packing '%s'", entries[i].path);
+		success = PackEntry(&entries[i]);
+	}
+
+	success = success && WritePack(outPath, entries, entryCount);
+
+	if(convertSounds)
+	{ Audio_Sounds_Quit(); }
+
+	for(uint32 i = 0; i < entryCount; i++)
+	{ free(entries[i].data); }
+
+	free(entries);
+	return success ? 0 : 1;
+}
\ No newline at end of file